@@ -0,0 +1,376 @@
+#include <cli/BatchPipeline.h>
+#include <cli/MemoryBudget.h>
+#include <ImageProcessor.h>
+#include <utils/ConcurrencyGovernor.h>
+#include <utils/MappedFile.h>
+#include <utils/ThreadPool.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace
+{
+    /**
+     * @brief Ограниченная очередь между стадиями
+     *
+     * push() блокируется при заполненной очереди, pop() - при пустой,
+     * пока очередь не закрыта.
+     */
+    template <typename T>
+    class BoundedQueue
+    {
+    public:
+        explicit BoundedQueue(size_t capacity)
+            : capacity_(std::max<size_t>(1, capacity))
+        {
+        }
+
+        void push(T item)
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            not_full_.wait(lock, [this] { return items_.size() < capacity_; });
+            items_.push_back(std::move(item));
+            not_empty_.notify_one();
+        }
+
+        /**
+         * @return false если очередь закрыта и пуста
+         */
+        bool pop(T& item)
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            not_empty_.wait(lock, [this] { return !items_.empty() || closed_; });
+            if (items_.empty())
+            {
+                return false;
+            }
+            item = std::move(items_.front());
+            items_.pop_front();
+            not_full_.notify_one();
+            return true;
+        }
+
+        void close()
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            closed_ = true;
+            not_empty_.notify_all();
+        }
+
+    private:
+        std::mutex mutex_;
+        std::condition_variable not_empty_;
+        std::condition_variable not_full_;
+        std::deque<T> items_;
+        size_t capacity_;
+        bool closed_ = false;
+    };
+
+    /**
+     * @brief Задание в процессе прохождения конвейера
+     */
+    struct PipelineItem
+    {
+        BatchPipeline::Job job;
+        MappedFile file;
+        ImageProcessor image;
+        size_t charged_bytes = 0;
+    };
+
+    using ItemPtr = std::unique_ptr<PipelineItem>;
+    using ItemQueue = BoundedQueue<ItemPtr>;
+
+    /**
+     * @brief Счетчики загрузки стадии
+     */
+    struct StageCounters
+    {
+        std::atomic<size_t> items{0};
+        std::atomic<int64_t> busy_nanoseconds{0};
+    };
+
+    /**
+     * @brief Выполняет функцию стадии, замеряя время и перехватывая исключения
+     */
+    template <typename Function>
+    FilterResult runTimed(StageCounters& counters, Function&& function)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        FilterResult result;
+        try
+        {
+            result = function();
+        }
+        catch (const std::exception& e)
+        {
+            result = FilterResult::failure(FilterError::SystemError, e.what());
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        counters.busy_nanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+        ++counters.items;
+        return result;
+    }
+
+    size_t imageBytes(const ImageProcessor& image)
+    {
+        return static_cast<size_t>(image.getWidth()) * static_cast<size_t>(image.getHeight()) *
+               static_cast<size_t>(image.getChannels());
+    }
+}
+
+BatchPipeline::BatchPipeline(Stages stages)
+    : BatchPipeline(std::move(stages), Config{})
+{
+}
+
+BatchPipeline::BatchPipeline(Stages stages, const Config& config)
+    : stages_(std::move(stages))
+    , config_(resolveConfig(config))
+{
+}
+
+BatchPipeline::Config BatchPipeline::resolveConfig(const Config& config)
+{
+    const int thread_budget = ConcurrencyGovernor::getInstance().getThreadBudget();
+
+    // Большая часть времени уходит на фильтры, декодирование и кодирование
+    // делят оставшиеся потоки бюджета поровну
+    Config resolved = config;
+    if (resolved.read_workers <= 0)
+    {
+        resolved.read_workers = 1;
+    }
+    if (resolved.decode_workers <= 0)
+    {
+        resolved.decode_workers = std::max(1, thread_budget / 4);
+    }
+    if (resolved.process_workers <= 0)
+    {
+        resolved.process_workers = std::max(1, thread_budget / 2);
+    }
+    if (resolved.encode_workers <= 0)
+    {
+        resolved.encode_workers = std::max(1, thread_budget / 4);
+    }
+    if (resolved.queue_capacity == 0)
+    {
+        resolved.queue_capacity = static_cast<size_t>(std::max({resolved.decode_workers,
+                                                                resolved.process_workers,
+                                                                resolved.encode_workers})) * 2;
+    }
+    return resolved;
+}
+
+BatchPipeline::Statistics BatchPipeline::run(const std::vector<Job>& jobs,
+                                             const CompletionCallback& on_complete) const
+{
+    size_t next_index = 0;
+    const JobSource source = [&](Job& job) {
+        if (next_index >= jobs.size())
+        {
+            return false;
+        }
+        job = jobs[next_index++];
+        return true;
+    };
+    return run(source, on_complete);
+}
+
+BatchPipeline::Statistics BatchPipeline::run(const JobSource& next_job,
+                                             const CompletionCallback& on_complete) const
+{
+    ItemQueue decode_queue(config_.queue_capacity);
+    ItemQueue process_queue(config_.queue_capacity);
+    ItemQueue encode_queue(config_.queue_capacity);
+
+    // Допуск мягкий (см. MemoryBudget): при чтении резервируется оценка пиковой
+    // памяти по заголовку (Stages::estimate_bytes), и декодирование начинается
+    // только после допуска. Без оценки учитывается размер файла, а после
+    // декодирования - размер пикселей
+    MemoryBudget memory_budget(config_.memory_budget_bytes);
+
+    StageCounters read_counters;
+    StageCounters decode_counters;
+    StageCounters process_counters;
+    StageCounters encode_counters;
+
+    // Источник заданий вызывается потоками чтения по очереди
+    std::mutex source_mutex;
+
+    // Потоки декодирования, фильтров и кодирования занимают общий бюджет на время
+    // обработки задания, поэтому построчный параллелизм фильтров получает только
+    // незанятые ядра
+    auto& governor = ConcurrencyGovernor::getInstance();
+
+    // Завершение задания: освобождаем бюджет и сообщаем результат
+    auto complete = [&](ItemPtr item, const FilterResult& result) {
+        const Job job = std::move(item->job);
+        const size_t charged_bytes = item->charged_bytes;
+        item.reset();
+        memory_budget.release(charged_bytes);
+        if (on_complete)
+        {
+            on_complete(job, result);
+        }
+    };
+
+    auto read_worker = [&]() {
+        while (true)
+        {
+            auto item = std::make_unique<PipelineItem>();
+            {
+                std::lock_guard<std::mutex> lock(source_mutex);
+                if (!next_job(item->job))
+                {
+                    break;
+                }
+            }
+            const auto result = runTimed(read_counters, [&]() {
+                auto open_result = item->file.open(item->job.input_path);
+                if (open_result.isSuccess())
+                {
+                    item->file.prefetch();
+                }
+                return open_result;
+            });
+            if (!result.isSuccess())
+            {
+                complete(std::move(item), result);
+                continue;
+            }
+
+            const size_t estimated_bytes = stages_.estimate_bytes ? stages_.estimate_bytes(item->file.bytes()) : 0;
+            item->charged_bytes = estimated_bytes > 0 ? estimated_bytes : item->file.size();
+            memory_budget.acquire(item->charged_bytes);
+            decode_queue.push(std::move(item));
+        }
+    };
+
+    auto decode_worker = [&]() {
+        ItemPtr item;
+        while (decode_queue.pop(item))
+        {
+            auto worker_lease = governor.acquireWorker();
+            const auto result = runTimed(decode_counters, [&]() {
+                return stages_.decode(item->file.bytes(), item->image);
+            });
+            worker_lease.release();
+            item->file.close();
+
+            // Оценка учитывает и буферы фильтров, поэтому уменьшается только до нее;
+            // превышение оценки (заголовок не прочитан) учитывается без ожидания
+            const size_t decoded_bytes = result.isSuccess() ? imageBytes(item->image) : 0;
+            const size_t charged_bytes = stages_.estimate_bytes ? std::max(item->charged_bytes, decoded_bytes)
+                                                                : decoded_bytes;
+            memory_budget.adjust(item->charged_bytes, charged_bytes);
+            item->charged_bytes = charged_bytes;
+
+            if (!result.isSuccess())
+            {
+                complete(std::move(item), result);
+                continue;
+            }
+            process_queue.push(std::move(item));
+        }
+    };
+
+    auto process_worker = [&]() {
+        ItemPtr item;
+        while (process_queue.pop(item))
+        {
+            auto worker_lease = governor.acquireWorker();
+            const auto result = runTimed(process_counters, [&]() {
+                return stages_.process(item->image);
+            });
+            worker_lease.release();
+            if (!result.isSuccess())
+            {
+                complete(std::move(item), result);
+                continue;
+            }
+            encode_queue.push(std::move(item));
+        }
+    };
+
+    auto encode_worker = [&]() {
+        ItemPtr item;
+        while (encode_queue.pop(item))
+        {
+            auto worker_lease = governor.acquireWorker();
+            const auto result = runTimed(encode_counters, [&]() {
+                return stages_.encode(item->image, item->job.output_path);
+            });
+            worker_lease.release();
+            complete(std::move(item), result);
+        }
+    };
+
+    const auto start_time = std::chrono::steady_clock::now();
+    {
+        ThreadPool read_pool(config_.read_workers);
+        ThreadPool decode_pool(config_.decode_workers);
+        ThreadPool process_pool(config_.process_workers);
+        ThreadPool encode_pool(config_.encode_workers);
+
+        for (int i = 0; i < config_.encode_workers; ++i)
+        {
+            encode_pool.enqueue(encode_worker);
+        }
+        for (int i = 0; i < config_.process_workers; ++i)
+        {
+            process_pool.enqueue(process_worker);
+        }
+        for (int i = 0; i < config_.decode_workers; ++i)
+        {
+            decode_pool.enqueue(decode_worker);
+        }
+        for (int i = 0; i < config_.read_workers; ++i)
+        {
+            read_pool.enqueue(read_worker);
+        }
+
+        // Стадии завершаются по порядку: когда все потоки стадии вышли,
+        // очередь следующей стадии закрывается
+        read_pool.waitAll();
+        decode_queue.close();
+        decode_pool.waitAll();
+        process_queue.close();
+        process_pool.waitAll();
+        encode_queue.close();
+        encode_pool.waitAll();
+    }
+    const double wall_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+
+    Statistics statistics;
+    statistics.wall_seconds = wall_seconds;
+    const auto budget_statistics = memory_budget.getStatistics();
+    statistics.peak_in_flight_bytes = budget_statistics.peak_bytes;
+    statistics.budget_waits = budget_statistics.waits;
+    statistics.budget_wait_seconds = budget_statistics.wait_seconds;
+
+    auto add_stage = [&](const char* name, int workers, const StageCounters& counters) {
+        StageStatistics stage;
+        stage.name = name;
+        stage.workers = workers;
+        stage.items = counters.items.load();
+        stage.busy_seconds = static_cast<double>(counters.busy_nanoseconds.load()) / 1e9;
+        if (wall_seconds > 0.0 && workers > 0)
+        {
+            stage.utilisation = std::clamp(stage.busy_seconds / (wall_seconds * workers), 0.0, 1.0);
+        }
+        statistics.stages.push_back(stage);
+    };
+    add_stage("read", config_.read_workers, read_counters);
+    add_stage("decode", config_.decode_workers, decode_counters);
+    add_stage("filter", config_.process_workers, process_counters);
+    add_stage("encode", config_.encode_workers, encode_counters);
+
+    return statistics;
+}
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <string>
+#include <vector>
+#include <utils/FilterResult.h>
+
+class ImageProcessor;
+
+/**
+ * @brief Конвейерная пакетная обработка изображений
+ *
+ * Обработка файла разбита на четыре стадии, соединенные ограниченными очередями:
+ * - чтение (отображение файла в память);
+ * - декодирование;
+ * - цепочка фильтров;
+ * - кодирование и запись.
+ *
+ * У каждой стадии свой пул потоков, а заполненная очередь блокирует
+ * предыдущую стадию (обратное давление). Объем изображений в обработке
+ * ограничивается бюджетом памяти: оценка по заголовку резервируется до
+ * начала декодирования. По окончании доступна загрузка каждой стадии.
+ */
+class BatchPipeline
+{
+public:
+    /**
+     * @brief Задание: один входной и один выходной файл
+     */
+    struct Job
+    {
+        std::string input_path;
+        std::string output_path;
+    };
+
+    /**
+     * @brief Функции стадий (должны быть безопасны для вызова из нескольких потоков)
+     */
+    struct Stages
+    {
+        std::function<FilterResult(std::span<const uint8_t> data, ImageProcessor& image)> decode;
+        std::function<FilterResult(ImageProcessor& image)> process;
+        std::function<FilterResult(const ImageProcessor& image, const std::string& output_path)> encode;
+
+        // Оценка пиковой памяти изображения по заголовку файла (0 = оценить не удалось).
+        // Резервируется до декодирования; без оценки учитывается размер файла
+        std::function<size_t(std::span<const uint8_t> data)> estimate_bytes;
+    };
+
+    /**
+     * @brief Параметры конвейера (0 = автоматически)
+     */
+    struct Config
+    {
+        int read_workers = 1;             // Потоки чтения
+        int decode_workers = 0;           // Потоки декодирования
+        int process_workers = 0;          // Потоки цепочки фильтров
+        int encode_workers = 0;           // Потоки кодирования и записи
+        size_t queue_capacity = 0;        // Емкость очереди между стадиями
+        size_t memory_budget_bytes = 0;   // Бюджет памяти изображений в обработке (0 = без ограничения)
+    };
+
+    /**
+     * @brief Статистика одной стадии
+     */
+    struct StageStatistics
+    {
+        std::string name;
+        int workers = 0;
+        size_t items = 0;            // Обработано заданий
+        double busy_seconds = 0.0;   // Суммарное время работы потоков стадии
+        double utilisation = 0.0;    // Доля занятости потоков за время прогона (0.0 - 1.0)
+    };
+
+    /**
+     * @brief Статистика прогона
+     */
+    struct Statistics
+    {
+        std::vector<StageStatistics> stages;
+        double wall_seconds = 0.0;
+        size_t peak_in_flight_bytes = 0;   // Пиковый учтенный объем изображений в обработке
+        size_t budget_waits = 0;           // Сколько раз чтение ждало освобождения бюджета
+        double budget_wait_seconds = 0.0;  // Суммарное время ожидания бюджета
+    };
+
+    /**
+     * @brief Вызывается по завершении задания (успешном или на любой стадии)
+     * @note Может вызываться одновременно из потоков разных стадий
+     */
+    using CompletionCallback = std::function<void(const Job& job, const FilterResult& result)>;
+
+    /**
+     * @brief Источник заданий: заполняет job и возвращает false, когда задания закончились
+     * @note Вызывается потоками чтения поочередно (под блокировкой), может блокироваться
+     */
+    using JobSource = std::function<bool(Job& job)>;
+
+    /**
+     * @brief Конструктор с параметрами по умолчанию
+     * @param stages Функции стадий
+     */
+    explicit BatchPipeline(Stages stages);
+
+    /**
+     * @brief Конструктор
+     * @param stages Функции стадий
+     * @param config Параметры конвейера
+     */
+    BatchPipeline(Stages stages, const Config& config);
+
+    /**
+     * @brief Прогоняет задания через конвейер
+     * @param jobs Задания
+     * @param on_complete Обработчик завершения задания (опционально)
+     * @return Статистика прогона
+     */
+    Statistics run(const std::vector<Job>& jobs, const CompletionCallback& on_complete = nullptr) const;
+
+    /**
+     * @brief Прогоняет через конвейер задания из источника по мере их появления
+     * @param next_job Источник заданий
+     * @param on_complete Обработчик завершения задания (опционально)
+     * @return Статистика прогона
+     */
+    Statistics run(const JobSource& next_job, const CompletionCallback& on_complete = nullptr) const;
+
+    /**
+     * @brief Заменяет автоматические значения параметров конкретными
+     * @param config Параметры
+     * @return Параметры с числом потоков каждой стадии и емкостью очередей больше нуля
+     */
+    static Config resolveConfig(const Config& config);
+
+private:
+    Stages stages_;
+    Config config_;
+};
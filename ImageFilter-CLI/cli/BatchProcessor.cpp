@@ -1,16 +1,113 @@
 #include <cli/BatchProcessor.h>
+#include <cli/MemoryBudget.h>
+#include <cli/ProgressReporter.h>
 #include <utils/FileSystemHelper.h>
+#include <utils/DirectoryScanner.h>
+#include <preset/IncrementalManifest.h>
+#include <preset/ResumeJournal.h>
 #include <preset/ResumeStateManager.h>
 #include <utils/FilterResult.h>
 #include <utils/Logger.h>
 #include <utils/IThreadPool.h>
 #include <utils/ThreadPool.h>
+#include <utils/ConcurrencyGovernor.h>
 
+#include <algorithm>
 #include <filesystem>
-#include <set>
-#include <mutex>
-#include <atomic>
 #include <chrono>
+#include <utility>
+
+namespace
+{
+    /**
+     * @brief Общее количество файлов для прогресса: пока обход не завершен - оценка по найденным
+     */
+    ProgressReporter::TotalSource scannerTotal(const DirectoryScanner& scanner)
+    {
+        return [&scanner](bool& estimated) {
+            estimated = !scanner.isComplete();
+            return scanner.getDiscoveredCount();
+        };
+    }
+
+    /**
+     * @brief Останавливает вывод прогресса и переносит счетчики в статистику
+     */
+    void finishProgress(ProgressReporter& reporter, BatchStatistics& stats)
+    {
+        reporter.stop();
+        const auto totals = reporter.getTotals();
+        stats.processed_files = totals.processed;
+        stats.failed_files = totals.failed;
+        stats.skipped_files = totals.skipped;
+    }
+
+    /**
+     * @brief Запускает потоковый обход входной директории
+     * @return false если директорию невозможно обойти
+     */
+    bool startScan(DirectoryScanner& scanner)
+    {
+        const auto result = scanner.start();
+        if (!result.isSuccess())
+        {
+            Logger::error(result.getFullMessage());
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Создает выходную директорию, если она не существует
+     */
+    bool createOutputDirectory(const std::string& output_dir)
+    {
+        try
+        {
+            std::filesystem::create_directories(output_dir);
+            return true;
+        }
+        catch (const std::filesystem::filesystem_error& e)
+        {
+            Logger::error("Не удалось создать выходную директорию: " + std::string(e.what()));
+            return false;
+        }
+    }
+
+    /**
+     * @brief Итоговое количество найденных файлов
+     */
+    void logDiscoveredFiles(const DirectoryScanner& scanner, const std::string& input_dir)
+    {
+        if (scanner.getDiscoveredCount() == 0)
+        {
+            Logger::warning("Не найдено изображений для обработки в директории: " + input_dir);
+            return;
+        }
+        Logger::info("Найдено изображений для обработки: " + std::to_string(scanner.getDiscoveredCount()));
+    }
+
+    /**
+     * @brief Открывает журнал возобновления, если указан файл
+     */
+    void openResumeJournal(const std::string& resume_state_file, ResumeJournal& journal)
+    {
+        if (resume_state_file.empty())
+        {
+            return;
+        }
+
+        journal.open(resume_state_file);
+        if (journal.getLoadedCount() > 0)
+        {
+            Logger::info("Загружено состояние возобновления: " + std::to_string(journal.getLoadedCount()) + " файлов уже обработано");
+        }
+        if (journal.getStatistics().compacted)
+        {
+            Logger::debug("Журнал возобновления сжат: " + resume_state_file);
+        }
+    }
+}
 
 BatchProcessor::BatchProcessor(const std::string& input_dir,
                                const std::string& output_dir,
@@ -45,39 +142,26 @@ BatchStatistics BatchProcessor::processAllWithResume(
     int max_parallel) const
 {
     BatchStatistics stats{};
-    auto images = findImages();
-    stats.total_files = images.size();
-
-    if (images.empty())
+    if (!createOutputDirectory(output_dir_))
     {
-        Logger::warning("Не найдено изображений для обработки в директории: " + input_dir_);
         return stats;
     }
 
-    Logger::info("Найдено изображений для обработки: " + std::to_string(stats.total_files));
-
-    // Создаем выходную директорию, если она не существует
-    std::filesystem::path output_path(output_dir_);
-    try
+    // Файлы обрабатываются по мере обхода директории
+    DirectoryScanner scanner(input_dir_, getScanOptions());
+    if (!startScan(scanner))
     {
-        std::filesystem::create_directories(output_path);
-    }
-    catch (const std::filesystem::filesystem_error& e)
-    {
-        Logger::error("Не удалось создать выходную директорию: " + std::string(e.what()));
         return stats;
     }
 
-    // Загружаем состояние возобновления, если указан файл
-    std::set<std::string> processed_files;
-    if (!resume_state_file.empty())
-    {
-        processed_files = ResumeStateManager::loadResumeState(resume_state_file);
-        if (!processed_files.empty())
-        {
-            Logger::info("Загружено состояние возобновления: " + std::to_string(processed_files.size()) + " файлов уже обработано");
-        }
-    }
+    // Загружаем журнал возобновления, если указан файл
+    ResumeJournal journal;
+    openResumeJournal(resume_state_file, journal);
+
+    // Порядок выдачи файлов и модель стоимости для сравнения оценки с фактом
+    CostModel default_cost_model;
+    CostModel& cost_model = (cost_model_ != nullptr) ? *cost_model_ : default_cost_model;
+    BatchScheduler scheduler(scanner, scheduling_policy_, cost_model);
 
     // Определяем количество параллельных потоков
     bool use_parallel = (thread_pool != nullptr);
@@ -94,193 +178,104 @@ BatchStatistics BatchProcessor::processAllWithResume(
         }
     }
 
-    // Время начала обработки
-    const auto start_time = std::chrono::steady_clock::now();
-    std::atomic<size_t> processed_count{0};  // Счетчик всех проверенных файлов
-
-    // Мьютекс для синхронизации доступа к статистике и состоянию
-    std::mutex stats_mutex;
-    std::set<std::string> processed_in_session;
+    // Рабочие потоки только отмечают итог файла в своих счетчиках,
+    // прогресс выводит отдельный поток с фиксированной частотой
+    ProgressReporter progress(std::move(progress_callback), scannerTotal(scanner));
+    progress.start();
 
     // Функция обработки одного файла
-    auto process_single_file = [&](size_t /*index*/, const std::filesystem::path& input_file) {
+    auto process_single_file = [&](ScheduledFile scheduled) {
+        const std::filesystem::path& input_file = scheduled.path;
         std::string input_file_str = input_file.string();
 
         // Определяем выходной путь
-        std::filesystem::path output_file;
-        if (recursive_)
-        {
-            std::filesystem::path input_path(input_dir_);
-            std::filesystem::path relative = FileSystemHelper::getRelativePath(input_file, input_path);
-            output_file = output_path / relative;
-        }
-        else
-        {
-            output_file = output_path / input_file.filename();
-        }
-
+        const std::filesystem::path output_file = getOutputPath(input_file);
         std::string output_file_str = output_file.string();
 
-        // Проверяем, не обработан ли уже файл
-        bool should_skip = false;
-        {
-            std::lock_guard<std::mutex> lock(stats_mutex);
-            if (processed_files.find(output_file_str) != processed_files.end() ||
-                ResumeStateManager::isFileProcessed(output_file))
-            {
-                stats.skipped_files++;
-                should_skip = true;
-            }
-        }
-
-        if (should_skip)
+        // Проверяем, не обработан ли уже файл (журнал не изменяется во время обработки)
+        if (isAlreadyProcessed(input_file, output_file, journal))
         {
-            // Обновляем счетчик и прогресс для пропущенных файлов
-            size_t current = ++processed_count;
-            if (progress_callback)
-            {
-                const auto current_time = std::chrono::steady_clock::now();
-                const auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(
-                    current_time - start_time);
-                
-                double percentage = (static_cast<double>(current) / static_cast<double>(stats.total_files)) * 100.0;
-                
-                double files_per_second = 0.0;
-                std::chrono::seconds estimated_remaining(0);
-                if (elapsed.count() > 0 && current > 0)
-                {
-                    files_per_second = static_cast<double>(current) / elapsed.count();
-                    if (files_per_second > 0.0)
-                    {
-                        const size_t remaining = stats.total_files - current;
-                        estimated_remaining = std::chrono::seconds(
-                            static_cast<long long>(remaining / files_per_second));
-                    }
-                }
-
-                ProgressInfo info;
-                info.current = current;
-                info.total = stats.total_files;
-                info.current_file = input_file_str;
-                info.percentage = percentage;
-                info.elapsed_time = elapsed;
-                info.estimated_remaining = estimated_remaining;
-                info.files_per_second = files_per_second;
-
-                progress_callback(info);
-            }
+            progress.record(ProgressReporter::Outcome::Skipped, input_file_str);
             return;
         }
 
         // Создаем выходную директорию для файла, если нужно
         if (!FileSystemHelper::ensureOutputDirectory(output_file))
         {
-            std::lock_guard<std::mutex> lock(stats_mutex);
             Logger::error("Не удалось создать директорию для: " + output_file_str);
-            stats.failed_files++;
+            progress.record(ProgressReporter::Outcome::Failed, input_file_str);
             return;
         }
 
-        // Обрабатываем файл
+        // Пиковая память изображения резервируется до начала обработки: пока бюджет
+        // занят другими изображениями, файл ждет, не занимая поток общего бюджета
+        MemoryBudget::Reservation memory_reservation;
+        if (memory_budget_ != nullptr)
+        {
+            if (scheduled.pixels == 0)
+            {
+                scheduled = scheduler.probe(std::filesystem::path(input_file));
+            }
+            memory_reservation = memory_budget_->reserve(
+                static_cast<size_t>(cost_model.estimatePeakBytes(scheduled.pixels, decoded_channels_)));
+        }
+
+        // Обрабатываем файл; при параллельной обработке поток занимает
+        // единицу общего бюджета, и фильтры получают только оставшиеся потоки
         FilterResult result;
+        const auto file_start_time = std::chrono::steady_clock::now();
         try
         {
+            ConcurrencyGovernor::Lease worker_lease;
+            if (use_parallel && num_parallel > 1)
+            {
+                worker_lease = ConcurrencyGovernor::getInstance().acquireWorker();
+            }
             result = process_function(input_file_str, output_file_str);
+            memory_reservation.release();
         }
         catch (const std::exception& e)
         {
-            std::lock_guard<std::mutex> lock(stats_mutex);
-            stats.failed_files++;
             Logger::error("Ошибка при обработке " + input_file_str + ": " + e.what());
+            progress.record(ProgressReporter::Outcome::Failed, input_file_str);
             return;
         }
 
-        // Обновляем статистику
-        size_t current = 0;
+        if (result.isSuccess())
         {
-            std::lock_guard<std::mutex> lock(stats_mutex);
-            if (result.isSuccess())
-            {
-                stats.processed_files++;
-                processed_in_session.insert(output_file_str);
-                Logger::debug("Обработан: " + input_file_str + " -> " + output_file_str);
-            }
-            else
-            {
-                stats.failed_files++;
-                Logger::warning("Не удалось обработать: " + input_file_str + 
-                              ". Ошибка: " + result.getFullMessage());
-            }
-
-            current = ++processed_count;
-
-            // Периодически сохраняем состояние возобновления
-            if (!resume_state_file.empty() && current % 10 == 0)
+            markProcessed(input_file_str, output_file_str, journal);
+            if (scheduled.estimated_seconds > 0.0)
             {
-                std::set<std::string> all_processed = processed_files;
-                all_processed.insert(processed_in_session.begin(), processed_in_session.end());
-                ResumeStateManager::saveResumeState(resume_state_file, all_processed);
+                const std::chrono::duration<double> actual = std::chrono::steady_clock::now() - file_start_time;
+                cost_model.record(scheduled.pixels, scheduled.estimated_seconds, actual.count());
             }
         }
 
-        // Обновляем прогресс
-        if (progress_callback)
+        // Обновляем статистику
+        if (result.isSuccess())
         {
-            const auto current_time = std::chrono::steady_clock::now();
-            const auto elapsed = std::chrono::duration_cast<std::chrono::seconds>(
-                current_time - start_time);
-            
-            double percentage = (static_cast<double>(current) / static_cast<double>(stats.total_files)) * 100.0;
-            
-            double files_per_second = 0.0;
-            std::chrono::seconds estimated_remaining(0);
-            if (elapsed.count() > 0 && current > 0)
-            {
-                files_per_second = static_cast<double>(current) / elapsed.count();
-                if (files_per_second > 0.0)
-                {
-                    const size_t remaining = stats.total_files - current;
-                    estimated_remaining = std::chrono::seconds(
-                        static_cast<long long>(remaining / files_per_second));
-                }
-            }
-
-            ProgressInfo info;
-            info.current = current;
-            info.total = stats.total_files;
-            info.current_file = input_file_str;
-            info.percentage = percentage;
-            info.elapsed_time = elapsed;
-            info.estimated_remaining = estimated_remaining;
-            info.files_per_second = files_per_second;
-
-            progress_callback(info);
+            Logger::debug("Обработан: " + input_file_str + " -> " + output_file_str);
+            progress.record(ProgressReporter::Outcome::Processed, input_file_str);
+        }
+        else
+        {
+            Logger::warning("Не удалось обработать: " + input_file_str +
+                            ". Ошибка: " + result.getFullMessage());
+            progress.record(ProgressReporter::Outcome::Failed, input_file_str);
         }
     };
 
     // Параллельная или последовательная обработка
     if (use_parallel && num_parallel > 1)
     {
-        // Параллельная обработка
-        size_t current_index = 0;
-        std::mutex index_mutex;
-
-        // Создаем задачи для пула потоков
-        for (int i = 0; i < num_parallel && i < static_cast<int>(images.size()); ++i)
+        // Каждая задача пула берет следующий файл у планировщика, пока файлы не закончатся
+        for (int i = 0; i < num_parallel; ++i)
         {
             thread_pool->enqueue([&]() {
-                while (true)
+                ScheduledFile scheduled;
+                while (scheduler.next(scheduled))
                 {
-                    size_t idx;
-                    {
-                        std::lock_guard<std::mutex> lock(index_mutex);
-                        if (current_index >= images.size())
-                        {
-                            break;
-                        }
-                        idx = current_index++;
-                    }
-                    process_single_file(idx, images[idx]);
+                    process_single_file(scheduled);
                 }
             });
         }
@@ -291,23 +286,179 @@ BatchStatistics BatchProcessor::processAllWithResume(
     else
     {
         // Последовательная обработка
-        for (size_t i = 0; i < images.size(); ++i)
+        ScheduledFile scheduled;
+        while (scheduler.next(scheduled))
         {
-            process_single_file(i, images[i]);
+            process_single_file(scheduled);
         }
     }
+    finishProgress(progress, stats);
+
+    // Дописываем журнал возобновления на диск
+    journal.close();
+
+    stats.total_files = scanner.getDiscoveredCount();
+    logDiscoveredFiles(scanner, input_dir_);
+    return stats;
+}
+
+BatchStatistics BatchProcessor::processAllPipelined(
+    const BatchPipeline::Stages& stages,
+    const BatchPipeline::Config& config,
+    ProgressCallback progress_callback,
+    const std::string& resume_state_file,
+    BatchPipeline::Statistics* pipeline_statistics) const
+{
+    BatchStatistics stats{};
+    if (!createOutputDirectory(output_dir_))
+    {
+        return stats;
+    }
 
-    // Финальное сохранение состояния возобновления
-    if (!resume_state_file.empty())
+    // Файлы поступают в конвейер по мере обхода директории
+    DirectoryScanner scanner(input_dir_, getScanOptions());
+    if (!startScan(scanner))
     {
-        std::set<std::string> all_processed = processed_files;
-        all_processed.insert(processed_in_session.begin(), processed_in_session.end());
-        ResumeStateManager::saveResumeState(resume_state_file, all_processed);
+        return stats;
     }
 
+    // Загружаем журнал возобновления, если указан файл
+    ResumeJournal journal;
+    openResumeJournal(resume_state_file, journal);
+
+    // Порядок выдачи файлов конвейеру
+    CostModel default_cost_model;
+    BatchScheduler scheduler(scanner, scheduling_policy_,
+                             (cost_model_ != nullptr) ? *cost_model_ : default_cost_model);
+
+    ProgressReporter progress(std::move(progress_callback), scannerTotal(scanner));
+    progress.start();
+
+    // Источник заданий: пропуски и ошибки создания директорий определяются
+    // до передачи файла в конвейер
+    auto next_job = [&](BatchPipeline::Job& job) -> bool {
+        ScheduledFile scheduled;
+        while (scheduler.next(scheduled))
+        {
+            const std::filesystem::path& input_file = scheduled.path;
+            const std::filesystem::path output_file = getOutputPath(input_file);
+            const std::string output_file_str = output_file.string();
+
+            if (isAlreadyProcessed(input_file, output_file, journal))
+            {
+                progress.record(ProgressReporter::Outcome::Skipped, input_file.string());
+                continue;
+            }
+
+            if (!FileSystemHelper::ensureOutputDirectory(output_file))
+            {
+                Logger::error("Не удалось создать директорию для: " + output_file_str);
+                progress.record(ProgressReporter::Outcome::Failed, input_file.string());
+                continue;
+            }
+
+            job = {input_file.string(), output_file_str};
+            return true;
+        }
+        return false;
+    };
+
+    auto on_complete = [&](const BatchPipeline::Job& job, const FilterResult& result) {
+        if (result.isSuccess())
+        {
+            markProcessed(job.input_path, job.output_path, journal);
+            Logger::debug("Обработан: " + job.input_path + " -> " + job.output_path);
+            progress.record(ProgressReporter::Outcome::Processed, job.input_path);
+        }
+        else
+        {
+            Logger::warning("Не удалось обработать: " + job.input_path +
+                            ". Ошибка: " + result.getFullMessage());
+            progress.record(ProgressReporter::Outcome::Failed, job.input_path);
+        }
+    };
+
+    const BatchPipeline pipeline(stages, config);
+    const auto statistics = pipeline.run(next_job, on_complete);
+    if (pipeline_statistics != nullptr)
+    {
+        *pipeline_statistics = statistics;
+    }
+    finishProgress(progress, stats);
+
+    // Дописываем журнал возобновления на диск
+    journal.close();
+
+    stats.total_files = scanner.getDiscoveredCount();
+    logDiscoveredFiles(scanner, input_dir_);
     return stats;
 }
 
+void BatchProcessor::setIncrementalManifest(IncrementalManifest* manifest) noexcept
+{
+    incremental_manifest_ = manifest;
+}
+
+void BatchProcessor::setMemoryBudget(MemoryBudget* memory_budget, int decoded_channels) noexcept
+{
+    memory_budget_ = memory_budget;
+    decoded_channels_ = decoded_channels;
+}
+
+void BatchProcessor::setScheduling(SchedulingPolicy policy, CostModel* cost_model) noexcept
+{
+    scheduling_policy_ = policy;
+    cost_model_ = cost_model;
+}
+
+bool BatchProcessor::isAlreadyProcessed(const std::filesystem::path& input_file,
+                                        const std::filesystem::path& output_file,
+                                        const ResumeJournal& journal) const
+{
+    const std::string output_file_str = output_file.string();
+
+    // В инкрементальном режиме решает только манифест: запись журнала не знает,
+    // изменились ли с тех пор вход или цепочка фильтров
+    if (incremental_manifest_ != nullptr)
+    {
+        return incremental_manifest_->isUpToDate(input_file.string(), output_file_str);
+    }
+    if (journal.contains(output_file_str))
+    {
+        return true;
+    }
+    return ResumeStateManager::isFileProcessed(output_file);
+}
+
+void BatchProcessor::markProcessed(const std::string& input_file,
+                                   const std::string& output_file,
+                                   ResumeJournal& journal) const
+{
+    journal.record(output_file);
+    if (incremental_manifest_ != nullptr && !incremental_manifest_->update(input_file, output_file))
+    {
+        Logger::warning("Не удалось добавить в манифест: " + input_file);
+    }
+}
+
+DirectoryScanner::Options BatchProcessor::getScanOptions() const
+{
+    DirectoryScanner::Options options;
+    options.recursive = recursive_;
+    options.pattern = pattern_;
+    return options;
+}
+
+std::filesystem::path BatchProcessor::getOutputPath(const std::filesystem::path& input_file) const
+{
+    const std::filesystem::path output_path(output_dir_);
+    if (recursive_)
+    {
+        return output_path / FileSystemHelper::getRelativePath(input_file, std::filesystem::path(input_dir_));
+    }
+    return output_path / input_file.filename();
+}
+
 std::filesystem::path BatchProcessor::getRelativePath(
     const std::filesystem::path& full_path,
     const std::filesystem::path& base_dir)
@@ -7,9 +7,14 @@
 #include <chrono>
 #include <set>
 #include <utils/FilterResult.h>
+#include <cli/BatchPipeline.h>
+#include <cli/BatchScheduler.h>
 
 // Forward declaration
 class IThreadPool;
+class IncrementalManifest;
+class MemoryBudget;
+class ResumeJournal;
 
 /**
  * @brief Результат обработки одного файла в пакетном режиме
@@ -44,7 +49,10 @@ struct ProgressInfo
     double percentage;            // Процент выполнения (0.0 - 100.0)
     std::chrono::seconds elapsed_time;  // Прошедшее время в секундах
     std::chrono::seconds estimated_remaining;  // Оценка оставшегося времени в секундах
-    double files_per_second;      // Скорость обработки (файлов в секунду)
+    double files_per_second;      // Скорость обработки (файлов в секунду, скользящее среднее)
+    bool total_estimated = false; // Общее количество - оценка (обход директории не завершен)
+    size_t failed_files = 0;      // Из них завершились ошибкой
+    size_t skipped_files = 0;     // Из них пропущено
 };
 
 /**
@@ -59,11 +67,16 @@ using ProgressCallback = std::function<void(const ProgressInfo& info)>;
  * Поддерживает:
  * - Рекурсивный обход директорий
  * - Фильтрацию файлов по шаблону
+ * - Обработку файлов по мере параллельного обхода директории (см. DirectoryScanner)
  * - Сохранение структуры директорий
  * - Отображение прогресса с временем и ETA
  * - Обработку ошибок для отдельных файлов
  * - Возобновление прерванной обработки
+ * - Инкрементальную обработку: пропуск файлов с неизмененными входом и настройками
  * - Параллельную обработку нескольких изображений
+ * - Обработку самых больших изображений в первую очередь (см. BatchScheduler)
+ * - Ограничение памяти одновременно обрабатываемых изображений (см. MemoryBudget)
+ * - Конвейерную обработку с отдельными стадиями (см. BatchPipeline)
  */
 class BatchProcessor
 {
@@ -80,6 +93,41 @@ public:
                    bool recursive = false,
                    const std::string& pattern = "");
 
+    /**
+     * @brief Включает инкрементальный режим
+     * @param manifest Манифест инкрементальной обработки (nullptr = выключить; должен жить дольше обработки)
+     *
+     * Без манифеста файл пропускается, если выходной файл уже существует.
+     * С манифестом - только если манифест подтверждает, что вход и настройки
+     * не изменились (см. IncrementalManifest); успешно обработанные файлы
+     * добавляются в манифест.
+     */
+    void setIncrementalManifest(IncrementalManifest* manifest) noexcept;
+
+    /**
+     * @brief Задает порядок обработки файлов
+     * @param policy Порядок выдачи файлов (по умолчанию DiscoveryOrder)
+     * @param cost_model Модель стоимости (nullptr = модель без фильтров; должна жить дольше обработки)
+     *
+     * В режиме LargestFirst первыми обрабатываются самые большие изображения
+     * (см. BatchScheduler). Фактическое время обработки файлов в пуле потоков
+     * уточняет модель стоимости (CostModel::record()).
+     */
+    void setScheduling(SchedulingPolicy policy, CostModel* cost_model = nullptr) noexcept;
+
+    /**
+     * @brief Включает допуск изображений к обработке по бюджету памяти
+     * @param memory_budget Бюджет памяти (nullptr = без ограничения; должен жить дольше обработки)
+     * @param decoded_channels Каналы декодированного изображения (4 с --preserve-alpha, иначе 3)
+     *
+     * Перед обработкой файла в processAll()/processAllWithResume() резервируется
+     * оценка его пиковой памяти (размеры из заголовка и временные буферы фильтров,
+     * см. CostModel::estimatePeakBytes()); пока резерв не помещается в бюджет,
+     * файл ждет завершения других. Конвейерный режим использует собственный
+     * бюджет (BatchPipeline::Config::memory_budget_bytes).
+     */
+    void setMemoryBudget(MemoryBudget* memory_budget, int decoded_channels) noexcept;
+
     /**
      * @brief Находит все изображения в входной директории
      * @return Вектор путей к найденным изображениям
@@ -117,6 +165,22 @@ public:
         IThreadPool* thread_pool = nullptr,
         int max_parallel = 0) const;
 
+    /**
+     * @brief Обрабатывает все найденные изображения конвейером
+     * @param stages Функции стадий декодирования, фильтрации и кодирования
+     * @param config Параметры конвейера
+     * @param progress_callback Callback для отображения прогресса (опционально)
+     * @param resume_state_file Путь к файлу состояния для возобновления (пустая строка = без возобновления)
+     * @param pipeline_statistics Если не nullptr, получает статистику стадий конвейера
+     * @return Статистика обработки
+     */
+    BatchStatistics processAllPipelined(
+        const BatchPipeline::Stages& stages,
+        const BatchPipeline::Config& config,
+        ProgressCallback progress_callback = nullptr,
+        const std::string& resume_state_file = "",
+        BatchPipeline::Statistics* pipeline_statistics = nullptr) const;
+
     /**
      * @brief Получает относительный путь от базовой директории
      * @param full_path Полный путь к файлу
@@ -143,9 +207,45 @@ public:
     static bool matchesPattern(const std::string& filename, const std::string& pattern);
 
 private:
+    /**
+     * @brief Определяет выходной путь для входного файла
+     * @param input_file Входной файл
+     * @return Путь в выходной директории (с сохранением структуры при рекурсивном обходе)
+     */
+    std::filesystem::path getOutputPath(const std::filesystem::path& input_file) const;
+
+    /**
+     * @brief Параметры потокового обхода входной директории
+     */
+    DirectoryScanner::Options getScanOptions() const;
+
+    /**
+     * @brief Проверяет, можно ли пропустить файл
+     * @param input_file Входной файл
+     * @param output_file Выходной файл
+     * @param journal Журнал возобновления
+     * @return true если файл уже обработан
+     *
+     * С манифестом журнал не учитывается: файл из журнала обрабатывается
+     * заново, если манифест не подтверждает неизменность входа и настроек.
+     */
+    bool isAlreadyProcessed(const std::filesystem::path& input_file,
+                            const std::filesystem::path& output_file,
+                            const ResumeJournal& journal) const;
+
+    /**
+     * @brief Отмечает успешно обработанный файл в журнале и манифесте
+     */
+    void markProcessed(const std::string& input_file, const std::string& output_file, ResumeJournal& journal) const;
+
     std::string input_dir_;
     std::string output_dir_;
     std::string pattern_;
     bool recursive_;
+    IncrementalManifest* incremental_manifest_ = nullptr;
+    SchedulingPolicy scheduling_policy_ = SchedulingPolicy::DiscoveryOrder;
+    CostModel* cost_model_ = nullptr;
+    MemoryBudget* memory_budget_ = nullptr;
+    int decoded_channels_ = 4;
 };
 
@@ -0,0 +1,134 @@
+#include <cli/BatchScheduler.h>
+#include <utils/ImageLoader.h>
+
+#include <algorithm>
+#include <utility>
+
+namespace
+{
+    // Сколько найденных файлов поток забирает за раз для чтения заголовков
+    constexpr size_t PROBE_BATCH_SIZE = 16;
+
+    // Если заголовок не прочитан, количество пикселей оценивается по размеру файла
+    // (сжатые изображения - порядка трех пикселей на байт)
+    constexpr uint64_t PIXELS_PER_FILE_BYTE = 3;
+
+    struct SmallerCost
+    {
+        bool operator()(const ScheduledFile& a, const ScheduledFile& b) const noexcept
+        {
+            return a.pixels < b.pixels;
+        }
+    };
+}
+
+BatchScheduler::BatchScheduler(DirectoryScanner& scanner, SchedulingPolicy policy, const CostModel& cost_model)
+    : scanner_(scanner)
+    , policy_(policy)
+    , cost_model_(cost_model)
+{
+}
+
+bool BatchScheduler::next(ScheduledFile& file)
+{
+    std::filesystem::path path;
+    if (policy_ == SchedulingPolicy::DiscoveryOrder)
+    {
+        if (!scanner_.next(path))
+        {
+            return false;
+        }
+        file = ScheduledFile{};
+        file.path = std::move(path);
+        return true;
+    }
+
+    while (true)
+    {
+        // Забираем уже найденные файлы и читаем их заголовки вне блокировки
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            ++probing_;
+        }
+        std::vector<ScheduledFile> discovered;
+        while (discovered.size() < PROBE_BATCH_SIZE && scanner_.tryNext(path))
+        {
+            discovered.push_back(probe(std::move(path)));
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            --probing_;
+            for (auto& scheduled : discovered)
+            {
+                pushPending(std::move(scheduled));
+            }
+            probed_.notify_all();
+
+            if (takeLargest(file))
+            {
+                return true;
+            }
+            if (probing_ > 0)
+            {
+                // Другие потоки вот-вот добавят прочитанные файлы
+                probed_.wait(lock, [this] { return probing_ == 0 || !pending_.empty(); });
+                continue;
+            }
+        }
+
+        // Найденных файлов нет - ждем следующий
+        if (scanner_.next(path))
+        {
+            auto scheduled = probe(std::move(path));
+            std::lock_guard<std::mutex> lock(mutex_);
+            pushPending(std::move(scheduled));
+            return takeLargest(file);
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (pending_.empty() && probing_ == 0)
+        {
+            return false;
+        }
+    }
+}
+
+ScheduledFile BatchScheduler::probe(std::filesystem::path path) const
+{
+    ScheduledFile file;
+    file.path = std::move(path);
+    ImageLoader::ImageInfo info;
+    if (ImageLoader::probe(file.path.string(), info).isSuccess())
+    {
+        file.width = info.width;
+        file.height = info.height;
+        file.pixels = static_cast<uint64_t>(info.width) * static_cast<uint64_t>(info.height);
+    }
+    else
+    {
+        std::error_code ec;
+        const auto file_size = std::filesystem::file_size(file.path, ec);
+        file.pixels = ec ? 0 : static_cast<uint64_t>(file_size) * PIXELS_PER_FILE_BYTE;
+    }
+    file.estimated_seconds = cost_model_.estimateSeconds(file.pixels);
+    return file;
+}
+
+void BatchScheduler::pushPending(ScheduledFile file)
+{
+    pending_.push_back(std::move(file));
+    std::push_heap(pending_.begin(), pending_.end(), SmallerCost{});
+}
+
+bool BatchScheduler::takeLargest(ScheduledFile& file)
+{
+    if (pending_.empty())
+    {
+        return false;
+    }
+    std::pop_heap(pending_.begin(), pending_.end(), SmallerCost{});
+    file = std::move(pending_.back());
+    pending_.pop_back();
+    return true;
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cli/CostModel.h>
+#include <utils/DirectoryScanner.h>
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <vector>
+
+/**
+ * @brief Порядок выдачи файлов пакетной обработки
+ */
+enum class SchedulingPolicy
+{
+    DiscoveryOrder,   // В порядке обхода директории
+    LargestFirst      // Сначала самые дорогие по оценке CostModel
+};
+
+/**
+ * @brief Файл, выданный планировщиком
+ */
+struct ScheduledFile
+{
+    std::filesystem::path path;
+    int width = 0;                   // Размеры из заголовка (0, если не удалось определить)
+    int height = 0;
+    uint64_t pixels = 0;             // Количество пикселей (оценка по размеру файла, если заголовок не прочитан)
+    double estimated_seconds = 0.0;  // Оценка времени обработки (0, если заголовок не читался)
+};
+
+/**
+ * @brief Планировщик пакетной обработки поверх потокового обхода директории
+ *
+ * В режиме LargestFirst размеры каждого найденного файла читаются из
+ * заголовка без декодирования (ImageLoader::probe()), и рабочим потокам выдается самый дорогой
+ * из уже найденных файлов. Так огромное изображение не оказывается в конце
+ * очереди, когда остальные ядра уже простаивают. Пока обход не завершен,
+ * выбор идет среди найденных файлов, после завершения - среди всех.
+ *
+ * Большие изображения при этом обрабатываются монопольно всеми потоками
+ * бюджета по строкам, а маленькие - параллельно по файлам
+ * (см. ConcurrencyGovernor::acquireExclusive()).
+ *
+ * @note next() thread-safe; заголовки читаются вызывающими потоками параллельно
+ */
+class BatchScheduler
+{
+public:
+    /**
+     * @brief Конструктор
+     * @param scanner Запущенный обход директории (должен жить дольше планировщика)
+     * @param policy Порядок выдачи файлов
+     * @param cost_model Модель стоимости (должна жить дольше планировщика)
+     */
+    BatchScheduler(DirectoryScanner& scanner, SchedulingPolicy policy, const CostModel& cost_model);
+
+    BatchScheduler(const BatchScheduler&) = delete;
+    BatchScheduler& operator=(const BatchScheduler&) = delete;
+
+    /**
+     * @brief Получает следующий файл для обработки
+     * @param file Файл с оценкой стоимости (выходной параметр)
+     * @return false если файлы закончились
+     *
+     * Блокирует вызывающий поток, пока не найден очередной файл или не завершен обход.
+     */
+    bool next(ScheduledFile& file);
+
+    /**
+     * @brief Читает размеры файла из заголовка и оценивает стоимость
+     * @param path Путь к изображению
+     * @return Файл с размерами и оценкой (по размеру файла, если заголовок не прочитан)
+     *
+     * В режиме DiscoveryOrder next() заголовки не читает; вызывающий может
+     * прочитать их сам, если размеры нужны (например, для бюджета памяти).
+     */
+    [[nodiscard]] ScheduledFile probe(std::filesystem::path path) const;
+
+private:
+    void pushPending(ScheduledFile file);
+    bool takeLargest(ScheduledFile& file);
+
+    DirectoryScanner& scanner_;
+    SchedulingPolicy policy_;
+    const CostModel& cost_model_;
+
+    std::mutex mutex_;
+    std::condition_variable probed_;
+    std::vector<ScheduledFile> pending_;   // Куча по количеству пикселей (LargestFirst)
+    size_t probing_ = 0;                   // Потоки, читающие заголовки забранных файлов
+};
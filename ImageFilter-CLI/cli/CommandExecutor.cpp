@@ -1,7 +1,10 @@
 #include <cli/CommandExecutor.h>
 #include <cli/ImageProcessingHelper.h>
 #include <cli/FilterInfoDisplay.h>
+#include <cli/ImageProbeDisplay.h>
+#include <cli/MemoryBudget.h>
 #include <cli/ProgressDisplay.h>
+#include <preset/IncrementalManifest.h>
 #include <preset/PresetManager.h>
 #include <utils/ErrorHandlerChain.h>
 #include <utils/FilterResult.h>
@@ -10,9 +13,130 @@
 #include <utils/LoggerConfigurator.h>
 #include <cli/FilterFactory.h>
 #include "BatchProcessor.h"
-#include <utils/BufferPool.h>
+#include <utils/ConcurrencyGovernor.h>
+#include <utils/ImageAllocator.h>
+#include <utils/ImageLoader.h>
 #include <utils/ThreadPool.h>
+#include <ImageProcessor.h>
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
 #include <memory>
+#include <span>
+#include <sstream>
+
+namespace {
+    /**
+     * @brief Форматирует объем памяти в килобайтах для вывода в лог
+     */
+    std::string formatKilobytes(size_t bytes) {
+        return std::to_string((bytes + 1023) / 1024) + " КБ";
+    }
+
+    /**
+     * @brief Выводит итоговую статистику пакетной обработки
+     */
+    void logBatchStatistics(const BatchStatistics &stats) {
+        Logger::info("Пакетная обработка завершена:");
+        Logger::info("  Всего файлов: " + std::to_string(stats.total_files));
+        Logger::info("  Успешно обработано: " + std::to_string(stats.processed_files));
+        Logger::info("  Ошибок: " + std::to_string(stats.failed_files));
+        Logger::info("  Пропущено: " + std::to_string(stats.skipped_files));
+    }
+
+    /**
+     * @brief Определяет порядок пакетной обработки по значению --schedule
+     * @return false если значение неизвестно
+     */
+    bool parseSchedulingPolicy(const std::string &name, SchedulingPolicy &policy) {
+        if (name == "largest-first") {
+            policy = SchedulingPolicy::LargestFirst;
+            return true;
+        }
+        if (name == "discovery") {
+            policy = SchedulingPolicy::DiscoveryOrder;
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Выводит сравнение оценок модели стоимости с фактическим временем
+     */
+    void logCostModel(const CostModel &cost_model) {
+        const auto statistics = cost_model.getStatistics();
+        if (statistics.files == 0) {
+            return;
+        }
+        std::ostringstream oss;
+        oss << std::fixed << std::setprecision(2)
+            << "  Модель стоимости: оценка " << statistics.estimated_seconds
+            << " с, фактически " << statistics.actual_seconds << " с (" << statistics.files
+            << " файлов, поправка " << statistics.correction << ")";
+        Logger::info(oss.str());
+    }
+
+    /**
+     * @brief Выводит статистику допуска изображений по бюджету памяти
+     */
+    void logMemoryBudget(const MemoryBudget &memory_budget) {
+        const auto statistics = memory_budget.getStatistics();
+        std::ostringstream oss;
+        oss << std::fixed << std::setprecision(2)
+            << "  Бюджет памяти " << formatKilobytes(memory_budget.getBudget())
+            << ": пик " << formatKilobytes(statistics.peak_bytes)
+            << ", ожиданий " << statistics.waits << " из " << statistics.reservations
+            << " (всего " << statistics.wait_seconds << " с, максимум " << statistics.max_wait_seconds << " с)";
+        Logger::info(oss.str());
+    }
+
+    /**
+     * @brief Формирует нормализованное описание настроек для инкрементального режима
+     *
+     * В описание входят фильтры цепочки с явно заданными параметрами и
+     * параметры кодирования; опции, не влияющие на результат, не учитываются.
+     */
+    std::string buildIncrementalSettings(const CommandOptions &options,
+                                         const std::vector<std::string> &filters,
+                                         const CLI::App &app) {
+        const auto &factory = FilterFactory::getInstance();
+        std::string settings = "chain=";
+        for (const auto &filter_name : filters) {
+            settings += factory.describe(filter_name, app) + ";";
+        }
+        settings += "jpeg_quality=" + std::to_string(options.jpeg_quality);
+        settings += ";preserve_alpha=" + std::to_string(options.preserve_alpha ? 1 : 0);
+        settings += ";force_rgb=" + std::to_string(options.force_rgb ? 1 : 0);
+        return settings;
+    }
+
+    /**
+     * @brief Закрывает манифест инкрементальной обработки, если он используется
+     *
+     * Записи уже дописаны по мере обработки файлов; close() лишь убирает дубликаты.
+     */
+    void closeIncrementalManifest(IncrementalManifest *manifest, const std::string &manifest_file) {
+        if (manifest == nullptr) {
+            return;
+        }
+        if (manifest->close()) {
+            Logger::info("  Записей в манифесте: " + std::to_string(manifest->size()));
+        } else {
+            Logger::warning("Не удалось сохранить манифест: " + manifest_file);
+        }
+    }
+
+    /**
+     * @brief Атомарно обновляет максимум
+     */
+    void updateMaximum(std::atomic<size_t> &maximum, size_t value) {
+        size_t observed = maximum.load(std::memory_order_relaxed);
+        while (value > observed &&
+               !maximum.compare_exchange_weak(observed, value, std::memory_order_relaxed)) {
+        }
+    }
+}
 
 CommandExecutor::CommandExecutor() {
 }
@@ -21,6 +145,19 @@ int CommandExecutor::execute(const CommandOptions &options, CLI::App &app) {
     // Настраиваем логирование на основе разобранных опций
     LoggerConfigurator::configure(options.quiet, options.log_level_str);
 
+    // Поток прогресса JSON Lines в stdout не должен перемешиваться с сообщениями журнала
+    Logger::setStderrOnly(options.progress_json == "-");
+
+    if (!configureAllocator(options)) {
+        return 1;
+    }
+
+    if (options.thread_budget < 0) {
+        Logger::error("Ошибка: бюджет потоков не может быть отрицательным");
+        return 1;
+    }
+    ConcurrencyGovernor::getInstance().setThreadBudget(options.thread_budget);
+
     // Обработка специальных команд
     if (options.list_filters) {
         return executeListFilters(app);
@@ -30,6 +167,10 @@ int CommandExecutor::execute(const CommandOptions &options, CLI::App &app) {
         return executeFilterInfo(options.filter_info, app);
     }
 
+    if (!options.probe_path.empty()) {
+        return executeProbe(options);
+    }
+
     // Обработка пресетов
     std::string preset_directory = options.preset_dir.empty() ? "./presets" : options.preset_dir;
     std::string filter_name = options.filter_name;
@@ -66,6 +207,30 @@ int CommandExecutor::execute(const CommandOptions &options, CLI::App &app) {
     return executeSingleImage(options, app);
 }
 
+bool CommandExecutor::configureAllocator(const CommandOptions &options) {
+    if (options.allocator == "heap") {
+        ImageAllocator::setDefault(nullptr);
+        return true;
+    }
+
+    if (options.allocator == "mmap") {
+        if (!MmapImageAllocator::isSupported()) {
+            Logger::warning("mmap недоступен на этой платформе, используется heap");
+            return true;
+        }
+
+        MmapImageAllocator::Options allocator_options;
+        allocator_options.populate = options.populate_pages;
+        // Распределитель должен жить до завершения процесса: им выделены буферы изображений
+        static MmapImageAllocator mmap_allocator(allocator_options);
+        ImageAllocator::setDefault(&mmap_allocator);
+        return true;
+    }
+
+    Logger::error("Ошибка: неизвестный распределитель памяти: " + options.allocator + " (допустимо: heap, mmap)");
+    return false;
+}
+
 int CommandExecutor::executeListFilters(CLI::App &app) {
     FilterInfoDisplay::printFilterList(app);
     return 0;
@@ -76,6 +241,10 @@ int CommandExecutor::executeFilterInfo(const std::string &filter_name, CLI::App
     return 0;
 }
 
+int CommandExecutor::executeProbe(const CommandOptions &options) {
+    return ImageProbeDisplay::printProbe(options.probe_path, options.recursive, options.pattern, std::cout);
+}
+
 int CommandExecutor::executeSavePreset(const CommandOptions &options) {
     std::string preset_directory = options.preset_dir.empty() ? "./presets" : options.preset_dir;
     if (PresetManager::savePreset(options.filter_name, options.save_preset, preset_directory)) {
@@ -103,15 +272,32 @@ int CommandExecutor::executeSingleImage(const CommandOptions &options, CLI::App
     Logger::info("Загрузка изображения: " + options.input_file);
 
     // Используем вспомогательную функцию для обработки изображения
-    if (!ImageProcessingHelper::processSingleImage(
-        options.input_file,
-        options.output_file,
-        filters,
-        app,
-        options.preserve_alpha,
-        options.force_rgb,
-        options.jpeg_quality)) {
-        return 1;
+    if (options.streaming) {
+        if (!ImageProcessingHelper::processImageStreaming(
+            options.input_file,
+            options.output_file,
+            filters,
+            app,
+            options.preserve_alpha,
+            options.force_rgb,
+            options.jpeg_quality,
+            options.strip_rows)) {
+            return 1;
+        }
+    } else {
+        size_t peak_scratch_bytes = 0;
+        if (!ImageProcessingHelper::processSingleImage(
+            options.input_file,
+            options.output_file,
+            filters,
+            app,
+            options.preserve_alpha,
+            options.force_rgb,
+            options.jpeg_quality,
+            &peak_scratch_bytes)) {
+            return 1;
+        }
+        Logger::debug("Пиковый объем временной памяти фильтров: " + formatKilobytes(peak_scratch_bytes));
     }
 
     Logger::info("Готово! Результат сохранен в " + options.output_file);
@@ -142,23 +328,82 @@ int CommandExecutor::executeBatchProcessing(const CommandOptions &options, CLI::
         Logger::info("Шаблон фильтрации: " + options.pattern);
     }
 
-    // Создаем пул буферов для оптимизации использования памяти
-    // Используем один пул для всей пакетной обработки
-    BufferPool buffer_pool;
-    auto &factory = FilterFactory::getInstance();
-    factory.setBufferPool(&buffer_pool);
+    // Каждый рабочий поток получает собственные фильтры и пул буферов,
+    // которые переиспользуются всеми его файлами
+    WorkerFilterChains worker_chains(filters, app);
 
     // Создаем процессор пакетной обработки
     BatchProcessor processor(options.input_dir, options.output_dir, options.recursive, options.pattern);
 
+    // Порядок обработки: модель стоимости строится по фильтрам цепочки и
+    // уточняется по фактическому времени обработки файлов
+    SchedulingPolicy scheduling_policy = SchedulingPolicy::LargestFirst;
+    if (!parseSchedulingPolicy(options.schedule, scheduling_policy)) {
+        Logger::error("Ошибка: неизвестный порядок обработки: " + options.schedule +
+                      " (допустимо: largest-first, discovery)");
+        return 1;
+    }
+    FilterChain cost_chain;
+    const auto cost_chain_result = FilterChain::build(filters, app, nullptr, cost_chain);
+    if (!cost_chain_result.isSuccess()) {
+        Logger::error(cost_chain_result.getFullMessage());
+        return 1;
+    }
+    CostModel cost_model(cost_chain.getFilters());
+    processor.setScheduling(scheduling_policy, &cost_model);
+    Logger::info("Порядок обработки: " + options.schedule);
+
+    // Допуск по памяти: изображение начинает обрабатываться, только когда
+    // оценка его пиковой памяти помещается в бюджет
+    std::unique_ptr<MemoryBudget> memory_budget;
+    if (options.memory_budget_mb > 0 && !options.pipeline) {
+        memory_budget = std::make_unique<MemoryBudget>(options.memory_budget_mb * 1024 * 1024);
+        processor.setMemoryBudget(memory_budget.get(), options.preserve_alpha ? 4 : 3);
+        Logger::info("Бюджет памяти изображений: " + std::to_string(options.memory_budget_mb) +
+                     " МБ (буферов фильтров на изображение: " + std::to_string(cost_model.getScratchImages()) + ")");
+    }
+
+    // Инкрементальный режим: пропускаются только файлы с неизмененными входом и настройками
+    std::unique_ptr<IncrementalManifest> manifest;
+    if (!options.incremental_manifest.empty()) {
+        manifest = std::make_unique<IncrementalManifest>(buildIncrementalSettings(options, filters, app));
+        if (!manifest->open(options.incremental_manifest)) {
+            Logger::error("Ошибка: не удалось прочитать манифест: " + options.incremental_manifest);
+            return 1;
+        }
+        processor.setIncrementalManifest(manifest.get());
+        Logger::info("Инкрементальная обработка: включена (манифест: " + options.incremental_manifest +
+                     ", записей: " + std::to_string(manifest->size()) + ")");
+    }
+
     // Создаем цепочку обработчиков ошибок
     ErrorHandlerChain error_chain = ErrorHandlerChain::createDefault();
 
+    // Пиковый объем временной памяти фильтров среди всех изображений
+    std::atomic<size_t> max_peak_scratch_bytes{0};
+
     // Функция обработки одного файла
     auto process_function = [&](const std::string &input_path, const std::string &output_path) -> FilterResult {
-        const bool success = ImageProcessingHelper::processSingleImage(
-            input_path, output_path, filters, app,
-            options.preserve_alpha, options.force_rgb, options.jpeg_quality);
+        FilterChain *chain = nullptr;
+        const auto chain_result = worker_chains.getForCurrentThread(chain);
+        if (!chain_result.isSuccess()) {
+            Logger::error(chain_result.getFullMessage());
+            return chain_result;
+        }
+
+        bool success = false;
+        if (options.streaming) {
+            success = ImageProcessingHelper::processImageStreaming(
+                input_path, output_path, *chain,
+                options.preserve_alpha, options.force_rgb, options.jpeg_quality, options.strip_rows);
+        } else {
+            size_t peak_scratch_bytes = 0;
+            success = ImageProcessingHelper::processSingleImage(
+                input_path, output_path, *chain,
+                options.preserve_alpha, options.force_rgb, options.jpeg_quality, &peak_scratch_bytes);
+            Logger::debug("Временная память фильтров для " + input_path + ": " + formatKilobytes(peak_scratch_bytes));
+            updateMaximum(max_peak_scratch_bytes, peak_scratch_bytes);
+        }
         if (success) {
             return FilterResult::success();
         } else {
@@ -172,8 +417,37 @@ int CommandExecutor::executeBatchProcessing(const CommandOptions &options, CLI::
         }
     };
 
-    // Callback для отображения прогресса
+    // Callback для отображения прогресса; его вызывает один поток вывода
+    // с фиксированной частотой, а не рабочие потоки на каждый файл
     ProgressCallback progress_callback = ProgressDisplay::displayProgress;
+    std::ofstream progress_json_file;
+    if (options.progress_json == "-") {
+        progress_callback = [](const ProgressInfo &info) { ProgressDisplay::writeJsonLine(info, std::cout); };
+    } else if (!options.progress_json.empty()) {
+        progress_json_file.open(options.progress_json, std::ios::trunc);
+        if (!progress_json_file.is_open()) {
+            Logger::error("Ошибка: не удалось открыть файл прогресса: " + options.progress_json);
+            return 1;
+        }
+        progress_callback = [&progress_json_file](const ProgressInfo &info) {
+            ProgressDisplay::displayProgress(info);
+            ProgressDisplay::writeJsonLine(info, progress_json_file);
+        };
+    }
+
+    // Определяем файл состояния для возобновления
+    std::string resume_state_file;
+    if (!options.resume_state_file.empty()) {
+        resume_state_file = options.resume_state_file;
+        Logger::info("Возобновление обработки: включено (файл состояния: " + resume_state_file + ")");
+    }
+
+    if (options.pipeline) {
+        const int exit_code = executePipelinedBatch(options, worker_chains, processor, cost_model,
+                                                    progress_callback, resume_state_file);
+        closeIncrementalManifest(manifest.get(), options.incremental_manifest);
+        return exit_code;
+    }
 
     // Определяем параметры параллельной обработки
     std::unique_ptr<ThreadPool> thread_pool;
@@ -186,21 +460,14 @@ int CommandExecutor::executeBatchProcessing(const CommandOptions &options, CLI::
     const bool use_parallel = true; // Можно сделать настраиваемым через опции
 
     if (use_parallel) {
-        // Создаем пул потоков (количество потоков = количество ядер процессора)
-        thread_pool = std::make_unique<ThreadPool>(0); // 0 = автоматическое определение
+        // Создаем пул потоков (количество потоков = бюджет потоков, по умолчанию количество ядер)
+        thread_pool = std::make_unique<ThreadPool>(ConcurrencyGovernor::getInstance().getThreadBudget());
         pool = thread_pool.get();
         max_parallel = 0; // 0 = использовать все потоки пула
         Logger::info("Параллельная обработка: включена (" +
                      std::to_string(pool->getThreadCount()) + " потоков)");
     }
 
-    // Определяем файл состояния для возобновления
-    std::string resume_state_file;
-    if (!options.resume_state_file.empty()) {
-        resume_state_file = options.resume_state_file;
-        Logger::info("Возобновление обработки: включено (файл состояния: " + resume_state_file + ")");
-    }
-
     // Обрабатываем все файлы
     BatchStatistics stats;
     if (!resume_state_file.empty()) {
@@ -211,11 +478,104 @@ int CommandExecutor::executeBatchProcessing(const CommandOptions &options, CLI::
     }
 
     // Выводим статистику
-    Logger::info("Пакетная обработка завершена:");
-    Logger::info("  Всего файлов: " + std::to_string(stats.total_files));
-    Logger::info("  Успешно обработано: " + std::to_string(stats.processed_files));
-    Logger::info("  Ошибок: " + std::to_string(stats.failed_files));
-    Logger::info("  Пропущено: " + std::to_string(stats.skipped_files));
+    logBatchStatistics(stats);
+    Logger::info("  Пик временной памяти фильтров на изображение: " +
+                 formatKilobytes(max_peak_scratch_bytes.load(std::memory_order_relaxed)));
+    Logger::info("  Цепочек фильтров рабочих потоков: " + std::to_string(worker_chains.getWorkerCount()) +
+                 " (буферов в пулах: " + formatKilobytes(worker_chains.getPooledBytes()) + ")");
+    logCostModel(cost_model);
+    if (memory_budget) {
+        logMemoryBudget(*memory_budget);
+    }
+    closeIncrementalManifest(manifest.get(), options.incremental_manifest);
+
+    return (stats.failed_files > 0) ? 1 : 0;
+}
+
+int CommandExecutor::executePipelinedBatch(const CommandOptions &options,
+                                           WorkerFilterChains &worker_chains,
+                                           const BatchProcessor &processor,
+                                           const CostModel &cost_model,
+                                           const ProgressCallback &progress_callback,
+                                           const std::string &resume_state_file) {
+    if (options.streaming) {
+        Logger::warning("--streaming не используется вместе с --pipeline: изображения обрабатываются целиком");
+    }
+
+    std::atomic<size_t> max_peak_scratch_bytes{0};
+
+    BatchPipeline::Stages stages;
+    stages.decode = [&](std::span<const uint8_t> data, ImageProcessor &image) -> FilterResult {
+        if (!image.setJpegQuality(options.jpeg_quality)) {
+            return FilterResult::failure(FilterError::InvalidQuality, "Недопустимое качество JPEG");
+        }
+        const auto load_result = image.loadFromMemory(data, options.preserve_alpha);
+        if (!load_result.isSuccess() || !options.force_rgb || !image.hasAlpha()) {
+            return load_result;
+        }
+        return image.convertToRGB();
+    };
+    stages.process = [&](ImageProcessor &image) -> FilterResult {
+        FilterChain *chain = nullptr;
+        const auto chain_result = worker_chains.getForCurrentThread(chain);
+        if (!chain_result.isSuccess()) {
+            return chain_result;
+        }
+        size_t peak_scratch_bytes = 0;
+        const auto result = chain->apply(image, &peak_scratch_bytes);
+        updateMaximum(max_peak_scratch_bytes, peak_scratch_bytes);
+        return result;
+    };
+    stages.encode = [&](const ImageProcessor &image, const std::string &output_path) -> FilterResult {
+        const bool save_alpha = options.preserve_alpha && image.hasAlpha() && !options.force_rgb;
+        return image.saveToFile(output_path, save_alpha);
+    };
+    // Декодированное изображение и буферы фильтров резервируются в бюджете до декодирования
+    if (options.memory_budget_mb > 0) {
+        const int decoded_channels = options.preserve_alpha ? 4 : 3;
+        stages.estimate_bytes = [&cost_model, decoded_channels](std::span<const uint8_t> data) -> size_t {
+            ImageLoader::ImageInfo info;
+            if (!ImageLoader::probeFromMemory(data, info).isSuccess()) {
+                return 0;
+            }
+            const uint64_t pixels = static_cast<uint64_t>(info.width) * static_cast<uint64_t>(info.height);
+            return static_cast<size_t>(cost_model.estimatePeakBytes(pixels, decoded_channels));
+        };
+    }
+
+    BatchPipeline::Config config;
+    config.read_workers = options.read_threads;
+    config.decode_workers = options.decode_threads;
+    config.process_workers = options.filter_threads;
+    config.encode_workers = options.encode_threads;
+    config.queue_capacity = options.queue_depth;
+    config.memory_budget_bytes = options.memory_budget_mb * 1024 * 1024;
+    config = BatchPipeline::resolveConfig(config);
+
+    Logger::info("Конвейерная обработка: чтение " + std::to_string(config.read_workers) +
+                 ", декодирование " + std::to_string(config.decode_workers) +
+                 ", фильтры " + std::to_string(config.process_workers) +
+                 ", кодирование " + std::to_string(config.encode_workers) +
+                 " потоков, очередь " + std::to_string(config.queue_capacity));
+
+    BatchPipeline::Statistics pipeline_statistics;
+    const auto stats = processor.processAllPipelined(stages, config, progress_callback,
+                                                     resume_state_file, &pipeline_statistics);
+
+    logBatchStatistics(stats);
+    Logger::info("  Пик временной памяти фильтров на изображение: " +
+                 formatKilobytes(max_peak_scratch_bytes.load(std::memory_order_relaxed)));
+    Logger::info("  Цепочек фильтров рабочих потоков: " + std::to_string(worker_chains.getWorkerCount()) +
+                 " (буферов в пулах: " + formatKilobytes(worker_chains.getPooledBytes()) + ")");
+    Logger::info("  Пик памяти изображений в обработке: " + formatKilobytes(pipeline_statistics.peak_in_flight_bytes) +
+                 " (ожиданий бюджета: " + std::to_string(pipeline_statistics.budget_waits) +
+                 ", " + std::to_string(static_cast<int>(pipeline_statistics.budget_wait_seconds * 1000.0 + 0.5)) +
+                 " мс)");
+    for (const auto &stage : pipeline_statistics.stages) {
+        Logger::info("  Стадия " + stage.name + ": " + std::to_string(stage.items) + " файлов, " +
+                     std::to_string(stage.workers) + " потоков, загрузка " +
+                     std::to_string(static_cast<int>(stage.utilisation * 100.0 + 0.5)) + "%");
+    }
 
     return (stats.failed_files > 0) ? 1 : 0;
 }
@@ -1,6 +1,10 @@
 #pragma once
 
 #include <cli/CommandHandler.h>
+#include <cli/BatchProcessor.h>
+#include <cli/FilterChain.h>
+#include <string>
+#include <vector>
 
 // Forward declaration
 namespace CLI {
@@ -32,6 +36,13 @@ public:
     int execute(const CommandOptions& options, CLI::App& app);
 
 private:
+    /**
+     * @brief Устанавливает распределитель памяти изображений по умолчанию
+     * @param options Параметры команды
+     * @return true если распределитель задан корректно
+     */
+    static bool configureAllocator(const CommandOptions& options);
+
     /**
      * @brief Выполняет команду вывода списка фильтров
      * @param app CLI::App для доступа к параметрам фильтров
@@ -47,6 +58,13 @@ private:
      */
     int executeFilterInfo(const std::string& filter_name, CLI::App& app);
 
+    /**
+     * @brief Выполняет команду вывода сведений об изображениях из заголовков (--probe)
+     * @param options Параметры команды
+     * @return Код возврата
+     */
+    int executeProbe(const CommandOptions& options);
+
     /**
      * @brief Выполняет команду сохранения пресета
      * @param options Параметры команды
@@ -69,5 +87,22 @@ private:
      * @return Код возврата
      */
     int executeBatchProcessing(const CommandOptions& options, CLI::App& app);
+
+    /**
+     * @brief Выполняет пакетную обработку конвейером (см. BatchPipeline)
+     * @param options Параметры команды
+     * @param worker_chains Цепочки фильтров рабочих потоков
+     * @param processor Процессор пакетной обработки
+     * @param cost_model Модель стоимости цепочки (оценка памяти для бюджета)
+     * @param progress_callback Callback для отображения прогресса
+     * @param resume_state_file Файл состояния возобновления (пустая строка = без возобновления)
+     * @return Код возврата
+     */
+    int executePipelinedBatch(const CommandOptions& options,
+                              WorkerFilterChains& worker_chains,
+                              const BatchProcessor& processor,
+                              const CostModel& cost_model,
+                              const ProgressCallback& progress_callback,
+                              const std::string& resume_state_file);
 };
 
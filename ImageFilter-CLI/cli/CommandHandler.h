@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 
 /**
@@ -13,11 +15,17 @@ struct CommandOptions
     std::string output_file;
     bool list_filters = false;
     std::string filter_info;
+    std::string probe_path;  // Файл или директория для вывода сведений из заголовков (JSON)
     bool quiet = false;
     std::string log_level_str = "INFO";
     bool preserve_alpha = false;
     bool force_rgb = false;
     int jpeg_quality = 90;
+    std::string allocator = "heap";  // heap, mmap
+    bool populate_pages = false;  // Заполнять страницы mmap при выделении
+    bool streaming = false;  // Потоковая обработка полосами (декодирование → фильтры → кодирование)
+    int strip_rows = 256;  // Высота полосы в строках для потоковой обработки
+    int thread_budget = 0;  // Общий бюджет потоков файлов и строк (0 = количество ядер)
     
     // Параметры пакетной обработки
     bool batch_mode = false;
@@ -26,6 +34,16 @@ struct CommandOptions
     bool recursive = false;
     std::string pattern;
     std::string resume_state_file;  // Файл для сохранения/загрузки состояния возобновления
+    std::string incremental_manifest;  // Манифест инкрементальной обработки (пусто = выключена)
+    std::string progress_json;  // Поток прогресса в формате JSON Lines (пусто = выключен, "-" = stdout)
+    std::string schedule = "largest-first";  // Порядок обработки файлов: largest-first, discovery
+    bool pipeline = false;  // Конвейер: чтение → декодирование → фильтры → кодирование в отдельных пулах
+    int read_threads = 1;  // Потоки чтения конвейера
+    int decode_threads = 0;  // Потоки декодирования конвейера (0 = автоматически)
+    int filter_threads = 0;  // Потоки цепочки фильтров конвейера (0 = автоматически)
+    int encode_threads = 0;  // Потоки кодирования конвейера (0 = автоматически)
+    size_t queue_depth = 0;  // Емкость очередей между стадиями (0 = автоматически)
+    size_t memory_budget_mb = 0;  // Бюджет памяти изображений в обработке в МБ (0 = без ограничения)
     
     // Параметры фильтров
     double brightness_factor = 1.2;
@@ -38,12 +56,14 @@ struct CommandOptions
     double motion_blur_angle = 0.0;
     int median_radius = 2;
     double noise_intensity = 0.1;
+    uint64_t noise_seed = 0;  // Зерно шума (учитывается, только если опция указана явно)
     int posterize_levels = 4;
     int threshold_value = 128;
     double vignette_strength = 0.5;
     double sharpen_strength = 1.0;
     double edge_sensitivity = 0.5;
     std::string edge_operator = "sobel";  // sobel, prewitt, scharr
+    std::string edge_magnitude = "exact";  // exact, approx
     double emboss_strength = 1.0;
     
     // Параметры пресетов
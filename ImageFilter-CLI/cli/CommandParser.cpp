@@ -35,11 +35,17 @@ void CommandParser::setupOptions(CommandOptions& options)
     
     app_.add_flag("--list-filters", options.list_filters, "Вывести список доступных фильтров");
     app_.add_option("--filter-info", options.filter_info, "Вывести информацию о конкретном фильтре");
+    app_.add_option("--probe", options.probe_path, "Вывести в JSON формат, размеры и количество каналов изображения или изображений директории без декодирования (учитывает --recursive и --pattern)");
     app_.add_flag("-q,--quiet", options.quiet, "Тихий режим (минимальный вывод)");
     app_.add_option("--log-level", options.log_level_str, "Уровень логирования (DEBUG, INFO, WARNING, ERROR, по умолчанию INFO)");
     app_.add_flag("--preserve-alpha", options.preserve_alpha, "Сохранять альфа-канал при загрузке и сохранении (RGBA)");
     app_.add_flag("--force-rgb", options.force_rgb, "Принудительно преобразовать RGBA в RGB перед обработкой");
     app_.add_option("--jpeg-quality", options.jpeg_quality, "Качество сохранения JPEG изображений (0-100, по умолчанию 90)");
+    app_.add_option("--allocator", options.allocator, "Распределитель памяти изображений: heap или mmap (mmap с huge pages для больших изображений) (по умолчанию heap)");
+    app_.add_flag("--populate-pages", options.populate_pages, "Заполнять страницы при выделении (для --allocator mmap)");
+    app_.add_flag("--streaming", options.streaming, "Потоковая обработка полосами: в памяти только полоса строк и окрестность фильтров (для очень больших изображений)");
+    app_.add_option("--strip-rows", options.strip_rows, "Высота полосы в строках для --streaming (по умолчанию 256)");
+    app_.add_option("--thread-budget", options.thread_budget, "Общий бюджет потоков для параллельной обработки файлов и строк изображения (0 = количество ядер)");
     
     // Опции для работы с пресетами
     app_.add_option("--preset", options.preset_file, "Загрузить пресет фильтров из файла");
@@ -53,6 +59,16 @@ void CommandParser::setupOptions(CommandOptions& options)
     app_.add_flag("--recursive", options.recursive, "Рекурсивный обход поддиректорий (для пакетного режима)");
     app_.add_option("--pattern", options.pattern, "Шаблон для фильтрации файлов (например, *.jpg, *.png)");
     app_.add_option("--resume-state", options.resume_state_file, "Файл для сохранения/загрузки состояния возобновления пакетной обработки");
+    app_.add_option("--incremental", options.incremental_manifest, "Инкрементальная пакетная обработка с манифестом: пропускаются только файлы, у которых не изменились вход, цепочка фильтров с параметрами и параметры кодирования");
+    app_.add_option("--progress-json", options.progress_json, "Файл для потока прогресса пакетной обработки в формате JSON Lines, до 10 строк в секунду (\"-\" = stdout вместо индикатора прогресса, журнал при этом выводится в stderr)");
+    app_.add_option("--schedule", options.schedule, "Порядок пакетной обработки: largest-first (сначала самые большие изображения по размерам из заголовка) или discovery (в порядке обхода директории) (по умолчанию largest-first)");
+    app_.add_flag("--pipeline", options.pipeline, "Конвейерная пакетная обработка: чтение, декодирование, фильтры и кодирование в отдельных пулах потоков");
+    app_.add_option("--read-threads", options.read_threads, "Количество потоков чтения для --pipeline (по умолчанию 1)");
+    app_.add_option("--decode-threads", options.decode_threads, "Количество потоков декодирования для --pipeline (0 = автоматически)");
+    app_.add_option("--filter-threads", options.filter_threads, "Количество потоков фильтров для --pipeline (0 = автоматически)");
+    app_.add_option("--encode-threads", options.encode_threads, "Количество потоков кодирования для --pipeline (0 = автоматически)");
+    app_.add_option("--queue-depth", options.queue_depth, "Емкость очередей между стадиями для --pipeline (0 = автоматически)");
+    app_.add_option("--memory-budget", options.memory_budget_mb, "Бюджет памяти одновременно обрабатываемых изображений в МБ (0 = без ограничения)");
     
     // Параметры фильтров
     app_.add_option("--brightness-factor", options.brightness_factor, "Коэффициент яркости (по умолчанию 1.2)");
@@ -65,12 +81,14 @@ void CommandParser::setupOptions(CommandOptions& options)
     app_.add_option("--motion-blur-angle", options.motion_blur_angle, "Угол размытия движения в градусах (по умолчанию 0.0)");
     app_.add_option("--median-radius", options.median_radius, "Радиус медианного фильтра (по умолчанию 2)");
     app_.add_option("--noise-intensity", options.noise_intensity, "Интенсивность шума (по умолчанию 0.1, диапазон 0.0-1.0)");
+    app_.add_option("--noise-seed", options.noise_seed, "Зерно генератора шума для воспроизводимого результата (по умолчанию случайное)");
     app_.add_option("--posterize-levels", options.posterize_levels, "Количество уровней постеризации (по умолчанию 4, диапазон 2-256)");
     app_.add_option("--threshold-value", options.threshold_value, "Пороговое значение бинаризации (по умолчанию 128, диапазон 0-255)");
     app_.add_option("--vignette-strength", options.vignette_strength, "Сила виньетирования (по умолчанию 0.5, диапазон 0.0-1.0)");
     app_.add_option("--sharpen-strength", options.sharpen_strength, "Сила эффекта резкости (по умолчанию 1.0, >= 0.0)");
     app_.add_option("--edge-sensitivity", options.edge_sensitivity, "Чувствительность детекции краёв (по умолчанию 0.5, диапазон 0.0-1.0)");
     app_.add_option("--edge-operator", options.edge_operator, "Оператор детекции краёв: sobel, prewitt, scharr (по умолчанию sobel)");
+    app_.add_option("--edge-magnitude", options.edge_magnitude, "Магнитуда градиента: exact (sqrt) или approx (быстрое приближение, погрешность до 4%) (по умолчанию exact)");
     app_.add_option("--emboss-strength", options.emboss_strength, "Сила эффекта рельефа (по умолчанию 1.0, >= 0.0)");
 }
 
@@ -0,0 +1,102 @@
+#include <cli/CostModel.h>
+#include <filters/IFilter.h>
+
+#include <algorithm>
+
+namespace
+{
+    // Декодирование и кодирование пикселя (JPEG/PNG, один поток)
+    constexpr double CODEC_NS_PER_PIXEL = 20.0;
+
+    // Поточечный фильтр
+    constexpr double POINTWISE_NS_PER_PIXEL = 2.0;
+
+    // Доля окрестности: вклад каждой строки радиуса
+    constexpr double NS_PER_PIXEL_PER_RADIUS_ROW = 1.5;
+
+    // Фильтру нужно все изображение (статистика кадра, геометрия)
+    constexpr double WHOLE_IMAGE_NS_PER_PIXEL = 8.0;
+
+    // Поправка меняется, только когда фактических данных достаточно
+    constexpr double MIN_RAW_SECONDS_FOR_CORRECTION = 1e-3;
+
+    double filterNanosecondsPerPixel(const IFilter& filter)
+    {
+        const int radius = filter.getStreamingRadius();
+        if (radius < 0)
+        {
+            return WHOLE_IMAGE_NS_PER_PIXEL;
+        }
+        return POINTWISE_NS_PER_PIXEL + NS_PER_PIXEL_PER_RADIUS_ROW * static_cast<double>(2 * radius);
+    }
+
+    /**
+     * @brief Временные буферы фильтра размером с изображение
+     *
+     * In-place фильтру буфер не нужен, остальным нужна копия результата,
+     * а фильтрам с окрестностью - еще и промежуточный буфер (раздельные проходы).
+     */
+    int filterScratchImages(const IFilter& filter)
+    {
+        if (filter.supportsInPlace())
+        {
+            return 0;
+        }
+        return (filter.getStreamingRadius() > 0) ? 2 : 1;
+    }
+}
+
+CostModel::CostModel()
+    : CostModel(std::vector<IFilter*>{})
+{
+}
+
+CostModel::CostModel(const std::vector<IFilter*>& filters)
+    : nanoseconds_per_pixel_(CODEC_NS_PER_PIXEL)
+{
+    for (const IFilter* filter : filters)
+    {
+        if (filter != nullptr)
+        {
+            nanoseconds_per_pixel_ += filterNanosecondsPerPixel(*filter);
+            // Буферы переиспользуются фильтрами цепочки по очереди, поэтому важен максимум
+            scratch_images_ = std::max(scratch_images_, filterScratchImages(*filter));
+        }
+    }
+}
+
+double CostModel::estimateSeconds(uint64_t pixels) const
+{
+    double correction = 1.0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        correction = statistics_.correction;
+    }
+    return static_cast<double>(pixels) * nanoseconds_per_pixel_ * 1e-9 * correction;
+}
+
+uint64_t CostModel::estimatePeakBytes(uint64_t pixels, int decoded_channels) const noexcept
+{
+    return pixels * static_cast<uint64_t>(decoded_channels) * static_cast<uint64_t>(1 + scratch_images_);
+}
+
+void CostModel::record(uint64_t pixels, double estimated_seconds, double actual_seconds)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    statistics_.files++;
+    statistics_.estimated_seconds += estimated_seconds;
+    statistics_.actual_seconds += actual_seconds;
+
+    // Множитель - отношение фактического времени к оценке без поправки по всем файлам
+    raw_seconds_ += static_cast<double>(pixels) * nanoseconds_per_pixel_ * 1e-9;
+    if (raw_seconds_ >= MIN_RAW_SECONDS_FOR_CORRECTION)
+    {
+        statistics_.correction = statistics_.actual_seconds / raw_seconds_;
+    }
+}
+
+CostModel::Statistics CostModel::getStatistics() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return statistics_;
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+class IFilter;
+
+/**
+ * @brief Модель стоимости обработки изображения цепочкой фильтров
+ *
+ * Стоимость файла пропорциональна количеству пикселей: на каждый пиксель
+ * приходится декодирование и кодирование плюс вклад каждого фильтра,
+ * зависящий от размера окрестности (IFilter::getStreamingRadius()).
+ * Начальные коэффициенты грубые; по фактическому времени обработанных
+ * файлов модель вычисляет поправочный множитель (record()).
+ *
+ * Модель также оценивает пиковую память обработки изображения: само
+ * изображение плюс временные буферы размером с изображение, нужные самому
+ * требовательному фильтру цепочки (estimatePeakBytes()).
+ *
+ * @note Методы thread-safe
+ */
+class CostModel
+{
+public:
+    /**
+     * @brief Сравнение оценки с фактическим временем
+     */
+    struct Statistics
+    {
+        size_t files = 0;                 // Файлов с известной оценкой и фактическим временем
+        double estimated_seconds = 0.0;   // Сумма оценок на момент начала обработки файлов
+        double actual_seconds = 0.0;      // Сумма фактического времени обработки
+        double correction = 1.0;          // Текущий поправочный множитель модели
+    };
+
+    /**
+     * @brief Модель без фильтров (только декодирование и кодирование)
+     */
+    CostModel();
+
+    /**
+     * @brief Конструктор
+     * @param filters Фильтры цепочки (используются только при создании модели)
+     */
+    explicit CostModel(const std::vector<IFilter*>& filters);
+
+    CostModel(const CostModel&) = delete;
+    CostModel& operator=(const CostModel&) = delete;
+
+    /**
+     * @brief Оценивает время обработки изображения одним потоком
+     * @param pixels Количество пикселей
+     * @return Оценка в секундах с учетом текущей поправки
+     */
+    [[nodiscard]] double estimateSeconds(uint64_t pixels) const;
+
+    /**
+     * @brief Оценивает пиковую память обработки изображения
+     * @param pixels Количество пикселей
+     * @param decoded_channels Каналы декодированного изображения (4 с --preserve-alpha, иначе 3)
+     * @return Оценка в байтах: изображение и временные буферы фильтров
+     *
+     * Каналы берутся из параметров загрузки, а не из заголовка: загрузчик
+     * приводит любое изображение к RGB или RGBA.
+     */
+    [[nodiscard]] uint64_t estimatePeakBytes(uint64_t pixels, int decoded_channels) const noexcept;
+
+    /**
+     * @brief Учитывает фактическое время обработки файла
+     * @param pixels Количество пикселей
+     * @param estimated_seconds Оценка, выданная для файла перед обработкой
+     * @param actual_seconds Фактическое время обработки
+     */
+    void record(uint64_t pixels, double estimated_seconds, double actual_seconds);
+
+    /**
+     * @brief Получает сравнение оценок с фактическим временем
+     */
+    [[nodiscard]] Statistics getStatistics() const;
+
+    /**
+     * @brief Начальная стоимость пикселя в наносекундах без поправки
+     */
+    [[nodiscard]] double getNanosecondsPerPixel() const noexcept { return nanoseconds_per_pixel_; }
+
+    /**
+     * @brief Количество временных буферов размером с изображение у цепочки
+     */
+    [[nodiscard]] int getScratchImages() const noexcept { return scratch_images_; }
+
+private:
+    double nanoseconds_per_pixel_;
+    int scratch_images_ = 0;
+
+    mutable std::mutex mutex_;
+    Statistics statistics_;
+    double raw_seconds_ = 0.0;   // Сумма оценок без поправки для вычисления множителя
+};
@@ -0,0 +1,146 @@
+#include <cli/FilterChain.h>
+#include <cli/FilterFactory.h>
+#include <ImageProcessor.h>
+#include <CLI/CLI.hpp>
+#include <utils/ConcurrencyGovernor.h>
+#include <utils/ScratchArena.h>
+
+#include <utility>
+
+namespace
+{
+    /**
+     * @brief Арена временных буферов фильтров текущего потока
+     *
+     * В пакетном режиме каждый рабочий поток обрабатывает изображения по одному,
+     * поэтому одна арена на поток переиспользуется всеми его изображениями.
+     */
+    ScratchArena& threadScratchArena()
+    {
+        thread_local ScratchArena arena;
+        return arena;
+    }
+}
+
+FilterResult FilterChain::build(const std::vector<std::string>& filter_names,
+                                const CLI::App& app,
+                                IBufferPool* buffer_pool,
+                                FilterChain& chain)
+{
+    auto& factory = FilterFactory::getInstance();
+
+    FilterChain built;
+    built.names_.reserve(filter_names.size());
+    built.filters_.reserve(filter_names.size());
+    for (const auto& filter_name : filter_names)
+    {
+        auto filter = factory.create(filter_name, app, buffer_pool);
+        if (!filter)
+        {
+            return FilterResult::failure(FilterError::InvalidParameter, "Неизвестный фильтр: " + filter_name);
+        }
+        built.names_.push_back(filter_name);
+        built.filters_.push_back(std::move(filter));
+    }
+
+    chain = std::move(built);
+    return FilterResult::success();
+}
+
+FilterResult FilterChain::apply(ImageProcessor& image, size_t* peak_scratch_bytes)
+{
+    // Очень большое изображение в пакетной обработке получает все потоки бюджета:
+    // новые файлы не начинаются, пока его цепочка фильтров не завершится
+    const auto exclusive_lease = ConcurrencyGovernor::getInstance().acquireExclusive(image.getWidth(), image.getHeight());
+
+    // Временные буферы фильтров берутся из арены потока
+    auto& scratch_arena = threadScratchArena();
+    scratch_arena.reset();
+    image.setScratchArena(&scratch_arena);
+
+    // Применяем фильтры по очереди
+    for (size_t i = 0; i < filters_.size(); ++i)
+    {
+        const auto result = filters_[i]->apply(image);
+        if (!result.isSuccess())
+        {
+            image.setScratchArena(nullptr);
+            return FilterResult::failure(result.error,
+                                         "Ошибка применения фильтра " + names_[i] + ": " + result.getFullMessage(),
+                                         result.context);
+        }
+
+        // Временные буферы фильтра больше не нужны
+        scratch_arena.rewind();
+    }
+
+    image.setScratchArena(nullptr);
+    if (peak_scratch_bytes != nullptr)
+    {
+        *peak_scratch_bytes = scratch_arena.getPeakBytes();
+    }
+    return FilterResult::success();
+}
+
+std::vector<IFilter*> FilterChain::getFilters() const
+{
+    std::vector<IFilter*> filters;
+    filters.reserve(filters_.size());
+    for (const auto& filter : filters_)
+    {
+        filters.push_back(filter.get());
+    }
+    return filters;
+}
+
+WorkerFilterChains::WorkerFilterChains(std::vector<std::string> filter_names, const CLI::App& app)
+    : filter_names_(std::move(filter_names))
+    , app_(app)
+{
+}
+
+FilterResult WorkerFilterChains::getForCurrentThread(FilterChain*& chain)
+{
+    const auto thread_id = std::this_thread::get_id();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const auto it = workers_.find(thread_id);
+        if (it != workers_.end())
+        {
+            chain = &it->second->chain;
+            return FilterResult::success();
+        }
+    }
+
+    // Цепочка создается вне блокировки: другие потоки в это время обрабатывают файлы
+    auto worker = std::make_unique<Worker>();
+    const auto result = FilterChain::build(filter_names_, app_, &worker->buffer_pool, worker->chain);
+    if (!result.isSuccess())
+    {
+        chain = nullptr;
+        return result;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& stored = workers_[thread_id];
+    stored = std::move(worker);
+    chain = &stored->chain;
+    return FilterResult::success();
+}
+
+size_t WorkerFilterChains::getWorkerCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return workers_.size();
+}
+
+size_t WorkerFilterChains::getPooledBytes() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t total = 0;
+    for (const auto& [thread_id, worker] : workers_)
+    {
+        total += worker->buffer_pool.getTotalMemory();
+    }
+    return total;
+}
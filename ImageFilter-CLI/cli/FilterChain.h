@@ -0,0 +1,132 @@
+#pragma once
+
+#include <filters/IFilter.h>
+#include <utils/BufferPool.h>
+#include <utils/FilterResult.h>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Forward declaration
+namespace CLI {
+    class App;
+}
+
+class ImageProcessor;
+
+/**
+ * @brief Готовая цепочка фильтров
+ *
+ * Фильтры создаются один раз из параметров CLI::App и затем применяются
+ * к любому количеству изображений. Фильтры хранят параметры и указатель
+ * на пул буферов, поэтому цепочка не должна применяться из нескольких
+ * потоков одновременно (см. WorkerFilterChains).
+ */
+class FilterChain
+{
+public:
+    FilterChain() = default;
+    FilterChain(FilterChain&&) noexcept = default;
+    FilterChain& operator=(FilterChain&&) noexcept = default;
+
+    FilterChain(const FilterChain&) = delete;
+    FilterChain& operator=(const FilterChain&) = delete;
+
+    /**
+     * @brief Создает фильтры цепочки через FilterFactory
+     * @param filter_names Имена фильтров в порядке применения
+     * @param app CLI::App для получения параметров фильтров
+     * @param buffer_pool Пул буферов фильтров (может быть nullptr; должен жить дольше цепочки)
+     * @param chain Результат (выходной параметр)
+     * @return FilterResult с результатом операции
+     */
+    static FilterResult build(const std::vector<std::string>& filter_names,
+                              const CLI::App& app,
+                              IBufferPool* buffer_pool,
+                              FilterChain& chain);
+
+    /**
+     * @brief Применяет фильтры по очереди
+     * @param image Изображение
+     * @param peak_scratch_bytes Если не nullptr, получает пиковый объем временной памяти фильтров
+     * @return FilterResult с результатом операции
+     *
+     * Временные буферы фильтров берутся из арены текущего потока. Очень большие
+     * изображения в рабочих потоках пакетной обработки обрабатываются монопольно
+     * (см. ConcurrencyGovernor::acquireExclusive()).
+     */
+    FilterResult apply(ImageProcessor& image, size_t* peak_scratch_bytes = nullptr);
+
+    /**
+     * @brief Получает фильтры цепочки (для потоковой обработки)
+     * @return Указатели на фильтры в порядке применения
+     */
+    [[nodiscard]] std::vector<IFilter*> getFilters() const;
+
+    [[nodiscard]] bool empty() const noexcept { return filters_.empty(); }
+    [[nodiscard]] size_t size() const noexcept { return filters_.size(); }
+
+private:
+    std::vector<std::string> names_;
+    std::vector<std::unique_ptr<IFilter>> filters_;
+};
+
+/**
+ * @brief Цепочки фильтров и пулы буферов рабочих потоков пакетной обработки
+ *
+ * Каждый рабочий поток при первом обращении получает собственный пул буферов
+ * и собственную цепочку фильтров, которые живут до конца пакета. Поэтому
+ * фильтры не создаются заново для каждого файла, общая фабрика не изменяется
+ * из нескольких потоков, а буферы пула переиспользуются следующими файлами
+ * того же потока.
+ */
+class WorkerFilterChains
+{
+public:
+    /**
+     * @brief Конструктор
+     * @param filter_names Имена фильтров в порядке применения
+     * @param app CLI::App для получения параметров фильтров (должен жить дольше объекта)
+     */
+    WorkerFilterChains(std::vector<std::string> filter_names, const CLI::App& app);
+
+    WorkerFilterChains(const WorkerFilterChains&) = delete;
+    WorkerFilterChains& operator=(const WorkerFilterChains&) = delete;
+
+    /**
+     * @brief Получает цепочку текущего потока, создавая ее при первом обращении
+     * @param chain Цепочка текущего потока (выходной параметр)
+     * @return FilterResult с результатом операции
+     */
+    FilterResult getForCurrentThread(FilterChain*& chain);
+
+    /**
+     * @brief Количество рабочих потоков, получивших цепочку
+     */
+    [[nodiscard]] size_t getWorkerCount() const;
+
+    /**
+     * @brief Суммарный объем буферов в пулах рабочих потоков
+     * @return Объем в байтах
+     */
+    [[nodiscard]] size_t getPooledBytes() const;
+
+private:
+    /**
+     * @brief Долгоживущее состояние рабочего потока
+     */
+    struct Worker
+    {
+        BufferPool buffer_pool{0, 1};  // Пулом пользуется один поток, достаточно одного сегмента
+        FilterChain chain;
+    };
+
+    std::vector<std::string> filter_names_;
+    const CLI::App& app_;
+    mutable std::mutex mutex_;
+    std::unordered_map<std::thread::id, std::unique_ptr<Worker>> workers_;
+};
@@ -25,6 +25,7 @@
 #include <utils/IBufferPool.h>
 
 #include <algorithm>
+#include <optional>
 #include <vector>
 
 namespace
@@ -66,43 +67,43 @@ FilterFactory& FilterFactory::getInstance()
 void FilterFactory::registerAll()
 {
     // Цветовые фильтры
-    registerFilter("grayscale", [](const CLI::App&) {
+    registerFilter("grayscale", [](const CLI::App&, IBufferPool*) {
         return std::make_unique<GrayscaleFilter>();
     });
 
-    registerFilter("sepia", [](const CLI::App&) {
+    registerFilter("sepia", [](const CLI::App&, IBufferPool*) {
         return std::make_unique<SepiaFilter>();
     });
 
-    registerFilter("invert", [](const CLI::App&) {
+    registerFilter("invert", [](const CLI::App&, IBufferPool*) {
         return std::make_unique<InvertFilter>();
     });
 
-    registerFilter("brightness", [](const CLI::App& app) {
+    registerFilter("brightness", [](const CLI::App& app, IBufferPool*) {
         const double factor = getOptionValue(app, "--brightness-factor", 1.2);
         return std::make_unique<BrightnessFilter>(factor);
     });
 
-    registerFilter("contrast", [](const CLI::App& app) {
+    registerFilter("contrast", [](const CLI::App& app, IBufferPool*) {
         const double factor = getOptionValue(app, "--contrast-factor", 1.5);
         return std::make_unique<ContrastFilter>(factor);
     });
 
-    registerFilter("saturation", [](const CLI::App& app) {
+    registerFilter("saturation", [](const CLI::App& app, IBufferPool*) {
         const double factor = getOptionValue(app, "--saturation-factor", 1.5);
         return std::make_unique<SaturationFilter>(factor);
     });
 
     // Геометрические фильтры
-    registerFilter("flip_h", [](const CLI::App&) {
+    registerFilter("flip_h", [](const CLI::App&, IBufferPool*) {
         return std::make_unique<FlipHorizontalFilter>();
     });
 
-    registerFilter("flip_v", [](const CLI::App&) {
+    registerFilter("flip_v", [](const CLI::App&, IBufferPool*) {
         return std::make_unique<FlipVerticalFilter>();
     });
 
-    registerFilter("rotate90", [](const CLI::App& app) {
+    registerFilter("rotate90", [](const CLI::App& app, IBufferPool*) {
         bool counter_clockwise = false;
         const auto* opt = app.get_option("--counter-clockwise");
         if (opt && opt->count() > 0)
@@ -113,12 +114,12 @@ void FilterFactory::registerAll()
     });
 
     // Фильтры краёв и деталей
-    registerFilter("sharpen", [this](const CLI::App& app) {
+    registerFilter("sharpen", [](const CLI::App& app, IBufferPool* buffer_pool) {
         const double strength = getOptionValue(app, "--sharpen-strength", 1.0);
-        return std::make_unique<SharpenFilter>(strength, BorderHandler::Strategy::Mirror, buffer_pool_);
+        return std::make_unique<SharpenFilter>(strength, BorderHandler::Strategy::Mirror, buffer_pool);
     });
 
-    registerFilter("edges", [](const CLI::App& app) {
+    registerFilter("edges", [](const CLI::App& app, IBufferPool*) {
         const double sensitivity = getOptionValue(app, "--edge-sensitivity", 0.5);
         std::string operator_str = getOptionValue(app, "--edge-operator", std::string("sobel"));
         
@@ -133,58 +134,70 @@ void FilterFactory::registerAll()
             op = EdgeDetectionFilter::Operator::Scharr;
         }
         // По умолчанию используется Sobel
+
+        const std::string magnitude_str = getOptionValue(app, "--edge-magnitude", std::string("exact"));
+        const auto magnitude = (magnitude_str == "approx")
+            ? EdgeDetectionFilter::Magnitude::Approximate
+            : EdgeDetectionFilter::Magnitude::Exact;
         
-        return std::make_unique<EdgeDetectionFilter>(sensitivity, op);
+        return std::make_unique<EdgeDetectionFilter>(sensitivity, op, BorderHandler::Strategy::Mirror, magnitude);
     });
 
-    registerFilter("emboss", [](const CLI::App& app) {
+    registerFilter("emboss", [](const CLI::App& app, IBufferPool*) {
         const double strength = getOptionValue(app, "--emboss-strength", 1.0);
         return std::make_unique<EmbossFilter>(strength);
     });
 
-    registerFilter("outline", [](const CLI::App&) {
+    registerFilter("outline", [](const CLI::App&, IBufferPool*) {
         return std::make_unique<OutlineFilter>();
     });
 
     // Фильтры размытия и шума
-    registerFilter("blur", [this](const CLI::App& app) {
+    registerFilter("blur", [](const CLI::App& app, IBufferPool* buffer_pool) {
         const double radius = getOptionValue(app, "--blur-radius", 5.0);
-        return std::make_unique<GaussianBlurFilter>(radius, BorderHandler::Strategy::Mirror, buffer_pool_);
+        return std::make_unique<GaussianBlurFilter>(radius, BorderHandler::Strategy::Mirror, buffer_pool);
     });
 
-    registerFilter("box_blur", [this](const CLI::App& app) {
+    registerFilter("box_blur", [](const CLI::App& app, IBufferPool* buffer_pool) {
         const int radius = getOptionValue(app, "--box-blur-radius", 5);
-        return std::make_unique<BoxBlurFilter>(radius, BorderHandler::Strategy::Mirror, buffer_pool_);
+        return std::make_unique<BoxBlurFilter>(radius, BorderHandler::Strategy::Mirror, buffer_pool);
     });
 
-    registerFilter("motion_blur", [this](const CLI::App& app) {
+    registerFilter("motion_blur", [](const CLI::App& app, IBufferPool* buffer_pool) {
         const int length = getOptionValue(app, "--motion-blur-length", 10);
         const double angle = getOptionValue(app, "--motion-blur-angle", 0.0);
-        return std::make_unique<MotionBlurFilter>(length, angle, BorderHandler::Strategy::Mirror, buffer_pool_);
+        return std::make_unique<MotionBlurFilter>(length, angle, BorderHandler::Strategy::Mirror, buffer_pool);
     });
 
-    registerFilter("median", [this](const CLI::App& app) {
+    registerFilter("median", [](const CLI::App& app, IBufferPool* buffer_pool) {
         const int radius = getOptionValue(app, "--median-radius", 2);
-        return std::make_unique<MedianFilter>(radius, BorderHandler::Strategy::Mirror, buffer_pool_);
+        return std::make_unique<MedianFilter>(radius, BorderHandler::Strategy::Mirror, buffer_pool);
     });
 
-    registerFilter("noise", [](const CLI::App& app) {
+    registerFilter("noise", [](const CLI::App& app, IBufferPool*) {
         const double intensity = getOptionValue(app, "--noise-intensity", 0.1);
-        return std::make_unique<NoiseFilter>(intensity);
+        // Зерно передается только при явном указании опции, иначе шум невоспроизводим
+        std::optional<uint64_t> seed;
+        const auto* seed_opt = app.get_option("--noise-seed");
+        if (seed_opt && seed_opt->count() > 0)
+        {
+            seed = getOptionValue(app, "--noise-seed", static_cast<uint64_t>(0));
+        }
+        return std::make_unique<NoiseFilter>(intensity, seed);
     });
 
     // Стилистические фильтры
-    registerFilter("posterize", [](const CLI::App& app) {
+    registerFilter("posterize", [](const CLI::App& app, IBufferPool*) {
         const int levels = getOptionValue(app, "--posterize-levels", 4);
         return std::make_unique<PosterizeFilter>(levels);
     });
 
-    registerFilter("threshold", [](const CLI::App& app) {
+    registerFilter("threshold", [](const CLI::App& app, IBufferPool*) {
         const int threshold = getOptionValue(app, "--threshold-value", 128);
         return std::make_unique<ThresholdFilter>(threshold);
     });
 
-    registerFilter("vignette", [](const CLI::App& app) {
+    registerFilter("vignette", [](const CLI::App& app, IBufferPool*) {
         const double strength = getOptionValue(app, "--vignette-strength", 0.5);
         return std::make_unique<VignetteFilter>(strength);
     });
@@ -196,15 +209,29 @@ void FilterFactory::registerFilter(const std::string& name, FilterCreator creato
 }
 
 std::unique_ptr<IFilter> FilterFactory::create(const std::string& name, const CLI::App& app) const
+{
+    return create(name, app, buffer_pool_);
+}
+
+std::unique_ptr<IFilter> FilterFactory::create(const std::string& name, const CLI::App& app,
+                                               IBufferPool* buffer_pool) const
 {
     const auto it = creators_.find(name);
     if (it != creators_.end())
     {
-        return it->second(app);
+        return it->second(app, buffer_pool);
     }
     return nullptr;
 }
 
+std::string FilterFactory::describe(const std::string& name, const CLI::App& app) const
+{
+    // Описание строится по созданному фильтру: учитываются значения по умолчанию,
+    // исправленные конструктором значения и одинаковые числа в разной записи
+    const auto filter = create(name, app, nullptr);
+    return name + "(" + (filter ? filter->getParameters() : std::string()) + ")";
+}
+
 bool FilterFactory::isRegistered(const std::string& name) const
 {
     return creators_.find(name) != creators_.end();
@@ -5,6 +5,7 @@
 #include <string>
 #include <unordered_map>
 #include <functional>
+#include <vector>
 
 // Forward declaration
 namespace CLI {
@@ -32,8 +33,10 @@ class FilterFactory
 public:
     /**
      * @brief Тип функции для создания фильтра
+     *
+     * Получает параметры из CLI::App и пул буферов для фильтров, которые его поддерживают.
      */
-    using FilterCreator = std::function<std::unique_ptr<IFilter>(const CLI::App&)>;
+    using FilterCreator = std::function<std::unique_ptr<IFilter>(const CLI::App&, IBufferPool*)>;
 
     /**
      * @brief Получает единственный экземпляр фабрики (Singleton)
@@ -63,6 +66,30 @@ public:
      */
     std::unique_ptr<IFilter> create(const std::string& name, const CLI::App& app) const;
 
+    /**
+     * @brief Создает фильтр по имени с заданным пулом буферов
+     * 
+     * В отличие от create(name, app) не использует общий пул фабрики, поэтому
+     * безопасен для вызова из нескольких потоков со своими пулами.
+     * 
+     * @param name Имя фильтра
+     * @param app CLI::App для получения параметров фильтра
+     * @param buffer_pool Пул буферов для создаваемого фильтра (может быть nullptr)
+     * @return Умный указатель на фильтр или nullptr если фильтр не найден
+     */
+    std::unique_ptr<IFilter> create(const std::string& name, const CLI::App& app, IBufferPool* buffer_pool) const;
+
+    /**
+     * @brief Формирует нормализованное описание фильтра с параметрами
+     * @param name Имя фильтра
+     * @param app CLI::App для получения параметров фильтра
+     * @return Строка вида "blur(radius=3,border=mirror)" с действующими
+     *         параметрами созданного фильтра (см. IFilter::getParameters())
+     *
+     * Одинаковые описания означают одинаковый результат фильтра (см. --incremental).
+     */
+    std::string describe(const std::string& name, const CLI::App& app) const;
+
     /**
      * @brief Проверяет, зарегистрирован ли фильтр с заданным именем
      * @param name Имя фильтра
@@ -83,6 +110,9 @@ public:
      * Это позволяет оптимизировать использование памяти при обработке цепочек фильтров.
      * 
      * @param buffer_pool Указатель на пул буферов (может быть nullptr)
+     * 
+     * @note Пул общий для всех вызовов create(name, app). Из нескольких потоков
+     *       фильтры создаются через create(name, app, buffer_pool) (см. FilterChain).
      */
     void setBufferPool(IBufferPool* buffer_pool) noexcept;
 
@@ -0,0 +1,73 @@
+#include <cli/ImageProbeDisplay.h>
+#include <utils/DirectoryScanner.h>
+#include <utils/ImageLoader.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <vector>
+
+nlohmann::json ImageProbeDisplay::probeFile(const std::string& path)
+{
+    nlohmann::json entry;
+    entry["path"] = path;
+
+    ImageLoader::ImageInfo info;
+    const auto result = ImageLoader::probe(path, info);
+    if (!result.isSuccess())
+    {
+        entry["error"] = result.getFullMessage();
+        return entry;
+    }
+
+    entry["format"] = info.format;
+    entry["width"] = info.width;
+    entry["height"] = info.height;
+    entry["channels"] = info.channels;
+    entry["file_size"] = info.file_size;
+    return entry;
+}
+
+int ImageProbeDisplay::printProbe(const std::string& path, bool recursive, const std::string& pattern,
+                                  std::ostream& out)
+{
+    std::error_code ec;
+    if (!std::filesystem::is_directory(path, ec))
+    {
+        const auto entry = probeFile(path);
+        out << entry.dump(2) << std::endl;
+        return entry.contains("error") ? 1 : 0;
+    }
+
+    DirectoryScanner::Options options;
+    options.recursive = recursive;
+    options.pattern = pattern;
+    DirectoryScanner scanner(path, options);
+    const auto start_result = scanner.start();
+    if (!start_result.isSuccess())
+    {
+        out << nlohmann::json{{"path", path}, {"error", start_result.getFullMessage()}}.dump(2) << std::endl;
+        return 1;
+    }
+
+    std::vector<std::string> files;
+    std::filesystem::path file;
+    while (scanner.next(file))
+    {
+        files.push_back(file.string());
+    }
+    std::sort(files.begin(), files.end());
+
+    int exit_code = 0;
+    auto entries = nlohmann::json::array();
+    for (const auto& image : files)
+    {
+        auto entry = probeFile(image);
+        if (entry.contains("error"))
+        {
+            exit_code = 1;
+        }
+        entries.push_back(std::move(entry));
+    }
+    out << entries.dump(2) << std::endl;
+    return exit_code;
+}
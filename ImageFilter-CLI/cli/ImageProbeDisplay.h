@@ -0,0 +1,36 @@
+#pragma once
+
+#include <nlohmann/json.hpp>
+
+#include <ostream>
+#include <string>
+
+/**
+ * @brief Вывод сведений об изображениях из заголовков в формате JSON
+ *
+ * Для каждого изображения выводятся путь, формат, размеры, количество
+ * каналов и размер файла (см. ImageLoader::probe()); пиксели не декодируются.
+ * Для файла выводится один объект, для директории - массив объектов,
+ * отсортированный по пути. Если заголовок не прочитан, вместо сведений
+ * объект содержит поле "error".
+ */
+class ImageProbeDisplay
+{
+public:
+    /**
+     * @brief Читает заголовок одного изображения
+     * @param path Путь к файлу
+     * @return JSON-объект со сведениями или с полем "error"
+     */
+    static nlohmann::json probeFile(const std::string& path);
+
+    /**
+     * @brief Выводит сведения об изображении или изображениях директории
+     * @param path Путь к файлу или директории
+     * @param recursive Обходить поддиректории
+     * @param pattern Шаблон имени файла (например, "*.jpg")
+     * @param out Поток вывода
+     * @return Код возврата (0 = все заголовки прочитаны)
+     */
+    static int printProbe(const std::string& path, bool recursive, const std::string& pattern, std::ostream& out);
+};
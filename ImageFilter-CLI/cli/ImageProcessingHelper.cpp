@@ -1,10 +1,13 @@
 #include <cli/ImageProcessingHelper.h>
+#include <cli/FilterChain.h>
 #include <ImageProcessor.h>
 #include <filters/IFilter.h>
 #include <CLI/CLI.hpp>
 #include <utils/Logger.h>
-#include <cli/FilterFactory.h>
 #include <utils/BufferPool.h>
+#include <utils/RowStream.h>
+#include <utils/StripPipeline.h>
+#include <memory>
 #include <sstream>
 #include <algorithm>
 
@@ -56,7 +59,32 @@ bool ImageProcessingHelper::processSingleImage(
     CLI::App& app,
     bool preserve_alpha,
     bool force_rgb,
-    int jpeg_quality)
+    int jpeg_quality,
+    size_t* peak_scratch_bytes)
+{
+    // Создаем пул буферов для оптимизации использования памяти
+    // Используем один пул для всей цепочки фильтров
+    BufferPool buffer_pool;
+    FilterChain chain;
+    const auto build_result = FilterChain::build(filter_names, app, &buffer_pool, chain);
+    if (!build_result.isSuccess())
+    {
+        Logger::error(build_result.getFullMessage());
+        return false;
+    }
+
+    return processSingleImage(input_file, output_file, chain, preserve_alpha, force_rgb,
+                              jpeg_quality, peak_scratch_bytes);
+}
+
+bool ImageProcessingHelper::processSingleImage(
+    const std::string& input_file,
+    const std::string& output_file,
+    FilterChain& chain,
+    bool preserve_alpha,
+    bool force_rgb,
+    int jpeg_quality,
+    size_t* peak_scratch_bytes)
 {
     ImageProcessor image;
     
@@ -85,27 +113,11 @@ bool ImageProcessingHelper::processSingleImage(
         }
     }
     
-    // Создаем пул буферов для оптимизации использования памяти
-    // Используем один пул для всей цепочки фильтров
-    BufferPool buffer_pool;
-    auto& factory = FilterFactory::getInstance();
-    factory.setBufferPool(&buffer_pool);
-    
-    // Применяем фильтры по очереди
-    for (const auto& filter_name : filter_names)
+    const auto chain_result = chain.apply(image, peak_scratch_bytes);
+    if (!chain_result.isSuccess())
     {
-        auto filter = factory.create(filter_name, app);
-        if (!filter)
-        {
-            return false;
-        }
-        
-        const auto result = filter->apply(image);
-        if (!result.isSuccess())
-        {
-            Logger::error("Ошибка применения фильтра " + filter_name + ": " + result.getFullMessage());
-            return false;
-        }
+        Logger::error(chain_result.getFullMessage());
+        return false;
     }
     
     // Определяем, нужно ли сохранять альфа-канал
@@ -121,3 +133,80 @@ bool ImageProcessingHelper::processSingleImage(
     return true;
 }
 
+bool ImageProcessingHelper::processImageStreaming(
+    const std::string& input_file,
+    const std::string& output_file,
+    const std::vector<std::string>& filter_names,
+    CLI::App& app,
+    bool preserve_alpha,
+    bool force_rgb,
+    int jpeg_quality,
+    int strip_rows)
+{
+    BufferPool buffer_pool;
+    FilterChain chain;
+    const auto build_result = FilterChain::build(filter_names, app, &buffer_pool, chain);
+    if (!build_result.isSuccess())
+    {
+        Logger::error(build_result.getFullMessage());
+        return false;
+    }
+
+    return processImageStreaming(input_file, output_file, chain, preserve_alpha, force_rgb,
+                                 jpeg_quality, strip_rows);
+}
+
+bool ImageProcessingHelper::processImageStreaming(
+    const std::string& input_file,
+    const std::string& output_file,
+    FilterChain& chain,
+    bool preserve_alpha,
+    bool force_rgb,
+    int jpeg_quality,
+    int strip_rows)
+{
+    const auto filters = chain.getFilters();
+    if (StripPipeline::getChainRadius(filters) < 0)
+    {
+        Logger::warning("Цепочка содержит фильтры, которым нужно все изображение; потоковая обработка отключена");
+        return processSingleImage(input_file, output_file, chain,
+                                  preserve_alpha, force_rgb, jpeg_quality);
+    }
+
+    // RGBA сохраняется только при явном запросе и без принудительного RGB
+    const bool keep_alpha = preserve_alpha && !force_rgb;
+
+    std::unique_ptr<IRowReader> reader;
+    const auto open_result = RowStream::openReader(input_file, keep_alpha, reader);
+    if (!open_result.isSuccess())
+    {
+        Logger::error("Ошибка загрузки изображения: " + open_result.getFullMessage());
+        return false;
+    }
+
+    std::unique_ptr<IRowWriter> writer;
+    const auto writer_result = RowStream::createWriter(output_file, keep_alpha, jpeg_quality, writer);
+    if (!writer_result.isSuccess())
+    {
+        Logger::error("Ошибка сохранения изображения: " + writer_result.getFullMessage());
+        return false;
+    }
+
+    if (!RowStream::isStreamingFormat(input_file) || !RowStream::isStreamingFormat(output_file))
+    {
+        Logger::debug("Формат не поддерживает построчный кодек, кадр декодируется или кодируется целиком");
+    }
+
+    StripPipeline::Statistics statistics;
+    const auto result = StripPipeline::run(*reader, *writer, filters, strip_rows, &statistics);
+    if (!result.isSuccess())
+    {
+        Logger::error("Ошибка потоковой обработки: " + result.getFullMessage());
+        return false;
+    }
+
+    Logger::debug("Потоковая обработка: полос " + std::to_string(statistics.strips) +
+                  ", строк окрестности " + std::to_string(statistics.halo_rows) +
+                  ", пик памяти " + std::to_string((statistics.peak_memory_bytes + 1023) / 1024) + " КБ");
+    return true;
+}
@@ -1,18 +1,20 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
 #include <vector>
 #include <CLI/CLI.hpp>
+#include <utils/FilterResult.h>
 
 // Forward declaration
-class ImageProcessor;
+class FilterChain;
 
 /**
  * @brief Вспомогательный класс для обработки изображений
  * 
  * Отвечает за:
  * - Обработку одного изображения с применением цепочки фильтров
- * - Управление пулом буферов
+ * - Управление пулом буферов и цепочкой фильтров (см. FilterChain)
  * - Преобразование форматов изображений
  */
 class ImageProcessingHelper
@@ -27,7 +29,14 @@ public:
      * @param preserve_alpha Сохранять ли альфа-канал
      * @param force_rgb Принудительно преобразовать RGBA в RGB
      * @param jpeg_quality Качество сохранения JPEG (0-100)
+     * @param peak_scratch_bytes Если не nullptr, получает пиковый объем временной памяти
+     *        фильтров для этого изображения (в байтах)
      * @return true если обработка успешна, false в противном случае
+     *
+     * Временные буферы фильтров выделяются из арены потока (ScratchArena), которая
+     * освобождается после каждого фильтра и сбрасывается перед каждым изображением.
+     * Поэтому пиковый объем временной памяти равен потребности самого требовательного
+     * фильтра цепочки, а память арены переиспользуется между изображениями.
      */
     static bool processSingleImage(
         const std::string& input_file,
@@ -36,7 +45,73 @@ public:
         CLI::App& app,
         bool preserve_alpha,
         bool force_rgb,
-        int jpeg_quality);
+        int jpeg_quality,
+        size_t* peak_scratch_bytes = nullptr);
+
+    /**
+     * @brief Обрабатывает одно изображение готовой цепочкой фильтров
+     * @param input_file Путь к входному файлу
+     * @param output_file Путь к выходному файлу
+     * @param chain Цепочка фильтров (см. FilterChain, WorkerFilterChains)
+     * @param preserve_alpha Сохранять ли альфа-канал
+     * @param force_rgb Принудительно преобразовать RGBA в RGB
+     * @param jpeg_quality Качество сохранения JPEG (0-100)
+     * @param peak_scratch_bytes Если не nullptr, получает пиковый объем временной памяти фильтров
+     * @return true если обработка успешна, false в противном случае
+     */
+    static bool processSingleImage(
+        const std::string& input_file,
+        const std::string& output_file,
+        FilterChain& chain,
+        bool preserve_alpha,
+        bool force_rgb,
+        int jpeg_quality,
+        size_t* peak_scratch_bytes = nullptr);
+
+    /**
+     * @brief Обрабатывает одно изображение потоково полосами (см. StripPipeline)
+     * @param input_file Путь к входному файлу
+     * @param output_file Путь к выходному файлу
+     * @param filter_names Список имен фильтров для применения
+     * @param app CLI::App для доступа к параметрам фильтров
+     * @param preserve_alpha Сохранять ли альфа-канал
+     * @param force_rgb Принудительно преобразовать RGBA в RGB
+     * @param jpeg_quality Качество сохранения JPEG (0-100)
+     * @param strip_rows Высота полосы в строках
+     * @return true если обработка успешна, false в противном случае
+     *
+     * Если хотя бы одному фильтру цепочки нужно все изображение (поворот, нормализация
+     * по кадру и т.п.), изображение обрабатывается целиком через processSingleImage().
+     */
+    static bool processImageStreaming(
+        const std::string& input_file,
+        const std::string& output_file,
+        const std::vector<std::string>& filter_names,
+        CLI::App& app,
+        bool preserve_alpha,
+        bool force_rgb,
+        int jpeg_quality,
+        int strip_rows);
+
+    /**
+     * @brief Обрабатывает одно изображение потоково готовой цепочкой фильтров
+     * @param input_file Путь к входному файлу
+     * @param output_file Путь к выходному файлу
+     * @param chain Цепочка фильтров
+     * @param preserve_alpha Сохранять ли альфа-канал
+     * @param force_rgb Принудительно преобразовать RGBA в RGB
+     * @param jpeg_quality Качество сохранения JPEG (0-100)
+     * @param strip_rows Высота полосы в строках
+     * @return true если обработка успешна, false в противном случае
+     */
+    static bool processImageStreaming(
+        const std::string& input_file,
+        const std::string& output_file,
+        FilterChain& chain,
+        bool preserve_alpha,
+        bool force_rgb,
+        int jpeg_quality,
+        int strip_rows);
 
     /**
      * @brief Разбивает строку фильтров на отдельные имена
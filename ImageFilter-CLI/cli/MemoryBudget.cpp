@@ -0,0 +1,102 @@
+#include <cli/MemoryBudget.h>
+
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+MemoryBudget::Reservation::Reservation(MemoryBudget* budget, size_t bytes) noexcept
+    : budget_(budget)
+    , bytes_(bytes)
+{
+}
+
+MemoryBudget::Reservation::~Reservation()
+{
+    release();
+}
+
+MemoryBudget::Reservation::Reservation(Reservation&& other) noexcept
+    : budget_(std::exchange(other.budget_, nullptr))
+    , bytes_(std::exchange(other.bytes_, 0))
+{
+}
+
+MemoryBudget::Reservation& MemoryBudget::Reservation::operator=(Reservation&& other) noexcept
+{
+    if (this != &other)
+    {
+        release();
+        budget_ = std::exchange(other.budget_, nullptr);
+        bytes_ = std::exchange(other.bytes_, 0);
+    }
+    return *this;
+}
+
+void MemoryBudget::Reservation::release() noexcept
+{
+    if (budget_ != nullptr)
+    {
+        budget_->release(bytes_);
+        budget_ = nullptr;
+        bytes_ = 0;
+    }
+}
+
+MemoryBudget::MemoryBudget(size_t budget_bytes)
+    : budget_(budget_bytes)
+{
+}
+
+MemoryBudget::Reservation MemoryBudget::reserve(size_t bytes)
+{
+    acquire(bytes);
+    return Reservation(this, bytes);
+}
+
+void MemoryBudget::acquire(size_t bytes)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (budget_ > 0 && reserved_ > 0 && reserved_ + bytes > budget_)
+    {
+        const auto wait_start = std::chrono::steady_clock::now();
+        released_.wait(lock, [this, bytes] { return reserved_ == 0 || reserved_ + bytes <= budget_; });
+        const std::chrono::duration<double> waited = std::chrono::steady_clock::now() - wait_start;
+
+        statistics_.waits++;
+        statistics_.wait_seconds += waited.count();
+        statistics_.max_wait_seconds = std::max(statistics_.max_wait_seconds, waited.count());
+    }
+    reserved_ += bytes;
+    statistics_.reservations++;
+    statistics_.peak_bytes = std::max(statistics_.peak_bytes, reserved_);
+}
+
+void MemoryBudget::adjust(size_t old_bytes, size_t new_bytes)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    reserved_ = reserved_ - old_bytes + new_bytes;
+    statistics_.peak_bytes = std::max(statistics_.peak_bytes, reserved_);
+    if (new_bytes < old_bytes)
+    {
+        released_.notify_all();
+    }
+}
+
+void MemoryBudget::release(size_t bytes) noexcept
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    reserved_ -= std::min(bytes, reserved_);
+    released_.notify_all();
+}
+
+size_t MemoryBudget::getReservedBytes() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return reserved_;
+}
+
+MemoryBudget::Statistics MemoryBudget::getStatistics() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return statistics_;
+}
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+
+/**
+ * @brief Бюджет памяти изображений в обработке
+ *
+ * Работает как семафор в байтах: перед обработкой изображения резервируется
+ * оценка его пиковой памяти, и если резерв не помещается в бюджет, вызывающий
+ * поток ждет освобождения памяти другими изображениями. Так одновременная
+ * обработка нескольких больших изображений не выходит за пределы памяти машины,
+ * а маленькие изображения по-прежнему обрабатываются параллельно.
+ *
+ * Допуск мягкий: если ничего не зарезервировано, резерв выдается всегда, даже
+ * если он больше бюджета, - иначе изображение больше бюджета не было бы
+ * обработано никогда.
+ *
+ * @note Методы thread-safe
+ */
+class MemoryBudget
+{
+public:
+    /**
+     * @brief Статистика допуска
+     */
+    struct Statistics
+    {
+        size_t reservations = 0;        // Выданных резервов
+        size_t waits = 0;               // Сколько резервов ждали освобождения памяти
+        double wait_seconds = 0.0;      // Суммарное время ожидания
+        double max_wait_seconds = 0.0;  // Самое долгое ожидание
+        size_t peak_bytes = 0;          // Пиковый зарезервированный объем
+    };
+
+    /**
+     * @brief Резерв памяти; освобождается в деструкторе
+     */
+    class Reservation
+    {
+    public:
+        Reservation() noexcept = default;
+        ~Reservation();
+
+        Reservation(Reservation&& other) noexcept;
+        Reservation& operator=(Reservation&& other) noexcept;
+
+        Reservation(const Reservation&) = delete;
+        Reservation& operator=(const Reservation&) = delete;
+
+        /**
+         * @brief Зарезервированный объем в байтах
+         */
+        [[nodiscard]] size_t getBytes() const noexcept { return bytes_; }
+
+        /**
+         * @brief Досрочно освобождает резерв
+         */
+        void release() noexcept;
+
+    private:
+        friend class MemoryBudget;
+
+        Reservation(MemoryBudget* budget, size_t bytes) noexcept;
+
+        MemoryBudget* budget_ = nullptr;
+        size_t bytes_ = 0;
+    };
+
+    /**
+     * @brief Конструктор
+     * @param budget_bytes Бюджет в байтах (0 = без ограничения, только учет)
+     */
+    explicit MemoryBudget(size_t budget_bytes);
+
+    MemoryBudget(const MemoryBudget&) = delete;
+    MemoryBudget& operator=(const MemoryBudget&) = delete;
+
+    /**
+     * @brief Резервирует память, при необходимости ожидая ее освобождения
+     * @param bytes Объем в байтах
+     * @return Резерв, освобождающий память при уничтожении
+     */
+    [[nodiscard]] Reservation reserve(size_t bytes);
+
+    /**
+     * @brief Резервирует память без RAII (освобождается через release())
+     * @param bytes Объем в байтах
+     */
+    void acquire(size_t bytes);
+
+    /**
+     * @brief Изменяет размер уже выданного резерва без ожидания
+     * @param old_bytes Прежний объем
+     * @param new_bytes Новый объем
+     *
+     * Используется, когда точный размер становится известен после начала
+     * обработки (например, после декодирования).
+     */
+    void adjust(size_t old_bytes, size_t new_bytes);
+
+    /**
+     * @brief Освобождает память, зарезервированную через acquire()
+     * @param bytes Объем в байтах
+     */
+    void release(size_t bytes) noexcept;
+
+    /**
+     * @brief Бюджет в байтах (0 = без ограничения)
+     */
+    [[nodiscard]] size_t getBudget() const noexcept { return budget_; }
+
+    /**
+     * @brief Текущий зарезервированный объем в байтах
+     */
+    [[nodiscard]] size_t getReservedBytes() const;
+
+    /**
+     * @brief Получает статистику допуска
+     */
+    [[nodiscard]] Statistics getStatistics() const;
+
+private:
+    const size_t budget_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable released_;
+    size_t reserved_ = 0;
+    Statistics statistics_;
+};
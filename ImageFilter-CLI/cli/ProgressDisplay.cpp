@@ -36,7 +36,8 @@ void ProgressDisplay::displayProgress(const ProgressInfo& info)
     
     std::cout << "\r[";
     std::cout << std::setw(3) << std::fixed << std::setprecision(0) << info.percentage << "%] ";
-    std::cout << "[" << info.current << "/" << info.total << "] ";
+    // Пока директория обходится, общее количество файлов - оценка
+    std::cout << "[" << info.current << "/" << (info.total_estimated ? "~" : "") << info.total << "] ";
     
     // Отображаем имя файла (только последнюю часть пути для компактности)
     std::filesystem::path file_path(info.current_file);
@@ -52,7 +53,7 @@ void ProgressDisplay::displayProgress(const ProgressInfo& info)
     {
         std::cout << " | Время: " << formatTime(info.elapsed_time);
         
-        if (info.estimated_remaining.count() > 0 && info.current < info.total)
+        if (info.estimated_remaining.count() > 0 && info.current < info.total && !info.total_estimated)
         {
             std::cout << " | Осталось: " << formatTime(info.estimated_remaining);
         }
@@ -64,7 +65,7 @@ void ProgressDisplay::displayProgress(const ProgressInfo& info)
         }
     }
     
-    if (info.current == info.total)
+    if (info.current == info.total && !info.total_estimated)
     {
         std::cout << std::endl;
     }
@@ -74,3 +75,28 @@ void ProgressDisplay::displayProgress(const ProgressInfo& info)
     }
 }
 
+
+nlohmann::json ProgressDisplay::toJson(const ProgressInfo& info)
+{
+    nlohmann::json entry;
+    entry["current"] = info.current;
+    entry["total"] = info.total;
+    entry["total_estimated"] = info.total_estimated;
+    entry["percent"] = info.percentage;
+    entry["failed"] = info.failed_files;
+    entry["skipped"] = info.skipped_files;
+    entry["elapsed_seconds"] = info.elapsed_time.count();
+    // Пока общее количество неизвестно или скорость не измерена, оценки нет
+    const bool has_eta = !info.total_estimated && (info.files_per_second > 0.0 || info.current == info.total);
+    entry["eta_seconds"] = has_eta ? nlohmann::json(info.estimated_remaining.count()) : nlohmann::json(nullptr);
+    entry["files_per_second"] = info.files_per_second;
+    entry["file"] = info.current_file;
+    return entry;
+}
+
+void ProgressDisplay::writeJsonLine(const ProgressInfo& info, std::ostream& out)
+{
+    // Имя файла может быть не в UTF-8: некорректные байты заменяются, а не бросают исключение
+    out << toJson(info).dump(-1, ' ', false, nlohmann::json::error_handler_t::replace) << '\n';
+    out.flush();
+}
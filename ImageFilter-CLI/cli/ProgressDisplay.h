@@ -1,7 +1,9 @@
 #pragma once
 
 #include "BatchProcessor.h"
+#include <nlohmann/json.hpp>
 #include <chrono>
+#include <ostream>
 #include <string>
 
 /**
@@ -9,6 +11,7 @@
  * 
  * Отвечает за:
  * - Форматирование и отображение прогресса обработки файлов
+ * - Машиночитаемый поток прогресса в формате JSON Lines
  * - Форматирование времени
  */
 class ProgressDisplay
@@ -20,6 +23,23 @@ public:
      */
     static void displayProgress(const ProgressInfo& info);
 
+    /**
+     * @brief Преобразует прогресс в JSON-объект
+     * @param info Информация о прогрессе
+     * @return Объект с полями current, total, total_estimated, percent, failed, skipped,
+     *         elapsed_seconds, eta_seconds (null, пока оценка невозможна), files_per_second, file
+     */
+    static nlohmann::json toJson(const ProgressInfo& info);
+
+    /**
+     * @brief Записывает прогресс одной строкой JSON (JSON Lines) и сбрасывает поток
+     * @param info Информация о прогрессе
+     * @param out Поток вывода
+     *
+     * В отличие от displayProgress() выводится и в тихом режиме.
+     */
+    static void writeJsonLine(const ProgressInfo& info, std::ostream& out);
+
 private:
     /**
      * @brief Форматирует время в читаемый вид
@@ -0,0 +1,226 @@
+#include <cli/ProgressReporter.h>
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace
+{
+    // Счетчиков не меньше, чем рабочих потоков на типичной машине
+    constexpr size_t MIN_SLOTS = 8;
+
+    // Без новых файлов прогресс все равно обновляется раз в секунду (время, ETA)
+    constexpr auto IDLE_REPORT_INTERVAL = std::chrono::seconds(1);
+
+    // Номер рабочего потока, общий для всех экземпляров; счетчик выбирается по модулю
+    std::atomic<size_t> next_thread_index{0};
+
+    size_t currentThreadIndex() noexcept
+    {
+        thread_local const size_t index = next_thread_index.fetch_add(1, std::memory_order_relaxed);
+        return index;
+    }
+
+    int64_t nowTicks() noexcept
+    {
+        return std::chrono::steady_clock::now().time_since_epoch().count();
+    }
+}
+
+/**
+ * @brief Счетчики одного рабочего потока в отдельной кэш-линии
+ */
+struct alignas(64) ProgressReporter::Slot
+{
+    std::atomic<size_t> processed{0};
+    std::atomic<size_t> failed{0};
+    std::atomic<size_t> skipped{0};
+    std::atomic<int64_t> last_record_ticks{0};
+
+    // Блокировку делят только поток счетчика и поток вывода
+    mutable std::mutex file_mutex;
+    std::string last_file;
+};
+
+ProgressReporter::ProgressReporter(ProgressCallback callback, TotalSource total_source)
+    : ProgressReporter(std::move(callback), std::move(total_source), Options{})
+{
+}
+
+ProgressReporter::ProgressReporter(ProgressCallback callback, TotalSource total_source, const Options& options)
+    : callback_(std::move(callback))
+    , total_source_(std::move(total_source))
+    , options_(options)
+    , slot_count_(std::max<size_t>(MIN_SLOTS, 2 * static_cast<size_t>(std::thread::hardware_concurrency())))
+{
+    slots_ = std::make_unique<Slot[]>(slot_count_);
+}
+
+ProgressReporter::~ProgressReporter()
+{
+    stop();
+}
+
+void ProgressReporter::start()
+{
+    start_time_ = std::chrono::steady_clock::now();
+    last_sample_time_ = start_time_;
+    last_report_time_ = start_time_;
+    if (callback_)
+    {
+        thread_ = std::thread(&ProgressReporter::reporterLoop, this);
+    }
+}
+
+void ProgressReporter::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopping_)
+        {
+            return;
+        }
+        stopping_ = true;
+    }
+    stop_requested_.notify_all();
+
+    if (thread_.joinable())
+    {
+        thread_.join();
+        report(std::chrono::steady_clock::now(), true);
+    }
+}
+
+void ProgressReporter::record(Outcome outcome, const std::string& file)
+{
+    Slot& slot = currentSlot();
+    switch (outcome)
+    {
+        case Outcome::Processed:
+            slot.processed.fetch_add(1, std::memory_order_relaxed);
+            break;
+        case Outcome::Failed:
+            slot.failed.fetch_add(1, std::memory_order_relaxed);
+            break;
+        case Outcome::Skipped:
+            slot.skipped.fetch_add(1, std::memory_order_relaxed);
+            break;
+    }
+
+    if (callback_)
+    {
+        {
+            std::lock_guard<std::mutex> lock(slot.file_mutex);
+            slot.last_file = file;
+        }
+        slot.last_record_ticks.store(nowTicks(), std::memory_order_relaxed);
+    }
+}
+
+ProgressReporter::Totals ProgressReporter::getTotals() const noexcept
+{
+    Totals totals;
+    for (size_t i = 0; i < slot_count_; ++i)
+    {
+        totals.processed += slots_[i].processed.load(std::memory_order_relaxed);
+        totals.failed += slots_[i].failed.load(std::memory_order_relaxed);
+        totals.skipped += slots_[i].skipped.load(std::memory_order_relaxed);
+    }
+    return totals;
+}
+
+ProgressReporter::Slot& ProgressReporter::currentSlot() noexcept
+{
+    return slots_[currentThreadIndex() % slot_count_];
+}
+
+void ProgressReporter::reporterLoop()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stop_requested_.wait_for(lock, options_.interval, [this] { return stopping_; }))
+    {
+        lock.unlock();
+        report(std::chrono::steady_clock::now(), false);
+        lock.lock();
+    }
+}
+
+void ProgressReporter::report(std::chrono::steady_clock::time_point now, bool final_report)
+{
+    const Totals totals = getTotals();
+    const size_t completed = totals.completed();
+
+    // Скорость: первая оценка - среднее с начала, далее EWMA по интервалам
+    const double sample_seconds = std::chrono::duration<double>(now - last_sample_time_).count();
+    if (sample_seconds > 0.0)
+    {
+        const double elapsed_seconds = std::chrono::duration<double>(now - start_time_).count();
+        if (!has_rate_)
+        {
+            if (completed > 0 && elapsed_seconds > 0.0)
+            {
+                files_per_second_ = static_cast<double>(completed) / elapsed_seconds;
+                has_rate_ = true;
+            }
+        }
+        else
+        {
+            const double sample = static_cast<double>(completed - last_completed_) / sample_seconds;
+            const double time_constant = std::chrono::duration<double>(options_.time_constant).count();
+            const double alpha = 1.0 - std::exp(-sample_seconds / time_constant);
+            files_per_second_ += alpha * (sample - files_per_second_);
+        }
+        last_sample_time_ = now;
+        last_completed_ = completed;
+    }
+
+    if (completed == 0)
+    {
+        return;
+    }
+    if (!final_report && completed == last_reported_ && now - last_report_time_ < IDLE_REPORT_INTERVAL)
+    {
+        return;
+    }
+    last_reported_ = completed;
+    last_report_time_ = now;
+
+    bool total_estimated = false;
+    const size_t total = std::max(total_source_ ? total_source_(total_estimated) : completed, completed);
+
+    ProgressInfo info;
+    info.current = completed;
+    info.total = total;
+    info.current_file = latestFile();
+    info.percentage = (static_cast<double>(completed) / static_cast<double>(total)) * 100.0;
+    info.elapsed_time = std::chrono::duration_cast<std::chrono::seconds>(now - start_time_);
+    info.files_per_second = files_per_second_;
+    info.estimated_remaining = std::chrono::seconds(0);
+    if (files_per_second_ > 0.0)
+    {
+        info.estimated_remaining = std::chrono::seconds(
+            static_cast<long long>(static_cast<double>(total - completed) / files_per_second_));
+    }
+    info.total_estimated = total_estimated;
+    info.failed_files = totals.failed;
+    info.skipped_files = totals.skipped;
+    callback_(info);
+}
+
+std::string ProgressReporter::latestFile() const
+{
+    const Slot* latest = nullptr;
+    int64_t latest_ticks = 0;
+    for (size_t i = 0; i < slot_count_; ++i)
+    {
+        const int64_t ticks = slots_[i].last_record_ticks.load(std::memory_order_relaxed);
+        if (latest == nullptr || ticks > latest_ticks)
+        {
+            latest = &slots_[i];
+            latest_ticks = ticks;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(latest->file_mutex);
+    return latest->last_file;
+}
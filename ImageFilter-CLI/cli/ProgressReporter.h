@@ -0,0 +1,147 @@
+#pragma once
+
+#include <cli/BatchProcessor.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/**
+ * @brief Сбор прогресса пакетной обработки и его вывод с фиксированной частотой
+ *
+ * Рабочие потоки только отмечают завершенные файлы в собственных счетчиках
+ * (record()), не блокируя друг друга и не вызывая callback. Отдельный поток
+ * раз в интервал суммирует счетчики, оценивает скорость и вызывает callback,
+ * поэтому вывод на терминал не становится общим узким местом при сотнях
+ * маленьких файлов в секунду.
+ *
+ * Скорость - экспоненциальное скользящее среднее (EWMA) с постоянной времени
+ * несколько секунд: оценка оставшегося времени следует за текущим темпом
+ * обработки, а не за средним с начала прогона.
+ *
+ * @note record() и getTotals() thread-safe
+ */
+class ProgressReporter
+{
+public:
+    /**
+     * @brief Итог обработки файла
+     */
+    enum class Outcome
+    {
+        Processed,
+        Failed,
+        Skipped
+    };
+
+    /**
+     * @brief Суммарные счетчики
+     */
+    struct Totals
+    {
+        size_t processed = 0;
+        size_t failed = 0;
+        size_t skipped = 0;
+
+        [[nodiscard]] size_t completed() const noexcept { return processed + failed + skipped; }
+    };
+
+    /**
+     * @brief Параметры вывода
+     */
+    struct Options
+    {
+        std::chrono::milliseconds interval{100};        // Интервал вывода (10 Гц)
+        std::chrono::milliseconds time_constant{5000};  // Постоянная времени EWMA скорости
+    };
+
+    /**
+     * @brief Источник общего количества файлов
+     *
+     * Возвращает известное на текущий момент количество и через параметр
+     * сообщает, является ли оно оценкой (обход директории не завершен).
+     */
+    using TotalSource = std::function<size_t(bool& estimated)>;
+
+    /**
+     * @brief Конструктор с параметрами по умолчанию
+     * @param callback Callback прогресса (nullptr = только подсчет)
+     * @param total_source Источник общего количества файлов
+     */
+    ProgressReporter(ProgressCallback callback, TotalSource total_source);
+
+    /**
+     * @brief Конструктор
+     * @param callback Callback прогресса (nullptr = только подсчет)
+     * @param total_source Источник общего количества файлов
+     * @param options Параметры вывода
+     */
+    ProgressReporter(ProgressCallback callback, TotalSource total_source, const Options& options);
+
+    /**
+     * @brief Останавливает поток вывода (см. stop())
+     */
+    ~ProgressReporter();
+
+    ProgressReporter(const ProgressReporter&) = delete;
+    ProgressReporter& operator=(const ProgressReporter&) = delete;
+
+    /**
+     * @brief Запускает поток вывода и отсчет времени
+     */
+    void start();
+
+    /**
+     * @brief Останавливает поток вывода и выводит итоговый прогресс
+     *
+     * Повторный вызов ничего не делает.
+     */
+    void stop();
+
+    /**
+     * @brief Отмечает завершенный файл
+     * @param outcome Итог обработки
+     * @param file Путь к файлу (показывается как текущий)
+     */
+    void record(Outcome outcome, const std::string& file);
+
+    /**
+     * @brief Суммирует счетчики всех рабочих потоков
+     */
+    [[nodiscard]] Totals getTotals() const noexcept;
+
+private:
+    struct Slot;
+
+    Slot& currentSlot() noexcept;
+    void reporterLoop();
+    void report(std::chrono::steady_clock::time_point now, bool final_report);
+    std::string latestFile() const;
+
+    ProgressCallback callback_;
+    TotalSource total_source_;
+    Options options_;
+
+    std::unique_ptr<Slot[]> slots_;
+    size_t slot_count_;
+
+    std::thread thread_;
+    std::mutex mutex_;
+    std::condition_variable stop_requested_;
+    bool stopping_ = false;
+
+    // Состояние потока вывода
+    std::chrono::steady_clock::time_point start_time_;
+    std::chrono::steady_clock::time_point last_sample_time_;
+    std::chrono::steady_clock::time_point last_report_time_;
+    size_t last_completed_ = 0;
+    size_t last_reported_ = 0;
+    double files_per_second_ = 0.0;
+    bool has_rate_ = false;
+};
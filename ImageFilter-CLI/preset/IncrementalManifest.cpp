@@ -0,0 +1,503 @@
+#include <preset/IncrementalManifest.h>
+#include <utils/FileSystemHelper.h>
+#include <utils/Logger.h>
+#include <utils/MappedFile.h>
+
+#include <array>
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string_view>
+
+namespace
+{
+    // v2: пути экранируются; v1 (без экранирования) читается и переписывается при open()
+    constexpr const char* MANIFEST_HEADER = "# ImageFilter incremental manifest v2";
+    constexpr const char* MANIFEST_HEADER_V1 = "# ImageFilter incremental manifest v1";
+    constexpr uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+    constexpr uint64_t FNV_PRIME = 1099511628211ULL;
+
+    // Дозаписанные строки сбрасываются на диск пачками
+    constexpr size_t SYNC_EVERY = 256;
+    constexpr auto SYNC_INTERVAL = std::chrono::milliseconds(500);
+
+    // Манифест переписывается при открытии, если устаревших строк больше, чем актуальных
+    constexpr size_t COMPACT_MIN_LINES = 4096;
+
+    /**
+     * @brief Экранирует путь для поля манифеста (\\, \t, \n, \r)
+     */
+    std::string escapeField(std::string_view text)
+    {
+        std::string escaped;
+        escaped.reserve(text.size());
+        for (const char c : text)
+        {
+            switch (c)
+            {
+                case '\\':
+                    escaped += "\\\\";
+                    break;
+                case '\t':
+                    escaped += "\\t";
+                    break;
+                case '\n':
+                    escaped += "\\n";
+                    break;
+                case '\r':
+                    escaped += "\\r";
+                    break;
+                default:
+                    escaped += c;
+                    break;
+            }
+        }
+        return escaped;
+    }
+
+    /**
+     * @brief Восстанавливает путь из поля манифеста
+     * @return false при некорректной escape-последовательности
+     */
+    bool unescapeField(std::string_view text, std::string& value)
+    {
+        value.clear();
+        value.reserve(text.size());
+        for (size_t i = 0; i < text.size(); ++i)
+        {
+            if (text[i] != '\\')
+            {
+                value += text[i];
+                continue;
+            }
+            if (++i == text.size())
+            {
+                return false;
+            }
+            switch (text[i])
+            {
+                case '\\':
+                    value += '\\';
+                    break;
+                case 't':
+                    value += '\t';
+                    break;
+                case 'n':
+                    value += '\n';
+                    break;
+                case 'r':
+                    value += '\r';
+                    break;
+                default:
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Разбивает строку по символу табуляции
+     */
+    std::vector<std::string_view> splitFields(std::string_view line)
+    {
+        std::vector<std::string_view> fields;
+        size_t start = 0;
+        while (true)
+        {
+            const size_t end = line.find('\t', start);
+            fields.push_back(line.substr(start, end == std::string_view::npos ? std::string_view::npos : end - start));
+            if (end == std::string_view::npos)
+            {
+                return fields;
+            }
+            start = end + 1;
+        }
+    }
+
+    /**
+     * @brief Разбирает целое число в заданной системе счисления
+     */
+    template<typename T>
+    bool parseNumber(std::string_view text, T& value, int base = 10)
+    {
+        const auto* end = text.data() + text.size();
+        const auto [ptr, ec] = std::from_chars(text.data(), end, value, base);
+        return ec == std::errc() && ptr == end;
+    }
+}
+
+IncrementalManifest::IncrementalManifest(const std::string& settings)
+    : settings_hash_(hashBytes({reinterpret_cast<const uint8_t*>(settings.data()), settings.size()}))
+{
+}
+
+IncrementalManifest::~IncrementalManifest()
+{
+    close();
+}
+
+bool IncrementalManifest::open(const std::string& manifest_file)
+{
+    close();
+
+    LoadState state;
+    if (!load(manifest_file, state))
+    {
+        return false;
+    }
+    manifest_file_ = manifest_file;
+
+    // Оборванную строку нужно убрать до дозаписи, иначе к ней приклеится следующая
+    const bool exists = std::filesystem::exists(manifest_file_);
+    const bool wasted = state.lines >= COMPACT_MIN_LINES && state.lines > 2 * size();
+    if (!exists || !state.current_format || state.torn_tail || wasted)
+    {
+        if (!save(manifest_file_))
+        {
+            return true;
+        }
+    }
+
+    file_ = std::fopen(manifest_file_.c_str(), "ab");
+    if (file_ == nullptr)
+    {
+        Logger::warning("Не удалось открыть манифест для дозаписи: " + manifest_file_);
+        return true;
+    }
+
+    stopping_ = false;
+    writer_ = std::thread(&IncrementalManifest::writerLoop, this);
+    return true;
+}
+
+bool IncrementalManifest::close()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    changed_.notify_one();
+
+    if (writer_.joinable())
+    {
+        writer_.join();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (file_ == nullptr && manifest_file_.empty())
+        {
+            return true;
+        }
+        if (file_ != nullptr)
+        {
+            std::fclose(file_);
+            file_ = nullptr;
+        }
+    }
+
+    // Дописанные строки уже на диске; перезапись убирает дубликаты
+    const std::string manifest_file = std::move(manifest_file_);
+    manifest_file_.clear();
+    return save(manifest_file);
+}
+
+bool IncrementalManifest::load(const std::string& manifest_file)
+{
+    LoadState state;
+    return load(manifest_file, state);
+}
+
+bool IncrementalManifest::load(const std::string& manifest_file, LoadState& state)
+{
+    state = LoadState{};
+    std::ifstream file(manifest_file, std::ios::binary);
+    if (!file.is_open())
+    {
+        return !std::filesystem::exists(manifest_file);
+    }
+    const std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    const size_t header_end = contents.find('\n');
+    const std::string_view header = std::string_view(contents).substr(0, header_end);
+    state.current_format = header == MANIFEST_HEADER;
+    if (!state.current_format && header != MANIFEST_HEADER_V1)
+    {
+        Logger::warning("Неизвестный формат манифеста, все файлы будут обработаны заново: " + manifest_file);
+        std::lock_guard<std::mutex> lock(mutex_);
+        entries_.clear();
+        return true;
+    }
+
+    std::unordered_map<std::string, Entry> entries;
+    std::string output_path;
+    size_t line_start = header_end == std::string::npos ? contents.size() : header_end + 1;
+    while (line_start < contents.size())
+    {
+        const size_t line_end = contents.find('\n', line_start);
+        if (line_end == std::string::npos)
+        {
+            // Последняя строка не дописана: сбой во время записи
+            state.torn_tail = true;
+            break;
+        }
+        const auto fields = splitFields(std::string_view(contents).substr(line_start, line_end - line_start));
+        line_start = line_end + 1;
+        if (fields.size() != 6)
+        {
+            continue;
+        }
+        ++state.lines;
+
+        Entry entry;
+        if (state.current_format)
+        {
+            if (!unescapeField(fields[0], output_path) || !unescapeField(fields[1], entry.input_path))
+            {
+                continue;
+            }
+        }
+        else
+        {
+            output_path = std::string(fields[0]);
+            entry.input_path = std::string(fields[1]);
+        }
+        if (!parseNumber(fields[2], entry.input.size) ||
+            !parseNumber(fields[3], entry.input.mtime) ||
+            !parseNumber(fields[4], entry.input.content_hash, 16) ||
+            !parseNumber(fields[5], entry.settings_hash, 16))
+        {
+            continue;
+        }
+        entries[output_path] = std::move(entry);
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_ = std::move(entries);
+    return true;
+}
+
+bool IncrementalManifest::save(const std::string& manifest_file) const
+{
+    const std::string temp_file = manifest_file + ".tmp";
+    try
+    {
+        const std::filesystem::path path(manifest_file);
+        if (path.has_parent_path())
+        {
+            std::filesystem::create_directories(path.parent_path());
+        }
+
+        std::FILE* file = std::fopen(temp_file.c_str(), "wb");
+        if (file == nullptr)
+        {
+            Logger::warning("Не удалось открыть манифест для записи: " + temp_file);
+            return false;
+        }
+
+        std::fputs(MANIFEST_HEADER, file);
+        std::fputc('\n', file);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (const auto& [output_path, entry] : entries_)
+            {
+                const std::string line = formatEntry(output_path, entry);
+                std::fwrite(line.data(), 1, line.size(), file);
+            }
+        }
+        const bool written = !std::ferror(file) && FileSystemHelper::flushToDisk(file);
+        std::fclose(file);
+        if (!written)
+        {
+            std::filesystem::remove(temp_file);
+            return false;
+        }
+
+        // Старый манифест заменяется только полностью записанным новым
+        std::filesystem::rename(temp_file, manifest_file);
+        FileSystemHelper::syncDirectory(path);
+        return true;
+    }
+    catch (const std::exception& e)
+    {
+        Logger::warning("Ошибка при сохранении манифеста: " + std::string(e.what()));
+        return false;
+    }
+}
+
+bool IncrementalManifest::isUpToDate(const std::string& input_path, const std::string& output_path) const
+{
+    Entry entry;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const auto it = entries_.find(output_path);
+        if (it == entries_.end())
+        {
+            return false;
+        }
+        entry = it->second;
+    }
+
+    if (entry.settings_hash != settings_hash_ || entry.input_path != input_path)
+    {
+        return false;
+    }
+
+    std::error_code ec;
+    if (!std::filesystem::is_regular_file(output_path, ec))
+    {
+        return false;
+    }
+
+    InputSignature current;
+    if (!readSignature(input_path, current, false) || current.size != entry.input.size)
+    {
+        return false;
+    }
+    if (current.mtime == entry.input.mtime)
+    {
+        return true;
+    }
+
+    // Время изменения другое, но содержимое могло остаться прежним
+    return readSignature(input_path, current, true) && current.content_hash == entry.input.content_hash;
+}
+
+bool IncrementalManifest::update(const std::string& input_path, const std::string& output_path)
+{
+    Entry entry;
+    entry.input_path = input_path;
+    entry.settings_hash = settings_hash_;
+    if (!readSignature(input_path, entry.input, true))
+    {
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (file_ != nullptr && !stopping_)
+        {
+            pending_.push_back(formatEntry(output_path, entry));
+        }
+        entries_[output_path] = std::move(entry);
+    }
+    changed_.notify_one();
+    return true;
+}
+
+size_t IncrementalManifest::size() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+uint64_t IncrementalManifest::hashBytes(std::span<const uint8_t> data) noexcept
+{
+    uint64_t hash = FNV_OFFSET_BASIS;
+    for (const uint8_t byte : data)
+    {
+        hash = (hash ^ byte) * FNV_PRIME;
+    }
+    return hash;
+}
+
+std::string IncrementalManifest::formatEntry(const std::string& output_path, const Entry& entry)
+{
+    std::array<char, 24> number{};
+    const auto append_number = [&number](std::string& line, auto value, int base) {
+        const auto [end, ec] = std::to_chars(number.data(), number.data() + number.size(), value, base);
+        line.append(number.data(), ec == std::errc() ? end : number.data());
+    };
+
+    std::string line = escapeField(output_path);
+    line += '\t';
+    line += escapeField(entry.input_path);
+    line += '\t';
+    append_number(line, entry.input.size, 10);
+    line += '\t';
+    append_number(line, entry.input.mtime, 10);
+    line += '\t';
+    append_number(line, entry.input.content_hash, 16);
+    line += '\t';
+    append_number(line, entry.settings_hash, 16);
+    line += '\n';
+    return line;
+}
+
+void IncrementalManifest::writerLoop()
+{
+    std::vector<std::string> batch;
+    size_t unsynced = 0;
+    auto last_sync = std::chrono::steady_clock::now();
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true)
+    {
+        changed_.wait_for(lock, SYNC_INTERVAL, [this] { return stopping_ || !pending_.empty(); });
+        batch.swap(pending_);
+        const bool stop = stopping_;
+        lock.unlock();
+
+        for (const auto& line : batch)
+        {
+            std::fwrite(line.data(), 1, line.size(), file_);
+        }
+        unsynced += batch.size();
+
+        const auto now = std::chrono::steady_clock::now();
+        if (unsynced >= SYNC_EVERY || (unsynced > 0 && (stop || now - last_sync >= SYNC_INTERVAL)))
+        {
+            if (!FileSystemHelper::flushToDisk(file_))
+            {
+                Logger::warning("Не удалось сбросить манифест на диск: " + manifest_file_);
+            }
+            unsynced = 0;
+            last_sync = now;
+        }
+
+        lock.lock();
+        batch.clear();
+        if (stop && pending_.empty())
+        {
+            break;
+        }
+    }
+}
+
+bool IncrementalManifest::readSignature(const std::string& input_path, InputSignature& signature, bool with_hash)
+{
+    std::error_code ec;
+    const auto size = std::filesystem::file_size(input_path, ec);
+    if (ec)
+    {
+        return false;
+    }
+    const auto mtime = std::filesystem::last_write_time(input_path, ec);
+    if (ec)
+    {
+        return false;
+    }
+
+    signature.size = static_cast<uint64_t>(size);
+    signature.mtime = static_cast<int64_t>(mtime.time_since_epoch().count());
+    if (!with_hash)
+    {
+        return true;
+    }
+
+    if (size == 0)
+    {
+        signature.content_hash = hashBytes({});
+        return true;
+    }
+
+    MappedFile file;
+    if (!file.open(input_path).isSuccess())
+    {
+        return false;
+    }
+    file.adviseSequential();
+    signature.content_hash = hashBytes(file.bytes());
+    return true;
+}
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Манифест инкрементальной пакетной обработки
+ *
+ * Для каждого выходного файла хранит входной файл, его размер, время
+ * изменения и хэш содержимого, а также хэш настроек обработки (нормализованная
+ * цепочка фильтров с параметрами и параметры кодирования). Файл пропускается,
+ * только если выход существует и не изменились ни вход, ни настройки:
+ * - совпадают размер и время изменения входа (быстрая проверка без чтения);
+ * - или совпадает размер и хэш содержимого (файл скопирован или "тронут").
+ *
+ * После open() каждая запись update() дописывается в файл манифеста отдельным
+ * потоком записи (как в ResumeJournal), поэтому после сбоя или прерывания
+ * сохраняются записи всех завершенных файлов. Более поздняя строка для того же
+ * выходного файла заменяет раннюю; close() переписывает манифест без дубликатов.
+ *
+ * Пути в файле экранируются (\\, \t, \n, \r), поэтому табуляция и переводы
+ * строк в именах файлов не нарушают формат.
+ *
+ * Методы isUpToDate() и update() можно вызывать из нескольких потоков.
+ */
+class IncrementalManifest
+{
+public:
+    /**
+     * @brief Конструктор
+     * @param settings Нормализованное описание настроек обработки
+     */
+    explicit IncrementalManifest(const std::string& settings);
+
+    /**
+     * @brief Дописывает очередь и останавливает поток записи (см. close())
+     */
+    ~IncrementalManifest();
+
+    IncrementalManifest(const IncrementalManifest&) = delete;
+    IncrementalManifest& operator=(const IncrementalManifest&) = delete;
+
+    /**
+     * @brief Загружает манифест и открывает его для дозаписи
+     * @param manifest_file Путь к файлу манифеста (создается при необходимости)
+     * @return false если существующий манифест не удалось прочитать
+     *
+     * Манифест предварительно переписывается, если он в старом формате,
+     * оборван на середине строки или содержит много устаревших строк.
+     * Если файл не удалось открыть для записи, записи хранятся только в
+     * памяти до close().
+     */
+    bool open(const std::string& manifest_file);
+
+    /**
+     * @brief Дописывает очередь, останавливает поток записи и переписывает манифест
+     * @return true если манифест сохранен (или не был открыт)
+     */
+    bool close();
+
+    /**
+     * @brief Загружает манифест из файла
+     * @param manifest_file Путь к файлу манифеста
+     * @return true если файл прочитан или отсутствует (первый запуск)
+     *
+     * Строки неизвестной версии или поврежденные строки пропускаются:
+     * соответствующие файлы будут обработаны заново.
+     */
+    bool load(const std::string& manifest_file);
+
+    /**
+     * @brief Сохраняет манифест в файл (через временный файл и переименование)
+     * @param manifest_file Путь к файлу манифеста
+     * @return true если сохранение успешно
+     */
+    bool save(const std::string& manifest_file) const;
+
+    /**
+     * @brief Проверяет, что выход актуален для текущих входа и настроек
+     * @param input_path Путь к входному файлу
+     * @param output_path Путь к выходному файлу
+     * @return true если обработку можно пропустить
+     */
+    [[nodiscard]] bool isUpToDate(const std::string& input_path, const std::string& output_path) const;
+
+    /**
+     * @brief Запоминает успешно обработанный файл
+     * @param input_path Путь к входному файлу
+     * @param output_path Путь к выходному файлу
+     * @return true если вход удалось прочитать и запись добавлена
+     *
+     * После open() запись также ставится в очередь потока записи; вызывающий
+     * поток не выполняет запись в файл манифеста.
+     */
+    bool update(const std::string& input_path, const std::string& output_path);
+
+    /**
+     * @brief Количество записей манифеста
+     */
+    [[nodiscard]] size_t size() const;
+
+    /**
+     * @brief Хэш содержимого (64-битный FNV-1a)
+     * @param data Данные
+     * @return Хэш
+     */
+    static uint64_t hashBytes(std::span<const uint8_t> data) noexcept;
+
+private:
+    /**
+     * @brief Признаки входного файла
+     */
+    struct InputSignature
+    {
+        uint64_t size = 0;
+        int64_t mtime = 0;            // Время изменения в единицах file_time_type
+        uint64_t content_hash = 0;
+    };
+
+    /**
+     * @brief Запись манифеста для одного выходного файла
+     */
+    struct Entry
+    {
+        std::string input_path;
+        InputSignature input;
+        uint64_t settings_hash = 0;
+    };
+
+    /**
+     * @brief Сведения о прочитанном файле манифеста
+     */
+    struct LoadState
+    {
+        bool current_format = false;  // Заголовок текущей версии
+        bool torn_tail = false;       // Последняя строка оборвана
+        size_t lines = 0;             // Строк-записей в файле (с дубликатами)
+    };
+
+    static bool readSignature(const std::string& input_path, InputSignature& signature, bool with_hash);
+    static std::string formatEntry(const std::string& output_path, const Entry& entry);
+    bool load(const std::string& manifest_file, LoadState& state);
+    void writerLoop();
+
+    uint64_t settings_hash_;
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, Entry> entries_;  // Ключ - путь к выходному файлу
+
+    // Дозапись манифеста (после open())
+    std::string manifest_file_;
+    std::FILE* file_ = nullptr;
+    std::thread writer_;
+    std::condition_variable changed_;
+    std::vector<std::string> pending_;
+    bool stopping_ = false;
+};
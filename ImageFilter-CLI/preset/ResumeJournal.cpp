@@ -0,0 +1,300 @@
+#include <preset/ResumeJournal.h>
+#include <utils/FileSystemHelper.h>
+#include <utils/Logger.h>
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+namespace
+{
+    /**
+     * @brief Убирает пробелы в начале и конце строки
+     */
+    std::string trim(const std::string& str)
+    {
+        const size_t start = str.find_first_not_of(" \t\r");
+        if (start == std::string::npos)
+        {
+            return "";
+        }
+        const size_t end = str.find_last_not_of(" \t\r");
+        return str.substr(start, end - start + 1);
+    }
+}
+
+ResumeJournal::~ResumeJournal()
+{
+    close();
+}
+
+bool ResumeJournal::open(const std::string& journal_file)
+{
+    return open(journal_file, Options{});
+}
+
+bool ResumeJournal::open(const std::string& journal_file, const Options& options)
+{
+    close();
+
+    journal_file_ = journal_file;
+    options_ = options;
+    statistics_ = Statistics{};
+
+    size_t total_lines = 0;
+    bool torn_tail = false;
+    loaded_ = load(journal_file_, &total_lines, &torn_tail);
+    statistics_.loaded_records = loaded_.size();
+    records_ = loaded_;
+    file_lines_ = total_lines;
+
+    try
+    {
+        const std::filesystem::path path(journal_file_);
+        if (path.has_parent_path())
+        {
+            std::filesystem::create_directories(path.parent_path());
+        }
+    }
+    catch (const std::filesystem::filesystem_error& e)
+    {
+        Logger::warning("Не удалось создать директорию журнала возобновления: " + std::string(e.what()));
+        return false;
+    }
+
+    // Оборванную запись нужно убрать до дозаписи, иначе к ней приклеится следующая
+    if (torn_tail || needsCompaction())
+    {
+        statistics_.compacted = compact(records_);
+    }
+
+    file_ = std::fopen(journal_file_.c_str(), "ab");
+    if (file_ == nullptr)
+    {
+        Logger::warning("Не удалось открыть журнал возобновления для записи: " + journal_file_);
+        return false;
+    }
+    if (torn_tail && !statistics_.compacted)
+    {
+        std::fputc('\n', file_);
+    }
+
+    stopping_ = false;
+    writer_ = std::thread(&ResumeJournal::writerLoop, this);
+    return true;
+}
+
+bool ResumeJournal::contains(const std::string& output_path) const
+{
+    return loaded_.find(output_path) != loaded_.end();
+}
+
+void ResumeJournal::record(const std::string& output_path)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (file_ == nullptr || stopping_)
+        {
+            return;
+        }
+        pending_.push_back(output_path);
+    }
+    changed_.notify_one();
+}
+
+void ResumeJournal::close()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    changed_.notify_one();
+
+    if (writer_.joinable())
+    {
+        writer_.join();
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (file_ != nullptr)
+    {
+        std::fclose(file_);
+        file_ = nullptr;
+    }
+    records_.clear();
+    file_lines_ = 0;
+}
+
+ResumeJournal::Statistics ResumeJournal::getStatistics() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return statistics_;
+}
+
+std::unordered_set<std::string> ResumeJournal::load(const std::string& journal_file,
+                                                    size_t* total_lines,
+                                                    bool* torn_tail)
+{
+    std::unordered_set<std::string> records;
+    size_t lines = 0;
+    bool torn = false;
+
+    try
+    {
+        std::ifstream file(journal_file, std::ios::binary);
+        if (file.is_open())
+        {
+            const std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+            size_t line_start = 0;
+            while (line_start < contents.size())
+            {
+                const size_t line_end = contents.find('\n', line_start);
+                if (line_end == std::string::npos)
+                {
+                    // Последняя запись не дописана: сбой во время записи
+                    torn = true;
+                    break;
+                }
+
+                const std::string line = trim(contents.substr(line_start, line_end - line_start));
+                if (!line.empty() && line[0] != '#')  // Игнорируем пустые строки и комментарии
+                {
+                    records.insert(line);
+                    ++lines;
+                }
+                line_start = line_end + 1;
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        Logger::warning("Ошибка при загрузке журнала возобновления: " + std::string(e.what()));
+    }
+
+    if (total_lines != nullptr)
+    {
+        *total_lines = lines;
+    }
+    if (torn_tail != nullptr)
+    {
+        *torn_tail = torn;
+    }
+    return records;
+}
+
+void ResumeJournal::writerLoop()
+{
+    std::vector<std::string> batch;
+    size_t unsynced = 0;
+    auto last_sync = std::chrono::steady_clock::now();
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true)
+    {
+        changed_.wait_for(lock, options_.sync_interval, [this] { return stopping_ || !pending_.empty(); });
+        batch.swap(pending_);
+        const bool stop = stopping_;
+        lock.unlock();
+
+        for (const auto& output_path : batch)
+        {
+            std::fputs(output_path.c_str(), file_);
+            std::fputc('\n', file_);
+            records_.insert(output_path);
+        }
+        unsynced += batch.size();
+        file_lines_ += batch.size();
+
+        const auto now = std::chrono::steady_clock::now();
+        const bool sync_due = unsynced >= options_.sync_every ||
+                              (unsynced > 0 && (stop || now - last_sync >= options_.sync_interval));
+        bool synced = false;
+        if (sync_due)
+        {
+            if (!FileSystemHelper::flushToDisk(file_))
+            {
+                Logger::warning("Не удалось сбросить журнал возобновления на диск: " + journal_file_);
+            }
+            synced = true;
+            unsynced = 0;
+            last_sync = now;
+        }
+
+        // Повторные записи одного файла (например, при перезапуске пакета в том же
+        // процессе) раздувают журнал: сжимаем его, не дожидаясь следующего open()
+        bool compacted = false;
+        if (needsCompaction())
+        {
+            std::fclose(file_);
+            compacted = compact(records_);
+            std::FILE* reopened = std::fopen(journal_file_.c_str(), "ab");
+            if (reopened == nullptr)
+            {
+                Logger::warning("Не удалось заново открыть журнал возобновления: " + journal_file_);
+            }
+            lock.lock();
+            file_ = reopened;
+            lock.unlock();
+            unsynced = 0;
+        }
+
+        lock.lock();
+        statistics_.written_records += batch.size();
+        statistics_.syncs += synced ? 1 : 0;
+        statistics_.compactions += compacted ? 1 : 0;
+        batch.clear();
+        if ((stop && pending_.empty()) || file_ == nullptr)
+        {
+            break;
+        }
+    }
+}
+
+bool ResumeJournal::needsCompaction() const noexcept
+{
+    return file_lines_ >= options_.compact_min_records && file_lines_ > 2 * records_.size();
+}
+
+bool ResumeJournal::compact(const std::unordered_set<std::string>& records)
+{
+    const std::string temp_file = journal_file_ + ".tmp";
+    std::FILE* file = std::fopen(temp_file.c_str(), "wb");
+    if (file == nullptr)
+    {
+        Logger::warning("Не удалось сжать журнал возобновления: " + journal_file_);
+        return false;
+    }
+
+    std::fputs("# Журнал возобновления пакетной обработки\n", file);
+    std::fputs("# Каждая строка содержит путь к обработанному файлу\n", file);
+    for (const auto& output_path : records)
+    {
+        std::fputs(output_path.c_str(), file);
+        std::fputc('\n', file);
+    }
+
+    const bool written = !std::ferror(file) && FileSystemHelper::flushToDisk(file);
+    std::fclose(file);
+
+    try
+    {
+        if (written)
+        {
+            // Замена атомарна: после сбоя остается либо старый, либо сжатый журнал
+            std::filesystem::rename(temp_file, journal_file_);
+            if (!FileSystemHelper::syncDirectory(journal_file_))
+            {
+                Logger::warning("Не удалось сбросить на диск директорию журнала возобновления: " + journal_file_);
+            }
+            file_lines_ = records.size();
+            return true;
+        }
+        std::filesystem::remove(temp_file);
+    }
+    catch (const std::filesystem::filesystem_error& e)
+    {
+        Logger::warning("Не удалось заменить журнал возобновления: " + std::string(e.what()));
+    }
+    return false;
+}
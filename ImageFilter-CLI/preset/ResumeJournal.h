@@ -0,0 +1,143 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * @brief Журнал возобновления пакетной обработки (только дозапись)
+ *
+ * Каждый завершенный файл добавляет в журнал одну строку с путем к выходному
+ * файлу. Формат совместим с файлом состояния ResumeStateManager: строки,
+ * начинающиеся с '#', считаются комментариями.
+ *
+ * - Рабочие потоки только ставят запись в очередь (record()), запись в файл
+ *   и fsync выполняет отдельный поток журнала пачками.
+ * - Строка без завершающего перевода строки (оборванная при сбое запись)
+ *   при загрузке отбрасывается.
+ * - Журнал сжимается (дубликаты, комментарии и оборванная запись удаляются),
+ *   если в нем накопилось много лишних строк: при открытии и потоком журнала
+ *   во время записи. Сжатие пишет временный файл и атомарно заменяет им
+ *   журнал, после чего сбрасывает на диск директорию журнала.
+ */
+class ResumeJournal
+{
+public:
+    /**
+     * @brief Параметры записи журнала
+     */
+    struct Options
+    {
+        size_t sync_every = 256;                        // fsync после стольких записей...
+        std::chrono::milliseconds sync_interval{500};   // ...или по прошествии этого времени
+        size_t compact_min_records = 4096;              // Сжатие не раньше этого числа строк в файле
+    };
+
+    /**
+     * @brief Статистика записи журнала
+     */
+    struct Statistics
+    {
+        size_t loaded_records = 0;     // Уникальных записей загружено при открытии
+        size_t written_records = 0;    // Записей добавлено в этом сеансе
+        size_t syncs = 0;              // Выполнено fsync
+        bool compacted = false;        // Журнал был сжат при открытии
+        size_t compactions = 0;        // Сжатий потоком журнала во время записи
+    };
+
+    ResumeJournal() = default;
+    ~ResumeJournal();
+
+    ResumeJournal(const ResumeJournal&) = delete;
+    ResumeJournal& operator=(const ResumeJournal&) = delete;
+
+    /**
+     * @brief Загружает журнал и запускает поток записи
+     * @param journal_file Путь к файлу журнала (создается при необходимости)
+     * @return true если журнал открыт для записи
+     *
+     * Если файл не удалось открыть для записи, загруженные записи все равно
+     * доступны через contains(), а record() ничего не делает.
+     */
+    bool open(const std::string& journal_file);
+
+    /**
+     * @brief Загружает журнал и запускает поток записи
+     * @param journal_file Путь к файлу журнала (создается при необходимости)
+     * @param options Параметры записи
+     * @return true если журнал открыт для записи
+     */
+    bool open(const std::string& journal_file, const Options& options);
+
+    /**
+     * @brief Проверяет, записан ли файл в журнал на момент открытия
+     * @param output_path Путь к выходному файлу
+     * @return true если файл уже обработан в предыдущем сеансе
+     *
+     * Множество загруженных записей не изменяется до close(), поэтому метод
+     * можно вызывать из любых потоков без блокировки.
+     */
+    [[nodiscard]] bool contains(const std::string& output_path) const;
+
+    /**
+     * @brief Количество уникальных записей, загруженных при открытии
+     */
+    [[nodiscard]] size_t getLoadedCount() const noexcept { return loaded_.size(); }
+
+    /**
+     * @brief Ставит запись об обработанном файле в очередь потока журнала
+     * @param output_path Путь к выходному файлу
+     *
+     * Не выполняет ввод-вывод: вызывающий поток только добавляет строку в очередь.
+     */
+    void record(const std::string& output_path);
+
+    /**
+     * @brief Дописывает очередь, выполняет fsync и останавливает поток журнала
+     */
+    void close();
+
+    /**
+     * @brief Статистика журнала (полная после close())
+     */
+    [[nodiscard]] Statistics getStatistics() const;
+
+    /**
+     * @brief Загружает записи журнала без открытия для записи
+     * @param journal_file Путь к файлу журнала
+     * @param total_lines Если не nullptr, получает число строк-записей в файле (с дубликатами)
+     * @param torn_tail Если не nullptr, получает признак оборванной последней записи
+     * @return Множество путей к обработанным файлам
+     */
+    static std::unordered_set<std::string> load(const std::string& journal_file,
+                                                size_t* total_lines = nullptr,
+                                                bool* torn_tail = nullptr);
+
+private:
+    void writerLoop();
+    [[nodiscard]] bool needsCompaction() const noexcept;
+    bool compact(const std::unordered_set<std::string>& records);
+
+    std::string journal_file_;
+    Options options_;
+    std::unordered_set<std::string> loaded_;
+
+    std::FILE* file_ = nullptr;
+    std::thread writer_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable changed_;
+    std::vector<std::string> pending_;
+    bool stopping_ = false;
+    Statistics statistics_;
+
+    // Состояние файла журнала; после open() изменяется только потоком журнала
+    std::unordered_set<std::string> records_;  // Уникальные записи файла
+    size_t file_lines_ = 0;                    // Строк-записей в файле (с дубликатами)
+};
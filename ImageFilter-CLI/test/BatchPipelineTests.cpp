@@ -0,0 +1,239 @@
+/**
+ * @file BatchPipelineTests.cpp
+ * @brief Юнит-тесты конвейерной пакетной обработки BatchPipeline.
+ *
+ * Стадии заменены простыми функциями, поэтому проверяется только сам конвейер:
+ * прохождение заданий через стадии, пропуск стадий после ошибки, ограничение
+ * памяти в обработке (в том числе резерв оценки до декодирования) и статистика
+ * BatchProcessor::processAllPipelined.
+ */
+
+#include <gtest/gtest.h>
+
+#include <TestSupport.h>
+
+#include <cli/BatchPipeline.h>
+#include <cli/BatchProcessor.h>
+#include <ImageProcessor.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    using TestSupport::makeTempDirectory;
+    using TestSupport::writeFile;
+
+    constexpr int IMAGE_SIZE = 16;
+    constexpr size_t IMAGE_BYTES = static_cast<size_t>(IMAGE_SIZE) * IMAGE_SIZE * 3;
+
+    /**
+     * @brief Стадии-заглушки: декодирование создает серое изображение,
+     * если файл не начинается с "bad", кодирование пишет пустой файл
+     */
+    BatchPipeline::Stages makeStages()
+    {
+        BatchPipeline::Stages stages;
+        stages.decode = [](std::span<const uint8_t> data, ImageProcessor& image) -> FilterResult {
+            if (data.size() >= 3 && std::equal(data.begin(), data.begin() + 3, "bad"))
+            {
+                return FilterResult::failure(FilterError::CorruptedImage, "Поврежденные данные");
+            }
+            const std::vector<uint8_t> pixels(IMAGE_BYTES, 128);
+            return image.resize(IMAGE_SIZE, IMAGE_SIZE, 3, pixels.data());
+        };
+        stages.process = [](ImageProcessor& image) -> FilterResult {
+            image.getData()[0] = 255;
+            return FilterResult::success();
+        };
+        stages.encode = [](const ImageProcessor& image, const std::string& output_path) -> FilterResult {
+            std::ofstream file(output_path, std::ios::binary);
+            file << static_cast<int>(image.getData()[0]);
+            return FilterResult::success();
+        };
+        return stages;
+    }
+}
+
+TEST(BatchPipelineTests, RunsEveryJobThroughAllStages)
+{
+    const auto directory = makeTempDirectory("imagefilter_pipeline_all");
+    std::vector<BatchPipeline::Job> jobs;
+    for (int i = 0; i < 6; ++i)
+    {
+        const auto input = directory / ("in" + std::to_string(i) + ".png");
+        writeFile(input, "image" + std::to_string(i));
+        jobs.push_back({input.string(), (directory / ("out" + std::to_string(i) + ".png")).string()});
+    }
+
+    BatchPipeline::Config config;
+    config.decode_workers = 2;
+    config.process_workers = 2;
+    config.encode_workers = 2;
+    config.queue_capacity = 1;
+    const BatchPipeline pipeline(makeStages(), config);
+
+    std::mutex mutex;
+    size_t succeeded = 0;
+    const auto statistics = pipeline.run(jobs, [&](const BatchPipeline::Job&, const FilterResult& result) {
+        std::lock_guard<std::mutex> lock(mutex);
+        succeeded += result.isSuccess() ? 1 : 0;
+    });
+
+    EXPECT_EQ(succeeded, jobs.size());
+    ASSERT_EQ(statistics.stages.size(), 4u);
+    for (const auto& stage : statistics.stages)
+    {
+        EXPECT_EQ(stage.items, jobs.size()) << stage.name;
+        EXPECT_GE(stage.utilisation, 0.0) << stage.name;
+        EXPECT_LE(stage.utilisation, 1.0) << stage.name;
+    }
+    for (const auto& job : jobs)
+    {
+        EXPECT_TRUE(std::filesystem::exists(job.output_path));
+    }
+    std::filesystem::remove_all(directory);
+}
+
+TEST(BatchPipelineTests, FailedJobsSkipLaterStages)
+{
+    const auto directory = makeTempDirectory("imagefilter_pipeline_fail");
+    writeFile(directory / "good.png", "good");
+    writeFile(directory / "bad.png", "bad data");
+    const std::vector<BatchPipeline::Job> jobs = {
+        {(directory / "good.png").string(), (directory / "good_out.png").string()},
+        {(directory / "bad.png").string(), (directory / "bad_out.png").string()},
+        {(directory / "missing.png").string(), (directory / "missing_out.png").string()},
+    };
+
+    const BatchPipeline pipeline(makeStages());
+    std::mutex mutex;
+    std::vector<FilterError> errors;
+    const auto statistics = pipeline.run(jobs, [&](const BatchPipeline::Job&, const FilterResult& result) {
+        std::lock_guard<std::mutex> lock(mutex);
+        errors.push_back(result.error);
+    });
+
+    ASSERT_EQ(errors.size(), 3u);
+    EXPECT_EQ(std::count(errors.begin(), errors.end(), FilterError::Success), 1);
+    EXPECT_EQ(std::count(errors.begin(), errors.end(), FilterError::CorruptedImage), 1);
+    EXPECT_EQ(std::count(errors.begin(), errors.end(), FilterError::FileReadError), 1);
+    EXPECT_EQ(statistics.stages[1].items, 2u);
+    EXPECT_EQ(statistics.stages[2].items, 1u);
+    EXPECT_EQ(statistics.stages[3].items, 1u);
+    EXPECT_FALSE(std::filesystem::exists(directory / "bad_out.png"));
+    std::filesystem::remove_all(directory);
+}
+
+TEST(BatchPipelineTests, MemoryBudgetLimitsImagesInFlight)
+{
+    const auto directory = makeTempDirectory("imagefilter_pipeline_budget");
+    std::vector<BatchPipeline::Job> jobs;
+    for (int i = 0; i < 4; ++i)
+    {
+        const auto input = directory / ("in" + std::to_string(i) + ".png");
+        writeFile(input, "image");
+        jobs.push_back({input.string(), (directory / ("out" + std::to_string(i) + ".png")).string()});
+    }
+
+    auto stages = makeStages();
+    std::atomic<int> in_filter{0};
+    std::atomic<int> max_in_filter{0};
+    stages.process = [&](ImageProcessor&) -> FilterResult {
+        const int current = ++in_filter;
+        max_in_filter = std::max(max_in_filter.load(), current);
+        --in_filter;
+        return FilterResult::success();
+    };
+
+    // Бюджет меньше одного изображения: в обработке всегда не больше одного задания
+    BatchPipeline::Config config;
+    config.process_workers = 2;
+    config.memory_budget_bytes = 1;
+    const BatchPipeline pipeline(stages, config);
+    const auto statistics = pipeline.run(jobs);
+
+    EXPECT_EQ(statistics.stages[3].items, jobs.size());
+    EXPECT_EQ(statistics.peak_in_flight_bytes, IMAGE_BYTES);
+    EXPECT_EQ(max_in_filter.load(), 1);
+    std::filesystem::remove_all(directory);
+}
+
+TEST(BatchPipelineTests, EstimateIsReservedBeforeDecoding)
+{
+    const auto directory = makeTempDirectory("imagefilter_pipeline_estimate");
+    std::vector<BatchPipeline::Job> jobs;
+    for (int i = 0; i < 6; ++i)
+    {
+        const auto input = directory / ("in" + std::to_string(i) + ".png");
+        writeFile(input, "image");
+        jobs.push_back({input.string(), (directory / ("out" + std::to_string(i) + ".png")).string()});
+    }
+
+    // Оценка по заголовку намного больше файла: в бюджет помещается одно изображение
+    constexpr size_t ESTIMATED_BYTES = IMAGE_BYTES * 4;
+    auto stages = makeStages();
+    const auto decode = stages.decode;
+    std::atomic<int> in_decode{0};
+    std::atomic<int> max_in_decode{0};
+    stages.decode = [&](std::span<const uint8_t> data, ImageProcessor& image) -> FilterResult {
+        const int current = ++in_decode;
+        int expected = max_in_decode.load();
+        while (current > expected && !max_in_decode.compare_exchange_weak(expected, current))
+        {
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        --in_decode;
+        return decode(data, image);
+    };
+    stages.estimate_bytes = [](std::span<const uint8_t>) { return ESTIMATED_BYTES; };
+
+    BatchPipeline::Config config;
+    config.decode_workers = 4;
+    config.queue_capacity = 4;
+    config.memory_budget_bytes = ESTIMATED_BYTES + ESTIMATED_BYTES / 2;
+    const BatchPipeline pipeline(stages, config);
+    const auto statistics = pipeline.run(jobs);
+
+    EXPECT_EQ(statistics.stages[3].items, jobs.size());
+    EXPECT_EQ(max_in_decode.load(), 1);
+    EXPECT_EQ(statistics.peak_in_flight_bytes, ESTIMATED_BYTES);
+    EXPECT_GT(statistics.budget_waits, 0u);
+    std::filesystem::remove_all(directory);
+}
+
+TEST(BatchPipelineTests, BatchProcessorCountsPipelinedResults)
+{
+    const auto input_directory = makeTempDirectory("imagefilter_pipeline_batch_in");
+    const auto output_directory = makeTempDirectory("imagefilter_pipeline_batch_out");
+    writeFile(input_directory / "a.png", "a");
+    writeFile(input_directory / "b.png", "bad");
+    writeFile(input_directory / "c.png", "c");
+    writeFile(output_directory / "c.png", "уже обработан");
+
+    const BatchProcessor processor(input_directory.string(), output_directory.string());
+    ProgressInfo last_progress{};
+    BatchPipeline::Statistics pipeline_statistics;
+    const auto stats = processor.processAllPipelined(
+        makeStages(), {}, [&](const ProgressInfo& info) { last_progress = info; }, "", &pipeline_statistics);
+
+    EXPECT_EQ(stats.total_files, 3u);
+    EXPECT_EQ(stats.processed_files, 1u);
+    EXPECT_EQ(stats.failed_files, 1u);
+    EXPECT_EQ(stats.skipped_files, 1u);
+    // Прогресс выводится с фиксированной частотой; итоговый вывод - после всех файлов
+    EXPECT_EQ(last_progress.current, 3u);
+    EXPECT_EQ(last_progress.total, 3u);
+    EXPECT_FALSE(last_progress.total_estimated);
+    EXPECT_EQ(pipeline_statistics.stages[0].items, 2u);
+    EXPECT_TRUE(std::filesystem::exists(output_directory / "a.png"));
+    std::filesystem::remove_all(input_directory);
+    std::filesystem::remove_all(output_directory);
+}
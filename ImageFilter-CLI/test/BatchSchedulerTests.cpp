@@ -0,0 +1,134 @@
+/**
+ * @file BatchSchedulerTests.cpp
+ * @brief Юнит-тесты планировщика пакетной обработки BatchScheduler и модели стоимости CostModel.
+ *
+ * Проверяется выдача самых больших по заголовку файлов первыми, порядок
+ * обхода без чтения заголовков и уточнение модели стоимости по фактическому
+ * времени обработки.
+ */
+
+#include <gtest/gtest.h>
+
+#include <TestSupport.h>
+
+#include <cli/BatchProcessor.h>
+#include <cli/BatchScheduler.h>
+#include <cli/CostModel.h>
+#include <filters/IFilter.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    using TestSupport::makeTempDirectory;
+    using TestSupport::writeBytes;
+    using TestSupport::writeImageHeader;
+    using TestSupport::StubFilter;
+}
+
+TEST(BatchSchedulerTest, LargestFirstOrdersDiscoveredFilesByPixels)
+{
+    const auto directory = makeTempDirectory("imagefilter_scheduler_order");
+    writeImageHeader(directory / "small.png", 10, 10);
+    writeImageHeader(directory / "huge.png", 20000, 10000);
+    writeImageHeader(directory / "medium.png", 800, 600);
+
+    DirectoryScanner scanner(directory.string());
+    ASSERT_TRUE(scanner.start().isSuccess());
+    while (!scanner.isComplete())
+    {
+        std::this_thread::yield();
+    }
+
+    const CostModel cost_model;
+    BatchScheduler scheduler(scanner, SchedulingPolicy::LargestFirst, cost_model);
+    std::vector<std::string> order;
+    ScheduledFile file;
+    while (scheduler.next(file))
+    {
+        order.push_back(file.path.filename().string());
+        EXPECT_EQ(file.pixels, static_cast<uint64_t>(file.width) * static_cast<uint64_t>(file.height));
+        EXPECT_GT(file.estimated_seconds, 0.0);
+    }
+    EXPECT_EQ(order, (std::vector<std::string>{"huge.png", "medium.png", "small.png"}));
+    std::filesystem::remove_all(directory);
+}
+
+TEST(BatchSchedulerTest, DiscoveryOrderSkipsProbing)
+{
+    const auto directory = makeTempDirectory("imagefilter_scheduler_discovery");
+    writeImageHeader(directory / "a.png", 100, 100);
+    writeImageHeader(directory / "b.png", 200, 200);
+
+    DirectoryScanner scanner(directory.string());
+    ASSERT_TRUE(scanner.start().isSuccess());
+    const CostModel cost_model;
+    BatchScheduler scheduler(scanner, SchedulingPolicy::DiscoveryOrder, cost_model);
+
+    size_t count = 0;
+    ScheduledFile file;
+    while (scheduler.next(file))
+    {
+        ++count;
+        EXPECT_EQ(file.pixels, 0u);
+        EXPECT_EQ(file.estimated_seconds, 0.0);
+    }
+    EXPECT_EQ(count, 2u);
+    std::filesystem::remove_all(directory);
+}
+
+TEST(CostModelTest, FiltersAndMeasurementsShapeEstimate)
+{
+    StubFilter pointwise(0);
+    StubFilter neighbourhood(5);
+    const CostModel codec_only;
+    const CostModel light({&pointwise});
+    CostModel heavy({&pointwise, &neighbourhood});
+
+    const uint64_t pixels = 10'000'000;
+    EXPECT_LT(codec_only.estimateSeconds(pixels), light.estimateSeconds(pixels));
+    EXPECT_LT(light.estimateSeconds(pixels), heavy.estimateSeconds(pixels));
+
+    // Фактическое время вдвое больше оценки - последующие оценки удваиваются
+    const double estimate = heavy.estimateSeconds(pixels);
+    heavy.record(pixels, estimate, estimate * 2.0);
+    EXPECT_NEAR(heavy.estimateSeconds(pixels), estimate * 2.0, estimate * 1e-6);
+
+    const auto statistics = heavy.getStatistics();
+    EXPECT_EQ(statistics.files, 1u);
+    EXPECT_DOUBLE_EQ(statistics.estimated_seconds, estimate);
+    EXPECT_DOUBLE_EQ(statistics.actual_seconds, estimate * 2.0);
+    EXPECT_NEAR(statistics.correction, 2.0, 1e-9);
+}
+
+TEST(BatchSchedulerTest, BatchProcessorRecordsActualCost)
+{
+    const auto input_directory = makeTempDirectory("imagefilter_scheduler_batch_in");
+    const auto output_directory = makeTempDirectory("imagefilter_scheduler_batch_out");
+    writeImageHeader(input_directory / "a.png", 4000, 3000);
+    writeImageHeader(input_directory / "b.png", 300, 200);
+    writeImageHeader(input_directory / "c.png", 1000, 1000);
+
+    CostModel cost_model;
+    BatchProcessor processor(input_directory.string(), output_directory.string());
+    processor.setScheduling(SchedulingPolicy::LargestFirst, &cost_model);
+
+    const auto stats = processor.processAll([](const std::string&, const std::string& output_path) {
+        writeBytes(output_path, {1});
+        return FilterResult::success();
+    });
+    EXPECT_EQ(stats.total_files, 3u);
+    EXPECT_EQ(stats.processed_files, 3u);
+
+    const auto statistics = cost_model.getStatistics();
+    EXPECT_EQ(statistics.files, 3u);
+    EXPECT_GT(statistics.estimated_seconds, 0.0);
+
+    std::filesystem::remove_all(input_directory);
+    std::filesystem::remove_all(output_directory);
+}
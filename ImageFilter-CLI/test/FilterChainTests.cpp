@@ -0,0 +1,120 @@
+/**
+ * @file FilterChainTests.cpp
+ * @brief Юнит-тесты цепочек фильтров FilterChain и WorkerFilterChains.
+ *
+ * Проверяется создание цепочки по именам фильтров, применение к изображению
+ * и то, что в пакетном режиме каждый рабочий поток один раз получает
+ * собственную цепочку и пул буферов.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cli/FilterChain.h>
+#include <cli/FilterFactory.h>
+#include <ImageProcessor.h>
+#include <CLI/CLI.hpp>
+
+#include <thread>
+#include <vector>
+
+namespace
+{
+    constexpr int IMAGE_SIZE = 32;
+
+    ImageProcessor makeImage(uint8_t value)
+    {
+        ImageProcessor image;
+        const std::vector<uint8_t> pixels(static_cast<size_t>(IMAGE_SIZE) * IMAGE_SIZE * 3, value);
+        EXPECT_TRUE(image.resize(IMAGE_SIZE, IMAGE_SIZE, 3, pixels.data()).isSuccess());
+        return image;
+    }
+}
+
+TEST(FilterChainTest, BuildRejectsUnknownFilter)
+{
+    FilterFactory::getInstance().registerAll();
+    CLI::App app("test-app");
+
+    FilterChain chain;
+    const auto result = FilterChain::build({"invert", "no_such_filter"}, app, nullptr, chain);
+
+    EXPECT_FALSE(result.isSuccess());
+    EXPECT_EQ(result.error, FilterError::InvalidParameter);
+    EXPECT_TRUE(chain.empty());
+}
+
+TEST(FilterChainTest, AppliesFiltersInOrder)
+{
+    FilterFactory::getInstance().registerAll();
+    CLI::App app("test-app");
+
+    FilterChain chain;
+    ASSERT_TRUE(FilterChain::build({"invert"}, app, nullptr, chain).isSuccess());
+    ASSERT_EQ(chain.size(), 1u);
+
+    // Одна цепочка применяется к нескольким изображениям
+    for (const uint8_t value : {10, 200})
+    {
+        auto image = makeImage(value);
+        ASSERT_TRUE(chain.apply(image).isSuccess());
+        EXPECT_EQ(image.getData()[0], 255 - value);
+    }
+}
+
+TEST(FilterChainTest, WorkerChainIsBuiltOncePerThread)
+{
+    FilterFactory::getInstance().registerAll();
+    CLI::App app("test-app");
+    WorkerFilterChains worker_chains({"invert"}, app);
+
+    FilterChain* first = nullptr;
+    FilterChain* second = nullptr;
+    ASSERT_TRUE(worker_chains.getForCurrentThread(first).isSuccess());
+    ASSERT_TRUE(worker_chains.getForCurrentThread(second).isSuccess());
+    EXPECT_EQ(first, second);
+
+    FilterChain* other = nullptr;
+    std::thread worker([&]() {
+        EXPECT_TRUE(worker_chains.getForCurrentThread(other).isSuccess());
+    });
+    worker.join();
+
+    EXPECT_NE(other, nullptr);
+    EXPECT_NE(other, first);
+    EXPECT_EQ(worker_chains.getWorkerCount(), 2u);
+}
+
+TEST(FilterChainTest, WorkerBufferPoolIsReusedAcrossImages)
+{
+    FilterFactory::getInstance().registerAll();
+    CLI::App app("test-app");
+    WorkerFilterChains worker_chains({"blur"}, app);
+
+    FilterChain* chain = nullptr;
+    ASSERT_TRUE(worker_chains.getForCurrentThread(chain).isSuccess());
+    const auto filters = chain->getFilters();
+    ASSERT_EQ(filters.size(), 1u);
+
+    // Без арены изображения (как в потоковой обработке) буферы берутся из пула потока
+    auto first_image = makeImage(100);
+    ASSERT_TRUE(filters[0]->apply(first_image).isSuccess());
+    const size_t pooled_after_first = worker_chains.getPooledBytes();
+    EXPECT_GT(pooled_after_first, 0u);
+
+    // Второе изображение того же размера не добавляет буферов в пул
+    auto second_image = makeImage(50);
+    ASSERT_TRUE(filters[0]->apply(second_image).isSuccess());
+    EXPECT_EQ(worker_chains.getPooledBytes(), pooled_after_first);
+}
+
+TEST(FilterChainTest, WorkerChainReportsUnknownFilter)
+{
+    FilterFactory::getInstance().registerAll();
+    CLI::App app("test-app");
+    WorkerFilterChains worker_chains({"no_such_filter"}, app);
+
+    FilterChain* chain = nullptr;
+    EXPECT_FALSE(worker_chains.getForCurrentThread(chain).isSuccess());
+    EXPECT_EQ(chain, nullptr);
+    EXPECT_EQ(worker_chains.getWorkerCount(), 0u);
+}
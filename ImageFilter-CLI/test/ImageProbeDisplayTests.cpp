@@ -0,0 +1,74 @@
+/**
+ * @file ImageProbeDisplayTests.cpp
+ * @brief Юнит-тесты вывода сведений об изображениях в JSON (--probe).
+ *
+ * Проверяется вывод объекта для одного файла и отсортированного массива
+ * для директории с ошибкой для нечитаемого заголовка.
+ */
+
+#include <gtest/gtest.h>
+
+#include <TestSupport.h>
+
+#include <cli/ImageProbeDisplay.h>
+#include <utils/ImageSaver.h>
+#include <utils/JpegImageCodec.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+namespace
+{
+    using TestSupport::makeTempDirectory;
+
+    void saveImage(const std::filesystem::path& path, int width, int height)
+    {
+        const std::vector<uint8_t> pixels(static_cast<size_t>(width) * height * 3, 50);
+        ASSERT_TRUE(ImageSaver::saveToFile(path.string(), pixels.data(), width, height, 3, false, 90).isSuccess());
+    }
+}
+
+TEST(ImageProbeDisplayTest, PrintsObjectForSingleFile)
+{
+    const auto directory = makeTempDirectory("imagefilter_probe_display_file");
+    const auto path = directory / "image.bmp";
+    saveImage(path, 12, 7);
+
+    std::ostringstream out;
+    EXPECT_EQ(ImageProbeDisplay::printProbe(path.string(), false, "", out), 0);
+    const auto json = nlohmann::json::parse(out.str());
+    EXPECT_EQ(json["path"], path.string());
+    EXPECT_EQ(json["format"], "bmp");
+    EXPECT_EQ(json["width"], 12);
+    EXPECT_EQ(json["height"], 7);
+    EXPECT_EQ(json["channels"], 3);
+    EXPECT_EQ(json["file_size"], std::filesystem::file_size(path));
+    std::filesystem::remove_all(directory);
+}
+
+TEST(ImageProbeDisplayTest, PrintsSortedArrayForDirectory)
+{
+    if (!JpegImageCodec::isAvailable())
+    {
+        GTEST_SKIP() << "Библиотека собрана без libjpeg";
+    }
+
+    const auto directory = makeTempDirectory("imagefilter_probe_display_dir");
+    saveImage(directory / "a.jpg", 32, 16);
+    std::ofstream(directory / "b.png") << "not a png";
+
+    std::ostringstream out;
+    EXPECT_EQ(ImageProbeDisplay::printProbe(directory.string(), false, "", out), 1);
+    const auto json = nlohmann::json::parse(out.str());
+    ASSERT_TRUE(json.is_array());
+    ASSERT_EQ(json.size(), 2u);
+    EXPECT_EQ(json[0]["format"], "jpg");
+    EXPECT_EQ(json[0]["width"], 32);
+    EXPECT_EQ(json[0]["height"], 16);
+    EXPECT_TRUE(json[1].contains("error"));
+    EXPECT_FALSE(json[1].contains("width"));
+    std::filesystem::remove_all(directory);
+}
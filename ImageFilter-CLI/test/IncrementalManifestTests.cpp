@@ -0,0 +1,288 @@
+/**
+ * @file IncrementalManifestTests.cpp
+ * @brief Юнит-тесты манифеста инкрементальной обработки IncrementalManifest.
+ *
+ * Проверяется пропуск файлов только при неизмененных входе, настройках и
+ * существующем выходе, сохранение и загрузка манифеста, дозапись записей до
+ * завершения пакета, экранирование путей, инкрементальный режим BatchProcessor
+ * и нормализация параметров фильтров в ключе настроек.
+ */
+
+#include <gtest/gtest.h>
+
+#include <TestSupport.h>
+
+#include <cli/BatchProcessor.h>
+#include <filters/EdgeDetectionFilter.h>
+#include <filters/GaussianBlurFilter.h>
+#include <filters/NoiseFilter.h>
+#include <filters/ThresholdFilter.h>
+#include <preset/IncrementalManifest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+
+namespace
+{
+    using TestSupport::makeTempDirectory;
+    using TestSupport::writeFile;
+    using TestSupport::readFile;
+
+    void shiftModificationTime(const std::filesystem::path& path)
+    {
+        std::filesystem::last_write_time(path, std::filesystem::last_write_time(path) + std::chrono::seconds(10));
+    }
+}
+
+TEST(IncrementalManifestTest, UnchangedInputSurvivesReload)
+{
+    const auto directory = makeTempDirectory("imagefilter_manifest_reload");
+    const auto input = (directory / "in.png").string();
+    const auto output = (directory / "out.png").string();
+    const auto manifest_file = (directory / "manifest.tsv").string();
+    writeFile(input, "pixels");
+    writeFile(output, "result");
+
+    IncrementalManifest manifest("chain=blur();");
+    EXPECT_FALSE(manifest.isUpToDate(input, output));
+    ASSERT_TRUE(manifest.update(input, output));
+    EXPECT_TRUE(manifest.isUpToDate(input, output));
+    ASSERT_TRUE(manifest.save(manifest_file));
+
+    IncrementalManifest reloaded("chain=blur();");
+    ASSERT_TRUE(reloaded.load(manifest_file));
+    EXPECT_EQ(reloaded.size(), 1u);
+    EXPECT_TRUE(reloaded.isUpToDate(input, output));
+
+    // Другая цепочка фильтров или параметры - файл обрабатывается заново
+    IncrementalManifest changed_settings("chain=blur(--blur-radius=3);");
+    ASSERT_TRUE(changed_settings.load(manifest_file));
+    EXPECT_FALSE(changed_settings.isUpToDate(input, output));
+    std::filesystem::remove_all(directory);
+}
+
+TEST(IncrementalManifestTest, UpdatesReachDiskBeforeClose)
+{
+    const auto directory = makeTempDirectory("imagefilter_manifest_append");
+    const auto input = (directory / "in.png").string();
+    const auto output = (directory / "out.png").string();
+    const auto manifest_file = directory / "manifest.tsv";
+    writeFile(input, "pixels");
+    writeFile(output, "result");
+
+    IncrementalManifest manifest("settings");
+    ASSERT_TRUE(manifest.open(manifest_file.string()));
+    ASSERT_TRUE(manifest.update(input, output));
+
+    // Запись дописывается потоком записи, не дожидаясь close()
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (readFile(manifest_file).find("out.png") == std::string::npos &&
+           std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    // Процесс "упал" до close(): другой экземпляр видит запись
+    IncrementalManifest recovered("settings");
+    ASSERT_TRUE(recovered.load(manifest_file.string()));
+    EXPECT_TRUE(recovered.isUpToDate(input, output));
+
+    ASSERT_TRUE(manifest.close());
+    std::filesystem::remove_all(directory);
+}
+
+TEST(IncrementalManifestTest, TornTailIsDroppedOnOpen)
+{
+    const auto directory = makeTempDirectory("imagefilter_manifest_torn");
+    const auto input = (directory / "in.png").string();
+    const auto output = (directory / "out.png").string();
+    const auto manifest_file = directory / "manifest.tsv";
+    writeFile(input, "pixels");
+    writeFile(output, "result");
+
+    {
+        IncrementalManifest manifest("settings");
+        ASSERT_TRUE(manifest.update(input, output));
+        ASSERT_TRUE(manifest.save(manifest_file.string()));
+    }
+    // Сбой посреди дозаписи строки
+    std::ofstream(manifest_file, std::ios::binary | std::ios::app) << "partial\tline";
+
+    const auto other_input = (directory / "other.png").string();
+    const auto other_output = (directory / "other_out.png").string();
+    writeFile(other_input, "other");
+    writeFile(other_output, "result");
+    {
+        IncrementalManifest manifest("settings");
+        ASSERT_TRUE(manifest.open(manifest_file.string()));
+        EXPECT_EQ(manifest.size(), 1u);
+        ASSERT_TRUE(manifest.update(other_input, other_output));
+    }
+
+    IncrementalManifest reloaded("settings");
+    ASSERT_TRUE(reloaded.load(manifest_file.string()));
+    EXPECT_EQ(reloaded.size(), 2u);
+    EXPECT_TRUE(reloaded.isUpToDate(input, output));
+    EXPECT_TRUE(reloaded.isUpToDate(other_input, other_output));
+    EXPECT_EQ(readFile(manifest_file).find("partial"), std::string::npos);
+    std::filesystem::remove_all(directory);
+}
+
+TEST(IncrementalManifestTest, PathsWithTabsAndNewlinesRoundTrip)
+{
+    const auto directory = makeTempDirectory("imagefilter_manifest_escape");
+    const auto input = (directory / "in\tput\\name.png").string();
+    const auto output = (directory / "out\nput\r.png").string();
+    const auto manifest_file = (directory / "manifest.tsv").string();
+    writeFile(input, "pixels");
+    writeFile(output, "result");
+
+    IncrementalManifest manifest("settings");
+    ASSERT_TRUE(manifest.update(input, output));
+    ASSERT_TRUE(manifest.save(manifest_file));
+
+    // Одна строка заголовка и одна строка записи
+    const auto contents = readFile(manifest_file);
+    EXPECT_EQ(std::count(contents.begin(), contents.end(), '\n'), 2);
+
+    IncrementalManifest reloaded("settings");
+    ASSERT_TRUE(reloaded.load(manifest_file));
+    EXPECT_EQ(reloaded.size(), 1u);
+    EXPECT_TRUE(reloaded.isUpToDate(input, output));
+    std::filesystem::remove_all(directory);
+}
+
+TEST(IncrementalManifestTest, ContentHashDecidesWhenTimestampChanges)
+{
+    const auto directory = makeTempDirectory("imagefilter_manifest_hash");
+    const auto input = directory / "in.png";
+    const auto output = directory / "out.png";
+    writeFile(input, "pixels");
+    writeFile(output, "result");
+
+    IncrementalManifest manifest("settings");
+    ASSERT_TRUE(manifest.update(input.string(), output.string()));
+
+    // Файл "тронут", но содержимое то же
+    shiftModificationTime(input);
+    EXPECT_TRUE(manifest.isUpToDate(input.string(), output.string()));
+
+    // Тот же размер, другое содержимое
+    writeFile(input, "PIXELS");
+    shiftModificationTime(input);
+    EXPECT_FALSE(manifest.isUpToDate(input.string(), output.string()));
+    std::filesystem::remove_all(directory);
+}
+
+TEST(IncrementalManifestTest, MissingOutputIsNotUpToDate)
+{
+    const auto directory = makeTempDirectory("imagefilter_manifest_output");
+    const auto input = (directory / "in.png").string();
+    const auto output = directory / "out.png";
+    writeFile(input, "pixels");
+    writeFile(output, "result");
+
+    IncrementalManifest manifest("settings");
+    ASSERT_TRUE(manifest.update(input, output.string()));
+    std::filesystem::remove(output);
+    EXPECT_FALSE(manifest.isUpToDate(input, output.string()));
+
+    // Другой вход для того же выхода
+    writeFile(output, "result");
+    const auto other_input = (directory / "other.png").string();
+    writeFile(other_input, "pixels");
+    EXPECT_FALSE(manifest.isUpToDate(other_input, output.string()));
+    std::filesystem::remove_all(directory);
+}
+
+TEST(IncrementalManifestTest, BatchProcessorReprocessesOnlyChangedInputs)
+{
+    const auto input_directory = makeTempDirectory("imagefilter_manifest_batch_in");
+    const auto output_directory = makeTempDirectory("imagefilter_manifest_batch_out");
+    writeFile(input_directory / "a.png", "a");
+    writeFile(input_directory / "b.png", "b");
+    // Устаревший выход без записи в манифесте не должен пропускаться
+    writeFile(output_directory / "a.png", "stale");
+
+    size_t calls = 0;
+    const auto process = [&](const std::string&, const std::string& output_path) -> FilterResult {
+        ++calls;
+        writeFile(output_path, "fresh");
+        return FilterResult::success();
+    };
+
+    IncrementalManifest manifest("settings");
+    BatchProcessor processor(input_directory.string(), output_directory.string());
+    processor.setIncrementalManifest(&manifest);
+
+    auto stats = processor.processAll(process);
+    EXPECT_EQ(stats.processed_files, 2u);
+    EXPECT_EQ(stats.skipped_files, 0u);
+    EXPECT_EQ(manifest.size(), 2u);
+
+    writeFile(input_directory / "b.png", "B2");
+    stats = processor.processAll(process);
+    EXPECT_EQ(stats.processed_files, 1u);
+    EXPECT_EQ(stats.skipped_files, 1u);
+    EXPECT_EQ(calls, 3u);
+
+    std::filesystem::remove_all(input_directory);
+    std::filesystem::remove_all(output_directory);
+}
+
+TEST(IncrementalManifestTest, ResumeJournalDoesNotSkipChangedInputs)
+{
+    const auto input_directory = makeTempDirectory("imagefilter_manifest_resume_in");
+    const auto output_directory = makeTempDirectory("imagefilter_manifest_resume_out");
+    const auto resume_file = (output_directory / "resume.log").string();
+    writeFile(input_directory / "a.png", "a");
+    writeFile(input_directory / "b.png", "b");
+
+    size_t calls = 0;
+    const auto process = [&](const std::string&, const std::string& output_path) -> FilterResult {
+        ++calls;
+        writeFile(output_path, "fresh");
+        return FilterResult::success();
+    };
+
+    IncrementalManifest manifest("settings");
+    BatchProcessor processor(input_directory.string(), output_directory.string());
+    processor.setIncrementalManifest(&manifest);
+    auto stats = processor.processAllWithResume(process, nullptr, resume_file);
+    EXPECT_EQ(stats.processed_files, 2u);
+
+    // Оба выхода записаны в журнал, но вход b изменился - решает манифест
+    writeFile(input_directory / "b.png", "B2");
+    stats = processor.processAllWithResume(process, nullptr, resume_file);
+    EXPECT_EQ(stats.processed_files, 1u);
+    EXPECT_EQ(stats.skipped_files, 1u);
+    EXPECT_EQ(calls, 3u);
+
+    std::filesystem::remove_all(input_directory);
+    std::filesystem::remove_all(output_directory);
+}
+
+TEST(IncrementalManifestTest, FilterParametersAreNormalized)
+{
+    // Одно и то же значение в разной записи и явно указанное значение по умолчанию
+    EXPECT_EQ(GaussianBlurFilter(5.0).getParameters(), GaussianBlurFilter(5).getParameters());
+    EXPECT_EQ(GaussianBlurFilter().getParameters(), GaussianBlurFilter(5.0).getParameters());
+    EXPECT_EQ(GaussianBlurFilter(2.5).getParameters(), "radius=2.5,border=mirror");
+    EXPECT_EQ(EdgeDetectionFilter().getParameters(),
+              EdgeDetectionFilter(0.5, EdgeDetectionFilter::Operator::Sobel).getParameters());
+
+    // Некорректное значение заменяется конструктором и совпадает с замененным
+    EXPECT_EQ(ThresholdFilter(500).getParameters(), ThresholdFilter(128).getParameters());
+
+    // Разные значения дают разные описания
+    EXPECT_NE(GaussianBlurFilter(3.0).getParameters(), GaussianBlurFilter(5.0).getParameters());
+    EXPECT_NE(GaussianBlurFilter(5.0, BorderHandler::Strategy::Clamp).getParameters(),
+              GaussianBlurFilter(5.0).getParameters());
+    EXPECT_NE(NoiseFilter(0.1, 7).getParameters(), NoiseFilter(0.1).getParameters());
+    EXPECT_NE(NoiseFilter(0.1, 7).getParameters(), NoiseFilter(0.1, 8).getParameters());
+}
@@ -0,0 +1,135 @@
+/**
+ * @file MemoryBudgetTests.cpp
+ * @brief Юнит-тесты допуска изображений по бюджету памяти MemoryBudget.
+ *
+ * Проверяется ожидание резерва до освобождения памяти, допуск изображения
+ * больше бюджета, оценка пиковой памяти моделью стоимости и ограничение
+ * параллельной обработки в BatchProcessor.
+ */
+
+#include <gtest/gtest.h>
+
+#include <TestSupport.h>
+
+#include <cli/BatchProcessor.h>
+#include <cli/CostModel.h>
+#include <cli/MemoryBudget.h>
+#include <filters/IFilter.h>
+#include <utils/ThreadPool.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    using TestSupport::makeTempDirectory;
+    using TestSupport::writeImageHeader;
+    using TestSupport::StubFilter;
+}
+
+TEST(MemoryBudgetTest, ReservationWaitsUntilMemoryIsReleased)
+{
+    MemoryBudget budget(100);
+    auto first = budget.reserve(80);
+
+    std::atomic<bool> admitted{false};
+    std::thread waiter([&] {
+        auto second = budget.reserve(50);
+        admitted = true;
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_FALSE(admitted.load());
+    EXPECT_EQ(budget.getReservedBytes(), 80u);
+
+    first.release();
+    waiter.join();
+    EXPECT_TRUE(admitted.load());
+    EXPECT_EQ(budget.getReservedBytes(), 0u);
+
+    const auto statistics = budget.getStatistics();
+    EXPECT_EQ(statistics.reservations, 2u);
+    EXPECT_EQ(statistics.waits, 1u);
+    EXPECT_GT(statistics.wait_seconds, 0.0);
+    EXPECT_LE(statistics.peak_bytes, 100u);
+}
+
+TEST(MemoryBudgetTest, OversizedReservationIsAdmittedAlone)
+{
+    MemoryBudget budget(10);
+    {
+        auto reservation = budget.reserve(1000);
+        EXPECT_EQ(reservation.getBytes(), 1000u);
+        EXPECT_EQ(budget.getReservedBytes(), 1000u);
+    }
+    EXPECT_EQ(budget.getReservedBytes(), 0u);
+
+    const auto statistics = budget.getStatistics();
+    EXPECT_EQ(statistics.waits, 0u);
+    EXPECT_EQ(statistics.peak_bytes, 1000u);
+}
+
+TEST(MemoryBudgetTest, CostModelCountsScratchBuffersOfHungriestFilter)
+{
+    const CostModel codec_only;
+    EXPECT_EQ(codec_only.getScratchImages(), 0);
+    EXPECT_EQ(codec_only.estimatePeakBytes(100, 3), 300u);
+    EXPECT_EQ(codec_only.estimatePeakBytes(100, 4), 400u);
+
+    StubFilter in_place(0, true);
+    StubFilter copy(0);
+    StubFilter neighbourhood(3);
+    const CostModel chain({&in_place, &neighbourhood, &copy});
+    EXPECT_EQ(chain.getScratchImages(), 2);
+    EXPECT_EQ(chain.estimatePeakBytes(100, 4), 100u * 4u * 3u);
+}
+
+TEST(MemoryBudgetTest, BatchProcessorAdmitsImagesWithinBudget)
+{
+    const auto input_directory = makeTempDirectory("imagefilter_budget_in");
+    const auto output_directory = makeTempDirectory("imagefilter_budget_out");
+    constexpr int files = 4;
+    for (int i = 0; i < files; ++i)
+    {
+        writeImageHeader(input_directory / ("image" + std::to_string(i) + ".png"), 100, 100);
+    }
+
+    // Заголовок RGB, но загрузка с альфа-каналом: 100x100x4 = 40000 байт,
+    // в бюджет помещается только одно изображение
+    MemoryBudget budget(60000);
+    BatchProcessor processor(input_directory.string(), output_directory.string());
+    processor.setMemoryBudget(&budget, 4);
+
+    std::atomic<int> active{0};
+    std::atomic<int> max_active{0};
+    const auto process = [&](const std::string&, const std::string&) -> FilterResult {
+        const int now = ++active;
+        int expected = max_active.load();
+        while (now > expected && !max_active.compare_exchange_weak(expected, now))
+        {
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        --active;
+        return FilterResult::success();
+    };
+
+    ThreadPool pool(4);
+    const auto stats = processor.processAll(process, nullptr, &pool);
+    EXPECT_EQ(stats.processed_files, static_cast<size_t>(files));
+    EXPECT_EQ(max_active.load(), 1);
+
+    const auto statistics = budget.getStatistics();
+    EXPECT_EQ(statistics.reservations, static_cast<size_t>(files));
+    EXPECT_EQ(statistics.peak_bytes, 40000u);
+    EXPECT_EQ(budget.getReservedBytes(), 0u);
+
+    std::filesystem::remove_all(input_directory);
+    std::filesystem::remove_all(output_directory);
+}
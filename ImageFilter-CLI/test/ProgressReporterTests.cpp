@@ -0,0 +1,178 @@
+/**
+ * @file ProgressReporterTests.cpp
+ * @brief Юнит-тесты сбора и вывода прогресса ProgressReporter и потока JSON Lines.
+ *
+ * Проверяется подсчет итогов из многих потоков без общей блокировки, вывод
+ * с фиксированной частотой вместо вызова на каждый файл, следование скорости
+ * за текущим темпом (EWMA) и формат строки JSON.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cli/ProgressDisplay.h>
+#include <cli/ProgressReporter.h>
+
+#include <chrono>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    ProgressReporter::TotalSource fixedTotal(size_t total)
+    {
+        return [total](bool& estimated) {
+            estimated = false;
+            return total;
+        };
+    }
+}
+
+TEST(ProgressReporterTest, CountsOutcomesFromManyThreads)
+{
+    constexpr int threads = 8;
+    constexpr int files_per_thread = 1000;
+    ProgressReporter reporter(nullptr, fixedTotal(threads * files_per_thread));
+    reporter.start();
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t)
+    {
+        workers.emplace_back([&reporter] {
+            for (int i = 0; i < files_per_thread; ++i)
+            {
+                const auto outcome = (i % 10 == 0)  ? ProgressReporter::Outcome::Failed
+                                   : (i % 10 == 1) ? ProgressReporter::Outcome::Skipped
+                                                   : ProgressReporter::Outcome::Processed;
+                reporter.record(outcome, "file.png");
+            }
+        });
+    }
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+    reporter.stop();
+
+    const auto totals = reporter.getTotals();
+    EXPECT_EQ(totals.completed(), static_cast<size_t>(threads * files_per_thread));
+    EXPECT_EQ(totals.failed, static_cast<size_t>(threads * files_per_thread / 10));
+    EXPECT_EQ(totals.skipped, static_cast<size_t>(threads * files_per_thread / 10));
+}
+
+TEST(ProgressReporterTest, ReportsAtFixedCadenceAndOnStop)
+{
+    constexpr size_t files = 2000;
+    std::mutex mutex;
+    std::vector<ProgressInfo> reports;
+    std::thread::id first_callback_thread;
+    ProgressReporter::Options options;
+    options.interval = std::chrono::milliseconds(20);
+    ProgressReporter reporter(
+        [&](const ProgressInfo& info) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (reports.empty())
+            {
+                first_callback_thread = std::this_thread::get_id();
+            }
+            reports.push_back(info);
+        },
+        fixedTotal(files), options);
+    reporter.start();
+
+    for (size_t i = 0; i < files; ++i)
+    {
+        reporter.record(ProgressReporter::Outcome::Processed, "image" + std::to_string(i) + ".png");
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    reporter.stop();
+
+    // Callback вызывает поток вывода по таймеру (итог - stop()), а не каждый файл
+    ASSERT_GE(reports.size(), 2u);
+    EXPECT_LT(reports.size(), 20u);
+    EXPECT_NE(first_callback_thread, std::this_thread::get_id());
+    const auto& last = reports.back();
+    EXPECT_EQ(last.current, files);
+    EXPECT_EQ(last.total, files);
+    EXPECT_DOUBLE_EQ(last.percentage, 100.0);
+    EXPECT_EQ(last.current_file, "image1999.png");
+}
+
+TEST(ProgressReporterTest, RateFollowsRecentThroughput)
+{
+    ProgressInfo last{};
+    ProgressReporter::Options options;
+    options.interval = std::chrono::milliseconds(10);
+    options.time_constant = std::chrono::milliseconds(50);
+    ProgressReporter reporter([&](const ProgressInfo& info) { last = info; }, fixedTotal(1000), options);
+    reporter.start();
+
+    // Быстрый всплеск, затем медленная обработка
+    for (int i = 0; i < 500; ++i)
+    {
+        reporter.record(ProgressReporter::Outcome::Processed, "fast.png");
+    }
+    const auto start = std::chrono::steady_clock::now();
+    int slow_files = 0;
+    while (std::chrono::steady_clock::now() - start < std::chrono::milliseconds(400))
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        reporter.record(ProgressReporter::Outcome::Processed, "slow.png");
+        ++slow_files;
+    }
+    reporter.stop();
+
+    // Среднее с начала - больше 1000 файлов/с, текущий темп - около 50 файлов/с
+    const double cumulative_rate = static_cast<double>(500 + slow_files) / 0.4;
+    EXPECT_GT(last.files_per_second, 0.0);
+    EXPECT_LT(last.files_per_second, cumulative_rate / 4.0);
+    EXPECT_GT(last.estimated_remaining.count(), 0);
+}
+
+TEST(ProgressReporterTest, JsonLineDescribesProgress)
+{
+    ProgressInfo info{};
+    info.current = 3;
+    info.total = 10;
+    info.current_file = "dir/a.png";
+    info.percentage = 30.0;
+    info.elapsed_time = std::chrono::seconds(2);
+    info.estimated_remaining = std::chrono::seconds(5);
+    info.files_per_second = 1.5;
+    info.failed_files = 1;
+
+    std::ostringstream out;
+    ProgressDisplay::writeJsonLine(info, out);
+    const std::string line = out.str();
+    ASSERT_FALSE(line.empty());
+    EXPECT_EQ(line.back(), '\n');
+    EXPECT_EQ(line.find('\n'), line.size() - 1);
+
+    const auto entry = nlohmann::json::parse(line);
+    EXPECT_EQ(entry["current"], 3);
+    EXPECT_EQ(entry["total"], 10);
+    EXPECT_EQ(entry["failed"], 1);
+    EXPECT_EQ(entry["skipped"], 0);
+    EXPECT_EQ(entry["eta_seconds"], 5);
+    EXPECT_EQ(entry["file"], "dir/a.png");
+
+    // Пока обход директории не завершен, оставшееся время неизвестно
+    info.total_estimated = true;
+    EXPECT_TRUE(ProgressDisplay::toJson(info)["eta_seconds"].is_null());
+}
+
+TEST(ProgressReporterTest, JsonLineReplacesInvalidUtf8InFileName)
+{
+    ProgressInfo info{};
+    info.current = 1;
+    info.total = 1;
+    info.current_file = std::string("bad\xff\xfe") + ".png";
+    info.percentage = 100.0;
+
+    std::ostringstream out;
+    ASSERT_NO_THROW(ProgressDisplay::writeJsonLine(info, out));
+    const auto entry = nlohmann::json::parse(out.str());
+    EXPECT_EQ(entry["file"], "bad\xEF\xBF\xBD\xEF\xBF\xBD.png");
+}
@@ -0,0 +1,198 @@
+/**
+ * @file ResumeJournalTests.cpp
+ * @brief Юнит-тесты журнала возобновления ResumeJournal.
+ *
+ * Проверяется дозапись и повторная загрузка записей, отбрасывание оборванной
+ * при сбое записи, сжатие дубликатов при открытии и во время записи, чтение
+ * старого формата файла состояния и пропуск уже обработанных файлов в
+ * BatchProcessor.
+ */
+
+#include <gtest/gtest.h>
+
+#include <TestSupport.h>
+
+#include <cli/BatchProcessor.h>
+#include <preset/ResumeJournal.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using TestSupport::makeTempDirectory;
+    using TestSupport::writeFile;
+    using TestSupport::readFile;
+}
+
+TEST(ResumeJournalTest, RecordsSurviveReopen)
+{
+    const auto directory = makeTempDirectory("imagefilter_journal_reopen");
+    const auto journal_file = (directory / "state" / "resume.txt").string();
+
+    {
+        ResumeJournal journal;
+        ASSERT_TRUE(journal.open(journal_file));
+        EXPECT_EQ(journal.getLoadedCount(), 0u);
+        for (int i = 0; i < 100; ++i)
+        {
+            journal.record("out/" + std::to_string(i) + ".png");
+        }
+        journal.close();
+
+        const auto statistics = journal.getStatistics();
+        EXPECT_EQ(statistics.written_records, 100u);
+        EXPECT_GE(statistics.syncs, 1u);
+    }
+
+    ResumeJournal journal;
+    ASSERT_TRUE(journal.open(journal_file));
+    EXPECT_EQ(journal.getLoadedCount(), 100u);
+    EXPECT_TRUE(journal.contains("out/0.png"));
+    EXPECT_TRUE(journal.contains("out/99.png"));
+    EXPECT_FALSE(journal.contains("out/100.png"));
+    std::filesystem::remove_all(directory);
+}
+
+TEST(ResumeJournalTest, TornTailIsDroppedBeforeAppending)
+{
+    const auto directory = makeTempDirectory("imagefilter_journal_torn");
+    const auto journal_file = directory / "resume.txt";
+    writeFile(journal_file, "out/a.png\nout/b.png\nout/c.p");
+
+    {
+        ResumeJournal journal;
+        ASSERT_TRUE(journal.open(journal_file.string()));
+        EXPECT_EQ(journal.getLoadedCount(), 2u);
+        EXPECT_FALSE(journal.contains("out/c.p"));
+        EXPECT_TRUE(journal.getStatistics().compacted);
+        journal.record("out/d.png");
+    }
+
+    const auto records = ResumeJournal::load(journal_file.string());
+    EXPECT_EQ(records.size(), 3u);
+    EXPECT_EQ(records.count("out/d.png"), 1u);
+    EXPECT_EQ(records.count("out/c.pout/d.png"), 0u);
+    std::filesystem::remove_all(directory);
+}
+
+TEST(ResumeJournalTest, CompactionRemovesDuplicates)
+{
+    const auto directory = makeTempDirectory("imagefilter_journal_compact");
+    const auto journal_file = directory / "resume.txt";
+    std::string contents;
+    for (int i = 0; i < 10; ++i)
+    {
+        contents += "out/a.png\nout/b.png\n";
+    }
+    writeFile(journal_file, contents);
+
+    ResumeJournal::Options options;
+    options.compact_min_records = 8;
+    ResumeJournal journal;
+    ASSERT_TRUE(journal.open(journal_file.string(), options));
+    journal.close();
+
+    size_t total_lines = 0;
+    bool torn_tail = true;
+    const auto records = ResumeJournal::load(journal_file.string(), &total_lines, &torn_tail);
+    EXPECT_TRUE(journal.getStatistics().compacted);
+    EXPECT_EQ(records.size(), 2u);
+    EXPECT_EQ(total_lines, 2u);
+    EXPECT_FALSE(torn_tail);
+    EXPECT_FALSE(std::filesystem::exists(directory / "resume.txt.tmp"));
+    std::filesystem::remove_all(directory);
+}
+
+TEST(ResumeJournalTest, WriterCompactsWhileRecording)
+{
+    const auto directory = makeTempDirectory("imagefilter_journal_compact_writer");
+    const auto journal_file = directory / "resume.txt";
+
+    ResumeJournal::Options options;
+    options.sync_every = 1;
+    options.compact_min_records = 8;
+    ResumeJournal journal;
+    ASSERT_TRUE(journal.open(journal_file.string(), options));
+    for (int i = 0; i < 40; ++i)
+    {
+        journal.record(i % 2 == 0 ? "out/a.png" : "out/b.png");
+    }
+    journal.close();
+
+    // 40 строк при двух уникальных записях: журнал сжимается, не дожидаясь open()
+    size_t total_lines = 0;
+    const auto records = ResumeJournal::load(journal_file.string(), &total_lines);
+    const auto statistics = journal.getStatistics();
+    EXPECT_FALSE(statistics.compacted);
+    EXPECT_GE(statistics.compactions, 1u);
+    EXPECT_EQ(statistics.written_records, 40u);
+    EXPECT_EQ(records.size(), 2u);
+    EXPECT_LE(total_lines, options.compact_min_records);
+    EXPECT_FALSE(std::filesystem::exists(directory / "resume.txt.tmp"));
+    std::filesystem::remove_all(directory);
+}
+
+TEST(ResumeJournalTest, ReadsLegacyStateFile)
+{
+    const auto directory = makeTempDirectory("imagefilter_journal_legacy");
+    const auto journal_file = directory / "resume.txt";
+    writeFile(journal_file,
+              "# Состояние возобновления пакетной обработки\n"
+              "# Каждая строка содержит путь к обработанному файлу\n"
+              "  out/a.png  \n"
+              "\n"
+              "out/b.png\n");
+
+    ResumeJournal journal;
+    ASSERT_TRUE(journal.open(journal_file.string()));
+    EXPECT_EQ(journal.getLoadedCount(), 2u);
+    EXPECT_TRUE(journal.contains("out/a.png"));
+    EXPECT_FALSE(journal.getStatistics().compacted);
+    journal.close();
+
+    // Без оборванной записи и лишних строк файл только дописывается
+    EXPECT_EQ(readFile(journal_file).rfind("# Состояние", 0), 0u);
+    std::filesystem::remove_all(directory);
+}
+
+TEST(ResumeJournalTest, BatchProcessorSkipsJournaledFiles)
+{
+    const auto input_directory = makeTempDirectory("imagefilter_journal_batch_in");
+    const auto output_directory = makeTempDirectory("imagefilter_journal_batch_out");
+    const auto journal_file = (input_directory.parent_path() / "imagefilter_journal_batch.txt").string();
+    std::filesystem::remove(journal_file);
+    for (const char* name : {"a.png", "b.png", "c.png"})
+    {
+        writeFile(input_directory / name, name);
+    }
+    writeFile(journal_file, (output_directory / "a.png").string() + "\n");
+
+    const BatchProcessor processor(input_directory.string(), output_directory.string());
+    std::mutex mutex;
+    std::vector<std::string> processed;
+    const auto process = [&](const std::string& input_path, const std::string& output_path) -> FilterResult {
+        std::lock_guard<std::mutex> lock(mutex);
+        processed.push_back(std::filesystem::path(input_path).filename().string());
+        writeFile(output_path, "done");
+        return FilterResult::success();
+    };
+
+    const auto stats = processor.processAllWithResume(process, nullptr, journal_file);
+    EXPECT_EQ(stats.skipped_files, 1u);
+    EXPECT_EQ(stats.processed_files, 2u);
+    EXPECT_EQ(std::count(processed.begin(), processed.end(), "a.png"), 0);
+
+    const auto records = ResumeJournal::load(journal_file);
+    EXPECT_EQ(records.size(), 3u);
+    EXPECT_EQ(records.count((output_directory / "c.png").string()), 1u);
+
+    std::filesystem::remove_all(input_directory);
+    std::filesystem::remove_all(output_directory);
+    std::filesystem::remove(journal_file);
+}
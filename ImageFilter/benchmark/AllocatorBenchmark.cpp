@@ -0,0 +1,128 @@
+/**
+ * @file AllocatorBenchmark.cpp
+ * @brief Бенчмарк пропускной способности размытия по Гауссу с разными распределителями.
+ *
+ * Для каждого распределителя (heap, mmap, mmap + populate) создается изображение
+ * заданного размера (по умолчанию 200 МП, RGB), затем несколько раз применяется
+ * GaussianBlurFilter с пулом буферов на том же распределителе. Первое применение
+ * включает page fault промежуточных буферов, последующие показывают
+ * установившуюся скорость.
+ *
+ * Использование: ImageFilterAllocatorBenchmark [width] [height] [iterations] [radius]
+ */
+
+#include <ImageProcessor.h>
+#include <filters/GaussianBlurFilter.h>
+#include <utils/BufferPool.h>
+#include <utils/ImageAllocator.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace
+{
+    struct BenchmarkCase
+    {
+        std::string name;
+        IImageAllocator* allocator;
+    };
+
+    /**
+     * @brief Создает исходные пиксели с детерминированным узором
+     */
+    std::vector<uint8_t> makePattern(int width, int height)
+    {
+        const auto row_size = static_cast<size_t>(width) * 3;
+        std::vector<uint8_t> pixels(row_size * static_cast<size_t>(height));
+        for (int y = 0; y < height; ++y)
+        {
+            auto* row = pixels.data() + static_cast<size_t>(y) * row_size;
+            for (size_t i = 0; i < row_size; ++i)
+            {
+                row[i] = static_cast<uint8_t>((i * 7 + static_cast<size_t>(y) * 13) & 0xFF);
+            }
+        }
+        return pixels;
+    }
+
+    /**
+     * @brief Прогоняет размытие и печатает скорость в мегапикселях в секунду
+     */
+    bool runCase(const BenchmarkCase& benchmark_case, int width, int height, int iterations, double radius)
+    {
+        using Clock = std::chrono::steady_clock;
+        const double megapixels = static_cast<double>(width) * static_cast<double>(height) / 1e6;
+
+        ImageProcessor image;
+        image.setAllocator(benchmark_case.allocator);
+        {
+            const auto pixels = makePattern(width, height);
+            const auto allocation_start = Clock::now();
+            if (!image.resize(width, height, 3, pixels.data()).isSuccess())
+            {
+                std::fprintf(stderr, "%s: недостаточно памяти\n", benchmark_case.name.c_str());
+                return false;
+            }
+            const double allocation_seconds = std::chrono::duration<double>(Clock::now() - allocation_start).count();
+            std::printf("%-16s allocate+copy %7.3f s\n", benchmark_case.name.c_str(), allocation_seconds);
+        }
+
+        BufferPool pool(0, 0, benchmark_case.allocator);
+        GaussianBlurFilter filter(radius, BorderHandler::Strategy::Mirror, &pool);
+
+        std::vector<double> seconds;
+        for (int i = 0; i < iterations; ++i)
+        {
+            const auto start = Clock::now();
+            if (!filter.apply(image).isSuccess())
+            {
+                std::fprintf(stderr, "%s: ошибка применения фильтра\n", benchmark_case.name.c_str());
+                return false;
+            }
+            seconds.push_back(std::chrono::duration<double>(Clock::now() - start).count());
+        }
+
+        const double first = seconds.front();
+        const double best = *std::min_element(seconds.begin(), seconds.end());
+        std::printf("%-16s first %7.3f s (%7.1f MP/s) | best %7.3f s (%7.1f MP/s)\n",
+                    benchmark_case.name.c_str(), first, megapixels / first, best, megapixels / best);
+        return true;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    // 16384 x 12208 ≈ 200 МП
+    const int width = argc > 1 ? std::atoi(argv[1]) : 16384;
+    const int height = argc > 2 ? std::atoi(argv[2]) : 12208;
+    const int iterations = std::max(1, argc > 3 ? std::atoi(argv[3]) : 3);
+    const double radius = argc > 4 ? std::atof(argv[4]) : 3.0;
+
+    std::printf("Gaussian blur r=%.1f, %d x %d RGB (%.1f MP), %d iterations\n",
+                radius, width, height, static_cast<double>(width) * height / 1e6, iterations);
+
+    MmapImageAllocator::Options populate_options;
+    populate_options.populate = true;
+    MmapImageAllocator mmap_allocator;
+    MmapImageAllocator mmap_populate_allocator(populate_options);
+
+    const std::vector<BenchmarkCase> cases = {
+        {"heap", &HeapImageAllocator::getInstance()},
+        {"mmap-hugepage", &mmap_allocator},
+        {"mmap-populate", &mmap_populate_allocator},
+    };
+
+    for (const auto& benchmark_case : cases)
+    {
+        if (!runCase(benchmark_case, width, height, iterations, radius))
+        {
+            return 1;
+        }
+    }
+
+    return 0;
+}
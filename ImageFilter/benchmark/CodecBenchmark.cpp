@@ -0,0 +1,146 @@
+/**
+ * @file CodecBenchmark.cpp
+ * @brief Бенчмарк скорости кодирования и декодирования JPEG разными кодеками.
+ *
+ * Для каждого доступного кодека (stb и libjpeg-turbo, если библиотека собрана
+ * с ним) синтетическое изображение кодируется в JPEG в памяти и декодируется
+ * обратно несколько раз; печатается лучшая скорость в мегапикселях исходного
+ * изображения в секунду. Для кодеков с масштабированием при декодировании
+ * дополнительно измеряется декодирование в 1/2, 1/4 и 1/8 размера (превью).
+ *
+ * Использование: ImageFilterCodecBenchmark [width] [height] [iterations] [quality]
+ */
+
+#include <utils/IImageCodec.h>
+#include <utils/JpegImageCodec.h>
+#include <utils/StbImageCodec.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Создает исходные пиксели: плавный градиент с мелкой текстурой,
+     * чтобы размер JPEG был близок к фотографии
+     */
+    std::vector<uint8_t> makePattern(int width, int height)
+    {
+        const auto row_size = static_cast<size_t>(width) * 3;
+        std::vector<uint8_t> pixels(row_size * static_cast<size_t>(height));
+        uint32_t noise = 12345;
+        for (int y = 0; y < height; ++y)
+        {
+            auto* row = pixels.data() + static_cast<size_t>(y) * row_size;
+            for (int x = 0; x < width; ++x)
+            {
+                noise = noise * 1103515245u + 12345u;
+                const int texture = static_cast<int>((noise >> 16) & 0x1F) - 16;
+                row[x * 3 + 0] = static_cast<uint8_t>(std::clamp(x * 255 / width + texture, 0, 255));
+                row[x * 3 + 1] = static_cast<uint8_t>(std::clamp(y * 255 / height + texture, 0, 255));
+                row[x * 3 + 2] = static_cast<uint8_t>(std::clamp((x + y) * 127 / (width + height) + 64 + texture, 0, 255));
+            }
+        }
+        return pixels;
+    }
+
+    /**
+     * @brief Выполняет операцию iterations раз и возвращает лучшее время в секундах (или -1 при ошибке)
+     */
+    double measureBest(int iterations, const std::function<bool()>& operation)
+    {
+        double best = -1.0;
+        for (int i = 0; i < iterations; ++i)
+        {
+            const auto start = Clock::now();
+            if (!operation())
+            {
+                return -1.0;
+            }
+            const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+            best = best < 0.0 ? seconds : std::min(best, seconds);
+        }
+        return best;
+    }
+
+    void printResult(const char* codec_name, const std::string& operation, double megapixels, double seconds)
+    {
+        if (seconds < 0.0)
+        {
+            std::printf("%-14s %-16s ошибка\n", codec_name, operation.c_str());
+            return;
+        }
+        std::printf("%-14s %-16s %8.3f s (%8.1f MP/s)\n", codec_name, operation.c_str(), seconds, megapixels / seconds);
+    }
+
+    void runCodec(const IImageCodec& codec, const std::vector<uint8_t>& pixels, int width, int height,
+                  int iterations, int quality)
+    {
+        const double megapixels = static_cast<double>(width) * static_cast<double>(height) / 1e6;
+
+        std::vector<uint8_t> encoded;
+        const IImageCodec::ByteSink sink = [&encoded](const uint8_t* bytes, size_t size) {
+            encoded.insert(encoded.end(), bytes, bytes + size);
+            return true;
+        };
+        const double encode_seconds = measureBest(iterations, [&]() {
+            encoded.clear();
+            return codec.encode(sink, "jpg", pixels.data(), width, height, 3, false, quality).isSuccess();
+        });
+        printResult(codec.getName(), "encode", megapixels, encode_seconds);
+        if (encode_seconds < 0.0)
+        {
+            return;
+        }
+
+        std::vector<int> scales = {1};
+        if (codec.supportsScaledDecode())
+        {
+            scales.insert(scales.end(), {2, 4, 8});
+        }
+
+        for (const int scale : scales)
+        {
+            const double decode_seconds = measureBest(iterations, [&]() {
+                ImageLoader::LoadedImage image;
+                const bool ok = codec.decode(encoded, 3, scale, image).isSuccess();
+                std::free(image.data);
+                return ok;
+            });
+            printResult(codec.getName(), scale == 1 ? "decode" : "decode 1/" + std::to_string(scale),
+                        megapixels, decode_seconds);
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const int width = argc > 1 ? std::atoi(argv[1]) : 6000;
+    const int height = argc > 2 ? std::atoi(argv[2]) : 4000;
+    const int iterations = std::max(1, argc > 3 ? std::atoi(argv[3]) : 3);
+    const int quality = argc > 4 ? std::atoi(argv[4]) : 90;
+
+    std::printf("JPEG q=%d, %d x %d RGB (%.1f MP), %d iterations\n",
+                quality, width, height, static_cast<double>(width) * height / 1e6, iterations);
+
+    const auto pixels = makePattern(width, height);
+
+    runCodec(StbImageCodec::getInstance(), pixels, width, height, iterations, quality);
+    if (JpegImageCodec::isAvailable())
+    {
+        runCodec(JpegImageCodec::getInstance(), pixels, width, height, iterations, quality);
+    }
+    else
+    {
+        std::printf("libjpeg-turbo: библиотека собрана без кодека\n");
+    }
+
+    return 0;
+}
@@ -0,0 +1,183 @@
+/**
+ * @file MixedSizeBenchmark.cpp
+ * @brief Бенчмарк пакетной обработки директории с изображениями разного размера.
+ *
+ * Во временной директории создаются много маленьких и несколько очень больших
+ * BMP. Каждый файл загружается, размывается по Гауссу и сохраняется пулом
+ * потоков уровня файлов (как в пакетном режиме CLI). Сравниваются два режима:
+ * - unbounded: бюджет потоков N² (как без согласования - каждый фильтр
+ *   создает пул на все ядра при занятых файловых потоках);
+ * - governed: общий бюджет N потоков (ConcurrencyGovernor), большие
+ *   изображения обрабатываются монопольно всеми потоками.
+ * Печатается время, скорость в мегапикселях в секунду и пиковое число
+ * занятых потоков бюджета.
+ *
+ * Использование: ImageFilterMixedSizeBenchmark [small_count] [small_size] [large_count] [large_width] [large_height]
+ */
+
+#include <ImageProcessor.h>
+#include <filters/GaussianBlurFilter.h>
+#include <utils/BMPHandler.h>
+#include <utils/BufferPool.h>
+#include <utils/ConcurrencyGovernor.h>
+#include <utils/ThreadPool.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    struct InputFile
+    {
+        std::filesystem::path path;
+        double megapixels;
+    };
+
+    /**
+     * @brief Создает BMP с детерминированным узором
+     */
+    bool writePattern(const std::filesystem::path& path, int width, int height)
+    {
+        const auto row_size = static_cast<size_t>(width) * 3;
+        std::vector<uint8_t> pixels(row_size * static_cast<size_t>(height));
+        for (int y = 0; y < height; ++y)
+        {
+            auto* row = pixels.data() + static_cast<size_t>(y) * row_size;
+            for (size_t i = 0; i < row_size; ++i)
+            {
+                row[i] = static_cast<uint8_t>((i * 7 + static_cast<size_t>(y) * 13) & 0xFF);
+            }
+        }
+        return BMPHandler::saveBMP(path.string(), width, height, 3, pixels.data());
+    }
+
+    /**
+     * @brief Обрабатывает все файлы пулом потоков уровня файлов и печатает результат
+     */
+    bool runCase(const char* name,
+                 const std::vector<InputFile>& files,
+                 const std::filesystem::path& output_dir,
+                 int file_threads,
+                 int thread_budget,
+                 int64_t exclusive_threshold)
+    {
+        auto& governor = ConcurrencyGovernor::getInstance();
+        governor.setThreadBudget(thread_budget);
+        governor.setExclusiveThreshold(exclusive_threshold);
+        governor.resetPeak();
+
+        BufferPool buffer_pool;
+        std::atomic<size_t> next_file{0};
+        std::atomic<bool> failed{false};
+
+        const auto start = Clock::now();
+        {
+            ThreadPool file_pool(file_threads);
+            for (int i = 0; i < file_threads; ++i)
+            {
+                file_pool.enqueue([&]() {
+                    while (true)
+                    {
+                        const size_t index = next_file++;
+                        if (index >= files.size())
+                        {
+                            break;
+                        }
+
+                        const auto worker = governor.acquireWorker();
+                        ImageProcessor image;
+                        if (!image.loadFromFile(files[index].path.string()).isSuccess())
+                        {
+                            failed = true;
+                            continue;
+                        }
+
+                        const auto exclusive = governor.acquireExclusive(image.getWidth(), image.getHeight());
+                        GaussianBlurFilter filter(3.0, BorderHandler::Strategy::Mirror, &buffer_pool);
+                        const auto output = output_dir / files[index].path.filename();
+                        if (!filter.apply(image).isSuccess() || !image.saveToFile(output.string()).isSuccess())
+                        {
+                            failed = true;
+                        }
+                    }
+                });
+            }
+            file_pool.waitAll();
+        }
+        const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        if (failed)
+        {
+            std::fprintf(stderr, "%s: ошибка обработки\n", name);
+            return false;
+        }
+
+        double megapixels = 0.0;
+        for (const auto& file : files)
+        {
+            megapixels += file.megapixels;
+        }
+        std::printf("%-10s %7.3f s (%7.1f MP/s) | пик потоков бюджета %d\n",
+                    name, seconds, megapixels / seconds, governor.getPeakThreadsInUse());
+        return true;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const int small_count = std::max(0, argc > 1 ? std::atoi(argv[1]) : 64);
+    const int small_size = std::max(1, argc > 2 ? std::atoi(argv[2]) : 512);
+    const int large_count = std::max(0, argc > 3 ? std::atoi(argv[3]) : 2);
+    const int large_width = std::max(1, argc > 4 ? std::atoi(argv[4]) : 6000);
+    const int large_height = std::max(1, argc > 5 ? std::atoi(argv[5]) : 4000);
+
+    const int hardware_threads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    const auto root = std::filesystem::temp_directory_path() / "imagefilter_mixed_size_benchmark";
+    const auto input_dir = root / "input";
+    const auto output_dir = root / "output";
+    std::filesystem::remove_all(root);
+    std::filesystem::create_directories(input_dir);
+    std::filesystem::create_directories(output_dir);
+
+    // Большие файлы равномерно перемешаны с маленькими, как в реальной директории
+    const int total_count = small_count + large_count;
+    const int large_stride = large_count > 0 ? std::max(1, total_count / large_count) : total_count + 1;
+    int large_written = 0;
+
+    std::vector<InputFile> files;
+    for (int i = 0; i < total_count; ++i)
+    {
+        const bool large = large_written < large_count && i % large_stride == 0;
+        large_written += large ? 1 : 0;
+        const int width = large ? large_width : small_size;
+        const int height = large ? large_height : small_size;
+        const auto path = input_dir / ("image_" + std::to_string(i) + ".bmp");
+        if (!writePattern(path, width, height))
+        {
+            std::fprintf(stderr, "Не удалось создать %s\n", path.string().c_str());
+            return 1;
+        }
+        files.push_back({path, static_cast<double>(width) * height / 1e6});
+    }
+
+    std::printf("Gaussian blur r=3.0: %d x %dx%d + %d x %dx%d BMP, %d аппаратных потоков\n",
+                small_count, small_size, small_size, large_count, large_width, large_height, hardware_threads);
+
+    // Порог монопольной обработки - размер больших изображений
+    const auto large_pixels = static_cast<int64_t>(large_width) * large_height;
+    const bool ok = runCase("unbounded", files, output_dir, hardware_threads,
+                            hardware_threads * hardware_threads, 0) &&
+                    runCase("governed", files, output_dir, hardware_threads, hardware_threads, large_pixels);
+
+    std::filesystem::remove_all(root);
+    return ok ? 0 : 1;
+}
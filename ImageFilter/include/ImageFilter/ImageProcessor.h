@@ -1,8 +1,15 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <span>
 #include <string>
+#include <vector>
 #include <utils/FilterResult.h>
+#include <utils/ImageBuffer.h>
+
+class IImageAllocator;
+class ScratchArena;
 
 /**
  * @brief Класс для работы с изображениями в форматах JPEG и PNG
@@ -10,6 +17,11 @@
  * Использует библиотеку STB Image для загрузки и сохранения изображений.
  * Хранит данные изображения в виде непрерывного массива пикселей в формате RGB или RGBA.
  * Поддерживает как 3 канала (RGB), так и 4 канала (RGBA) для работы с альфа-каналом.
+ *
+ * Данные хранятся в ImageBuffer, который сам знает способ освобождения: буферы,
+ * создаваемые resize(), выделяются через IImageAllocator (см. setAllocator()),
+ * данные декодера освобождаются через std::free, а готовые буферы фильтров,
+ * пулов и декодеров передаются без копирования через adopt().
  * 
  * @example example_basic_usage.cpp
  * Пример базового использования ImageProcessor:
@@ -34,7 +46,7 @@ public:
      */
     ~ImageProcessor();
 
-    // Запрещаем копирование (данные владеют памятью через stbi_image_free)
+    // Запрещаем копирование (объект владеет буфером пикселей)
     ImageProcessor(const ImageProcessor&) = delete;
     ImageProcessor& operator=(const ImageProcessor&) = delete;
 
@@ -55,12 +67,24 @@ public:
      * @brief Загружает изображение из файла
      * @param filename Путь к файлу изображения
      * @param preserve_alpha Если true, загружает с альфа-каналом (RGBA), если false - принудительно RGB
+     * @param scale_denominator Знаменатель масштаба 1, 2, 4 или 8 для превью и миниатюр
+     *        (см. ImageLoader::loadFromFile)
      * @return FilterResult с результатом операции
      * 
      * @note Путь к файлу валидируется на безопасность (защита от path traversal атак).
      * Размер файла ограничен DEFAULT_MAX_IMAGE_SIZE (1 GB по умолчанию).
      */
-    FilterResult loadFromFile(const std::string& filename, bool preserve_alpha = false);
+    FilterResult loadFromFile(const std::string& filename, bool preserve_alpha = false, int scale_denominator = 1);
+
+    /**
+     * @brief Загружает изображение из закодированных данных в памяти
+     * @param data Содержимое файла изображения (формат определяется по сигнатуре)
+     * @param preserve_alpha Если true, загружает с альфа-каналом (RGBA), если false - принудительно RGB
+     * @param scale_denominator Знаменатель масштаба 1, 2, 4 или 8 (см. ImageLoader::loadFromMemory)
+     * @return FilterResult с результатом операции
+     */
+    FilterResult loadFromMemory(std::span<const uint8_t> data, bool preserve_alpha = false,
+                                int scale_denominator = 1);
 
     /**
      * @brief Сохраняет изображение в файл
@@ -72,9 +96,23 @@ public:
      */
     FilterResult saveToFile(const std::string& filename, bool preserve_alpha = false) const;
 
+    /**
+     * @brief Кодирует изображение в буфер в памяти
+     * @param format Формат: "jpg", "jpeg", "png" или "bmp"
+     * @param output Закодированные байты (содержимое заменяется)
+     * @param preserve_alpha Если true, сохраняет альфа-канал (для PNG), если false - принудительно RGB
+     * @return FilterResult с результатом операции
+     *
+     * @note Используется текущее качество JPEG (см. setJpegQuality()).
+     */
+    FilterResult saveToMemory(const std::string& format, std::vector<uint8_t>& output,
+                              bool preserve_alpha = false) const;
+
     /**
      * @brief Преобразует RGBA изображение в RGB, удаляя альфа-канал
      * @return FilterResult с результатом операции
+     *
+     * Преобразование выполняется на месте, без выделения нового буфера.
      */
     FilterResult convertToRGB();
 
@@ -136,6 +174,35 @@ public:
      */
     [[nodiscard]] int getJpegQuality() const noexcept;
 
+    /**
+     * @brief Устанавливает распределитель для новых буферов изображения
+     * @param allocator Распределитель (nullptr = ImageAllocator::getDefault())
+     *
+     * Текущий буфер освобождается тем распределителем, которым он был выделен.
+     */
+    void setAllocator(IImageAllocator* allocator) noexcept;
+
+    /**
+     * @brief Получает распределитель для новых буферов изображения
+     * @return Распределитель, заданный через setAllocator(), или распределитель по умолчанию
+     */
+    [[nodiscard]] IImageAllocator& getAllocator() const noexcept;
+
+    /**
+     * @brief Устанавливает арену для временных буферов фильтров
+     * @param arena Арена (nullptr = временные буферы берутся из пула фильтра или кучи)
+     *
+     * Арена не принадлежит изображению; ее сбрасывает исполнитель цепочки фильтров.
+     * Фильтры получают из нее память через ScratchBuffer.
+     */
+    void setScratchArena(ScratchArena* arena) noexcept;
+
+    /**
+     * @brief Получает арену для временных буферов фильтров
+     * @return Арена или nullptr, если она не задана
+     */
+    [[nodiscard]] ScratchArena* getScratchArena() const noexcept;
+
     /**
      * @brief Изменяет размеры изображения и заменяет данные
      * @param new_width Новая ширина изображения
@@ -143,7 +210,7 @@ public:
      * @param new_data Указатель на новые данные изображения (должен быть размером new_width * new_height * channels)
      * @return FilterResult с результатом операции
      * 
-     * Принимает владение над new_data. Старые данные освобождаются через stbi_image_free.
+     * Копирует new_data в буфер, выделенный через getAllocator(). Старые данные освобождаются.
      * Если new_data == nullptr, то просто освобождается старое изображение и устанавливаются новые размеры.
      */
     FilterResult resize(int new_width, int new_height, const uint8_t* new_data = nullptr);
@@ -156,17 +223,52 @@ public:
      * @param new_data Указатель на новые данные изображения (должен быть размером new_width * new_height * new_channels)
      * @return FilterResult с результатом операции
      * 
-     * Принимает владение над new_data. Старые данные освобождаются через stbi_image_free.
+     * Копирует new_data в буфер, выделенный через getAllocator(). Старые данные освобождаются.
      * Если new_data == nullptr, то просто освобождается старое изображение и устанавливаются новые размеры и каналы.
      */
     FilterResult resize(int new_width, int new_height, int new_channels, const uint8_t* new_data);
 
+    /**
+     * @brief Принимает владение готовым буфером без копирования
+     * @param new_width Новая ширина изображения
+     * @param new_height Новая высота изображения
+     * @param new_channels Количество каналов (3 для RGB, 4 для RGBA)
+     * @param data Буфер размером не меньше new_width * new_height * new_channels
+     * @param deleter Функция освобождения буфера
+     * @return FilterResult с результатом операции
+     *
+     * Владение переходит к ImageProcessor в любом случае: при ошибке буфер
+     * сразу освобождается через deleter. Старые данные освобождаются.
+     */
+    FilterResult adopt(int new_width, int new_height, int new_channels,
+                       uint8_t* data, ImageBuffer::Deleter deleter);
+
+    /**
+     * @brief Принимает владение готовым буфером без копирования
+     * @param new_width Новая ширина изображения
+     * @param new_height Новая высота изображения
+     * @param new_channels Количество каналов (3 для RGB, 4 для RGBA)
+     * @param buffer Буфер размером не меньше new_width * new_height * new_channels
+     * @return FilterResult с результатом операции
+     *
+     * Владение переходит к ImageProcessor в любом случае: при ошибке буфер
+     * сразу освобождается. Старые данные освобождаются.
+     */
+    FilterResult adopt(int new_width, int new_height, int new_channels, ImageBuffer&& buffer);
+
 private:
     /**
-     * @note Поля упорядочены для минимизации padding: сначала указатель (требует выравнивания 8),
+     * @brief Принимает изображение, выделенное декодером через malloc
+     */
+    void setLoaded(uint8_t* data, int width, int height, int channels);
+
+    /**
+     * @note Поля упорядочены для минимизации padding: сначала буфер и указатель (выравнивание 8),
      * затем int поля (выравнивание 4) для оптимального использования памяти.
      */
-    uint8_t* data_ = nullptr; // Данные изображения (RGB или RGBA формат)
+    ImageBuffer buffer_; // Данные изображения (RGB или RGBA формат) и способ их освобождения
+    IImageAllocator* allocator_ = nullptr; // Распределитель новых буферов (nullptr = по умолчанию)
+    ScratchArena* scratch_arena_ = nullptr; // Арена временных буферов фильтров (не владеет)
     int width_ = 0; // Ширина изображения
     int height_ = 0; // Высота изображения
     int channels_ = 0; // Количество каналов (3 для RGB или 4 для RGBA)
@@ -29,7 +29,9 @@ public:
     std::string getName() const override;
     std::string getDescription() const override;
     std::string getCategory() const override;
+    std::string getParameters() const override;
     bool supportsInPlace() const noexcept override;
+    int getStreamingRadius() const noexcept override;
 
 private:
     double factor_;  // Коэффициент яркости
@@ -2,6 +2,7 @@
 
 #include <filters/IFilter.h>
 #include <utils/BorderHandler.h>
+#include <utils/GradientKernels.h>
 
 /**
  * @brief Фильтр детекции краёв
@@ -14,17 +15,21 @@
  * - Sobel: классический оператор, хороший баланс между точностью и производительностью
  * - Prewitt: более простой оператор, быстрее чем Sobel
  * - Scharr: более точный оператор, лучше определяет края под углом
+ *
+ * Магнитуда градиента вычисляется точно (sqrt) или приближенно
+ * (alpha-max-beta-min, без sqrt, погрешность не более 4%).
  */
 class EdgeDetectionFilter : public IFilter {
 public:
     /**
-     * @brief Тип оператора для детекции краёв
+     * @brief Тип оператора для детекции краёв (Sobel по умолчанию, Prewitt, Scharr)
      */
-    enum class Operator {
-        Sobel,   ///< Оператор Собеля (по умолчанию)
-        Prewitt,  ///< Оператор Преввитта
-        Scharr    ///< Оператор Шарра
-    };
+    using Operator = GradientKernels::Operator;
+
+    /**
+     * @brief Способ вычисления магнитуды градиента (Exact по умолчанию, Approximate)
+     */
+    using Magnitude = GradientKernels::Magnitude;
 
     /**
      * @brief Конструктор фильтра детекции краёв
@@ -32,12 +37,15 @@ public:
      *                    Влияет на порог нормализации. По умолчанию 0.5
      * @param operator_type Тип оператора для детекции краёв (по умолчанию Sobel)
      * @param borderStrategy Стратегия обработки границ (по умолчанию Mirror)
+     * @param magnitude Способ вычисления магнитуды градиента (по умолчанию Exact)
      */
     explicit EdgeDetectionFilter(double sensitivity = 0.5,
                                  Operator operator_type = Operator::Sobel,
-                                 BorderHandler::Strategy borderStrategy = BorderHandler::Strategy::Mirror) 
+                                 BorderHandler::Strategy borderStrategy = BorderHandler::Strategy::Mirror,
+                                 Magnitude magnitude = Magnitude::Exact) 
         : sensitivity_(sensitivity >= 0.0 && sensitivity <= 1.0 ? sensitivity : 0.5),
           operator_type_(operator_type),
+          magnitude_(magnitude),
           border_handler_(borderStrategy) {}
 
     /**
@@ -50,10 +58,12 @@ public:
     std::string getName() const override;
     std::string getDescription() const override;
     std::string getCategory() const override;
+    std::string getParameters() const override;
 
 private:
     double sensitivity_;  // Чувствительность детекции краёв
     Operator operator_type_;  // Тип оператора для детекции краёв
+    Magnitude magnitude_;  // Способ вычисления магнитуды градиента
     BorderHandler border_handler_;  // Обработчик границ
 };
 
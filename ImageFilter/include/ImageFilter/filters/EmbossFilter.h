@@ -37,6 +37,8 @@ public:
     std::string getName() const override;
     std::string getDescription() const override;
     std::string getCategory() const override;
+    std::string getParameters() const override;
+    int getStreamingRadius() const noexcept override;
 
 private:
     double strength_;  // Сила эффекта рельефа
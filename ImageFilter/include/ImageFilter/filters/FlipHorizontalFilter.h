@@ -19,6 +19,7 @@ public:
     std::string getName() const override;
     std::string getDescription() const override;
     std::string getCategory() const override;
+    int getStreamingRadius() const noexcept override;
 };
 
 
@@ -23,5 +23,6 @@ public:
     std::string getDescription() const override;
     std::string getCategory() const override;
     bool supportsInPlace() const noexcept override;
+    int getStreamingRadius() const noexcept override;
 };
 
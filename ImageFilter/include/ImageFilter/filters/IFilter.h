@@ -2,6 +2,7 @@
 
 #include <utils/FilterResult.h>
 #include <string>
+#include <string_view>
 
 class ImageProcessor;
 
@@ -73,5 +74,45 @@ public:
      */
     [[nodiscard]] virtual bool supportsInPlace() const noexcept { return false; }
 
+    /**
+     * @brief Возвращает число соседних строк, необходимых для вычисления строки результата
+     *
+     * Используется потоковой обработкой полосами (StripPipeline): строка y результата
+     * должна зависеть только от строк [y - R, y + R] входа, а не от размеров изображения,
+     * абсолютных координат или статистики всего кадра. Фильтры с обработкой границ
+     * Wrap читают строки у противоположного края изображения и возвращают -1.
+     *
+     * @return Радиус R по вертикали (0 для поточечных фильтров) или -1, если фильтру
+     *         нужно все изображение
+     */
+    [[nodiscard]] virtual int getStreamingRadius() const noexcept { return -1; }
+
+    /**
+     * @brief Возвращает нормализованное описание действующих параметров фильтра
+     *
+     * Описываются значения, с которыми фильтр был создан после проверки и замены
+     * некорректных значений, в каноническом виде ("radius=5,border=mirror"):
+     * одинаковые описания означают одинаковый результат фильтра (см. --incremental).
+     *
+     * @return Пары "имя=значение" через запятую (пустая строка для фильтров без параметров)
+     */
+    [[nodiscard]] virtual std::string getParameters() const { return {}; }
+
+protected:
+    /**
+     * @brief Форматирует числовой параметр в кратчайшем точном виде ("5" для 5 и 5.0)
+     * @param name Имя параметра
+     * @param value Значение
+     * @return Строка "имя=значение"
+     */
+    static std::string formatParameter(std::string_view name, double value);
+
+    /**
+     * @brief Форматирует строковый параметр
+     * @param name Имя параметра
+     * @param value Значение
+     * @return Строка "имя=значение"
+     */
+    static std::string formatParameter(std::string_view name, std::string_view value);
 };
 
@@ -36,6 +36,8 @@ public:
     std::string getName() const override;
     std::string getDescription() const override;
     std::string getCategory() const override;
+    std::string getParameters() const override;
+    int getStreamingRadius() const noexcept override;
 
 private:
     int radius_;  // Радиус окна
@@ -1,12 +1,19 @@
 #pragma once
 
 #include <filters/IFilter.h>
+#include <cstdint>
+#include <optional>
 
 /**
  * @brief Фильтр добавления шума
  * 
  * Добавляет случайный шум к изображению. Может использоваться для
  * тестирования алгоритмов удаления шума или создания художественных эффектов.
+ *
+ * Шум генерируется счетчиковым генератором Philox4x32 (см. CounterRNG), ключом
+ * которого является зерно, а счетчиком - глобальный индекс пикселя. Поэтому при
+ * заданном зерне результат побитово воспроизводим независимо от количества потоков
+ * и разбиения строк между ними.
  */
 class NoiseFilter : public IFilter {
 public:
@@ -14,9 +21,11 @@ public:
      * @brief Конструктор фильтра шума
      * @param intensity Интенсивность шума (0.0 - 1.0, где 1.0 = максимальный шум, по умолчанию 0.1)
      *                  При некорректном значении используется 0.1
+     * @param seed Зерно генератора шума. Если не задано, при каждом применении
+     *             выбирается случайное зерно (результат невоспроизводим)
      */
-    explicit NoiseFilter(double intensity = 0.1) 
-        : intensity_((intensity >= 0.0 && intensity <= 1.0) ? intensity : 0.1) {}
+    explicit NoiseFilter(double intensity = 0.1, std::optional<uint64_t> seed = std::nullopt) 
+        : intensity_((intensity >= 0.0 && intensity <= 1.0) ? intensity : 0.1), seed_(seed) {}
 
     /**
      * @brief Применяет фильтр шума к изображению
@@ -28,8 +37,16 @@ public:
     std::string getName() const override;
     std::string getDescription() const override;
     std::string getCategory() const override;
+    std::string getParameters() const override;
+
+    /**
+     * @brief Получает зерно генератора шума
+     * @return Зерно или std::nullopt, если используется случайное зерно
+     */
+    [[nodiscard]] std::optional<uint64_t> getSeed() const noexcept { return seed_; }
 
 private:
     double intensity_;  // Интенсивность шума
+    std::optional<uint64_t> seed_;  // Зерно генератора (std::nullopt = случайное)
 };
 
@@ -16,7 +16,8 @@ public:
     /**
      * @brief Конструктор фильтра поворота
      * @param clockwise true для поворота по часовой стрелке, false для поворота против часовой стрелки
-     * @param buffer_pool Пул буферов для переиспользования временных буферов (опционально)
+     * @param buffer_pool Пул буферов (опционально); буфер из пула становится
+     *                    буфером повернутого изображения и в пул не возвращается
      */
     explicit Rotate90Filter(bool clockwise = true, IBufferPool* buffer_pool = nullptr) 
         : buffer_pool_(buffer_pool), clockwise_(clockwise) {}
@@ -31,6 +32,7 @@ public:
     std::string getName() const override;
     std::string getDescription() const override;
     std::string getCategory() const override;
+    std::string getParameters() const override;
 
 private:
     IBufferPool* buffer_pool_;  // Пул буферов для переиспользования (может быть nullptr)
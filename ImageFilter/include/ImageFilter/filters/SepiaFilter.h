@@ -26,6 +26,7 @@ public:
     std::string getDescription() const override;
     std::string getCategory() const override;
     bool supportsInPlace() const noexcept override;
+    int getStreamingRadius() const noexcept override;
 };
 
 
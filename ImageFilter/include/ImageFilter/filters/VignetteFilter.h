@@ -28,6 +28,7 @@ public:
     std::string getName() const override;
     std::string getDescription() const override;
     std::string getCategory() const override;
+    std::string getParameters() const override;
 
 private:
     double strength_;  // Сила эффекта виньетирования
@@ -1,33 +1,72 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <fstream>
+#include <functional>
 #include <string>
 #include <vector>
+#include <utils/MappedFile.h>
 
 /**
  * @brief Обработчик для работы с BMP форматом
- * 
+ *
  * Предоставляет функции для чтения и записи BMP файлов.
  * Поддерживает 24-битные RGB изображения (без сжатия).
+ *
+ * Заголовки и размеры проверяются один раз на изображение, после чего строки
+ * копируются без проверок на каждый пиксель. Чтение идет напрямую из файла,
+ * отображенного в память (mmap), а при его недоступности - через один
+ * переиспользуемый буфер строки. Кроме полнокадровых loadBMP/saveBMP есть
+ * построчные BMPReader/BMPWriter для потоковой обработки.
  */
 namespace BMPHandler
 {
     /**
      * @brief Загружает BMP изображение из файла
-     * 
+     *
      * @param filename Путь к BMP файлу
      * @param width Ширина изображения (выходной параметр)
      * @param height Высота изображения (выходной параметр)
-     * @param channels Количество каналов (выходной параметр, всегда 3 для BMP)
-     * @return Указатель на данные изображения (RGB) или nullptr при ошибке
-     * 
+     * @param channels Количество каналов (выходной параметр, равен desired_channels)
+     * @param desired_channels Желаемое количество каналов: 3 (RGB) или 4 (RGBA с альфой 255)
+     * @return Указатель на данные изображения или nullptr при ошибке
+     *
      * @note Вызывающий код должен освободить память через std::free()
      */
-    uint8_t* loadBMP(const std::string& filename, int& width, int& height, int& channels);
+    uint8_t* loadBMP(const std::string& filename, int& width, int& height, int& channels,
+                     int desired_channels = 3);
+
+    /**
+     * @brief Загружает BMP изображение из памяти
+     *
+     * @param data Содержимое BMP файла
+     * @param size Размер данных в байтах
+     * @param width Ширина изображения (выходной параметр)
+     * @param height Высота изображения (выходной параметр)
+     * @param channels Количество каналов (выходной параметр, равен desired_channels)
+     * @param desired_channels Желаемое количество каналов: 3 (RGB) или 4 (RGBA с альфой 255)
+     * @return Указатель на данные изображения или nullptr при ошибке
+     *
+     * @note Вызывающий код должен освободить память через std::free()
+     */
+    uint8_t* loadBMPFromMemory(const uint8_t* data, size_t size, int& width, int& height, int& channels,
+                               int desired_channels = 3);
+
+    /**
+     * @brief Читает размеры изображения из заголовков BMP без чтения пикселей
+     *
+     * @param data Начало BMP файла (достаточно заголовков, 54 байта)
+     * @param size Размер данных в байтах
+     * @param width Ширина изображения (выходной параметр)
+     * @param height Высота изображения (выходной параметр)
+     * @return true если заголовки описывают поддерживаемый BMP (24 бита, без сжатия)
+     */
+    bool readBMPInfo(const uint8_t* data, size_t size, int& width, int& height);
 
     /**
      * @brief Сохраняет изображение в BMP файл
-     * 
+     *
      * @param filename Путь к выходному BMP файлу
      * @param width Ширина изображения
      * @param height Высота изображения
@@ -36,5 +75,160 @@ namespace BMPHandler
      * @return true если сохранение успешно, false в противном случае
      */
     bool saveBMP(const std::string& filename, int width, int height, int channels, const uint8_t* data);
-}
 
+    /**
+     * @brief Кодирует изображение в BMP, передавая байты приемнику по порядку
+     *
+     * @param width Ширина изображения
+     * @param height Высота изображения
+     * @param channels Количество каналов (1-4; при 4 альфа отбрасывается)
+     * @param data Данные изображения
+     * @param sink Приемник байтов файла; false прерывает кодирование
+     * @return true если все байты переданы приемнику
+     */
+    bool encodeBMP(int width, int height, int channels, const uint8_t* data,
+                   const std::function<bool(const uint8_t* bytes, size_t size)>& sink);
+
+    /**
+     * @brief Читает BMP файл построчно, передавая строки обработчику
+     *
+     * @param filename Путь к BMP файлу
+     * @param channels Количество каналов строк: 3 (RGB) или 4 (RGBA)
+     * @param on_header Вызывается один раз с размерами изображения; false прерывает чтение
+     * @param on_row Вызывается для каждой строки сверху вниз с ее номером; false прерывает чтение
+     * @return true если все строки прочитаны и обработаны
+     *
+     * @note Указатель на строку действителен только во время вызова on_row
+     */
+    bool readBMPRows(const std::string& filename, int channels,
+                     const std::function<bool(int width, int height)>& on_header,
+                     const std::function<bool(const uint8_t* row, int y)>& on_row);
+
+    /**
+     * @brief Меняет местами каналы R и B (BGR ↔ RGB)
+     * @param source Исходные пиксели по 3 байта
+     * @param destination Результат по 3 байта (не должен перекрываться с source)
+     * @param pixels Количество пикселей
+     */
+    void swapRedBlue(const uint8_t* source, uint8_t* destination, size_t pixels) noexcept;
+
+    /**
+     * @brief Преобразует BGR в RGBA с альфой 255
+     */
+    void convertBGRToRGBA(const uint8_t* source, uint8_t* destination, size_t pixels) noexcept;
+
+    /**
+     * @brief Преобразует RGBA в BGR, отбрасывая альфа-канал
+     */
+    void convertRGBAToBGR(const uint8_t* source, uint8_t* destination, size_t pixels) noexcept;
+
+    /**
+     * @brief Построчное чтение 24-битного BMP
+     *
+     * Строки отдаются сверху вниз независимо от порядка хранения в файле.
+     */
+    class BMPReader
+    {
+    public:
+        BMPReader() = default;
+        ~BMPReader();
+
+        BMPReader(const BMPReader&) = delete;
+        BMPReader& operator=(const BMPReader&) = delete;
+
+        /**
+         * @brief Открывает файл и проверяет заголовки и размер данных
+         * @param filename Путь к BMP файлу
+         * @return true если файл - поддерживаемый BMP и содержит все строки
+         */
+        bool open(const std::string& filename);
+
+        /**
+         * @brief Открывает BMP из памяти (данные не копируются и должны жить до close())
+         * @param data Содержимое BMP файла
+         * @param size Размер данных в байтах
+         * @return true если данные - поддерживаемый BMP и содержат все строки
+         */
+        bool open(const uint8_t* data, size_t size);
+
+        /**
+         * @brief Закрывает файл и освобождает отображение
+         */
+        void close() noexcept;
+
+        [[nodiscard]] int getWidth() const noexcept { return width_; }
+        [[nodiscard]] int getHeight() const noexcept { return height_; }
+
+        /**
+         * @brief Читает следующие count строк
+         * @param destination Буфер размером не меньше count * width * channels байт
+         * @param count Количество строк (не больше оставшегося)
+         * @param channels Количество каналов результата: 3 (RGB) или 4 (RGBA)
+         * @return true если строки прочитаны
+         */
+        bool readRows(uint8_t* destination, int count, int channels);
+
+    private:
+        bool parseHeaders(const uint8_t* headers, size_t file_size);
+        const uint8_t* getFileRow(int file_row);
+
+        MappedFile mapped_file_;
+        const uint8_t* data_ = nullptr; // Содержимое файла в памяти (отображение или внешний буфер)
+        std::ifstream file_;
+        std::vector<uint8_t> row_buffer_;
+        size_t data_offset_ = 0;
+        size_t row_size_ = 0;
+        int width_ = 0;
+        int height_ = 0;
+        int next_row_ = 0;
+        bool top_down_ = false;
+    };
+
+    /**
+     * @brief Построчная запись 24-битного BMP
+     *
+     * Строки принимаются сверху вниз, а в файл пишутся в стандартном порядке
+     * снизу вверх: каждая порция строк записывается одним блоком на свое место.
+     */
+    class BMPWriter
+    {
+    public:
+        BMPWriter() = default;
+
+        BMPWriter(const BMPWriter&) = delete;
+        BMPWriter& operator=(const BMPWriter&) = delete;
+
+        /**
+         * @brief Создает файл и записывает заголовки
+         * @param filename Путь к выходному файлу
+         * @param width Ширина изображения
+         * @param height Высота изображения
+         * @return true если файл создан
+         */
+        bool open(const std::string& filename, int width, int height);
+
+        /**
+         * @brief Записывает следующие count строк
+         * @param source Строки подряд, width * channels байт каждая
+         * @param count Количество строк
+         * @param channels Количество каналов строк (1-4; при 4 альфа отбрасывается)
+         * @return true если строки записаны
+         */
+        bool writeRows(const uint8_t* source, int count, int channels);
+
+        /**
+         * @brief Проверяет, что записаны все строки, и закрывает файл
+         * @return true если файл полностью записан
+         */
+        bool finish();
+
+    private:
+        std::ofstream file_;
+        std::vector<uint8_t> block_;
+        size_t data_offset_ = 0;
+        size_t row_size_ = 0;
+        int width_ = 0;
+        int height_ = 0;
+        int next_row_ = 0;
+    };
+}
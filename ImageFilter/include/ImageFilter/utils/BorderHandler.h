@@ -60,6 +60,12 @@ public:
      */
     [[nodiscard]] Strategy getStrategy() const noexcept;
 
+    /**
+     * @brief Получить имя текущей стратегии
+     * @return "mirror", "clamp", "wrap" или "extend"
+     */
+    [[nodiscard]] const char* getStrategyName() const noexcept;
+
 private:
     Strategy strategy_;  ///< Текущая стратегия обработки границ
 };
@@ -0,0 +1,262 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <tuple>
+#include <unordered_map>
+
+/**
+ * @brief Потокобезопасный кэш с ограничением по объему и вытеснением CLOCK
+ *
+ * Используется CacheManager для ядер свертки и LUT таблиц.
+ *
+ * Особенности:
+ * - Значения выдаются как std::shared_ptr<const Value>: попадание стоит
+ *   одного увеличения счетчика ссылок
+ * - Однократная генерация (single-flight): при одновременных промахах по одному
+ *   ключу генератор вызывается одним потоком, остальные ожидают результат
+ * - Ограничение суммарного объема значений в байтах; вытеснение по алгоритму
+ *   CLOCK (приближение LRU), при котором попадание выполняется под shared lock
+ *   и только выставляет флаг обращения
+ * - Счетчики попаданий, промахов, вытеснений и занятого объема
+ *
+ * @tparam Key Тип ключа
+ * @tparam Hash Хэш-функция ключа
+ * @tparam Value Тип значения (контейнер с size() и value_type)
+ */
+template <typename Key, typename Hash, typename Value>
+class BoundedCache
+{
+public:
+    using Ptr = std::shared_ptr<const Value>;
+    using Generator = std::function<Value(const Key&)>;
+
+    /**
+     * @brief Статистика использования кэша
+     */
+    struct Statistics
+    {
+        size_t entries = 0;      ///< Количество записей (включая генерируемые)
+        size_t bytes = 0;        ///< Объем значений в байтах
+        size_t max_bytes = 0;    ///< Ограничение объема в байтах
+        uint64_t hits = 0;       ///< Количество попаданий
+        uint64_t misses = 0;     ///< Количество промахов (вызовов генератора)
+        uint64_t evictions = 0;  ///< Количество вытесненных записей
+    };
+
+    /**
+     * @brief Конструктор
+     * @param max_bytes Ограничение суммарного объема значений в байтах
+     */
+    explicit BoundedCache(size_t max_bytes) noexcept
+        : hand_(ring_.end()), max_bytes_(max_bytes)
+    {
+    }
+
+    BoundedCache(const BoundedCache&) = delete;
+    BoundedCache& operator=(const BoundedCache&) = delete;
+
+    /**
+     * @brief Получает значение из кэша или генерирует его
+     * @param key Ключ
+     * @param generator Функция генерации, вызывается с ключом только при промахе
+     * @return Разделяемое значение
+     * @throws Исключение генератора; в этом случае ключ не кэшируется
+     */
+    Ptr getOrGenerate(const Key& key, const Generator& generator)
+    {
+        // Попадание: shared lock, флаг обращения и копирование shared_future
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex_);
+            const auto it = entries_.find(key);
+            if (it != entries_.end())
+            {
+                it->second.referenced.store(true, std::memory_order_relaxed);
+                hits_.fetch_add(1, std::memory_order_relaxed);
+                const auto pending = it->second.value;
+                lock.unlock();
+                return pending.get();
+            }
+        }
+
+        std::promise<Ptr> promise;
+        uint64_t id = 0;
+        {
+            std::unique_lock<std::shared_mutex> lock(mutex_);
+            // Проверяем еще раз: другой поток мог начать генерацию этого ключа
+            const auto it = entries_.find(key);
+            if (it != entries_.end())
+            {
+                it->second.referenced.store(true, std::memory_order_relaxed);
+                hits_.fetch_add(1, std::memory_order_relaxed);
+                const auto pending = it->second.value;
+                lock.unlock();
+                return pending.get();
+            }
+
+            misses_.fetch_add(1, std::memory_order_relaxed);
+            id = ++next_id_;
+            auto& entry = entries_.emplace(std::piecewise_construct,
+                                           std::forward_as_tuple(key),
+                                           std::forward_as_tuple()).first->second;
+            entry.value = promise.get_future().share();
+            entry.id = id;
+            entry.ring_position = ring_.insert(hand_, key);
+        }
+
+        // Генерируем значение без блокировки кэша
+        Ptr value;
+        try
+        {
+            value = std::make_shared<const Value>(generator(key));
+        }
+        catch (...)
+        {
+            // Ожидающие потоки получат исключение, а ключ удаляется для повторной попытки
+            promise.set_exception(std::current_exception());
+            std::unique_lock<std::shared_mutex> lock(mutex_);
+            const auto it = entries_.find(key);
+            if (it != entries_.end() && it->second.id == id)
+            {
+                eraseLocked(it);
+            }
+            throw;
+        }
+        promise.set_value(value);
+
+        {
+            std::unique_lock<std::shared_mutex> lock(mutex_);
+            // Запись могла быть удалена clear() во время генерации
+            const auto it = entries_.find(key);
+            if (it != entries_.end() && it->second.id == id)
+            {
+                it->second.bytes = value->size() * sizeof(typename Value::value_type);
+                it->second.ready = true;
+                bytes_ += it->second.bytes;
+                evictLocked();
+            }
+        }
+
+        return value;
+    }
+
+    /**
+     * @brief Устанавливает ограничение объема и при необходимости вытесняет записи
+     * @param max_bytes Ограничение суммарного объема значений в байтах
+     */
+    void setMaxBytes(size_t max_bytes)
+    {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        max_bytes_ = max_bytes;
+        evictLocked();
+    }
+
+    /**
+     * @brief Удаляет все записи (выданные значения остаются действительными)
+     */
+    void clear() noexcept
+    {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        entries_.clear();
+        ring_.clear();
+        hand_ = ring_.end();
+        bytes_ = 0;
+    }
+
+    /**
+     * @brief Возвращает статистику использования
+     */
+    [[nodiscard]] Statistics getStatistics() const noexcept
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        Statistics stats;
+        stats.entries = entries_.size();
+        stats.bytes = bytes_;
+        stats.max_bytes = max_bytes_;
+        stats.hits = hits_.load(std::memory_order_relaxed);
+        stats.misses = misses_.load(std::memory_order_relaxed);
+        stats.evictions = evictions_.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+private:
+    /**
+     * @brief Запись кэша
+     */
+    struct Entry
+    {
+        std::shared_future<Ptr> value;                  ///< Значение или ожидание генерации
+        size_t bytes = 0;                               ///< Объем значения (0 до завершения генерации)
+        uint64_t id = 0;                                ///< Идентификатор генерации
+        bool ready = false;                             ///< Генерация завершена
+        std::atomic<bool> referenced{true};             ///< Флаг обращения для CLOCK
+        typename std::list<Key>::iterator ring_position;  ///< Позиция в кольце CLOCK
+    };
+
+    using EntryIterator = typename std::unordered_map<Key, Entry, Hash>::iterator;
+
+    /**
+     * @brief Удаляет запись, сохраняя корректность стрелки CLOCK (под unique lock)
+     */
+    void eraseLocked(EntryIterator it) noexcept
+    {
+        if (hand_ == it->second.ring_position)
+        {
+            hand_ = ring_.erase(hand_);
+        }
+        else
+        {
+            ring_.erase(it->second.ring_position);
+        }
+        bytes_ -= it->second.bytes;
+        entries_.erase(it);
+    }
+
+    /**
+     * @brief Вытесняет записи, пока объем превышает ограничение (под unique lock)
+     *
+     * Стрелка обходит кольцо: запись с флагом обращения получает второй шанс
+     * (флаг сбрасывается), запись без флага вытесняется. Генерируемые записи пропускаются.
+     */
+    void evictLocked() noexcept
+    {
+        // Два полных оборота достаточно, чтобы сбросить все флаги и найти жертву
+        size_t steps_left = ring_.size() * 2 + 1;
+        while (bytes_ > max_bytes_ && !ring_.empty() && steps_left-- > 0)
+        {
+            if (hand_ == ring_.end())
+            {
+                hand_ = ring_.begin();
+            }
+
+            const auto it = entries_.find(*hand_);
+            if (!it->second.ready || it->second.referenced.exchange(false, std::memory_order_relaxed))
+            {
+                ++hand_;
+                continue;
+            }
+
+            eraseLocked(it);
+            evictions_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    mutable std::shared_mutex mutex_;
+    std::unordered_map<Key, Entry, Hash> entries_;
+    std::list<Key> ring_;
+    typename std::list<Key>::iterator hand_;
+    size_t bytes_ = 0;
+    size_t max_bytes_;
+    uint64_t next_id_ = 0;
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> misses_{0};
+    std::atomic<uint64_t> evictions_{0};
+};
@@ -1,6 +1,9 @@
 #pragma once
 
 #include <utils/IBufferPool.h>
+#include <array>
+#include <atomic>
+#include <memory>
 #include <mutex>
 #include <vector>
 #include <cstdint>
@@ -13,10 +16,18 @@
  * для уменьшения количества аллокаций памяти при обработке изображений.
  * 
  * Особенности:
- * - Thread-safe: все операции синхронизированы через мьютекс
- * - Автоматическое управление размером пула
+ * - Классы размеров по степеням двойки: буфер выделяется с capacity, округленной
+ *   вверх до степени двойки, и хранится в списке своего класса. Поиск буфера —
+ *   O(1) вместо линейного просмотра всего пула
+ * - Сегментированный пул: буферы хранятся в нескольких сегментах со своими мьютексами.
+ *   Каждый поток закреплен за «домашним» сегментом, который служит ему локальным
+ *   кэшем; при промахе буфер забирается из других сегментов
+ * - Неинициализированная выдача: acquire() не заполняет буфер нулями
+ *   (см. PooledBuffer), повторное использование кадрового буфера не стоит memset
  * - Поддержка предварительного резервирования буферов
- * - Оптимизация для частых операций acquire/release
+ *
+ * Сегменты принадлежат пулу, а не потокам (thread_local), поэтому буферы
+ * освобождаются вместе с пулом, даже если он создается на одно изображение.
  * 
  * @note Рекомендуется использовать один экземпляр BufferPool на весь процесс
  * или на цепочку фильтров для максимальной эффективности.
@@ -28,8 +39,13 @@ public:
      * @brief Конструктор пула буферов
      * 
      * @param max_pool_size Максимальное количество буферов в пуле (0 = без ограничений)
+     * @param shard_count Количество сегментов (0 = по числу аппаратных потоков);
+     *                    округляется вверх до степени двойки
+     * @param allocator Распределитель памяти буферов (nullptr = ImageAllocator::getDefault()
+     *                  на момент создания пула)
      */
-    explicit BufferPool(size_t max_pool_size = 0);
+    explicit BufferPool(size_t max_pool_size = 0, size_t shard_count = 0,
+                        IImageAllocator* allocator = nullptr);
 
     /**
      * @brief Деструктор - освобождает все буферы
@@ -43,27 +59,30 @@ public:
     /**
      * @brief Получить буфер из пула или создать новый
      * 
-     * Если в пуле есть буфер подходящего размера, он будет возвращен.
-     * В противном случае создается новый буфер.
+     * Буфер берется из списка класса размера size: сначала в домашнем сегменте
+     * потока, затем в остальных. Если буфера нет, создается новый с capacity,
+     * равной размеру класса. Содержимое буфера не инициализируется.
      * 
      * @param size Минимальный размер буфера в байтах
-     * @return std::vector<uint8_t> Буфер с зарезервированной памятью (capacity >= size)
+     * @return PooledBuffer Буфер размера size (capacity >= size)
      */
-    std::vector<uint8_t> acquire(size_t size) override;
+    PooledBuffer acquire(size_t size) override;
 
     /**
      * @brief Вернуть буфер в пул для переиспользования
      * 
-     * Буфер будет добавлен в пул, если есть место и размер пула не превышен.
+     * Буфер будет добавлен в домашний сегмент потока, если размер пула не превышен.
+     * Класс определяется по capacity (округление вниз до степени двойки), поэтому
+     * принимаются и буферы, созданные не пулом.
      * 
      * @param buffer Буфер для возврата в пул (будет перемещен)
      */
-    void release(std::vector<uint8_t>&& buffer) override;
+    void release(PooledBuffer&& buffer) override;
 
     /**
      * @brief Предварительно зарезервировать буферы определенного размера
      * 
-     * Создает указанное количество буферов заданного размера и добавляет их в пул.
+     * Создает указанное количество буферов класса размера size и добавляет их в пул.
      * 
      * @param size Размер каждого буфера в байтах
      * @param count Количество буферов для резервирования
@@ -114,19 +133,49 @@ public:
     void getStats(size_t& total_buffers, size_t& total_memory, 
                  size_t& largest_buffer, size_t& smallest_buffer) const override;
 
-private:
     /**
-     * @brief Находит буфер подходящего размера в пуле
+     * @brief Получить количество сегментов пула
      * 
-     * Ищет буфер с capacity >= size. Если такого нет, возвращает пустой optional.
+     * @return size_t Количество сегментов (степень двойки)
+     */
+    [[nodiscard]] size_t getShardCount() const noexcept;
+
+    /**
+     * @brief Получить класс размера для запроса
      * 
-     * @param size Требуемый размер буфера
-     * @return Индекс найденного буфера или -1 если не найден
+     * @param size Размер в байтах
+     * @return size_t Показатель степени двойки, не меньшей size (не меньше MIN_SIZE_CLASS)
      */
-    int findSuitableBuffer(size_t size) const;
+    [[nodiscard]] static size_t getSizeClass(size_t size) noexcept;
 
-    mutable std::mutex mutex_;                    // Мьютекс для синхронизации
-    std::vector<std::vector<uint8_t>> buffers_;    // Пул буферов
-    size_t max_pool_size_;                         // Максимальный размер пула (0 = без ограничений)
-};
+private:
+    static constexpr size_t SIZE_CLASS_COUNT = 64;  // Классы 2^0 .. 2^63
+    static constexpr size_t MIN_SIZE_CLASS = 6;     // Минимальный класс: 64 байта
+
+    /**
+     * @brief Сегмент пула: списки свободных буферов по классам размеров
+     *
+     * Выравнивание по строке кэша исключает ложное разделение мьютексов.
+     */
+    struct alignas(64) Shard
+    {
+        mutable std::mutex mutex;
+        std::array<std::vector<PooledBuffer>, SIZE_CLASS_COUNT> free_lists;
+    };
+
+    /**
+     * @brief Возвращает домашний сегмент текущего потока
+     */
+    [[nodiscard]] Shard& homeShard() const noexcept;
 
+    /**
+     * @brief Удаляет буферы, пока их количество превышает max_count
+     */
+    void trimTo(size_t max_count) noexcept;
+
+    IImageAllocator& allocator_;                     // Распределитель памяти буферов
+    std::unique_ptr<Shard[]> shards_;               // Сегменты пула
+    size_t shard_mask_;                              // shard_count - 1
+    std::atomic<size_t> buffer_count_{0};            // Количество буферов во всех сегментах
+    std::atomic<size_t> max_pool_size_;              // Максимальный размер пула (0 = без ограничений)
+};
@@ -1,9 +1,10 @@
 #pragma once
 
+#include <utils/BoundedCache.h>
+#include <atomic>
 #include <cstdint>
 #include <vector>
-#include <unordered_map>
-#include <shared_mutex>
+#include <memory>
 #include <functional>
 
 /**
@@ -100,10 +101,30 @@ struct LUTCacheKeyHash
  * - LUT таблиц для преобразований (гамма-коррекция, яркость, контраст)
  * 
  * Thread-safe: все операции синхронизированы с использованием shared_mutex
+ * 
+ * Значения выдаются как std::shared_ptr на неизменяемый вектор: попадание в кэш
+ * стоит одного увеличения счетчика ссылок, без копирования данных.
+ * Генерация выполняется однократно (single-flight): если несколько потоков
+ * одновременно запрашивают отсутствующий ключ, генератор вызывается одним из них,
+ * а остальные ожидают его результат.
+ * 
+ * Объем каждого кэша ограничен (см. CacheLimits), лишние записи вытесняются
+ * по алгоритму CLOCK. Ключи могут квантоваться, чтобы близкие параметры
+ * (например, радиусы при перетаскивании слайдера) использовали одну запись.
  */
 class CacheManager
 {
 public:
+    /**
+     * @brief Разделяемое неизменяемое ядро свертки
+     */
+    using KernelPtr = std::shared_ptr<const std::vector<int32_t>>;
+
+    /**
+     * @brief Разделяемая неизменяемая LUT таблица
+     */
+    using LUTPtr = std::shared_ptr<const std::vector<uint8_t>>;
+
     /**
      * @brief Получает единственный экземпляр CacheManager (Singleton)
      * @return Ссылка на CacheManager
@@ -113,22 +134,54 @@ public:
     /**
      * @brief Получает или генерирует ядро свертки из кэша
      * @param key Ключ кэша (тип, радиус, sigma)
-     * @param generator Функция генерации ядра, если его нет в кэше
-     * @return Вектор коэффициентов ядра (масштабированные на 65536)
+     * @param generator Функция генерации ядра, вызывается только при промахе с ключом
+     *                  после квантования; ядро должно строиться по параметрам этого ключа
+     * @return Ядро (коэффициенты масштабированы на 65536), разделяемое с кэшем
+     * @throws Исключение генератора; в этом случае ключ не кэшируется
      */
-    std::vector<int32_t> getOrGenerateKernel(
+    KernelPtr getOrGenerateKernel(
         const KernelCacheKey& key,
-        const std::function<std::vector<int32_t>()>& generator);
+        const std::function<std::vector<int32_t>(const KernelCacheKey&)>& generator);
     
     /**
      * @brief Получает или генерирует LUT таблицу из кэша
      * @param key Ключ кэша (тип, параметр)
-     * @param generator Функция генерации LUT, если её нет в кэше
-     * @return Вектор значений LUT (256 элементов для 8-битных значений)
+     * @param generator Функция генерации LUT, вызывается только при промахе с ключом
+     *                  после квантования; таблица должна строиться по параметру этого ключа
+     * @return LUT (256 элементов для 8-битных значений), разделяемая с кэшем
+     * @throws Исключение генератора; в этом случае ключ не кэшируется
      */
-    std::vector<uint8_t> getOrGenerateLUT(
+    LUTPtr getOrGenerateLUT(
         const LUTCacheKey& key,
-        const std::function<std::vector<uint8_t>()>& generator);
+        const std::function<std::vector<uint8_t>(const LUTCacheKey&)>& generator);
+
+    /**
+     * @brief Ограничения кэшей
+     */
+    struct CacheLimits
+    {
+        size_t kernel_max_bytes = 8 * 1024 * 1024;  ///< Объем кэша ядер (байт)
+        size_t lut_max_bytes = 1024 * 1024;         ///< Объем кэша LUT (байт)
+        double kernel_key_step = 0.0;               ///< Шаг квантования radius/sigma (0 = без квантования)
+        double lut_key_step = 0.0;                  ///< Шаг квантования параметра LUT (0 = без квантования)
+    };
+
+    /**
+     * @brief Устанавливает ограничения кэшей
+     * 
+     * Уменьшение объема сразу вытесняет лишние записи. Новый шаг квантования
+     * применяется к последующим запросам. Значение, которое квантование
+     * превратило бы в особую точку генератора (sigma = 0, gamma = 0,
+     * контраст = 1), кэшируется без квантования.
+     * 
+     * @param limits Новые ограничения
+     */
+    void setLimits(const CacheLimits& limits);
+
+    /**
+     * @brief Возвращает текущие ограничения кэшей
+     */
+    CacheLimits getLimits() const noexcept;
     
     /**
      * @brief Очищает кэш ядер свертки
@@ -153,12 +206,27 @@ public:
     {
         size_t kernel_cache_size = 0;
         size_t lut_cache_size = 0;
+
+        /**
+         * @brief Счетчики одного кэша
+         */
+        struct Counters
+        {
+            uint64_t hits = 0;       ///< Попадания
+            uint64_t misses = 0;     ///< Промахи (вызовы генератора)
+            uint64_t evictions = 0;  ///< Вытесненные записи
+            size_t bytes = 0;        ///< Занятый объем (байт)
+            size_t max_bytes = 0;    ///< Ограничение объема (байт)
+        };
+
+        Counters kernel;  ///< Кэш ядер свертки
+        Counters lut;     ///< Кэш LUT таблиц
     };
     
     CacheStatistics getStatistics() const noexcept;
 
 private:
-    CacheManager() = default;
+    CacheManager();
     ~CacheManager() = default;
     
     // Запрещаем копирование и присваивание
@@ -166,11 +234,11 @@ private:
     CacheManager& operator=(const CacheManager&) = delete;
     
     // Кэш ядер свертки
-    mutable std::shared_mutex kernel_cache_mutex_;
-    std::unordered_map<KernelCacheKey, std::vector<int32_t>, KernelCacheKeyHash> kernel_cache_;
+    BoundedCache<KernelCacheKey, KernelCacheKeyHash, std::vector<int32_t>> kernel_cache_;
+    std::atomic<double> kernel_key_step_{0.0};
     
     // Кэш LUT таблиц
-    mutable std::shared_mutex lut_cache_mutex_;
-    std::unordered_map<LUTCacheKey, std::vector<uint8_t>, LUTCacheKeyHash> lut_cache_;
+    BoundedCache<LUTCacheKey, LUTCacheKeyHash, std::vector<uint8_t>> lut_cache_;
+    std::atomic<double> lut_key_step_{0.0};
 };
 
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+/**
+ * @brief Общий бюджет потоков для вложенного параллелизма
+ *
+ * Пакетная обработка запускает по потоку на файл, а фильтры внутри файла
+ * распараллеливают строки (ParallelImageProcessor::processRowsParallel).
+ * Без согласования на N ядрах получается до N² потоков. Губернатор хранит
+ * общий бюджет (по умолчанию число аппаратных потоков) и учитывает:
+ * - рабочие потоки уровня файлов (acquireWorker());
+ * - дополнительные потоки уровня строк (acquireRowThreads()).
+ *
+ * Построчный параллелизм получает только свободную часть бюджета, поэтому
+ * при загруженных файловых потоках фильтры работают последовательно,
+ * а когда файлов в работе мало - занимают освободившиеся ядра.
+ * Очень большие изображения обрабатываются в монопольном режиме
+ * (acquireExclusive()): новые файлы не начинаются, пока такое изображение
+ * не обработано всеми потоками бюджета.
+ *
+ * @note Все методы класса thread-safe
+ */
+class ConcurrencyGovernor
+{
+public:
+    /**
+     * @brief Разрешение на потоки; освобождается в деструкторе
+     */
+    class Lease
+    {
+    public:
+        Lease() noexcept = default;
+        ~Lease();
+
+        Lease(Lease&& other) noexcept;
+        Lease& operator=(Lease&& other) noexcept;
+
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        /**
+         * @brief Количество потоков, которыми может пользоваться владелец
+         * @return Для разрешения строк - число потоков с учетом вызывающего (не меньше 1)
+         */
+        [[nodiscard]] int getThreads() const noexcept { return threads_; }
+
+        /**
+         * @brief Досрочно освобождает разрешение
+         */
+        void release() noexcept;
+
+    private:
+        friend class ConcurrencyGovernor;
+
+        enum class Kind
+        {
+            None,
+            Worker,
+            Rows,
+            Exclusive
+        };
+
+        Lease(ConcurrencyGovernor* governor, Kind kind, int threads, int tokens) noexcept;
+
+        ConcurrencyGovernor* governor_ = nullptr;
+        Kind kind_ = Kind::None;
+        int threads_ = 1;
+        int tokens_ = 0;
+    };
+
+    /**
+     * @brief Получает глобальный экземпляр
+     */
+    static ConcurrencyGovernor& getInstance();
+
+    /**
+     * @brief Создает губернатор с заданным бюджетом
+     * @param thread_budget Бюджет потоков (0 = количество аппаратных потоков)
+     */
+    explicit ConcurrencyGovernor(int thread_budget = 0);
+
+    ConcurrencyGovernor(const ConcurrencyGovernor&) = delete;
+    ConcurrencyGovernor& operator=(const ConcurrencyGovernor&) = delete;
+
+    /**
+     * @brief Устанавливает бюджет потоков
+     * @param thread_budget Бюджет потоков (0 = количество аппаратных потоков)
+     */
+    void setThreadBudget(int thread_budget);
+
+    [[nodiscard]] int getThreadBudget() const;
+
+    /**
+     * @brief Устанавливает порог монопольной обработки
+     * @param pixels Размер изображения (width * height), начиная с которого
+     *               изображение обрабатывается монопольно (0 = никогда)
+     */
+    void setExclusiveThreshold(int64_t pixels);
+
+    [[nodiscard]] int64_t getExclusiveThreshold() const;
+
+    /**
+     * @brief Регистрирует текущий поток как рабочий поток уровня файлов
+     *
+     * Ждет, пока завершится или дождется своей очереди монопольная обработка.
+     * Пока разрешение живо, поток занимает одну единицу бюджета.
+     */
+    [[nodiscard]] Lease acquireWorker();
+
+    /**
+     * @brief Запрашивает потоки для построчной обработки
+     *
+     * Не блокируется: выдает не больше свободной части бюджета. Рабочий поток
+     * уровня файлов во время ожидания строк простаивает, поэтому его единица
+     * учитывается как свободная.
+     *
+     * @param requested Желаемое количество потоков с учетом вызывающего
+     * @return Разрешение; getThreads() == 1 означает последовательную обработку
+     */
+    [[nodiscard]] Lease acquireRowThreads(int requested);
+
+    /**
+     * @brief Запрашивает монопольную обработку изображения
+     *
+     * Для изображений не меньше порога (см. setExclusiveThreshold()) рабочий поток
+     * уровня файлов ждет, пока остальные рабочие потоки закончат свои файлы,
+     * после чего все потоки бюджета достаются построчной обработке этого изображения.
+     * Вне рабочих потоков и для меньших изображений возвращает пустое разрешение сразу.
+     *
+     * @param width Ширина изображения
+     * @param height Высота изображения
+     */
+    [[nodiscard]] Lease acquireExclusive(int width, int height);
+
+    /**
+     * @brief Количество занятых единиц бюджета (рабочие потоки и потоки строк)
+     */
+    [[nodiscard]] int getThreadsInUse() const;
+
+    /**
+     * @brief Пиковое количество занятых единиц бюджета
+     */
+    [[nodiscard]] int getPeakThreadsInUse() const;
+
+    /**
+     * @brief Сбрасывает пиковое значение
+     */
+    void resetPeak();
+
+    /**
+     * @brief Порог монопольной обработки по умолчанию (≈ 24 МП)
+     */
+    static constexpr int64_t DEFAULT_EXCLUSIVE_THRESHOLD = 6000 * 4000;
+
+private:
+    void release(Lease::Kind kind, int tokens) noexcept;
+    void updatePeak();
+
+    mutable std::mutex mutex_;
+    std::condition_variable changed_;
+    int thread_budget_ = 1;
+    int64_t exclusive_threshold_ = DEFAULT_EXCLUSIVE_THRESHOLD;
+    int workers_ = 0;            // Рабочие потоки уровня файлов
+    int row_threads_ = 0;        // Дополнительные потоки уровня строк
+    int exclusive_waiting_ = 0;  // Ожидающие монопольной обработки
+    bool exclusive_active_ = false;
+    int peak_threads_ = 0;
+};
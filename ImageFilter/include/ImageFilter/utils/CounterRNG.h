@@ -0,0 +1,105 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Счетчиковый (counter-based) генератор псевдослучайных чисел Philox4x32-10
+ *
+ * В отличие от генераторов с внутренним состоянием (std::mt19937), результат
+ * является чистой функцией от пары (ключ, счетчик). Это позволяет:
+ * - получать случайное значение для любого пикселя напрямую по его индексу;
+ * - обрабатывать изображение в любом количестве потоков с побитово одинаковым результатом;
+ * - генерировать сразу блок значений в цикле без зависимостей между итерациями,
+ *   который компилятор векторизует (умножения 32x32->64 хорошо ложатся на SIMD).
+ *
+ * Алгоритм: J. Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3" (Random123).
+ */
+namespace CounterRNG
+{
+    /**
+     * @brief Константы раундов Philox4x32
+     */
+    namespace PhiloxConstants
+    {
+        constexpr uint32_t M0 = 0xD2511F53u;  ///< Множитель для слов 0/1
+        constexpr uint32_t M1 = 0xCD9E8D57u;  ///< Множитель для слов 2/3
+        constexpr uint32_t W0 = 0x9E3779B9u;  ///< Приращение ключа (золотое сечение)
+        constexpr uint32_t W1 = 0xBB67AE85u;  ///< Приращение ключа (sqrt(3) - 1)
+        constexpr int ROUNDS = 10;            ///< Количество раундов
+    }
+
+    /**
+     * @brief Вычисляет один блок Philox4x32-10
+     *
+     * @param counter 128-битный счетчик (4 слова)
+     * @param key 64-битный ключ (2 слова)
+     * @return 4 псевдослучайных 32-битных слова
+     */
+    constexpr std::array<uint32_t, 4> philox4x32(std::array<uint32_t, 4> counter,
+                                                 std::array<uint32_t, 2> key) noexcept
+    {
+        for (int round = 0; round < PhiloxConstants::ROUNDS; ++round)
+        {
+            const uint64_t product0 = static_cast<uint64_t>(PhiloxConstants::M0) * counter[0];
+            const uint64_t product1 = static_cast<uint64_t>(PhiloxConstants::M1) * counter[2];
+            const auto hi0 = static_cast<uint32_t>(product0 >> 32);
+            const auto lo0 = static_cast<uint32_t>(product0);
+            const auto hi1 = static_cast<uint32_t>(product1 >> 32);
+            const auto lo1 = static_cast<uint32_t>(product1);
+
+            counter = {hi1 ^ counter[1] ^ key[0], lo1, hi0 ^ counter[3] ^ key[1], lo0};
+            key[0] += PhiloxConstants::W0;
+            key[1] += PhiloxConstants::W1;
+        }
+        return counter;
+    }
+
+    /**
+     * @brief Генерирует блок случайных чисел для последовательных счетчиков
+     *
+     * Для каждого i в [0, count) вычисляет philox4x32({first_counter + i}, seed) и
+     * раскладывает 4 выходных слова по отдельным массивам (SoA), чтобы цикл
+     * не содержал зависимостей между итерациями и векторизовался компилятором.
+     *
+     * @param seed 64-битное зерно (ключ генератора)
+     * @param first_counter Счетчик первого элемента блока (например, глобальный индекс пикселя)
+     * @param count Количество элементов в блоке
+     * @param out0 Выходной массив для слова 0 (размер >= count)
+     * @param out1 Выходной массив для слова 1 (размер >= count)
+     * @param out2 Выходной массив для слова 2 (размер >= count)
+     * @param out3 Выходной массив для слова 3 (размер >= count)
+     */
+    inline void generateBlock(uint64_t seed, uint64_t first_counter, size_t count,
+                              uint32_t* out0, uint32_t* out1, uint32_t* out2, uint32_t* out3) noexcept
+    {
+        const std::array<uint32_t, 2> key = {static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)};
+        for (size_t i = 0; i < count; ++i)
+        {
+            const uint64_t counter = first_counter + i;
+            const auto words = philox4x32(
+                {static_cast<uint32_t>(counter), static_cast<uint32_t>(counter >> 32), 0u, 0u}, key);
+            out0[i] = words[0];
+            out1[i] = words[1];
+            out2[i] = words[2];
+            out3[i] = words[3];
+        }
+    }
+
+    /**
+     * @brief Отображает 32-битное случайное слово в диапазон [0, range)
+     *
+     * Использует умножение со сдвигом (метод Лемира) вместо деления по модулю.
+     * Смещение распределения не превышает range / 2^32 и для диапазонов
+     * пиксельных значений пренебрежимо мало.
+     *
+     * @param word Случайное 32-битное слово
+     * @param range Размер диапазона (> 0)
+     * @return Значение в диапазоне [0, range)
+     */
+    constexpr uint32_t toRange(uint32_t word, uint32_t range) noexcept
+    {
+        return static_cast<uint32_t>((static_cast<uint64_t>(word) * range) >> 32);
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief Аллокатор, выполняющий инициализацию по умолчанию вместо value-инициализации
+ *
+ * std::vector<uint8_t>::resize(n) заполняет новые элементы нулями. Для буферов,
+ * которые фильтр полностью перезаписывает, это лишний memset на весь кадр.
+ * С этим аллокатором resize() без значения оставляет память неинициализированной;
+ * resize(n, value), assign() и вставка значений работают как обычно.
+ *
+ * @tparam T Тип элемента
+ * @tparam A Базовый аллокатор
+ */
+template <typename T, typename A = std::allocator<T>>
+class DefaultInitAllocator : public A
+{
+    using Traits = std::allocator_traits<A>;
+
+public:
+    template <typename U>
+    struct rebind
+    {
+        using other = DefaultInitAllocator<U, typename Traits::template rebind_alloc<U>>;
+    };
+
+    using A::A;
+
+    DefaultInitAllocator() = default;
+
+    template <typename U, typename B>
+    DefaultInitAllocator(const DefaultInitAllocator<U, B>& other) noexcept
+        : A(static_cast<const B&>(other))
+    {
+    }
+
+    /**
+     * @brief Конструирование без аргументов: инициализация по умолчанию
+     */
+    template <typename U>
+    void construct(U* ptr) noexcept(std::is_nothrow_default_constructible_v<U>)
+    {
+        ::new (static_cast<void*>(ptr)) U;
+    }
+
+    /**
+     * @brief Конструирование с аргументами делегируется базовому аллокатору
+     */
+    template <typename U, typename... Args>
+    void construct(U* ptr, Args&&... args)
+    {
+        Traits::construct(static_cast<A&>(*this), ptr, std::forward<Args>(args)...);
+    }
+};
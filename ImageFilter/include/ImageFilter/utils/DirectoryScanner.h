@@ -0,0 +1,133 @@
+#pragma once
+
+#include <utils/FilterResult.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Параллельный потоковый обход директории с изображениями
+ *
+ * Несколько потоков обходят поддиректории одновременно, и найденные
+ * изображения сразу становятся доступны через next(): обработка первых
+ * файлов начинается, не дожидаясь окончания обхода всего дерева.
+ *
+ * На POSIX директории читаются через readdir, тип записи берется из d_type,
+ * поэтому stat выполняется только для символических ссылок и файловых
+ * систем, не заполняющих d_type. Символические ссылки на директории не
+ * обходятся (как в std::filesystem::recursive_directory_iterator).
+ *
+ * @note next(), getDiscoveredCount() и isComplete() thread-safe
+ */
+class DirectoryScanner
+{
+public:
+    /**
+     * @brief Параметры обхода
+     */
+    struct Options
+    {
+        bool recursive = false;   // Обходить поддиректории
+        std::string pattern;      // Шаблон имени файла (например, "*.jpg"; пусто = все изображения)
+        int threads = 0;          // Потоки обхода (0 = автоматически, не больше 4)
+    };
+
+    /**
+     * @brief Конструктор с параметрами по умолчанию (без рекурсии и шаблона)
+     * @param input_dir Входная директория
+     */
+    explicit DirectoryScanner(std::string input_dir);
+
+    /**
+     * @brief Конструктор
+     * @param input_dir Входная директория
+     * @param options Параметры обхода
+     */
+    DirectoryScanner(std::string input_dir, const Options& options);
+
+    /**
+     * @brief Останавливает обход и ждет завершения потоков
+     */
+    ~DirectoryScanner();
+
+    DirectoryScanner(const DirectoryScanner&) = delete;
+    DirectoryScanner& operator=(const DirectoryScanner&) = delete;
+
+    /**
+     * @brief Проверяет входную директорию и запускает потоки обхода
+     * @return FilterResult с результатом операции
+     */
+    FilterResult start();
+
+    /**
+     * @brief Получает следующее найденное изображение
+     * @param path Путь к изображению (выходной параметр)
+     * @return false если обход завершен и все изображения уже выданы
+     *
+     * Блокирует вызывающий поток, пока не будет найдено изображение или
+     * не завершится обход.
+     */
+    bool next(std::filesystem::path& path);
+
+    /**
+     * @brief Получает уже найденное изображение без ожидания
+     * @param path Путь к изображению (выходной параметр)
+     * @return false если сейчас нет найденных и еще не выданных изображений
+     */
+    bool tryNext(std::filesystem::path& path);
+
+    /**
+     * @brief Количество найденных на текущий момент изображений
+     */
+    [[nodiscard]] size_t getDiscoveredCount() const noexcept;
+
+    /**
+     * @brief Проверяет, завершен ли обход (количество найденных окончательное)
+     */
+    [[nodiscard]] bool isComplete() const noexcept;
+
+    /**
+     * @brief Проверяет имя файла на расширение изображения (jpg, jpeg, png) без учета регистра
+     * @param filename Имя файла
+     * @return true если имя файла - изображение
+     */
+    static bool isImageFileName(std::string_view filename) noexcept;
+
+    /**
+     * @brief Проверяет соответствие имени файла шаблону "*.ext" или точному имени без учета регистра
+     * @param filename Имя файла
+     * @param pattern Шаблон (пустой шаблон соответствует любому имени)
+     * @return true если соответствует
+     */
+    static bool matchesPattern(std::string_view filename, std::string_view pattern) noexcept;
+
+private:
+    void scanWorker();
+    void scanDirectory(const std::string& directory);
+    void addFiles(std::vector<std::filesystem::path>& files);
+    void addDirectory(std::string directory);
+    [[nodiscard]] bool accepts(std::string_view filename) const noexcept;
+
+    std::string input_dir_;
+    Options options_;
+    std::vector<std::thread> threads_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable directories_changed_;
+    std::condition_variable files_changed_;
+    std::deque<std::string> directories_;   // Директории, ожидающие обхода
+    size_t active_directories_ = 0;         // Директории в очереди и в обходе
+    std::deque<std::filesystem::path> files_;
+
+    std::atomic<bool> stopping_{false};
+    std::atomic<size_t> discovered_{0};
+    std::atomic<bool> complete_{false};
+};
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdio>
 #include <filesystem>
 #include <string>
 #include <vector>
@@ -12,6 +13,7 @@
  * - Проверку типов файлов
  * - Сопоставление файлов с шаблонами
  * - Работу с путями
+ * - Надежную запись журналов (сброс файла и директории на диск)
  */
 class FileSystemHelper
 {
@@ -22,6 +24,8 @@ public:
      * @param recursive Включить рекурсивный обход поддиректорий
      * @param pattern Шаблон для фильтрации файлов (например, "*.jpg")
      * @return Вектор путей к найденным изображениям
+     *
+     * Ждет окончания обхода; для обработки по мере обхода используйте DirectoryScanner.
      */
     static std::vector<std::filesystem::path> findImages(
         const std::string& input_dir,
@@ -60,16 +64,20 @@ public:
      */
     static bool ensureOutputDirectory(const std::filesystem::path& output_path);
 
-private:
     /**
-     * @brief Рекурсивно находит изображения в директории
-     * @param dir Директория для поиска
-     * @param images Вектор для сохранения найденных путей
-     * @param pattern Шаблон для фильтрации файлов
+     * @brief Сбрасывает буферы открытого файла на диск (fflush и fsync)
+     * @param file Открытый файл
+     * @return true если данные переданы на диск
      */
-    static void findImagesRecursive(
-        const std::filesystem::path& dir,
-        std::vector<std::filesystem::path>& images,
-        const std::string& pattern);
-};
+    static bool flushToDisk(std::FILE* file);
 
+    /**
+     * @brief Сбрасывает на диск директорию, содержащую файл
+     * @param file_path Путь к файлу
+     * @return true если директория сброшена (или платформа не поддерживает fsync)
+     *
+     * Вызывается после rename(): без этого после сбоя питания переименование
+     * может быть потеряно, даже если содержимое нового файла уже на диске.
+     */
+    static bool syncDirectory(const std::filesystem::path& file_path);
+};
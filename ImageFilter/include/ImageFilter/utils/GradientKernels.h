@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief Построчные ядра градиента 3x3 для детекции краёв
+ *
+ * Ядра работают над тремя строками градаций серого (см. GrayscaleRowWindow)
+ * и записывают горизонтальный и вертикальный градиенты в массивы int16_t.
+ * Для каждого оператора внутренний цикл строки инстанцируется отдельно
+ * с константными весами и не содержит ветвлений и проверок границ, поэтому
+ * компилятор векторизует его; граница обрабатывается только в крайних пикселях.
+ *
+ * Диапазон значений: |G| <= 16 * 255 = 4080 (оператор Шарра), что помещается в int16_t.
+ */
+namespace GradientKernels
+{
+    /**
+     * @brief Оператор градиента
+     */
+    enum class Operator
+    {
+        Sobel,    ///< Оператор Собеля (веса 1, 2)
+        Prewitt,  ///< Оператор Преввитта (веса 1, 1)
+        Scharr    ///< Оператор Шарра (веса 3, 10)
+    };
+
+    /**
+     * @brief Способ вычисления магнитуды градиента
+     */
+    enum class Magnitude
+    {
+        Exact,       ///< sqrt(gx^2 + gy^2), округление вниз
+        Approximate  ///< Приближение alpha * max + beta * min (погрешность не более 4%)
+    };
+
+    /**
+     * @brief Вычисляет градиенты одной строки
+     *
+     * @param op Оператор градиента
+     * @param above Строка y - 1 в градациях серого
+     * @param center Строка y в градациях серого
+     * @param below Строка y + 1 в градациях серого
+     * @param width Ширина строки
+     * @param left_border Координата, соответствующая x = -1 (с учетом стратегии границ)
+     * @param right_border Координата, соответствующая x = width (с учетом стратегии границ)
+     * @param gx Выходной горизонтальный градиент (width элементов)
+     * @param gy Выходной вертикальный градиент (width элементов)
+     */
+    void computeGradientRow(Operator op,
+                            const uint8_t* above, const uint8_t* center, const uint8_t* below,
+                            int width, int left_border, int right_border,
+                            int16_t* gx, int16_t* gy) noexcept;
+
+    /**
+     * @brief Вычисляет магнитуду градиента для строки
+     *
+     * @param mode Способ вычисления магнитуды
+     * @param gx Горизонтальный градиент
+     * @param gy Вертикальный градиент
+     * @param width Количество элементов
+     * @param magnitude Выходная магнитуда (width элементов)
+     */
+    void computeMagnitudeRow(Magnitude mode, const int16_t* gx, const int16_t* gy,
+                             int width, int32_t* magnitude) noexcept;
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <utils/BorderHandler.h>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Потоковая обработка изображения окном 3x3 в градациях серого
+ *
+ * Вместо полнокадрового буфера градаций серого каждая полоса строк обрабатывается
+ * скользящим окном из трех строк (кольцевой буфер 3 * width байт на поток):
+ * строка конвертируется в градации серого непосредственно перед использованием.
+ *
+ * Обработка выполняется в два параллельных прохода по одним и тем же полосам:
+ * - analyze(): только чтение, например для поиска глобального максимума отклика;
+ *   заодно сохраняет граничные строки соседних полос (по одной сверху и снизу);
+ * - write(): повторный проход, в котором обработчик может перезаписывать
+ *   строки изображения на месте. Строка y перезаписывается только после того, как
+ *   строка y + 1 уже сконвертирована, а строки соседних полос берутся из
+ *   сохраненных граничных строк, поэтому гонок между полосами нет.
+ *
+ * Дополнительная память: O(width) на полосу вместо O(width * height).
+ */
+class GrayscaleRowWindow
+{
+public:
+    /**
+     * @brief Обработчик строки окна
+     *
+     * Параметры: индекс полосы, номер строки y и указатели на строки
+     * градаций серого y - 1, y, y + 1 (с учетом стратегии обработки границ).
+     */
+    using RowVisitor = std::function<void(size_t strip, int y,
+                                          const uint8_t* above, const uint8_t* center, const uint8_t* below)>;
+
+    /**
+     * @brief Конструктор
+     * @param data Данные изображения (RGB или RGBA)
+     * @param width Ширина изображения
+     * @param height Высота изображения
+     * @param channels Количество каналов (3 или 4)
+     * @param border_handler Обработчик границ для строк за пределами изображения
+     */
+    GrayscaleRowWindow(const uint8_t* data, int width, int height, int channels,
+                       const BorderHandler& border_handler);
+
+    /**
+     * @brief Возвращает количество полос, на которые разбито изображение
+     *
+     * Индексы полос, передаваемые в RowVisitor, лежат в диапазоне [0, getStripCount()),
+     * что позволяет накапливать результаты по полосам без синхронизации.
+     */
+    [[nodiscard]] size_t getStripCount() const noexcept;
+
+    /**
+     * @brief Проход только для чтения по всем строкам изображения
+     * @param visitor Обработчик строки (не должен изменять изображение)
+     */
+    void analyze(const RowVisitor& visitor);
+
+    /**
+     * @brief Проход, допускающий запись результата в строку y на месте
+     *
+     * Должен вызываться после analyze(), которая сохраняет граничные строки полос.
+     *
+     * @param visitor Обработчик строки (может перезаписывать строку y изображения)
+     */
+    void write(const RowVisitor& visitor);
+
+    /**
+     * @brief Конвертирует строку RGB/RGBA в градации серого
+     * @param src Начало строки изображения
+     * @param width Ширина строки в пикселях
+     * @param channels Количество каналов
+     * @param dst Выходная строка (width байт)
+     */
+    static void convertRow(const uint8_t* src, int width, int channels, uint8_t* dst) noexcept;
+
+private:
+    /**
+     * @brief Граничные строки полосы, принадлежащие соседним полосам
+     */
+    struct StripHalo
+    {
+        std::vector<uint8_t> above;  ///< Строка над полосой (y = start_row - 1)
+        std::vector<uint8_t> below;  ///< Строка под полосой (y = end_row)
+    };
+
+    [[nodiscard]] int resolveRow(int y) const noexcept;
+    [[nodiscard]] size_t findStrip(int start_row) const noexcept;
+    void loadRow(int y, uint8_t* dst) const noexcept;
+    void process(bool in_place, const RowVisitor& visitor);
+
+    const uint8_t* data_;
+    int width_;
+    int height_;
+    int channels_;
+    const BorderHandler& border_handler_;
+    std::vector<std::pair<int, int>> strips_;
+    std::vector<StripHalo> halos_;
+};
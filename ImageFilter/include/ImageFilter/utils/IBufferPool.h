@@ -1,8 +1,20 @@
 #pragma once
 
+#include <utils/DefaultInitAllocator.h>
+#include <utils/IImageAllocator.h>
 #include <vector>
+#include <cstddef>
 #include <cstdint>
 
+/**
+ * @brief Буфер пула
+ *
+ * resize() не заполняет память нулями: содержимое полученного из пула буфера
+ * не определено, и фильтр обязан перезаписать все используемые байты.
+ * Память выделяется через IImageAllocator (выравнивание 64 байта).
+ */
+using PooledBuffer = std::vector<uint8_t, DefaultInitAllocator<uint8_t, StlImageAllocator<uint8_t>>>;
+
 /**
  * @brief Интерфейс для пула буферов
  * 
@@ -21,16 +33,16 @@ public:
      * @brief Получить буфер из пула или создать новый
      * 
      * @param size Минимальный размер буфера в байтах
-     * @return std::vector<uint8_t> Буфер с зарезервированной памятью
+     * @return PooledBuffer Буфер размера size с неинициализированным содержимым
      */
-    virtual std::vector<uint8_t> acquire(size_t size) = 0;
+    virtual PooledBuffer acquire(size_t size) = 0;
 
     /**
      * @brief Вернуть буфер в пул для переиспользования
      * 
      * @param buffer Буфер для возврата в пул
      */
-    virtual void release(std::vector<uint8_t>&& buffer) = 0;
+    virtual void release(PooledBuffer&& buffer) = 0;
 
     /**
      * @brief Предварительно зарезервировать буферы определенного размера
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+/**
+ * @brief Интерфейс распределителя памяти для пиксельных данных
+ *
+ * Через этот интерфейс выделяют память ImageProcessor, ImageConverter и BufferPool.
+ * Реализация выбирается при запуске (см. ImageAllocator::setDefault), например
+ * распределитель на основе mmap с подсказками huge pages для изображений
+ * размером в сотни мегабайт.
+ *
+ * Требования к реализации:
+ * - адрес выделенного блока выровнен минимум по ALIGNMENT байт
+ * - deallocate() получает тот же размер, что был передан в allocate()
+ * - методы потокобезопасны
+ */
+class IImageAllocator
+{
+public:
+    /**
+     * @brief Гарантированное выравнивание выделяемых блоков (строка кэша)
+     */
+    static constexpr size_t ALIGNMENT = 64;
+
+    virtual ~IImageAllocator() = default;
+
+    /**
+     * @brief Выделяет блок памяти
+     *
+     * Содержимое блока не инициализируется.
+     *
+     * @param size Размер блока в байтах
+     * @return Указатель на блок, выровненный по ALIGNMENT, или nullptr при нехватке памяти
+     */
+    virtual void* allocate(size_t size) noexcept = 0;
+
+    /**
+     * @brief Освобождает блок памяти
+     *
+     * @param ptr Указатель, полученный от allocate() этого распределителя (nullptr допускается)
+     * @param size Размер, переданный в allocate()
+     */
+    virtual void deallocate(void* ptr, size_t size) noexcept = 0;
+
+    /**
+     * @brief Имя реализации (для логов и бенчмарков)
+     */
+    [[nodiscard]] virtual const char* getName() const noexcept = 0;
+};
+
+namespace ImageAllocator
+{
+    /**
+     * @brief Возвращает распределитель по умолчанию
+     *
+     * Если распределитель не задан, используется куча с выравниванием 64 байта.
+     */
+    [[nodiscard]] IImageAllocator& getDefault() noexcept;
+
+    /**
+     * @brief Устанавливает распределитель по умолчанию
+     *
+     * Распределитель должен жить дольше всех выделенных им блоков.
+     * Уже выделенные блоки освобождаются тем распределителем, который их выделил.
+     *
+     * @param allocator Распределитель (nullptr = куча)
+     */
+    void setDefault(IImageAllocator* allocator) noexcept;
+}
+
+/**
+ * @brief Адаптер IImageAllocator к требованиям Allocator стандартной библиотеки
+ *
+ * Сконструированный по умолчанию адаптер запоминает текущий распределитель
+ * по умолчанию, поэтому контейнер освобождает память тем же распределителем,
+ * даже если распределитель по умолчанию позже изменится.
+ *
+ * @tparam T Тип элемента
+ */
+template <typename T>
+class StlImageAllocator
+{
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    StlImageAllocator() noexcept
+        : allocator_(&ImageAllocator::getDefault())
+    {
+    }
+
+    explicit StlImageAllocator(IImageAllocator& allocator) noexcept
+        : allocator_(&allocator)
+    {
+    }
+
+    template <typename U>
+    StlImageAllocator(const StlImageAllocator<U>& other) noexcept
+        : allocator_(&other.getImageAllocator())
+    {
+    }
+
+    [[nodiscard]] T* allocate(size_t count)
+    {
+        void* ptr = allocator_->allocate(count * sizeof(T));
+        if (ptr == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+        return static_cast<T*>(ptr);
+    }
+
+    void deallocate(T* ptr, size_t count) noexcept
+    {
+        allocator_->deallocate(ptr, count * sizeof(T));
+    }
+
+    [[nodiscard]] IImageAllocator& getImageAllocator() const noexcept
+    {
+        return *allocator_;
+    }
+
+    friend bool operator==(const StlImageAllocator& lhs, const StlImageAllocator& rhs) noexcept
+    {
+        return lhs.allocator_ == rhs.allocator_;
+    }
+
+private:
+    IImageAllocator* allocator_;
+};
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <string>
+#include <utils/FilterResult.h>
+#include <utils/ImageLoader.h>
+
+/**
+ * @brief Интерфейс кодека изображений
+ *
+ * Через этот интерфейс ImageLoader и ImageSaver декодируют и кодируют
+ * форматы, отличные от BMP. Реализации:
+ * - StbImageCodec - stb_image/stb_image_write, доступен всегда (запасной вариант)
+ * - JpegImageCodec - libjpeg-turbo для JPEG, подключается при конфигурации CMake
+ *   (IMAGEFILTER_JPEG_BACKEND), поддерживает масштабирование в области DCT
+ *
+ * Требования к реализации:
+ * - пути уже проверены вызывающим кодом (PathValidator)
+ * - decode() читает закодированные данные из памяти (файл отображается
+ *   ImageLoader через MappedFile), поэтому кодек не открывает файл повторно
+ * - encode() отдает закодированные байты приемнику порциями, поэтому один
+ *   и тот же код пишет в файл (ImageSaver::saveToFile) и в память
+ *   (ImageSaver::saveToMemory)
+ * - память результата decode() выделяется через std::malloc и освобождается std::free
+ * - методы потокобезопасны
+ */
+class IImageCodec
+{
+public:
+    /**
+     * @brief Приемник закодированных байтов
+     *
+     * Вызывается для каждой очередной порции данных; false прерывает кодирование
+     * с ошибкой записи. Приемник не должен выбрасывать исключения: он
+     * вызывается из C-кода кодеков (libjpeg, stb), через кадры которого
+     * исключение пройти не может.
+     */
+    using ByteSink = std::function<bool(const uint8_t* bytes, size_t size)>;
+
+    virtual ~IImageCodec() = default;
+
+    /**
+     * @brief Имя реализации (для логов и бенчмарков)
+     */
+    [[nodiscard]] virtual const char* getName() const noexcept = 0;
+
+    /**
+     * @brief Проверяет, умеет ли кодек декодировать формат
+     * @param extension Расширение файла в нижнем регистре без точки
+     */
+    [[nodiscard]] virtual bool canDecode(const std::string& extension) const noexcept = 0;
+
+    /**
+     * @brief Проверяет, умеет ли кодек кодировать формат
+     * @param extension Расширение файла в нижнем регистре без точки
+     */
+    [[nodiscard]] virtual bool canEncode(const std::string& extension) const noexcept = 0;
+
+    /**
+     * @brief Поддерживает ли кодек уменьшение при декодировании (scale_denominator > 1)
+     *
+     * Если нет, ImageLoader декодирует изображение целиком и уменьшает его сам.
+     */
+    [[nodiscard]] virtual bool supportsScaledDecode() const noexcept
+    {
+        return false;
+    }
+
+    /**
+     * @brief Декодирует изображение из памяти
+     * @param data Содержимое файла изображения
+     * @param desired_channels Количество каналов результата: 3 (RGB) или 4 (RGBA)
+     * @param scale_denominator Знаменатель масштаба 1, 2, 4 или 8 (учитывается,
+     *        если supportsScaledDecode(); размеры результата - ceil(размер / знаменатель))
+     * @param result Загруженное изображение
+     * @return FilterResult с результатом операции; UnsupportedFormat означает,
+     *         что вариант формата нужно передать запасному кодеку
+     */
+    virtual FilterResult decode(std::span<const uint8_t> data, int desired_channels, int scale_denominator,
+                                ImageLoader::LoadedImage& result) const = 0;
+
+    /**
+     * @brief Читает размеры и количество каналов из заголовка без декодирования
+     * @param data Содержимое файла изображения
+     * @param info Сведения об изображении (заполняются width, height и channels)
+     * @return FilterResult с результатом операции; UnsupportedFormat означает,
+     *         что заголовок нужно передать запасному кодеку
+     */
+    virtual FilterResult probe(std::span<const uint8_t> data, ImageLoader::ImageInfo& info) const
+    {
+        (void)data;
+        (void)info;
+        return FilterResult::failure(FilterError::UnsupportedFormat, "Кодек не читает заголовки изображений");
+    }
+
+    /**
+     * @brief Кодирует изображение
+     * @param sink Приемник закодированных байтов
+     * @param extension Расширение файла в нижнем регистре без точки
+     * @param data Данные изображения (RGB или RGBA)
+     * @param width Ширина изображения
+     * @param height Высота изображения
+     * @param channels Количество каналов данных (3 или 4; для форматов без альфы
+     *        альфа-канал отбрасывается при кодировании, без копии кадра)
+     * @param preserve_alpha Сохранять ли альфа-канал (для форматов с его поддержкой)
+     * @param jpeg_quality Качество JPEG (0-100)
+     * @return FilterResult с результатом операции
+     */
+    virtual FilterResult encode(const ByteSink& sink, const std::string& extension, const uint8_t* data,
+                                int width, int height, int channels, bool preserve_alpha,
+                                int jpeg_quality) const = 0;
+};
+
+namespace ImageCodec
+{
+    /**
+     * @brief Возвращает кодек для декодирования формата
+     *
+     * Кодек, выбранный при конфигурации (libjpeg-turbo для JPEG), имеет
+     * приоритет; для остальных форматов используется запасной кодек stb.
+     *
+     * @param extension Расширение файла в нижнем регистре без точки
+     */
+    [[nodiscard]] const IImageCodec& findDecoder(const std::string& extension) noexcept;
+
+    /**
+     * @brief Возвращает кодек для кодирования формата
+     * @param extension Расширение файла в нижнем регистре без точки
+     */
+    [[nodiscard]] const IImageCodec& findEncoder(const std::string& extension) noexcept;
+
+    /**
+     * @brief Возвращает запасной кодек (stb)
+     */
+    [[nodiscard]] const IImageCodec& getFallback() noexcept;
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <utils/IImageAllocator.h>
+#include <cstddef>
+
+/**
+ * @brief Распределитель на основе кучи с выравниванием по строке кэша
+ *
+ * Используется по умолчанию и как запасной вариант для небольших блоков
+ * в MmapImageAllocator.
+ */
+class HeapImageAllocator final : public IImageAllocator
+{
+public:
+    void* allocate(size_t size) noexcept override;
+    void deallocate(void* ptr, size_t size) noexcept override;
+    [[nodiscard]] const char* getName() const noexcept override;
+
+    /**
+     * @brief Общий экземпляр (распределитель не имеет состояния)
+     */
+    static HeapImageAllocator& getInstance() noexcept;
+};
+
+/**
+ * @brief Распределитель больших изображений на основе mmap
+ *
+ * Для изображений в 50–500 МБ страницы по 4 КБ дают много промахов TLB
+ * в вертикальных проходах размытия и лавину page fault при первом обращении.
+ * Этот распределитель:
+ * - отображает блоки от min_mapping_size байт анонимным mmap, выровненным
+ *   по границе huge page (2 МБ), и помечает их MADV_HUGEPAGE, чтобы ядро
+ *   использовало прозрачные huge pages (THP)
+ * - по запросу заранее заполняет страницы (MAP_POPULATE / MADV_POPULATE_WRITE),
+ *   перенося page fault из горячего цикла фильтра в момент выделения
+ * - меньшие блоки выделяет в куче через HeapImageAllocator
+ *
+ * На платформах без mmap все блоки выделяются в куче.
+ */
+class MmapImageAllocator final : public IImageAllocator
+{
+public:
+    /**
+     * @brief Размер huge page, по которому выравниваются отображения
+     */
+    static constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+    /**
+     * @brief Параметры распределителя
+     */
+    struct Options
+    {
+        bool huge_pages = true;                       ///< Выравнивать по 2 МБ и передавать MADV_HUGEPAGE
+        bool populate = false;                        ///< Заполнять страницы при выделении
+        size_t min_mapping_size = HUGE_PAGE_SIZE;     ///< Меньшие блоки выделяются в куче
+    };
+
+    /**
+     * @brief Конструктор с параметрами по умолчанию
+     */
+    MmapImageAllocator() noexcept;
+
+    /**
+     * @brief Конструктор
+     * @param options Параметры распределителя
+     */
+    explicit MmapImageAllocator(const Options& options) noexcept;
+
+    void* allocate(size_t size) noexcept override;
+    void deallocate(void* ptr, size_t size) noexcept override;
+    [[nodiscard]] const char* getName() const noexcept override;
+
+    /**
+     * @brief Возвращает параметры распределителя
+     */
+    [[nodiscard]] const Options& getOptions() const noexcept;
+
+    /**
+     * @brief Проверяет, поддерживается ли mmap на текущей платформе
+     */
+    [[nodiscard]] static bool isSupported() noexcept;
+
+private:
+    /**
+     * @brief Размер отображения для блока size байт
+     */
+    [[nodiscard]] size_t mappingSize(size_t size) const noexcept;
+
+    Options options_;
+};
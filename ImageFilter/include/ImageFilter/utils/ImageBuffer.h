@@ -0,0 +1,81 @@
+#pragma once
+
+#include <utils/IBufferPool.h>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+class IImageAllocator;
+
+/**
+ * @brief Владеющий дескриптор буфера пикселей с произвольным освобождением
+ *
+ * Буфер знает, как себя освободить: через распределитель, std::free,
+ * возврат std::vector и т.п. Благодаря этому ImageProcessor может принимать
+ * буферы декодеров, фильтров и пулов без копирования (см. ImageProcessor::adopt).
+ *
+ * Только перемещаемый. Пустой буфер (data() == nullptr) ничего не освобождает.
+ */
+class ImageBuffer
+{
+public:
+    /**
+     * @brief Функция освобождения буфера
+     */
+    using Deleter = std::function<void(uint8_t*)>;
+
+    ImageBuffer() noexcept = default;
+
+    /**
+     * @brief Принимает владение буфером
+     * @param data Указатель на буфер
+     * @param size Размер буфера в байтах
+     * @param deleter Функция освобождения (вызывается один раз в деструкторе или reset())
+     */
+    ImageBuffer(uint8_t* data, size_t size, Deleter deleter) noexcept;
+
+    ~ImageBuffer();
+
+    ImageBuffer(const ImageBuffer&) = delete;
+    ImageBuffer& operator=(const ImageBuffer&) = delete;
+
+    ImageBuffer(ImageBuffer&& other) noexcept;
+    ImageBuffer& operator=(ImageBuffer&& other) noexcept;
+
+    /**
+     * @brief Выделяет буфер через распределитель
+     * @param size Размер в байтах
+     * @param allocator Распределитель, которым буфер будет освобожден
+     * @return Буфер или пустой буфер при нехватке памяти
+     */
+    [[nodiscard]] static ImageBuffer allocate(size_t size, IImageAllocator& allocator);
+
+    /**
+     * @brief Забирает память буфера пула без копирования
+     *
+     * Вектор перемещается во владение дескриптора и освобождается вместе с ним.
+     *
+     * @param buffer Буфер пула (size() байт используются как данные)
+     */
+    [[nodiscard]] static ImageBuffer fromPooled(PooledBuffer&& buffer);
+
+    /**
+     * @brief Освобождает буфер
+     */
+    void reset() noexcept;
+
+    [[nodiscard]] uint8_t* data() noexcept { return data_; }
+    [[nodiscard]] const uint8_t* data() const noexcept { return data_; }
+
+    /**
+     * @brief Размер буфера в байтах (может превышать размер текущего изображения)
+     */
+    [[nodiscard]] size_t size() const noexcept { return size_; }
+
+    [[nodiscard]] explicit operator bool() const noexcept { return data_ != nullptr; }
+
+private:
+    uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+    Deleter deleter_;
+};
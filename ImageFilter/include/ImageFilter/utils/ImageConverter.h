@@ -1,8 +1,11 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <utils/FilterResult.h>
 
+class IImageAllocator;
+
 /**
  * @brief Класс для преобразования форматов изображений
  * 
@@ -23,10 +26,29 @@ public:
      * @return FilterResult с результатом операции
      * 
      * Использует альфа-канал для композиции с белым фоном (alpha blending).
+     * Допускается преобразование на месте (rgb_data == rgba_data): пиксели
+     * обрабатываются по порядку, и запись RGB не обгоняет чтение RGBA.
      */
     static FilterResult convertRGBAToRGB(const uint8_t* rgba_data,
                                          int width,
                                          int height,
                                          uint8_t* rgb_data);
+
+    /**
+     * @brief Преобразует RGBA изображение в RGB в новый буфер
+     * @param rgba_data Исходные RGBA данные
+     * @param width Ширина изображения
+     * @param height Высота изображения
+     * @param allocator Распределитель для выходного буфера
+     * @param rgb_data Выходной буфер (выделяется через allocator; nullptr при ошибке)
+     * @param rgb_size Размер выходного буфера в байтах (для allocator.deallocate())
+     * @return FilterResult с результатом операции
+     */
+    static FilterResult convertRGBAToRGB(const uint8_t* rgba_data,
+                                         int width,
+                                         int height,
+                                         IImageAllocator& allocator,
+                                         uint8_t*& rgb_data,
+                                         size_t& rgb_size);
 };
 
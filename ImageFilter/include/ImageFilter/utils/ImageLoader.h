@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <span>
 #include <string>
 #include <utils/FilterResult.h>
 
@@ -8,7 +9,8 @@
  * @brief Класс для загрузки изображений из файлов
  * 
  * Отвечает за:
- * - Загрузку изображений в различных форматах (JPEG, PNG, BMP)
+ * - Загрузку изображений в различных форматах (JPEG, PNG, BMP) через кодеки IImageCodec
+ * - Загрузку из файлов, отображенных в память (MappedFile), и из буферов в памяти
  * - Валидацию путей и размеров файлов
  * - Преобразование форматов при загрузке
  * - Обработку ошибок загрузки
@@ -18,6 +20,8 @@ class ImageLoader
 public:
     /**
      * @brief Структура для хранения загруженных данных изображения
+     *
+     * Память data выделена через std::malloc и освобождается std::free.
      */
     struct LoadedImage
     {
@@ -27,18 +31,76 @@ public:
         int channels = 0;
     };
 
+    /**
+     * @brief Сведения об изображении из заголовка (без декодирования пикселей)
+     */
+    struct ImageInfo
+    {
+        std::string format;      // Формат по сигнатуре: "bmp", "jpg", "png" (пусто, если не определен)
+        int width = 0;
+        int height = 0;
+        int channels = 0;        // Количество каналов в файле (1-4)
+        uint64_t file_size = 0;  // Размер закодированных данных в байтах
+    };
+
     /**
      * @brief Загружает изображение из файла
      * @param filename Путь к файлу изображения
      * @param preserve_alpha Если true, загружает с альфа-каналом (RGBA), если false - принудительно RGB
      * @param result Структура для сохранения загруженных данных
+     * @param scale_denominator Знаменатель масштаба 1, 2, 4 или 8 для превью: размеры
+     *        результата - ceil(размер / знаменатель). JPEG с libjpeg-turbo уменьшается
+     *        в области DCT при декодировании, остальные форматы - усреднением после него
      * @return FilterResult с результатом операции
      * 
      * @note Путь к файлу валидируется на безопасность (защита от path traversal атак).
      * Размер файла ограничен DEFAULT_MAX_IMAGE_SIZE (1 GB по умолчанию).
+     * Файл открывается один раз и отображается в память; формат определяется по
+     * расширению и декодируется кодеком из ImageCodec::findDecoder() (см. IImageCodec).
      */
     static FilterResult loadFromFile(const std::string& filename, 
                                      bool preserve_alpha, 
-                                     LoadedImage& result);
+                                     LoadedImage& result,
+                                     int scale_denominator = 1);
+
+    /**
+     * @brief Загружает изображение из закодированных данных в памяти
+     * @param data Содержимое файла изображения (BMP, JPEG, PNG и др.)
+     * @param preserve_alpha Если true, загружает с альфа-каналом (RGBA), если false - принудительно RGB
+     * @param result Структура для сохранения загруженных данных
+     * @param scale_denominator Знаменатель масштаба 1, 2, 4 или 8 (см. loadFromFile)
+     * @return FilterResult с результатом операции
+     *
+     * @note Формат определяется по сигнатуре данных. Данные не копируются и
+     * нужны только на время вызова. Позволяет заранее отобразить файл через
+     * MappedFile и вызвать prefetch(), а также декодировать буферы из архивов
+     * или сети без временных файлов. Размер ограничен DEFAULT_MAX_IMAGE_SIZE.
+     */
+    static FilterResult loadFromMemory(std::span<const uint8_t> data,
+                                       bool preserve_alpha,
+                                       LoadedImage& result,
+                                       int scale_denominator = 1);
+
+    /**
+     * @brief Читает формат, размеры и количество каналов из заголовка файла
+     * @param filename Путь к файлу изображения
+     * @param info Сведения об изображении (выходной параметр)
+     * @return FilterResult с результатом операции
+     *
+     * @note Пиксели не декодируются: файл отображается в память, и с диска
+     * читаются только страницы с заголовками (обычно несколько КБ). Формат
+     * определяется по сигнатуре; BMP разбирается BMPHandler, остальные
+     * форматы - кодеком (stbi_info для JPEG и PNG). Путь валидируется так же,
+     * как в loadFromFile().
+     */
+    static FilterResult probe(const std::string& filename, ImageInfo& info);
+
+    /**
+     * @brief Читает формат, размеры и количество каналов из закодированных данных в памяти
+     * @param data Содержимое файла изображения (достаточно начала с заголовками)
+     * @param info Сведения об изображении (выходной параметр)
+     * @return FilterResult с результатом операции
+     */
+    static FilterResult probeFromMemory(std::span<const uint8_t> data, ImageInfo& info);
 };
 
@@ -2,15 +2,18 @@
 
 #include <cstdint>
 #include <string>
+#include <vector>
 #include <utils/FilterResult.h>
 
 /**
  * @brief Класс для сохранения изображений в файлы
  * 
  * Отвечает за:
- * - Сохранение изображений в различных форматах (JPEG, PNG, BMP)
+ * - Сохранение изображений в различных форматах (JPEG, PNG, BMP) через кодеки IImageCodec
+ * - Кодирование в буфер в памяти без временных файлов
  * - Валидацию путей и данных изображения
- * - Преобразование форматов при сохранении (RGBA -> RGB для JPEG)
+ * - Преобразование форматов при сохранении (RGBA -> RGB для JPEG и BMP отбрасывает
+ *   альфа-канал при кодировании, без копии кадра)
  * - Обработку ошибок сохранения
  */
 class ImageSaver
@@ -36,5 +39,29 @@ public:
                                     int channels,
                                     bool preserve_alpha,
                                     int jpeg_quality);
+
+    /**
+     * @brief Кодирует изображение в буфер в памяти
+     * @param format Формат: расширение без учета регистра ("jpg", "jpeg", "png", "bmp"), точка допускается
+     * @param data Указатель на данные изображения
+     * @param width Ширина изображения
+     * @param height Высота изображения
+     * @param channels Количество каналов (3 для RGB, 4 для RGBA)
+     * @param preserve_alpha Если true, сохраняет альфа-канал (для PNG), если false - принудительно RGB
+     * @param jpeg_quality Качество JPEG (0-100)
+     * @param output Закодированные байты файла (содержимое заменяется)
+     * @return FilterResult с результатом операции
+     *
+     * @note Результат совпадает с содержимым файла, который записал бы saveToFile(),
+     * и может быть сразу передан в сеть или хранилище без записи на диск.
+     */
+    static FilterResult saveToMemory(const std::string& format,
+                                     const uint8_t* data,
+                                     int width,
+                                     int height,
+                                     int channels,
+                                     bool preserve_alpha,
+                                     int jpeg_quality,
+                                     std::vector<uint8_t>& output);
 };
 
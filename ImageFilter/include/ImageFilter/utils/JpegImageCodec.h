@@ -0,0 +1,75 @@
+#pragma once
+
+#include <memory>
+#include <utils/IImageCodec.h>
+
+class IRowReader;
+class IRowWriter;
+
+/**
+ * @brief Кодек JPEG на основе libjpeg-turbo
+ *
+ * Подключается при конфигурации CMake (IMAGEFILTER_JPEG_BACKEND = auto или turbo).
+ * Кроме полнокадрового декодирования и кодирования предоставляет построчные
+ * источник и приемник строк для потоковой обработки полосами (RowStream).
+ *
+ * Масштабирование при декодировании выполняется в области DCT: при знаменателе
+ * 2, 4 или 8 декодер вычисляет обратное DCT меньшего размера, поэтому
+ * уменьшенное изображение для превью декодируется в несколько раз быстрее
+ * полного и без полнокадрового буфера.
+ *
+ * С расширениями libjpeg-turbo (JCS_EXT_RGBA/JCS_EXT_RGBX) RGBA строки
+ * декодируются и кодируются без промежуточного буфера строки.
+ *
+ * Если библиотека собрана без libjpeg, isAvailable() возвращает false,
+ * а все операции - UnsupportedFormat.
+ */
+class JpegImageCodec final : public IImageCodec
+{
+public:
+    [[nodiscard]] const char* getName() const noexcept override;
+    [[nodiscard]] bool canDecode(const std::string& extension) const noexcept override;
+    [[nodiscard]] bool canEncode(const std::string& extension) const noexcept override;
+    [[nodiscard]] bool supportsScaledDecode() const noexcept override;
+
+    FilterResult decode(std::span<const uint8_t> data, int desired_channels, int scale_denominator,
+                        ImageLoader::LoadedImage& result) const override;
+
+    FilterResult probe(std::span<const uint8_t> data, ImageLoader::ImageInfo& info) const override;
+
+    FilterResult encode(const ByteSink& sink, const std::string& extension, const uint8_t* data,
+                        int width, int height, int channels, bool preserve_alpha,
+                        int jpeg_quality) const override;
+
+    /**
+     * @brief Проверяет, собрана ли библиотека с libjpeg
+     */
+    [[nodiscard]] static bool isAvailable() noexcept;
+
+    /**
+     * @brief Общий экземпляр (кодек не имеет состояния)
+     */
+    static JpegImageCodec& getInstance() noexcept;
+
+    /**
+     * @brief Открывает JPEG файл для построчного декодирования
+     * @param path Проверенный путь к файлу
+     * @param preserve_alpha Если true, строки отдаются в RGBA с альфой 255
+     * @param scale_denominator Знаменатель масштаба 1, 2, 4 или 8
+     * @param reader Созданный источник строк
+     * @return FilterResult с результатом операции; UnsupportedFormat для
+     *         вариантов JPEG без построчной поддержки (CMYK)
+     */
+    static FilterResult openRowReader(const std::string& path, bool preserve_alpha, int scale_denominator,
+                                      std::unique_ptr<IRowReader>& reader);
+
+    /**
+     * @brief Создает построчный кодер JPEG
+     * @param path Проверенный путь к выходному файлу
+     * @param jpeg_quality Качество JPEG (0-100)
+     * @param writer Созданный приемник строк (файл создается в begin())
+     * @return FilterResult с результатом операции
+     */
+    static FilterResult createRowWriter(const std::string& path, int jpeg_quality,
+                                        std::unique_ptr<IRowWriter>& writer);
+};
@@ -35,6 +35,14 @@ public:
      */
     static void setQuiet(bool quiet) noexcept;
 
+    /**
+     * @brief Направляет все сообщения в stderr
+     * @param stderr_only true, чтобы stdout оставался свободным для машиночитаемого вывода
+     *
+     * По умолчанию DEBUG, INFO и WARNING выводятся в stdout, ERROR - в stderr.
+     */
+    static void setStderrOnly(bool stderr_only) noexcept;
+
     /**
      * @brief Получает текущий минимальный уровень логирования
      * @return Текущий уровень
@@ -2,8 +2,8 @@
 
 #include <cstdint>
 #include <array>
+#include <memory>
 #include <vector>
-#include <mutex>
 
 /**
  * @brief Утилита для предвычисленных lookup tables
@@ -12,20 +12,13 @@
  * что позволяет избежать дорогостоящих вычислений в runtime.
  * 
  * Принципы:
- * - Все таблицы инициализируются один раз при первом использовании
- * - Thread-safe инициализация
+ * - Таблицы sin/cos/exp/sqrt вычисляются при компиляции (constexpr) и не требуют
+ *   инициализации во время выполнения
+ * - Доступ к таблицам не требует синхронизации
  * - Оптимизированы для производительности
  */
 class LookupTables {
 public:
-    /**
-     * @brief Инициализирует все lookup tables
-     * 
-     * Должна быть вызвана перед использованием таблиц.
-     * Thread-safe: можно вызывать из разных потоков.
-     */
-    static void initialize();
-
     /**
      * @brief Получает значение sin для угла в градусах
      * @param angle_degrees Угол в градусах [0, 360)
@@ -93,9 +86,9 @@ public:
      * Таблица содержит 256 элементов для преобразования 8-битных значений.
      * 
      * @param gamma Значение гаммы (должно быть > 0)
-     * @return Вектор из 256 элементов с преобразованными значениями
+     * @return Разделяемая с кэшем таблица из 256 элементов с преобразованными значениями
      */
-    static std::vector<uint8_t> getGammaLUT(double gamma) noexcept;
+    static std::shared_ptr<const std::vector<uint8_t>> getGammaLUT(double gamma) noexcept;
 
     /**
      * @brief Получает LUT таблицу для коррекции яркости
@@ -105,9 +98,9 @@ public:
      * 
      * @param brightness Значение яркости в диапазоне [-1.0, 1.0]
      *                  Положительные значения увеличивают яркость, отрицательные - уменьшают
-     * @return Вектор из 256 элементов с преобразованными значениями
+     * @return Разделяемая с кэшем таблица из 256 элементов с преобразованными значениями
      */
-    static std::vector<uint8_t> getBrightnessLUT(double brightness) noexcept;
+    static std::shared_ptr<const std::vector<uint8_t>> getBrightnessLUT(double brightness) noexcept;
 
     /**
      * @brief Получает LUT таблицу для коррекции контраста
@@ -117,9 +110,9 @@ public:
      * 
      * @param contrast Значение контраста в диапазоне [-1.0, 1.0]
      *                 Положительные значения увеличивают контраст, отрицательные - уменьшают
-     * @return Вектор из 256 элементов с преобразованными значениями
+     * @return Разделяемая с кэшем таблица из 256 элементов с преобразованными значениями
      */
-    static std::vector<uint8_t> getContrastLUT(double contrast) noexcept;
+    static std::shared_ptr<const std::vector<uint8_t>> getContrastLUT(double contrast) noexcept;
 
 };
 
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+#include <utils/FilterResult.h>
+
+/**
+ * @brief Файл, отображенный в память только для чтения
+ *
+ * Файл открывается один раз: размер берется из fstat открытого дескриптора,
+ * а содержимое отображается через mmap, поэтому декодер читает данные прямо
+ * из страничного кэша без повторного открытия файла и буферизации stdio.
+ * Отображение можно создать заранее и вызвать prefetch(), чтобы ядро начало
+ * чтение с диска до декодирования (см. ImageLoader::loadFromMemory).
+ *
+ * На платформах без mmap (или если отображение не удалось) файл при
+ * read_fallback = true читается в память целиком.
+ */
+class MappedFile
+{
+public:
+    MappedFile() noexcept = default;
+    ~MappedFile();
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @brief Открывает и отображает файл
+     * @param path Путь к файлу (должен быть уже проверен PathValidator)
+     * @param read_fallback Если mmap недоступен, прочитать файл в память целиком
+     * @return FilterResult с результатом операции
+     */
+    FilterResult open(const std::string& path, bool read_fallback = true);
+
+    /**
+     * @brief Освобождает отображение
+     */
+    void close() noexcept;
+
+    [[nodiscard]] const uint8_t* data() const noexcept { return data_; }
+    [[nodiscard]] size_t size() const noexcept { return size_; }
+    [[nodiscard]] std::span<const uint8_t> bytes() const noexcept { return {data_, size_}; }
+    [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+
+    /**
+     * @brief Проверяет, отображен ли файл через mmap (а не прочитан в память)
+     */
+    [[nodiscard]] bool isMapped() const noexcept { return mapped_; }
+
+    /**
+     * @brief Просит ядро заранее прочитать все страницы файла (MADV_WILLNEED)
+     */
+    void prefetch() const noexcept;
+
+    /**
+     * @brief Подсказывает ядру, что файл будет читаться последовательно (MADV_SEQUENTIAL)
+     */
+    void adviseSequential() const noexcept;
+
+private:
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+    std::vector<uint8_t> buffer_; // Содержимое файла, если mmap недоступен
+    bool mapped_ = false;
+};
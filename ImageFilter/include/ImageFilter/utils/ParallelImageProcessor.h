@@ -5,6 +5,7 @@
 #include <functional>
 #include <memory>
 #include <thread>
+#include <utility>
 #include <vector>
 #include <algorithm>
 
@@ -25,6 +26,7 @@ class IThreadPool;
  * - Использует ThreadPool для переиспользования потоков
  * - Поддерживает std::execution::par_unseq для векторных операций
  * - Адаптивный выбор между последовательной и параллельной обработкой
+ * - Согласование числа потоков с общим бюджетом (ConcurrencyGovernor)
  * 
  * @note Адаптивный выбор:
  *   - Маленькие изображения (< 100x100): последовательная обработка
@@ -61,6 +63,10 @@ public:
      * @param processRowRange Функция обработки диапазона строк: void(int start_row, int end_row)
      * @param thread_pool Пул потоков для выполнения задач (nullptr = использовать глобальный пул)
      * @param num_threads Количество потоков (0 = автоматическое определение на основе размера, используется только если thread_pool == nullptr)
+     *
+     * @note Без thread_pool потоки выдает ConcurrencyGovernor: при занятом бюджете
+     *       (например, все ядра заняты файлами пакетной обработки) полосы
+     *       обрабатываются последовательно в вызывающем потоке.
      */
     static void processRowsParallel(
         int height,
@@ -89,6 +95,21 @@ public:
     );
 
 
+    /**
+     * @brief Вычисляет разбиение изображения на полосы строк
+     * 
+     * Возвращает те же диапазоны [start_row, end_row), которые processRowsParallel
+     * передает в функцию обработки при тех же height, width и num_threads.
+     * Используется фильтрами, которым нужно связать данные между проходами
+     * по одним и тем же полосам (например, граничные строки соседних полос).
+     * 
+     * @param height Высота изображения в пикселях
+     * @param width Ширина изображения в пикселях
+     * @param num_threads Количество потоков (0 = автоматическое определение)
+     * @return Диапазоны строк в порядке возрастания (пустой вектор для пустого изображения)
+     */
+    static std::vector<std::pair<int, int>> splitRows(int height, int width, int num_threads = 0);
+
     /**
      * @brief Получает оптимальное количество потоков для обработки
      * 
@@ -99,6 +120,17 @@ public:
      */
     static int getOptimalThreadCount() noexcept;
 
+    /**
+     * @brief Переопределяет количество потоков, возвращаемое getOptimalThreadCount()
+     * 
+     * Меняет разбиение на полосы для всех последующих вызовов без явного num_threads.
+     * Позволяет проверить независимость результата фильтров от разбиения
+     * на машине с любым количеством ядер.
+     * 
+     * @param num_threads Количество потоков (0 = по количеству ядер процессора)
+     */
+    static void setThreadCountOverride(int num_threads) noexcept;
+
     /**
      * @brief Определяет, следует ли использовать параллельную обработку
      * 
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utils/FilterResult.h>
+
+/**
+ * @brief Источник строк изображения для потоковой обработки
+ *
+ * Отдает строки сверху вниз порциями произвольного размера. Строка занимает
+ * getWidth() * getChannels() байт без выравнивания.
+ */
+class IRowReader
+{
+public:
+    virtual ~IRowReader() = default;
+
+    [[nodiscard]] virtual int getWidth() const noexcept = 0;
+    [[nodiscard]] virtual int getHeight() const noexcept = 0;
+    [[nodiscard]] virtual int getChannels() const noexcept = 0;
+
+    /**
+     * @brief Читает следующие count строк
+     * @param destination Буфер размером не меньше count строк
+     * @param count Количество строк (не больше оставшегося)
+     * @return FilterResult с результатом операции
+     */
+    virtual FilterResult readRows(uint8_t* destination, int count) = 0;
+};
+
+/**
+ * @brief Приемник строк изображения для потоковой обработки
+ *
+ * Порядок вызовов: begin(), writeRows() сверху вниз до height строк, finish().
+ */
+class IRowWriter
+{
+public:
+    virtual ~IRowWriter() = default;
+
+    /**
+     * @brief Начинает запись изображения
+     * @param width Ширина изображения
+     * @param height Высота изображения
+     * @param channels Количество каналов строк (3 или 4)
+     * @return FilterResult с результатом операции
+     */
+    virtual FilterResult begin(int width, int height, int channels) = 0;
+
+    /**
+     * @brief Записывает следующие count строк
+     * @param source Строки подряд, width * channels байт каждая
+     * @param count Количество строк
+     * @return FilterResult с результатом операции
+     */
+    virtual FilterResult writeRows(const uint8_t* source, int count) = 0;
+
+    /**
+     * @brief Завершает запись (сбрасывает кодер и закрывает файл)
+     * @return FilterResult с результатом операции
+     */
+    virtual FilterResult finish() = 0;
+};
+
+/**
+ * @brief Построчные источники и приемники для файлов изображений
+ *
+ * Для форматов с построчным кодеком (BMP, JPEG через JpegImageCodec) строки декодируются
+ * и кодируются по мере обработки, и в памяти находятся только текущие строки.
+ * Для остальных форматов используется полнокадровый ImageLoader/ImageSaver,
+ * обернутый в тот же интерфейс: результат совпадает, но экономии памяти нет.
+ */
+namespace RowStream
+{
+    /**
+     * @brief Проверяет, поддерживается ли построчное декодирование и кодирование формата
+     * @param filename Путь к файлу (формат определяется по расширению)
+     * @return true, если формат обрабатывается без полного кадра в памяти
+     */
+    [[nodiscard]] bool isStreamingFormat(const std::string& filename);
+
+    /**
+     * @brief Открывает файл изображения для построчного чтения
+     * @param filename Путь к файлу
+     * @param preserve_alpha Если true, строки отдаются в RGBA (для форматов без альфы - с альфой 255)
+     * @param reader Созданный источник строк
+     * @return FilterResult с результатом операции
+     */
+    FilterResult openReader(const std::string& filename, bool preserve_alpha,
+                            std::unique_ptr<IRowReader>& reader);
+
+    /**
+     * @brief Создает приемник строк для записи файла изображения
+     * @param filename Путь к выходному файлу
+     * @param preserve_alpha Сохранять ли альфа-канал (для форматов с его поддержкой)
+     * @param jpeg_quality Качество JPEG (0-100)
+     * @param writer Созданный приемник строк
+     * @return FilterResult с результатом операции
+     */
+    FilterResult createWriter(const std::string& filename, bool preserve_alpha, int jpeg_quality,
+                              std::unique_ptr<IRowWriter>& writer);
+}
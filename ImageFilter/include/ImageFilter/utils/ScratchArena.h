@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class IImageAllocator;
+
+/**
+ * @brief Линейная (bump) арена для временных буферов фильтров одного изображения
+ *
+ * Фильтры цепочки запрашивают промежуточные буферы (горизонтальный проход,
+ * копия входа, результат) из арены, привязанной к изображению
+ * (ImageProcessor::setScratchArena). Выделение — сдвиг указателя, освобождения
+ * по отдельности нет: исполнитель цепочки вызывает rewind() после каждого фильтра
+ * и reset() между изображениями. Поэтому пиковый объем временной памяти
+ * ограничен самым требовательным фильтром цепочки, а не суммой всех фильтров.
+ *
+ * Память берется блоками через IImageAllocator и переиспользуется между
+ * изображениями. Если изображение потребовало нескольких блоков, reset()
+ * заменяет их одним блоком пикового размера.
+ *
+ * @note Не потокобезопасна: фильтры запрашивают буферы в apply() до параллельных участков.
+ */
+class ScratchArena
+{
+public:
+    /**
+     * @brief Выравнивание выделяемых буферов (строка кэша)
+     */
+    static constexpr size_t ALIGNMENT = 64;
+
+    /**
+     * @brief Минимальный размер блока по умолчанию
+     */
+    static constexpr size_t DEFAULT_CHUNK_SIZE = 1024 * 1024;
+
+    /**
+     * @brief Конструктор
+     * @param allocator Распределитель блоков (nullptr = ImageAllocator::getDefault() на момент создания)
+     * @param chunk_size Минимальный размер блока в байтах
+     */
+    explicit ScratchArena(IImageAllocator* allocator = nullptr, size_t chunk_size = DEFAULT_CHUNK_SIZE);
+
+    /**
+     * @brief Деструктор - освобождает все блоки
+     */
+    ~ScratchArena();
+
+    ScratchArena(const ScratchArena&) = delete;
+    ScratchArena& operator=(const ScratchArena&) = delete;
+
+    /**
+     * @brief Выделяет неинициализированный буфер
+     * @param size Размер в байтах
+     * @return Указатель, выровненный по ALIGNMENT, или nullptr при нехватке памяти
+     */
+    [[nodiscard]] uint8_t* allocate(size_t size) noexcept;
+
+    /**
+     * @brief Освобождает все выделения, сохраняя блоки (между фильтрами цепочки)
+     */
+    void rewind() noexcept;
+
+    /**
+     * @brief Освобождает все выделения и сбрасывает пиковый объем (между изображениями)
+     *
+     * Несколько блоков объединяются в один блок суммарного размера, чтобы
+     * следующее изображение того же размера обошлось одним блоком.
+     */
+    void reset() noexcept;
+
+    /**
+     * @brief Освобождает все блоки
+     */
+    void clear() noexcept;
+
+    /**
+     * @brief Объем, выделенный с последнего rewind() или reset(), в байтах
+     */
+    [[nodiscard]] size_t getUsedBytes() const noexcept;
+
+    /**
+     * @brief Пиковый объем выделений с последнего reset(), в байтах
+     */
+    [[nodiscard]] size_t getPeakBytes() const noexcept;
+
+    /**
+     * @brief Суммарный размер блоков, удерживаемых ареной, в байтах
+     */
+    [[nodiscard]] size_t getReservedBytes() const noexcept;
+
+private:
+    /**
+     * @brief Блок памяти арены
+     */
+    struct Chunk
+    {
+        uint8_t* data;
+        size_t size;
+    };
+
+    /**
+     * @brief Выделяет новый блок не меньше size байт и делает его текущим
+     */
+    bool addChunk(size_t size) noexcept;
+
+    IImageAllocator& allocator_;     // Распределитель блоков
+    size_t chunk_size_;              // Минимальный размер блока
+    std::vector<Chunk> chunks_;      // Блоки арены
+    size_t current_ = 0;             // Индекс текущего блока
+    size_t offset_ = 0;              // Смещение в текущем блоке
+    size_t used_ = 0;                // Выделено с последнего rewind()
+    size_t peak_ = 0;                // Пик с последнего reset()
+};
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <utils/IBufferPool.h>
+#include <cstddef>
+#include <cstdint>
+
+class ScratchArena;
+
+/**
+ * @brief Временный буфер фильтра на время одного вызова apply()
+ *
+ * Источник памяти выбирается по приоритету:
+ * 1. Арена изображения (ImageProcessor::getScratchArena()) - память освобождается
+ *    исполнителем цепочки, деструктор ничего не делает
+ * 2. Пул буферов фильтра - деструктор возвращает буфер в пул
+ * 3. Обычное выделение через PooledBuffer
+ *
+ * Содержимое буфера не инициализировано.
+ */
+class ScratchBuffer
+{
+public:
+    ScratchBuffer() = default;
+
+    /**
+     * @brief Выделяет временный буфер
+     * @param arena Арена изображения (может быть nullptr)
+     * @param pool Пул буферов фильтра (может быть nullptr)
+     * @param size Размер в байтах
+     * @throws std::bad_alloc если память не удалось выделить ни из одного источника
+     */
+    ScratchBuffer(ScratchArena* arena, IBufferPool* pool, size_t size);
+
+    /**
+     * @brief Деструктор - возвращает буфер в пул, если он был взят из пула
+     */
+    ~ScratchBuffer();
+
+    ScratchBuffer(const ScratchBuffer&) = delete;
+    ScratchBuffer& operator=(const ScratchBuffer&) = delete;
+
+    ScratchBuffer(ScratchBuffer&& other) noexcept;
+    ScratchBuffer& operator=(ScratchBuffer&& other) noexcept;
+
+    [[nodiscard]] uint8_t* data() noexcept { return data_; }
+    [[nodiscard]] const uint8_t* data() const noexcept { return data_; }
+    [[nodiscard]] size_t size() const noexcept { return size_; }
+    [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+
+    [[nodiscard]] uint8_t* begin() noexcept { return data_; }
+    [[nodiscard]] uint8_t* end() noexcept { return data_ + size_; }
+    [[nodiscard]] const uint8_t* begin() const noexcept { return data_; }
+    [[nodiscard]] const uint8_t* end() const noexcept { return data_ + size_; }
+
+    uint8_t& operator[](size_t index) noexcept { return data_[index]; }
+    const uint8_t& operator[](size_t index) const noexcept { return data_[index]; }
+
+private:
+    /**
+     * @brief Возвращает буфер в пул (если он из пула) и обнуляет состояние
+     */
+    void release() noexcept;
+
+    uint8_t* data_ = nullptr;       // Начало буфера (в арене или в owned_)
+    size_t size_ = 0;               // Размер буфера в байтах
+    PooledBuffer owned_;            // Память из пула или кучи (пусто для арены)
+    IBufferPool* pool_ = nullptr;   // Пул, в который вернется owned_
+};
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <utils/IImageCodec.h>
+
+/**
+ * @brief Кодек на основе stb_image и stb_image_write
+ *
+ * Декодирует все форматы stb_image (JPEG, PNG и др.), кодирует JPEG и PNG.
+ * Не поддерживает масштабирование при декодировании. Используется как
+ * запасной кодек, когда специализированный кодек недоступен или не
+ * поддерживает вариант формата.
+ */
+class StbImageCodec final : public IImageCodec
+{
+public:
+    [[nodiscard]] const char* getName() const noexcept override;
+    [[nodiscard]] bool canDecode(const std::string& extension) const noexcept override;
+    [[nodiscard]] bool canEncode(const std::string& extension) const noexcept override;
+
+    FilterResult decode(std::span<const uint8_t> data, int desired_channels, int scale_denominator,
+                        ImageLoader::LoadedImage& result) const override;
+
+    FilterResult probe(std::span<const uint8_t> data, ImageLoader::ImageInfo& info) const override;
+
+    FilterResult encode(const ByteSink& sink, const std::string& extension, const uint8_t* data,
+                        int width, int height, int channels, bool preserve_alpha,
+                        int jpeg_quality) const override;
+
+    /**
+     * @brief Общий экземпляр (кодек не имеет состояния)
+     */
+    static StbImageCodec& getInstance() noexcept;
+};
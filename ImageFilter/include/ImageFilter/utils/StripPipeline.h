@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <utils/FilterResult.h>
+
+class IFilter;
+class IRowReader;
+class IRowWriter;
+
+/**
+ * @brief Потоковая обработка изображения полосами: декодирование → фильтры → кодирование
+ *
+ * Изображение проходит через цепочку фильтров полосами по strip_rows строк.
+ * Для каждой полосы [a, b) из источника берется окно строк [a - R, b + R),
+ * где R - сумма IFilter::getStreamingRadius() всех фильтров цепочки. Фильтры
+ * применяются к окну целиком; после k-го фильтра неверными могут быть только
+ * строки в пределах r1 + ... + rk от краев окна, поэтому строки [a, b)
+ * совпадают с обработкой всего изображения и передаются приемнику. У краев
+ * кадра окно дополняется строками внутрь изображения до 2R + 1 строк, чтобы
+ * проверки радиуса фильтров принимали те же параметры, что и для всего кадра.
+ *
+ * Строки окна, нужные следующей полосе, сохраняются, а не декодируются заново.
+ * Пиковый объем памяти - O(width * (strip_rows + 2R)) вместо O(width * height).
+ */
+class StripPipeline
+{
+public:
+    /**
+     * @brief Высота полосы по умолчанию
+     */
+    static constexpr int DEFAULT_STRIP_ROWS = 256;
+
+    /**
+     * @brief Статистика выполнения
+     */
+    struct Statistics
+    {
+        size_t strips = 0;             ///< Количество обработанных полос
+        int halo_rows = 0;             ///< Строк окрестности с каждой стороны полосы (R)
+        size_t peak_memory_bytes = 0;  ///< Пиковый объем буферов окна и временной памяти фильтров
+    };
+
+    /**
+     * @brief Вычисляет суммарный радиус цепочки фильтров
+     * @param filters Цепочка фильтров
+     * @return Сумма радиусов или -1, если хотя бы одному фильтру нужно все изображение
+     */
+    [[nodiscard]] static int getChainRadius(const std::vector<IFilter*>& filters) noexcept;
+
+    /**
+     * @brief Обрабатывает изображение полосами
+     * @param reader Источник строк
+     * @param writer Приемник строк (begin() и finish() вызываются здесь)
+     * @param filters Цепочка фильтров (все должны поддерживать потоковую обработку)
+     * @param strip_rows Высота полосы в строках
+     * @param statistics Если не nullptr, получает статистику выполнения
+     * @return FilterResult с результатом операции
+     */
+    static FilterResult run(IRowReader& reader,
+                            IRowWriter& writer,
+                            const std::vector<IFilter*>& filters,
+                            int strip_rows = DEFAULT_STRIP_ROWS,
+                            Statistics* statistics = nullptr);
+};
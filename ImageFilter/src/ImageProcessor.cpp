@@ -2,32 +2,27 @@
 #include <utils/ImageLoader.h>
 #include <utils/ImageSaver.h>
 #include <utils/ImageConverter.h>
+#include <utils/ImageAllocator.h>
 #include <utils/FilterResult.h>
 #include <utils/SafeMath.h>
 
-// STB Image - заголовочные файлы для работы с изображениями (только для stbi_image_free)
-#include <stb_image.h>
-
 #include <algorithm>
 #include <cerrno>
 #include <cstdlib>
 #include <cstring>
 
-ImageProcessor::~ImageProcessor()
-{
-    // Освобождаем память, выделенную STB
-    stbi_image_free(data_);
-}
+ImageProcessor::~ImageProcessor() = default;
 
 ImageProcessor::ImageProcessor(ImageProcessor&& other) noexcept
-    : data_(other.data_)
+    : buffer_(std::move(other.buffer_))
+    , allocator_(other.allocator_)
+    , scratch_arena_(other.scratch_arena_)
     , width_(other.width_)
     , height_(other.height_)
     , channels_(other.channels_)
     , jpeg_quality_(other.jpeg_quality_)
 {
-    // Обнуляем данные в исходном объекте, чтобы деструктор не освободил память
-    other.data_ = nullptr;
+    // Обнуляем размеры в исходном объекте (буфер уже перенесен)
     other.width_ = 0;
     other.height_ = 0;
     other.channels_ = 0;
@@ -38,18 +33,16 @@ ImageProcessor& ImageProcessor::operator=(ImageProcessor&& other) noexcept
 {
     if (this != &other)
     {
-        // Освобождаем текущие данные
-        stbi_image_free(data_);
-        
-        // Переносим данные из другого объекта
-        data_ = other.data_;
+        // Перенос буфера освобождает текущие данные
+        buffer_ = std::move(other.buffer_);
+        allocator_ = other.allocator_;
+        scratch_arena_ = other.scratch_arena_;
         width_ = other.width_;
         height_ = other.height_;
         channels_ = other.channels_;
         jpeg_quality_ = other.jpeg_quality_;
         
         // Обнуляем данные в исходном объекте
-        other.data_ = nullptr;
         other.width_ = 0;
         other.height_ = 0;
         other.channels_ = 0;
@@ -59,12 +52,12 @@ ImageProcessor& ImageProcessor::operator=(ImageProcessor&& other) noexcept
     return *this;
 }
 
-FilterResult ImageProcessor::loadFromFile(const std::string& filename, bool preserve_alpha)
+FilterResult ImageProcessor::loadFromFile(const std::string& filename, bool preserve_alpha, int scale_denominator)
 {
     // Освобождаем предыдущие данные, если они были загружены
-    if (data_ != nullptr)
+    if (buffer_)
     {
-        stbi_image_free(data_);
+        buffer_.reset();
         width_ = 0;
         height_ = 0;
         channels_ = 0;
@@ -72,22 +65,51 @@ FilterResult ImageProcessor::loadFromFile(const std::string& filename, bool pres
 
     // Используем ImageLoader для загрузки изображения
     ImageLoader::LoadedImage loaded;
-    const auto result = ImageLoader::loadFromFile(filename, preserve_alpha, loaded);
+    const auto result = ImageLoader::loadFromFile(filename, preserve_alpha, loaded, scale_denominator);
     
     if (!result.isSuccess())
     {
         return result;
     }
 
-    // Устанавливаем загруженные данные
-    data_ = loaded.data;
-    width_ = loaded.width;
-    height_ = loaded.height;
-    channels_ = loaded.channels;
+    setLoaded(loaded.data, loaded.width, loaded.height, loaded.channels);
+    return FilterResult::success();
+}
+
+FilterResult ImageProcessor::loadFromMemory(std::span<const uint8_t> data, bool preserve_alpha,
+                                            int scale_denominator)
+{
+    // Освобождаем предыдущие данные, если они были загружены
+    if (buffer_)
+    {
+        buffer_.reset();
+        width_ = 0;
+        height_ = 0;
+        channels_ = 0;
+    }
+
+    ImageLoader::LoadedImage loaded;
+    const auto result = ImageLoader::loadFromMemory(data, preserve_alpha, loaded, scale_denominator);
+    if (!result.isSuccess())
+    {
+        return result;
+    }
 
+    setLoaded(loaded.data, loaded.width, loaded.height, loaded.channels);
     return FilterResult::success();
 }
 
+void ImageProcessor::setLoaded(uint8_t* data, int width, int height, int channels)
+{
+    // Память выделена декодером через malloc
+    const auto loaded_size = static_cast<size_t>(width) * static_cast<size_t>(height) *
+                             static_cast<size_t>(channels);
+    buffer_ = ImageBuffer(data, loaded_size, [](uint8_t* ptr) { std::free(ptr); });
+    width_ = width;
+    height_ = height;
+    channels_ = channels;
+}
+
 FilterResult ImageProcessor::saveToFile(const std::string& filename, bool preserve_alpha) const
 {
     if (!isValid())
@@ -98,16 +120,29 @@ FilterResult ImageProcessor::saveToFile(const std::string& filename, bool preser
     }
 
     // Используем ImageSaver для сохранения изображения
-    return ImageSaver::saveToFile(filename, data_, width_, height_, channels_, 
+    return ImageSaver::saveToFile(filename, buffer_.data(), width_, height_, channels_, 
                                  preserve_alpha, jpeg_quality_);
 }
 
+FilterResult ImageProcessor::saveToMemory(const std::string& format, std::vector<uint8_t>& output,
+                                          bool preserve_alpha) const
+{
+    if (!isValid())
+    {
+        output.clear();
+        return FilterResult::failure(FilterError::InvalidImage, "Изображение не загружено");
+    }
+
+    return ImageSaver::saveToMemory(format, buffer_.data(), width_, height_, channels_, preserve_alpha,
+                                    jpeg_quality_, output);
+}
+
 int ImageProcessor::getWidth() const noexcept { return width_; }
 int ImageProcessor::getHeight() const noexcept { return height_; }
 int ImageProcessor::getChannels() const noexcept { return channels_; }
-uint8_t* ImageProcessor::getData() noexcept { return data_; }
-const uint8_t* ImageProcessor::getData() const noexcept { return data_; }
-bool ImageProcessor::isValid() const noexcept { return data_ != nullptr; }
+uint8_t* ImageProcessor::getData() noexcept { return buffer_.data(); }
+const uint8_t* ImageProcessor::getData() const noexcept { return buffer_.data(); }
+bool ImageProcessor::isValid() const noexcept { return static_cast<bool>(buffer_); }
 
 bool ImageProcessor::hasAlpha() const noexcept
 {
@@ -129,6 +164,26 @@ int ImageProcessor::getJpegQuality() const noexcept
     return jpeg_quality_;
 }
 
+void ImageProcessor::setAllocator(IImageAllocator* allocator) noexcept
+{
+    allocator_ = allocator;
+}
+
+IImageAllocator& ImageProcessor::getAllocator() const noexcept
+{
+    return allocator_ != nullptr ? *allocator_ : ImageAllocator::getDefault();
+}
+
+void ImageProcessor::setScratchArena(ScratchArena* arena) noexcept
+{
+    scratch_arena_ = arena;
+}
+
+ScratchArena* ImageProcessor::getScratchArena() const noexcept
+{
+    return scratch_arena_;
+}
+
 FilterResult ImageProcessor::convertToRGB()
 {
     if (!isValid() || channels_ != 4)
@@ -145,49 +200,14 @@ FilterResult ImageProcessor::convertToRGB()
                                    "Некорректный размер изображения", ctx);
     }
     
-    // Проверяем, что произведение не приведет к переполнению
-    size_t width_height_product = 0;
-    if (!SafeMath::safeMultiply(static_cast<size_t>(width_), static_cast<size_t>(height_), width_height_product))
-    {
-        ErrorContext ctx = ErrorContext::withImage(width_, height_, channels_);
-        return FilterResult::failure(FilterError::ArithmeticOverflow, 
-                                   "Размер изображения слишком большой", ctx);
-    }
-    
-    size_t rgb_size = 0;
-    if (!SafeMath::safeMultiply(width_height_product, static_cast<size_t>(3), rgb_size))
-    {
-        ErrorContext ctx = ErrorContext::withImage(width_, height_, channels_);
-        return FilterResult::failure(FilterError::ArithmeticOverflow, 
-                                   "Размер изображения слишком большой", ctx);
-    }
-    
-    auto* rgb_data = static_cast<uint8_t*>(std::malloc(rgb_size));
-    if (rgb_data == nullptr)
-    {
-        const int errno_code = errno;
-        ErrorContext ctx = ErrorContext::withImage(width_, height_, channels_);
-        if (errno_code != 0)
-        {
-            ctx.system_error_code = errno_code;
-        }
-        return FilterResult::failure(FilterError::OutOfMemory, 
-                                   "Недостаточно памяти для преобразования RGBA в RGB", ctx);
-    }
-
-    // Используем ImageConverter для преобразования RGBA в RGB
-    const auto convert_result = ImageConverter::convertRGBAToRGB(data_, width_, height_, rgb_data);
+    // Преобразуем на месте: RGB данные короче RGBA, поэтому запись не обгоняет чтение.
+    // Буфер сохраняет прежний размер и освобождается исходным способом
+    const auto convert_result = ImageConverter::convertRGBAToRGB(buffer_.data(), width_, height_, buffer_.data());
     if (!convert_result.isSuccess())
     {
-        std::free(rgb_data);
         return convert_result;
     }
 
-    // Освобождаем старые данные
-    stbi_image_free(data_);
-
-    // Устанавливаем новые данные
-    data_ = rgb_data;
     channels_ = 3;
 
     return FilterResult::success();
@@ -212,8 +232,7 @@ FilterResult ImageProcessor::resize(int new_width, int new_height, int new_chann
     if (new_data == nullptr)
     {
         // Просто освобождаем старое изображение и устанавливаем новые размеры
-        stbi_image_free(data_);
-        data_ = nullptr;
+        buffer_.reset();
         width_ = new_width;
         height_ = new_height;
         return FilterResult::success();
@@ -236,9 +255,9 @@ FilterResult ImageProcessor::resize(int new_width, int new_height, int new_chann
                                    "Размер изображения слишком большой", ctx);
     }
 
-    // Выделяем новую память через malloc (совместимо с stbi_image_free)
-    auto* allocated_data = static_cast<uint8_t*>(std::malloc(new_size));
-    if (allocated_data == nullptr)
+    // Выделяем новую память через распределитель изображения
+    auto buffer = ImageBuffer::allocate(new_size, getAllocator());
+    if (!buffer)
     {
         const int errno_code = errno;
         ErrorContext ctx = ErrorContext::withImage(new_width, new_height, new_channels);
@@ -251,16 +270,66 @@ FilterResult ImageProcessor::resize(int new_width, int new_height, int new_chann
     }
 
     // Копируем данные из переданного буфера
-    std::memcpy(allocated_data, new_data, new_size);
-
-    // Освобождаем старые данные
-    stbi_image_free(data_);
+    std::memcpy(buffer.data(), new_data, new_size);
 
-    // Устанавливаем новые данные и размеры
-    data_ = allocated_data;
+    // Заменяем данные (старый буфер освобождается) и размеры
+    buffer_ = std::move(buffer);
     width_ = new_width;
     height_ = new_height;
 
     return FilterResult::success();
 }
 
+
+FilterResult ImageProcessor::adopt(int new_width, int new_height, int new_channels,
+                                   uint8_t* data, ImageBuffer::Deleter deleter)
+{
+    size_t new_size = 0;
+    if (new_width > 0 && new_height > 0 && new_channels > 0)
+    {
+        size_t width_height_product = 0;
+        if (!SafeMath::safeMultiply(static_cast<size_t>(new_width), static_cast<size_t>(new_height), width_height_product) ||
+            !SafeMath::safeMultiply(width_height_product, static_cast<size_t>(new_channels), new_size))
+        {
+            new_size = 0;
+        }
+    }
+    return adopt(new_width, new_height, new_channels, ImageBuffer(data, new_size, std::move(deleter)));
+}
+
+FilterResult ImageProcessor::adopt(int new_width, int new_height, int new_channels, ImageBuffer&& buffer)
+{
+    // Буфер принимается во владение в любом случае: при ошибке он освобождается здесь
+    ImageBuffer adopted = std::move(buffer);
+
+    if (new_width <= 0 || new_height <= 0 || (new_channels != 3 && new_channels != 4))
+    {
+        ErrorContext ctx = ErrorContext::withImage(new_width, new_height, new_channels);
+        return FilterResult::failure(FilterError::InvalidSize, 
+                                   "Некорректный размер или количество каналов", ctx);
+    }
+
+    size_t width_height_product = 0;
+    size_t required_size = 0;
+    if (!SafeMath::safeMultiply(static_cast<size_t>(new_width), static_cast<size_t>(new_height), width_height_product) ||
+        !SafeMath::safeMultiply(width_height_product, static_cast<size_t>(new_channels), required_size))
+    {
+        ErrorContext ctx = ErrorContext::withImage(new_width, new_height, new_channels);
+        return FilterResult::failure(FilterError::ArithmeticOverflow, 
+                                   "Размер изображения слишком большой", ctx);
+    }
+
+    if (!adopted || adopted.size() < required_size)
+    {
+        ErrorContext ctx = ErrorContext::withImage(new_width, new_height, new_channels);
+        return FilterResult::failure(FilterError::InvalidImage, 
+                                   "Буфер не задан или меньше размера изображения", ctx);
+    }
+
+    buffer_ = std::move(adopted);
+    width_ = new_width;
+    height_ = new_height;
+    channels_ = new_channels;
+
+    return FilterResult::success();
+}
@@ -3,7 +3,7 @@
 #include <utils/ParallelImageProcessor.h>
 #include <utils/FilterResult.h>
 #include <utils/BorderHandler.h>
-#include <utils/IBufferPool.h>
+#include <utils/ScratchBuffer.h>
 #include <utils/SafeMath.h>
 #include <utils/FilterValidator.h>
 #include <utils/FilterValidationHelper.h>
@@ -42,16 +42,8 @@ FilterResult BoxBlurFilter::apply(ImageProcessor& image)
                                    "Размер изображения слишком большой", ctx);
     }
     
-    // Получаем буферы из пула или создаем новые
-    std::vector<uint8_t> horizontal_result;
-    if (buffer_pool_ != nullptr)
-    {
-        horizontal_result = buffer_pool_->acquire(buffer_size);
-    }
-    else
-    {
-        horizontal_result.resize(buffer_size);
-    }
+    // Промежуточный буфер горизонтального прохода (арена изображения, пул или куча)
+    ScratchBuffer horizontal_result(image.getScratchArena(), buffer_pool_, buffer_size);
 
     ParallelImageProcessor::processRowsParallel(
         height,
@@ -90,21 +82,14 @@ FilterResult BoxBlurFilter::apply(ImageProcessor& image)
         }
     );
 
-    // Применяем ядро по вертикали
-    std::vector<uint8_t> final_result;
-    if (buffer_pool_ != nullptr)
-    {
-        final_result = buffer_pool_->acquire(buffer_size);
-    }
-    else
-    {
-        final_result.resize(buffer_size);
-    }
+    // Применяем ядро по вертикали: проход читает только horizontal_result,
+    // поэтому результат записывается прямо в изображение
+    auto* final_result = image.getData();
 
     ParallelImageProcessor::processRowsParallel(
         height,
         width,
-        [width, height, channels, &horizontal_result, &final_result, this, kernel_weight](int start_row, int end_row)
+        [width, height, channels, &horizontal_result, final_result, this, kernel_weight](int start_row, int end_row)
         {
             for (int y = start_row; y < end_row; ++y)
             {
@@ -137,17 +122,6 @@ FilterResult BoxBlurFilter::apply(ImageProcessor& image)
         }
     );
 
-    // Копируем результат обратно
-    auto* data = image.getData();
-    std::ranges::copy(final_result, data);
-
-    // Возвращаем буферы в пул для переиспользования
-    if (buffer_pool_ != nullptr)
-    {
-        buffer_pool_->release(std::move(horizontal_result));
-        buffer_pool_->release(std::move(final_result));
-    }
-
     return FilterResult::success();
 }
 
@@ -166,3 +140,13 @@ std::string BoxBlurFilter::getCategory() const
     return "Размытие и шум";
 }
 
+std::string BoxBlurFilter::getParameters() const
+{
+    return formatParameter("radius", radius_) + "," + formatParameter("border", border_handler_.getStrategyName());
+}
+
+int BoxBlurFilter::getStreamingRadius() const noexcept
+{
+    // Wrap берет строки у противоположного края изображения, которых нет в окне полосы
+    return border_handler_.getStrategy() == BorderHandler::Strategy::Wrap ? -1 : radius_;
+}
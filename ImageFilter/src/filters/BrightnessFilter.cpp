@@ -70,10 +70,17 @@ std::string BrightnessFilter::getCategory() const
     return "Цветовой";
 }
 
+std::string BrightnessFilter::getParameters() const
+{
+    return formatParameter("factor", factor_);
+}
+
 bool BrightnessFilter::supportsInPlace() const noexcept
 {
     return true;
 }
 
-
-
+int BrightnessFilter::getStreamingRadius() const noexcept
+{
+    return 0;
+}
@@ -110,11 +110,17 @@ std::string ContrastFilter::getCategory() const
     return "Цветовой";
 }
 
+std::string ContrastFilter::getParameters() const
+{
+    return formatParameter("factor", factor_);
+}
+
 bool ContrastFilter::supportsInPlace() const noexcept
 {
     return true;
 }
 
-
-
-
+int ContrastFilter::getStreamingRadius() const noexcept
+{
+    return 0;
+}
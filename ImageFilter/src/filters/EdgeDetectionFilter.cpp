@@ -1,70 +1,39 @@
 #include <filters/EdgeDetectionFilter.h>
 #include <ImageProcessor.h>
-#include <utils/ParallelImageProcessor.h>
 #include <utils/FilterResult.h>
 #include <utils/FilterValidator.h>
 #include <utils/FilterValidationHelper.h>
 #include <utils/BorderHandler.h>
-#include <utils/LookupTables.h>
-#include <utils/ColorConversionUtils.h>
-#include <cmath>
+#include <utils/GradientKernels.h>
+#include <utils/GrayscaleRowWindow.h>
+#include <algorithm>
 #include <vector>
-#include <array>
 
 namespace {
     /**
-     * @brief Возвращает ядра оператора Собеля
-     * @param gx Ядро для горизонтального градиента (выходной параметр)
-     * @param gy Ядро для вертикального градиента (выходной параметр)
+     * @brief Рабочие буферы строки для одной полосы изображения
      */
-    void getSobelKernels(std::array<std::array<int, 3>, 3>& gx, std::array<std::array<int, 3>, 3>& gy)
+    struct GradientRowScratch
     {
-        // Gx (горизонтальное)
-        gx[0] = {{-1, 0, 1}};
-        gx[1] = {{-2, 0, 2}};
-        gx[2] = {{-1, 0, 1}};
-
-        // Gy (вертикальное)
-        gy[0] = {{-1, -2, -1}};
-        gy[1] = {{0, 0, 0}};
-        gy[2] = {{1, 2, 1}};
-    }
-
-    /**
-     * @brief Возвращает ядра оператора Преввитта
-     * @param gx Ядро для горизонтального градиента (выходной параметр)
-     * @param gy Ядро для вертикального градиента (выходной параметр)
-     */
-    void getPrewittKernels(std::array<std::array<int, 3>, 3>& gx, std::array<std::array<int, 3>, 3>& gy)
-    {
-        // Gx (горизонтальное)
-        gx[0] = {{-1, 0, 1}};
-        gx[1] = {{-1, 0, 1}};
-        gx[2] = {{-1, 0, 1}};
-
-        // Gy (вертикальное)
-        gy[0] = {{-1, -1, -1}};
-        gy[1] = {{0, 0, 0}};
-        gy[2] = {{1, 1, 1}};
-    }
-
-    /**
-     * @brief Возвращает ядра оператора Шарра
-     * @param gx Ядро для горизонтального градиента (выходной параметр)
-     * @param gy Ядро для вертикального градиента (выходной параметр)
-     */
-    void getScharrKernels(std::array<std::array<int, 3>, 3>& gx, std::array<std::array<int, 3>, 3>& gy)
-    {
-        // Gx (горизонтальное) - оптимизированная версия для лучшей точности
-        gx[0] = {{-3, 0, 3}};
-        gx[1] = {{-10, 0, 10}};
-        gx[2] = {{-3, 0, 3}};
-
-        // Gy (вертикальное)
-        gy[0] = {{-3, -10, -3}};
-        gy[1] = {{0, 0, 0}};
-        gy[2] = {{3, 10, 3}};
-    }
+        std::vector<int16_t> gx;         ///< Горизонтальный градиент строки
+        std::vector<int16_t> gy;         ///< Вертикальный градиент строки
+        std::vector<int32_t> magnitude;  ///< Магнитуда градиента строки
+
+        /**
+         * @brief Выделяет буферы при первом использовании полосы
+         * @param width Ширина строки
+         */
+        void ensureSize(int width)
+        {
+            const auto size = static_cast<size_t>(width);
+            if (magnitude.size() != size)
+            {
+                gx.resize(size);
+                gy.resize(size);
+                magnitude.resize(size);
+            }
+        }
+    };
 }
 
 FilterResult EdgeDetectionFilter::apply(ImageProcessor& image)
@@ -91,155 +60,72 @@ FilterResult EdgeDetectionFilter::apply(ImageProcessor& image)
         return FilterResult::failure(sensitivity_result.error, sensitivity_result.message, ctx);
     }
 
-    // Инициализируем lookup tables
-    LookupTables::initialize();
-
-    const auto* input_data = image.getData();
-
-    // Сначала преобразуем в градации серого
-    const auto grayscale_size = static_cast<size_t>(width) * static_cast<size_t>(height);
-    
-    // Создаем буфер для градаций серого
-    std::vector<uint8_t> grayscale(grayscale_size);
-
-    // Коэффициенты для преобразования RGB в градации серого
-
-    for (int y = 0; y < height; ++y)
-    {
-        for (int x = 0; x < width; ++x)
-        {
-            const auto pixel_offset = (static_cast<size_t>(y) * static_cast<size_t>(width) + static_cast<size_t>(x)) * static_cast<size_t>(channels);
-            const auto r = static_cast<int>(input_data[pixel_offset + 0]);
-            const auto g = static_cast<int>(input_data[pixel_offset + 1]);
-            const auto b = static_cast<int>(input_data[pixel_offset + 2]);
-            // Используем общую утилиту для преобразования RGB в градации серого
-            grayscale[static_cast<size_t>(y) * static_cast<size_t>(width) + static_cast<size_t>(x)] = 
-                ColorConversionUtils::rgbToGrayscale(r, g, b);
-        }
-    }
+    auto* data = image.getData();
 
+    // Координаты соседей за левой и правой границей с учетом стратегии
+    const auto left_border = std::clamp(border_handler_.getX(-1, width), 0, width - 1);
+    const auto right_border = std::clamp(border_handler_.getX(width, width), 0, width - 1);
 
-    std::vector<int> gradient_magnitude(static_cast<size_t>(width) * static_cast<size_t>(height));
+    // Градации серого и градиенты вычисляются потоково окном из трех строк,
+    // полнокадровые промежуточные буферы не создаются
+    GrayscaleRowWindow window(data, width, height, channels, border_handler_);
+    std::vector<GradientRowScratch> scratch(window.getStripCount());
 
-    // Получаем ядра в зависимости от выбранного оператора
-    std::array<std::array<int, 3>, 3> gx_kernel, gy_kernel;
-    switch (operator_type_)
+    // Вычисляет магнитуду градиента строки y в буфер полосы
+    const auto compute_row = [this, width, left_border, right_border, &scratch](
+        size_t strip, const uint8_t* above, const uint8_t* center, const uint8_t* below) -> const int32_t*
     {
-        case EdgeDetectionFilter::Operator::Sobel:
-            getSobelKernels(gx_kernel, gy_kernel);
-            break;
-        case EdgeDetectionFilter::Operator::Prewitt:
-            getPrewittKernels(gx_kernel, gy_kernel);
-            break;
-        case EdgeDetectionFilter::Operator::Scharr:
-            getScharrKernels(gx_kernel, gy_kernel);
-            break;
-    }
-
-    // Применяем выбранный оператор
-    ParallelImageProcessor::processRowsParallel(
-        height,
-        [width, height, &grayscale, &gradient_magnitude, &gx_kernel, &gy_kernel, this](int start_row, int end_row)
+        auto& rows = scratch[strip];
+        rows.ensureSize(width);
+        GradientKernels::computeGradientRow(operator_type_, above, center, below,
+                                            width, left_border, right_border,
+                                            rows.gx.data(), rows.gy.data());
+        GradientKernels::computeMagnitudeRow(magnitude_, rows.gx.data(), rows.gy.data(),
+                                             width, rows.magnitude.data());
+        return rows.magnitude.data();
+    };
+
+    // Первый проход: максимум магнитуды по каждой полосе
+    std::vector<int32_t> strip_max(window.getStripCount(), 0);
+    window.analyze(
+        [width, &strip_max, &compute_row](size_t strip, int, const uint8_t* above, const uint8_t* center, const uint8_t* below)
         {
-            for (int y = start_row; y < end_row; ++y)
-            {
-                for (int x = 0; x < width; ++x)
-                {
-                    int gx = 0;
-                    int gy = 0;
-
-                    // Применяем ядра оператора
-                    for (int ky = -1; ky <= 1; ++ky)
-                    {
-                        for (int kx = -1; kx <= 1; ++kx)
-                        {
-                            const auto px = x + kx;
-                            const auto py = y + ky;
-
-                            // Обработка границ с использованием BorderHandler
-                            const auto clamped_x = border_handler_.getX(px, width);
-                            const auto clamped_y = border_handler_.getY(py, height);
-
-                            const auto pixel_value = static_cast<int>(grayscale[static_cast<size_t>(clamped_y) * static_cast<size_t>(width) +
-                                static_cast<size_t>(clamped_x)]);
-                            gx += pixel_value * gx_kernel[static_cast<size_t>(ky + 1)][static_cast<size_t>(kx + 1)];
-                            gy += pixel_value * gy_kernel[static_cast<size_t>(ky + 1)][static_cast<size_t>(kx + 1)];
-                        }
-                    }
-
-                    // Вычисляем магнитуду градиента
-                    // Используем lookup table для sqrt для оптимизации
-                    const auto gradient_squared = gx * gx + gy * gy;
-                    gradient_magnitude[static_cast<size_t>(y) * static_cast<size_t>(width) + static_cast<size_t>(x)] = 
-                        static_cast<int>(LookupTables::sqrtInt(gradient_squared));
-                }
-            }
+            const auto* magnitude = compute_row(strip, above, center, below);
+            strip_max[strip] = std::max(strip_max[strip], *std::max_element(magnitude, magnitude + width));
         }
     );
 
-    // Нормализуем и применяем к изображению с учетом чувствительности
-    int max_gradient = 0;
-    for (int val : gradient_magnitude)
-    {
-        if (val > max_gradient)
-        {
-            max_gradient = val;
-        }
-    }
+    const int max_gradient = strip_max.empty() ? 0 : *std::max_element(strip_max.begin(), strip_max.end());
 
     // Применяем чувствительность: чем выше чувствительность, тем ниже порог нормализации
     // Это позволяет выделять более слабые края при высокой чувствительности
     const auto threshold = static_cast<int>(max_gradient * (1.0 - sensitivity_));
     const auto effective_max = max_gradient - threshold;
 
-    auto* data = image.getData();
-    if (effective_max > 0)
-    {
-        ParallelImageProcessor::processRowsParallel(
-            height,
-            [width, channels, &gradient_magnitude, data, threshold, effective_max](int start_row, int end_row)
-            {
-                for (int y = start_row; y < end_row; ++y)
-                {
-                    for (int x = 0; x < width; ++x)
-                    {
-                        const auto pixel_offset = (static_cast<size_t>(y) * static_cast<size_t>(width) + static_cast<size_t>(x)) * static_cast<size_t>(channels);
-                        auto gradient = gradient_magnitude[static_cast<size_t>(y) * static_cast<size_t>(width) + static_cast<size_t>(x)];
-                        
-                        // Применяем порог с учетом чувствительности
-                        gradient = std::max(0, gradient - threshold);
-                        
-                        // Нормализуем в диапазон [0, 255]
-                        const auto normalized = static_cast<uint8_t>((gradient * 255) / effective_max);
-
-                        data[pixel_offset + 0] = normalized;
-                        data[pixel_offset + 1] = normalized;
-                        data[pixel_offset + 2] = normalized;
-                    }
-                }
-            }
-        );
-    }
-    else
-    {
-        // Если нет градиентов выше порога, заполняем черным
-        ParallelImageProcessor::processRowsParallel(
-            height,
-            [width, channels, data](int start_row, int end_row)
+    // Второй проход: градиенты пересчитываются и сразу записываются в изображение
+    window.write(
+        [width, channels, data, threshold, effective_max, &compute_row](size_t strip, int y, const uint8_t* above, const uint8_t* center, const uint8_t* below)
+        {
+            const auto* magnitude = compute_row(strip, above, center, below);
+            auto* row = data + static_cast<size_t>(y) * static_cast<size_t>(width) * static_cast<size_t>(channels);
+            for (int x = 0; x < width; ++x)
             {
-                for (int y = start_row; y < end_row; ++y)
+                uint8_t normalized = 0;
+                if (effective_max > 0)
                 {
-                    for (int x = 0; x < width; ++x)
-                    {
-                        const auto pixel_offset = (static_cast<size_t>(y) * static_cast<size_t>(width) + static_cast<size_t>(x)) * static_cast<size_t>(channels);
-                        data[pixel_offset + 0] = 0;
-                        data[pixel_offset + 1] = 0;
-                        data[pixel_offset + 2] = 0;
-                    }
+                    // Применяем порог с учетом чувствительности и нормализуем в диапазон [0, 255]
+                    const auto gradient = std::max(0, magnitude[x] - threshold);
+                    normalized = static_cast<uint8_t>((gradient * 255) / effective_max);
                 }
+                // Если нет градиентов выше порога, пиксель заполняется черным
+
+                auto* pixel = row + static_cast<size_t>(x) * static_cast<size_t>(channels);
+                pixel[0] = normalized;
+                pixel[1] = normalized;
+                pixel[2] = normalized;
             }
-        );
-    }
+        }
+    );
 
     return FilterResult::success();
 }
@@ -272,5 +158,23 @@ std::string EdgeDetectionFilter::getCategory() const
     return "Края и детали";
 }
 
+std::string EdgeDetectionFilter::getParameters() const
+{
+    const char* operator_name = "sobel";
+    if (operator_type_ == Operator::Prewitt)
+    {
+        operator_name = "prewitt";
+    }
+    else if (operator_type_ == Operator::Scharr)
+    {
+        operator_name = "scharr";
+    }
+    const char* magnitude_name = (magnitude_ == Magnitude::Approximate) ? "approx" : "exact";
+    return formatParameter("sensitivity", sensitivity_) + ","
+           + formatParameter("operator", operator_name) + ","
+           + formatParameter("magnitude", magnitude_name) + ","
+           + formatParameter("border", border_handler_.getStrategyName());
+}
+
 
 
@@ -6,6 +6,7 @@
 #include <utils/FilterValidationHelper.h>
 #include <utils/BorderHandler.h>
 #include <utils/SafeMath.h>
+#include <utils/ScratchBuffer.h>
 #include <algorithm>
 #include <vector>
 
@@ -34,8 +35,8 @@ FilterResult EmbossFilter::apply(ImageProcessor &image) {
                                      "Размер изображения слишком большой", ctx);
     }
 
-    // Создаем буфер для результата
-    std::vector<uint8_t> result(buffer_size);
+    // Временный буфер результата (арена изображения или куча)
+    ScratchBuffer result(image.getScratchArena(), nullptr, buffer_size);
 
     // Сохраняем strength в локальную переменную для захвата в лямбде
     const double strength = strength_;
@@ -118,3 +119,12 @@ std::string EmbossFilter::getDescription() const {
 std::string EmbossFilter::getCategory() const {
     return "Края и детали";
 }
+
+std::string EmbossFilter::getParameters() const {
+    return formatParameter("strength", strength_) + "," + formatParameter("border", border_handler_.getStrategyName());
+}
+
+int EmbossFilter::getStreamingRadius() const noexcept {
+    // Wrap берет строки у противоположного края изображения, которых нет в окне полосы
+    return border_handler_.getStrategy() == BorderHandler::Strategy::Wrap ? -1 : 1;
+}
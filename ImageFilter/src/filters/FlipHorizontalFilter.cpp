@@ -74,5 +74,7 @@ std::string FlipHorizontalFilter::getCategory() const
     return "Геометрический";
 }
 
-
-
+int FlipHorizontalFilter::getStreamingRadius() const noexcept
+{
+    return 0;
+}
@@ -4,7 +4,7 @@
 #include <utils/FilterResult.h>
 #include <utils/BorderHandler.h>
 #include <utils/LookupTables.h>
-#include <utils/IBufferPool.h>
+#include <utils/ScratchBuffer.h>
 #include <utils/CacheManager.h>
 #include <utils/SafeMath.h>
 #include <utils/FilterValidator.h>
@@ -25,9 +25,6 @@ namespace {
      * @return Вектор коэффициентов ядра (масштабированные на 65536 для точности)
      */
     std::vector<int32_t> generateKernel(const double radius, const double &sigma) {
-        // Инициализируем lookup tables при первом использовании
-        LookupTables::initialize();
-
         // Размер ядра должен быть нечетным и покрывать 3 сигмы в каждую сторону
         // Это обеспечивает, что 99.7% веса функции Гаусса попадет в ядро
         const auto kernel_size = static_cast<int>(std::ceil(radius * 2.0)) | 1; // Делаем нечетным
@@ -76,17 +73,18 @@ namespace {
      * @brief Генерирует или получает из кэша одномерное ядро Гаусса
      * @param radius Радиус размытия
      * @param sigma Стандартное отклонение (вычисляется из radius)
-     * @return Вектор коэффициентов ядра (масштабированные на 65536 для точности)
+     * @return Ядро (коэффициенты масштабированы на 65536), разделяемое с кэшем
      */
-    std::vector<int32_t> getOrGenerateKernel(const double radius, const double &sigma) {
+    CacheManager::KernelPtr getOrGenerateKernel(const double radius, const double &sigma) {
         KernelCacheKey key{};
         key.type = KernelCacheKey::Type::Gaussian;
         key.radius = radius;
         key.sigma = sigma;
 
         auto &cache_manager = CacheManager::getInstance();
-        return cache_manager.getOrGenerateKernel(key, [radius, sigma]() {
-            auto kernel = generateKernel(radius, sigma);
+        // Ядро строится по параметрам ключа: при квантовании ключей они могут отличаться от запрошенных
+        return cache_manager.getOrGenerateKernel(key, [](const KernelCacheKey& cache_key) {
+            auto kernel = generateKernel(cache_key.radius, cache_key.sigma);
             normalizeKernel(kernel);
             return kernel;
         });
@@ -98,9 +96,9 @@ namespace {
      * @param kernel Ядро для применения (целочисленное, масштабированное)
      * @param border_handler Обработчик границ
      * @param buffer_pool Пул буферов для переиспользования (может быть nullptr)
-     * @return Вектор с промежуточными результатами
+     * @return Буфер с промежуточными результатами (арена изображения, пул или куча)
      */
-    std::vector<uint8_t> applyHorizontalKernel(
+    ScratchBuffer applyHorizontalKernel(
         const ImageProcessor &image,
         const std::vector<int32_t> &kernel,
         const BorderHandler &border_handler,
@@ -117,17 +115,11 @@ namespace {
         size_t buffer_size = 0;
         if (!SafeMath::safeMultiply(static_cast<size_t>(width), static_cast<size_t>(height), width_height_product) ||
             !SafeMath::safeMultiply(width_height_product, static_cast<size_t>(channels), buffer_size)) {
-            // Возвращаем пустой вектор при переполнении
-            return std::vector<uint8_t>();
+            // Возвращаем пустой буфер при переполнении
+            return ScratchBuffer();
         }
 
-        // Получаем буфер из пула или создаем новый
-        std::vector<uint8_t> result;
-        if (buffer_pool != nullptr) {
-            result = buffer_pool->acquire(buffer_size);
-        } else {
-            result.resize(buffer_size);
-        }
+        ScratchBuffer result(image.getScratchArena(), buffer_pool, buffer_size);
 
         // Параллельная обработка строк изображения
         ParallelImageProcessor::processRowsParallel(
@@ -192,18 +184,18 @@ namespace {
     /**
      * @brief Применяет одномерное ядро по вертикали
      * @param horizontalResult Результат горизонтального применения
-     * @param image Исходное изображение (для получения размеров)
+     * @param image Изображение, в которое записывается финальный результат размытия
      * @param kernel Ядро для применения (целочисленное, масштабированное)
      * @param border_handler Обработчик границ
-     * @param buffer_pool Пул буферов для переиспользования (может быть nullptr)
-     * @return Финальный результат размытия
+     *
+     * Проход читает только horizontalResult, поэтому результат записывается
+     * прямо в изображение без дополнительного буфера и копирования.
      */
-    std::vector<uint8_t> applyVerticalKernel(
-        const std::vector<uint8_t> &horizontalResult,
-        const ImageProcessor &image,
+    void applyVerticalKernel(
+        const ScratchBuffer &horizontalResult,
+        ImageProcessor &image,
         const std::vector<int32_t> &kernel,
-        const BorderHandler &border_handler,
-        IBufferPool *buffer_pool
+        const BorderHandler &border_handler
     ) {
         const auto width = image.getWidth();
         const auto height = image.getHeight();
@@ -215,22 +207,19 @@ namespace {
         size_t buffer_size = 0;
         if (!SafeMath::safeMultiply(static_cast<size_t>(width), static_cast<size_t>(height), width_height_product) ||
             !SafeMath::safeMultiply(width_height_product, static_cast<size_t>(channels), buffer_size)) {
-            // Возвращаем пустой вектор при переполнении
-            return std::vector<uint8_t>();
+            return;
         }
-
-        // Получаем буфер из пула или создаем новый
-        std::vector<uint8_t> result;
-        if (buffer_pool != nullptr) {
-            result = buffer_pool->acquire(buffer_size);
-        } else {
-            result.resize(buffer_size);
+        if (horizontalResult.size() != buffer_size) {
+            // Горизонтальный проход не выполнен (переполнение размера)
+            return;
         }
 
+        auto *result = image.getData();
+
         // Параллельная обработка строк изображения
         ParallelImageProcessor::processRowsParallel(
             height,
-            [&horizontalResult, &result, &kernel, &border_handler, width, height, channels, kernel_size, kernel_radius](
+            [&horizontalResult, result, &kernel, &border_handler, width, height, channels, kernel_size, kernel_radius](
         int start_row, int end_row) {
                 // Обрабатываем строки в диапазоне [start_row, end_row)
                 for (int y = start_row; y < end_row; ++y) {
@@ -284,8 +273,6 @@ namespace {
                 }
             }
         );
-
-        return result;
     }
 }
 
@@ -314,18 +301,8 @@ FilterResult GaussianBlurFilter::apply(ImageProcessor &image) {
     // Применяем separable kernel: сначала по горизонтали, затем по вертикали
     // Это оптимизация: вместо O(N²) операций на пиксель получаем O(2N)
 
-    auto horizontal_result = applyHorizontalKernel(image, kernel, border_handler_, buffer_pool_);
-    auto final_result = applyVerticalKernel(horizontal_result, image, kernel, border_handler_, buffer_pool_);
-
-    // Копируем результат обратно в изображение
-    auto *data = image.getData();
-    std::ranges::copy(final_result, data);
-
-    // Возвращаем буферы в пул для переиспользования
-    if (buffer_pool_ != nullptr) {
-        buffer_pool_->release(std::move(horizontal_result));
-        buffer_pool_->release(std::move(final_result));
-    }
+    auto horizontal_result = applyHorizontalKernel(image, *kernel, border_handler_, buffer_pool_);
+    applyVerticalKernel(horizontal_result, image, *kernel, border_handler_);
 
     return FilterResult::success();
 }
@@ -342,3 +319,16 @@ std::string GaussianBlurFilter::getDescription() const {
 std::string GaussianBlurFilter::getCategory() const {
     return "Размытие и шум";
 }
+
+std::string GaussianBlurFilter::getParameters() const {
+    return formatParameter("radius", radius_) + "," + formatParameter("border", border_handler_.getStrategyName());
+}
+
+int GaussianBlurFilter::getStreamingRadius() const noexcept {
+    // Wrap берет строки у противоположного края изображения, которых нет в окне полосы
+    if (border_handler_.getStrategy() == BorderHandler::Strategy::Wrap) {
+        return -1;
+    }
+    // Половина размера ядра, см. generateKernel()
+    return (static_cast<int>(std::ceil(radius_ * 2.0)) | 1) / 2;
+}
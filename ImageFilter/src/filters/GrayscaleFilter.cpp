@@ -78,3 +78,7 @@ bool GrayscaleFilter::supportsInPlace() const noexcept
     return true;
 }
 
+int GrayscaleFilter::getStreamingRadius() const noexcept
+{
+    return 0;
+}
@@ -1,5 +1,8 @@
 #include <filters/IFilter.h>
 
+#include <array>
+#include <charconv>
+
 /**
  * @brief Определение виртуального деструктора
  * 
@@ -8,3 +11,21 @@
  */
 IFilter::~IFilter() = default;
 
+
+std::string IFilter::formatParameter(std::string_view name, double value)
+{
+    // Кратчайшее представление, из которого значение восстанавливается точно
+    std::array<char, 32> buffer{};
+    const auto [end, ec] = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+    const std::string_view text = (ec == std::errc()) ? std::string_view(buffer.data(), end - buffer.data())
+                                                      : std::string_view("nan");
+    return formatParameter(name, text);
+}
+
+std::string IFilter::formatParameter(std::string_view name, std::string_view value)
+{
+    std::string parameter;
+    parameter.reserve(name.size() + 1 + value.size());
+    parameter.append(name).append("=").append(value);
+    return parameter;
+}
@@ -64,5 +64,7 @@ bool InvertFilter::supportsInPlace() const noexcept
     return true;
 }
 
-
-
+int InvertFilter::getStreamingRadius() const noexcept
+{
+    return 0;
+}
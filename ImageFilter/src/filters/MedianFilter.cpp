@@ -3,7 +3,7 @@
 #include <utils/ParallelImageProcessor.h>
 #include <utils/FilterResult.h>
 #include <utils/BorderHandler.h>
-#include <utils/IBufferPool.h>
+#include <utils/ScratchBuffer.h>
 #include <utils/SafeMath.h>
 #include <utils/FilterValidator.h>
 #include <utils/FilterValidationHelper.h>
@@ -74,16 +74,8 @@ FilterResult MedianFilter::apply(ImageProcessor& image)
                                    "Размер изображения слишком большой", ctx);
     }
     
-    // Получаем буфер из пула или создаем новый
-    std::vector<uint8_t> result;
-    if (buffer_pool_ != nullptr)
-    {
-        result = buffer_pool_->acquire(buffer_size);
-    }
-    else
-    {
-        result.resize(buffer_size);
-    }
+    // Временный буфер результата (арена изображения, пул или куча)
+    ScratchBuffer result(image.getScratchArena(), buffer_pool_, buffer_size);
     
     const auto window_size = (2 * radius_ + 1) * (2 * radius_ + 1);
     size_t row_stride = 0;
@@ -224,6 +216,18 @@ FilterResult MedianFilter::apply(ImageProcessor& image)
                     result[pixel_offset + 1] = findMedianFromHistogram(histogram_g, window_size);
                     result[pixel_offset + 2] = findMedianFromHistogram(histogram_b, window_size);
                 }
+
+                // Альфа-канал не фильтруется: буфер результата не инициализирован,
+                // поэтому копируем альфу из исходного изображения
+                if (channels == 4)
+                {
+                    const auto row_offset = static_cast<size_t>(y) * row_stride;
+                    for (int x = 0; x < width; ++x)
+                    {
+                        const auto alpha_offset = row_offset + static_cast<size_t>(x) * 4 + 3;
+                        result[alpha_offset] = input_data[alpha_offset];
+                    }
+                }
             }
         }
     );
@@ -232,12 +236,6 @@ FilterResult MedianFilter::apply(ImageProcessor& image)
     auto* data = image.getData();
     std::ranges::copy(result, data);
 
-    // Возвращаем буфер в пул для переиспользования
-    if (buffer_pool_ != nullptr)
-    {
-        buffer_pool_->release(std::move(result));
-    }
-
     return FilterResult::success();
 }
 
@@ -256,3 +254,13 @@ std::string MedianFilter::getCategory() const
     return "Размытие и шум";
 }
 
+std::string MedianFilter::getParameters() const
+{
+    return formatParameter("radius", radius_) + "," + formatParameter("border", border_handler_.getStrategyName());
+}
+
+int MedianFilter::getStreamingRadius() const noexcept
+{
+    // Wrap берет строки у противоположного края изображения, которых нет в окне полосы
+    return border_handler_.getStrategy() == BorderHandler::Strategy::Wrap ? -1 : radius_;
+}
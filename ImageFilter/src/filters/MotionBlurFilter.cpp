@@ -6,7 +6,7 @@
 #include <utils/FilterValidationHelper.h>
 #include <utils/BorderHandler.h>
 #include <utils/LookupTables.h>
-#include <utils/IBufferPool.h>
+#include <utils/ScratchBuffer.h>
 #include <utils/SafeMath.h>
 #include <algorithm>
 #include <vector>
@@ -49,19 +49,8 @@ FilterResult MotionBlurFilter::apply(ImageProcessor& image)
                                    "Размер изображения слишком большой", ctx);
     }
     
-    // Получаем буфер из пула или создаем новый
-    std::vector<uint8_t> result;
-    if (buffer_pool_ != nullptr)
-    {
-        result = buffer_pool_->acquire(buffer_size);
-    }
-    else
-    {
-        result.resize(buffer_size);
-    }
-
-    // Инициализируем lookup tables
-    LookupTables::initialize();
+    // Временный буфер результата (арена изображения, пул или куча)
+    ScratchBuffer result(image.getScratchArena(), buffer_pool_, buffer_size);
 
     // Используем lookup table для sin/cos вместо вычислений в runtime
     const auto angle_degrees = static_cast<int>(angle_);
@@ -118,12 +107,6 @@ FilterResult MotionBlurFilter::apply(ImageProcessor& image)
     auto* data = image.getData();
     std::ranges::copy(result, data);
 
-    // Возвращаем буфер в пул для переиспользования
-    if (buffer_pool_ != nullptr)
-    {
-        buffer_pool_->release(std::move(result));
-    }
-
     return FilterResult::success();
 }
 
@@ -142,5 +125,24 @@ std::string MotionBlurFilter::getCategory() const
     return "Размытие и шум";
 }
 
+std::string MotionBlurFilter::getParameters() const
+{
+    return formatParameter("length", length_) + ","
+           + formatParameter("angle", angle_) + ","
+           + formatParameter("border", border_handler_.getStrategyName());
+}
+
+int MotionBlurFilter::getStreamingRadius() const noexcept
+{
+    // Wrap берет строки у противоположного края изображения, которых нет в окне полосы
+    if (border_handler_.getStrategy() == BorderHandler::Strategy::Wrap)
+    {
+        return -1;
+    }
+    // Смещение по вертикали не превышает length / 2; запас в одну строку
+    // учитывает округление значений синуса из таблицы
+    return length_ / 2 + 1;
+}
+
 
 
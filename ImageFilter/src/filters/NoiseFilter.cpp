@@ -5,10 +5,32 @@
 #include <utils/FilterValidator.h>
 #include <utils/FilterValidationHelper.h>
 #include <utils/PixelOffsetUtils.h>
-#include <utils/SafeMath.h>
+#include <utils/CounterRNG.h>
 #include <algorithm>
+#include <array>
 #include <random>
 
+namespace
+{
+    /**
+     * @brief Количество пикселей, для которых случайные числа генерируются за один вызов
+     *
+     * Блок достаточно велик для векторизации генератора и достаточно мал,
+     * чтобы четыре массива слов помещались в L1-кэш.
+     */
+    constexpr size_t NOISE_BLOCK_SIZE = 256;
+
+    /**
+     * @brief Выбирает случайное зерно для невоспроизводимого режима
+     * @return 64-битное зерно из std::random_device
+     */
+    uint64_t drawRandomSeed()
+    {
+        std::random_device device;
+        return (static_cast<uint64_t>(device()) << 32) ^ static_cast<uint64_t>(device());
+    }
+}
+
 FilterResult NoiseFilter::apply(ImageProcessor& image)
 {
     // Валидация параметра фильтра
@@ -28,13 +50,24 @@ FilterResult NoiseFilter::apply(ImageProcessor& image)
     auto* data = image.getData();
     const auto max_noise = static_cast<int>(intensity_ * 255);
 
+    if (max_noise == 0)
+    {
+        // Нулевая амплитуда шума - изображение не меняется
+        return FilterResult::success();
+    }
+
+    // Шум каждого пикселя определяется только зерном и глобальным индексом пикселя,
+    // поэтому результат не зависит от разбиения строк между потоками
+    const uint64_t seed = seed_.has_value() ? seed_.value() : drawRandomSeed();
+    const auto noise_range = static_cast<uint32_t>(2 * max_noise + 1);
+
     ParallelImageProcessor::processRowsParallel(
         height,
-        [width, channels, data, max_noise](int start_row, int end_row)
+        width,
+        [width, channels, data, max_noise, seed, noise_range](int start_row, int end_row)
         {
-            // Генератор случайных чисел для каждого потока
-            thread_local std::mt19937 local_gen(std::random_device{}());
-            std::uniform_int_distribution<int> local_dist(-max_noise, max_noise);
+            // Слова генератора: слово c используется для канала c (каналов не больше 4)
+            std::array<std::array<uint32_t, NOISE_BLOCK_SIZE>, 4> words{};
 
             for (int y = start_row; y < end_row; ++y)
             {
@@ -46,41 +79,26 @@ FilterResult NoiseFilter::apply(ImageProcessor& image)
                     continue;
                 }
 
-                for (int x = 0; x < width; ++x)
+                auto* row = data + row_offset;
+                const uint64_t row_first_pixel = static_cast<uint64_t>(y) * static_cast<uint64_t>(width);
+
+                for (int block_start = 0; block_start < width; block_start += static_cast<int>(NOISE_BLOCK_SIZE))
                 {
-                    // Вычисляем смещение пикселя с защитой от переполнения
-                    size_t pixel_offset = 0;
-                    if (!PixelOffsetUtils::computePixelOffset(row_offset, x, channels, pixel_offset))
-                    {
-                        // Пропускаем пиксель при переполнении
-                        continue;
-                    }
+                    const auto block_size = std::min(NOISE_BLOCK_SIZE, static_cast<size_t>(width - block_start));
+
+                    CounterRNG::generateBlock(seed, row_first_pixel + static_cast<uint64_t>(block_start), block_size,
+                                              words[0].data(), words[1].data(), words[2].data(), words[3].data());
 
+                    auto* block_pixels = row + static_cast<size_t>(block_start) * static_cast<size_t>(channels);
                     for (int c = 0; c < channels; ++c)
                     {
-                        size_t channel_offset = 0;
-                        if (!PixelOffsetUtils::computeChannelOffset(pixel_offset, c, channel_offset))
-                        {
-                            continue; // Пропускаем при переполнении
-                        }
-                        
-                        // Проверка границ
-                        const size_t row_end = row_offset + static_cast<size_t>(width) * static_cast<size_t>(channels);
-                        if (channel_offset >= row_end)
+                        const auto& channel_words = words[static_cast<size_t>(c)];
+                        for (size_t i = 0; i < block_size; ++i)
                         {
-                            continue; // Защита от выхода за границы
+                            auto& value = block_pixels[i * static_cast<size_t>(channels) + static_cast<size_t>(c)];
+                            const auto noise = static_cast<int>(CounterRNG::toRange(channel_words[i], noise_range)) - max_noise;
+                            value = static_cast<uint8_t>(std::clamp(static_cast<int>(value) + noise, 0, 255));
                         }
-                        
-                        const auto old_value = static_cast<int>(data[channel_offset]);
-                        const auto noise = local_dist(local_gen);
-                        // Проверка на переполнение при сложении
-                        int new_value = 0;
-                        if (!SafeMath::safeAdd(old_value, noise, new_value))
-                        {
-                            // При переполнении ограничиваем значение
-                            new_value = (noise > 0) ? 255 : 0;
-                        }
-                        data[channel_offset] = static_cast<uint8_t>(std::max(0, std::min(255, new_value)));
                     }
                 }
             }
@@ -105,3 +123,9 @@ std::string NoiseFilter::getCategory() const
     return "Размытие и шум";
 }
 
+std::string NoiseFilter::getParameters() const
+{
+    const std::string seed = seed_.has_value() ? std::to_string(*seed_) : std::string("random");
+    return formatParameter("intensity", intensity_) + "," + formatParameter("seed", seed);
+}
+
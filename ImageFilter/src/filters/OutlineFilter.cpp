@@ -1,9 +1,11 @@
 #include <filters/OutlineFilter.h>
 #include <ImageProcessor.h>
-#include <utils/ParallelImageProcessor.h>
 #include <utils/FilterResult.h>
 #include <utils/BorderHandler.h>
-#include <utils/ColorConversionUtils.h>
+#include <utils/GrayscaleRowWindow.h>
+#include <algorithm>
+#include <limits>
+#include <utility>
 #include <vector>
 
 FilterResult OutlineFilter::apply(ImageProcessor& image)
@@ -33,101 +35,81 @@ FilterResult OutlineFilter::apply(ImageProcessor& image)
                                      ctx);
     }
 
-    const auto* input_data = image.getData();
-
-    // Сначала преобразуем в градации серого
-    const auto grayscale_size = static_cast<size_t>(width) * static_cast<size_t>(height);
-    
-    // Создаем буфер для градаций серого
-    std::vector<uint8_t> grayscale(grayscale_size);
+    auto* data = image.getData();
 
-    for (int y = 0; y < height; ++y)
-    {
-        for (int x = 0; x < width; ++x)
+    // Градации серого и лапласиан вычисляются потоково окном из трех строк,
+    // полнокадровые промежуточные буферы не создаются
+    GrayscaleRowWindow window(data, width, height, channels, border_handler_);
+
+    // Ядро Лапласа для детекции контуров:
+    //    0 -1  0
+    //   -1  4 -1
+    //    0 -1  0
+    const auto laplacian = [](const uint8_t* above, const uint8_t* center, const uint8_t* below,
+                              int x, int left, int right) {
+        return 4 * center[x] - center[left] - center[right] - above[x] - below[x];
+    };
+
+    // Вызывает fn(x, left, right) для каждого пикселя строки;
+    // стратегия границ применяется только к крайним пикселям
+    const auto for_each_pixel = [width, this](auto&& fn) {
+        const auto clamp_x = [width, this](int x) {
+            return std::clamp(border_handler_.getX(x, width), 0, width - 1);
+        };
+        fn(0, clamp_x(-1), clamp_x(1));
+        for (int x = 1; x < width - 1; ++x)
         {
-            const auto pixel_offset = (static_cast<size_t>(y) * static_cast<size_t>(width) + static_cast<size_t>(x)) * static_cast<size_t>(channels);
-            const auto r = static_cast<int>(input_data[pixel_offset + 0]);
-            const auto g = static_cast<int>(input_data[pixel_offset + 1]);
-            const auto b = static_cast<int>(input_data[pixel_offset + 2]);
-            // Используем общую утилиту для преобразования RGB в градации серого
-            grayscale[static_cast<size_t>(y) * static_cast<size_t>(width) + static_cast<size_t>(x)] = 
-                ColorConversionUtils::rgbToGrayscale(r, g, b);
+            fn(x, x - 1, x + 1);
         }
-    }
-    std::vector<int> laplacian_result(static_cast<size_t>(width) * static_cast<size_t>(height));
-    ParallelImageProcessor::processRowsParallel(
-        height,
-        width,
-        [width, height, &grayscale, &laplacian_result, this](int start_row, int end_row)
+        if (width > 1)
         {
-            for (int y = start_row; y < end_row; ++y)
-            {
-                for (int x = 0; x < width; ++x)
-                {
-                    int sum = 0;
-
-                    for (int ky = -1; ky <= 1; ++ky)
-                    {
-                        for (int kx = -1; kx <= 1; ++kx)
-                        {
-                            // Ядро Лапласа для детекции контуров
-                            constexpr int laplacian_kernel[3][3] = {
-                                {0, -1, 0},
-                                {-1, 4, -1},
-                                {0, -1, 0}
-                            };
-
-                            const auto px = x + kx;
-                            const auto py = y + ky;
-
-                            // Обработка границ с использованием BorderHandler
-                            const auto clamped_x = border_handler_.getX(px, width);
-                            const auto clamped_y = border_handler_.getY(py, height);
-
-                            const auto pixel_value = static_cast<int>(grayscale[static_cast<size_t>(clamped_y) * static_cast<size_t>(width) +
-                                static_cast<size_t>(clamped_x)]);
-                            sum += pixel_value * laplacian_kernel[ky + 1][kx + 1];
-                        }
-                    }
-
-                    laplacian_result[static_cast<size_t>(y) * static_cast<size_t>(width) + static_cast<size_t>(x)] = sum;
-                }
-            }
+            fn(width - 1, clamp_x(width - 2), clamp_x(width));
+        }
+    };
+
+    // Первый проход: минимум и максимум отклика по каждой полосе
+    std::vector<std::pair<int, int>> strip_range(window.getStripCount(),
+                                                 {std::numeric_limits<int>::max(), std::numeric_limits<int>::min()});
+    window.analyze(
+        [&strip_range, &laplacian, &for_each_pixel](size_t strip, int, const uint8_t* above, const uint8_t* center, const uint8_t* below)
+        {
+            auto [row_min, row_max] = strip_range[strip];
+            for_each_pixel([&](int x, int left, int right) {
+                const auto value = laplacian(above, center, below, x, left, right);
+                row_min = std::min(row_min, value);
+                row_max = std::max(row_max, value);
+            });
+            strip_range[strip] = {row_min, row_max};
         }
     );
 
-    // Нормализуем и применяем к изображению
-    int min_val = laplacian_result[0];
-    int max_val = laplacian_result[0];
-    for (int val : laplacian_result)
+    int min_val = std::numeric_limits<int>::max();
+    int max_val = std::numeric_limits<int>::min();
+    for (const auto& [strip_min, strip_max] : strip_range)
     {
-        if (val < min_val) min_val = val;
-        if (val > max_val) max_val = val;
+        min_val = std::min(min_val, strip_min);
+        max_val = std::max(max_val, strip_max);
     }
 
-    auto* data = image.getData();
+    // Нормализуем и применяем к изображению
     const auto range = max_val - min_val;
     if (range > 0)
     {
-        ParallelImageProcessor::processRowsParallel(
-            height,
-            [width, channels, &laplacian_result, data, min_val, range](int start_row, int end_row)
+        // Второй проход: лапласиан пересчитывается и сразу записывается в изображение
+        window.write(
+            [width, channels, data, min_val, range, &laplacian, &for_each_pixel](size_t, int y, const uint8_t* above, const uint8_t* center, const uint8_t* below)
             {
-                for (int y = start_row; y < end_row; ++y)
-                {
-                    for (int x = 0; x < width; ++x)
-                    {
-                        const auto pixel_offset = (static_cast<size_t>(y) * static_cast<size_t>(width) + static_cast<size_t>(x)) * static_cast<size_t>(channels);
-                        const auto laplacian = laplacian_result[static_cast<size_t>(y) * static_cast<size_t>(width) + static_cast<size_t>(x)];
-                        // Защита от переполнения при умножении
-                        const int64_t numerator = static_cast<int64_t>(laplacian - min_val) * 255;
-                        const auto normalized = static_cast<uint8_t>(numerator / range);
-
-                        data[pixel_offset + 0] = normalized;
-                        data[pixel_offset + 1] = normalized;
-                        data[pixel_offset + 2] = normalized;
-                    }
-                }
+                auto* row = data + static_cast<size_t>(y) * static_cast<size_t>(width) * static_cast<size_t>(channels);
+                for_each_pixel([&](int x, int left, int right) {
+                    // Защита от переполнения при умножении
+                    const int64_t numerator = static_cast<int64_t>(laplacian(above, center, below, x, left, right) - min_val) * 255;
+                    const auto normalized = static_cast<uint8_t>(numerator / range);
+
+                    auto* pixel = row + static_cast<size_t>(x) * static_cast<size_t>(channels);
+                    pixel[0] = normalized;
+                    pixel[1] = normalized;
+                    pixel[2] = normalized;
+                });
             }
         );
     }
@@ -150,5 +132,10 @@ std::string OutlineFilter::getCategory() const
     return "Края и детали";
 }
 
+std::string OutlineFilter::getParameters() const
+{
+    return formatParameter("border", border_handler_.getStrategyName());
+}
+
 
 
@@ -71,5 +71,12 @@ std::string PosterizeFilter::getCategory() const
     return "Стилистический";
 }
 
+std::string PosterizeFilter::getParameters() const
+{
+    return formatParameter("levels", levels_);
+}
 
-
+int PosterizeFilter::getStreamingRadius() const noexcept
+{
+    return 0;
+}
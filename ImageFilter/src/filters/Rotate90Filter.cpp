@@ -3,10 +3,10 @@
 #include <utils/FilterResult.h>
 #include <utils/FilterValidationHelper.h>
 #include <utils/IBufferPool.h>
+#include <utils/ImageBuffer.h>
 #include <utils/SafeMath.h>
 #include <cerrno>
 #include <cstring>
-#include <vector>
 
 FilterResult Rotate90Filter::apply(ImageProcessor& image)
 {
@@ -40,19 +40,20 @@ FilterResult Rotate90Filter::apply(ImageProcessor& image)
                                    "Размер изображения слишком большой", ctx);
     }
     
-    // Получаем временный буфер из пула или создаем новый
-    std::vector<uint8_t> temp_buffer;
-    if (buffer_pool_ != nullptr)
+    // Буфер повернутого изображения берется из пула или выделяется распределителем
+    // изображения и затем передается изображению без копирования
+    ImageBuffer rotated = (buffer_pool_ != nullptr)
+        ? ImageBuffer::fromPooled(buffer_pool_->acquire(buffer_size))
+        : ImageBuffer::allocate(buffer_size, image.getAllocator());
+    if (!rotated)
     {
-        temp_buffer = buffer_pool_->acquire(buffer_size);
-    }
-    else
-    {
-        temp_buffer.resize(buffer_size);
+        ErrorContext ctx = ErrorContext::withImage(old_width, old_height, channels);
+        ctx.withFilterParam("clockwise", std::string(clockwise_ ? "true" : "false"));
+        return FilterResult::failure(FilterError::OutOfMemory, 
+                                   "Недостаточно памяти для поворота изображения", ctx);
     }
     
-    // Получаем указатель на данные временного буфера
-    uint8_t* new_data = temp_buffer.data();
+    uint8_t* new_data = rotated.data();
 
     // Предвычисляем размеры для оптимизации
     const auto old_row_stride = static_cast<size_t>(old_width) * static_cast<size_t>(channels);
@@ -102,21 +103,8 @@ FilterResult Rotate90Filter::apply(ImageProcessor& image)
         }
     }
     
-    // Передаем данные напрямую в resize() - он сам скопирует их в malloc-выделенную память
-    // После этого мы можем вернуть временный буфер в пул
-    const auto resize_result = image.resize(new_width, new_height, new_data);
-    
-    // Возвращаем временный буфер в пул (после того как resize() скопировал данные)
-    if (buffer_pool_ != nullptr)
-    {
-        buffer_pool_->release(std::move(temp_buffer));
-    }
-    if (!resize_result.isSuccess())
-    {
-        return resize_result;
-    }
-    
-    return FilterResult::success();
+    // Передаем буфер изображению; старые данные освобождаются
+    return image.adopt(new_width, new_height, channels, std::move(rotated));
 }
 
 std::string Rotate90Filter::getName() const
@@ -134,3 +122,8 @@ std::string Rotate90Filter::getCategory() const
     return "Геометрический";
 }
 
+std::string Rotate90Filter::getParameters() const
+{
+    return formatParameter("clockwise", clockwise_ ? "true" : "false");
+}
+
@@ -76,5 +76,12 @@ std::string SaturationFilter::getCategory() const
     return "Цветовой";
 }
 
+std::string SaturationFilter::getParameters() const
+{
+    return formatParameter("factor", factor_);
+}
 
-
+int SaturationFilter::getStreamingRadius() const noexcept
+{
+    return 0;
+}
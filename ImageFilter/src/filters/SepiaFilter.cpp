@@ -86,5 +86,7 @@ bool SepiaFilter::supportsInPlace() const noexcept
     return true;
 }
 
-
-
+int SepiaFilter::getStreamingRadius() const noexcept
+{
+    return 0;
+}
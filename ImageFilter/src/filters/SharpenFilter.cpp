@@ -5,7 +5,7 @@
 #include <utils/FilterValidator.h>
 #include <utils/FilterValidationHelper.h>
 #include <utils/BorderHandler.h>
-#include <utils/IBufferPool.h>
+#include <utils/ScratchBuffer.h>
 #include <utils/SafeMath.h>
 #include <algorithm>
 #include <vector>
@@ -62,18 +62,9 @@ FilterResult SharpenFilter::apply(ImageProcessor& image) {
                                    "Размер изображения слишком большой", ctx);
     }
     
-    // Получаем буфер из пула или создаем новый
-    std::vector<uint8_t> input_copy;
-    if (buffer_pool_ != nullptr)
-    {
-        input_copy = buffer_pool_->acquire(image_size);
-        // Копируем данные в буфер
-        std::copy(input_data, input_data + image_size, input_copy.begin());
-    }
-    else
-    {
-        input_copy.assign(input_data, input_data + image_size);
-    }
+    // Копия входа во временном буфере (арена изображения, пул или куча)
+    ScratchBuffer input_copy(image.getScratchArena(), buffer_pool_, image_size);
+    std::copy(input_data, input_data + image_size, input_copy.begin());
 
     auto* output_data = image.getData();
 
@@ -133,7 +124,7 @@ FilterResult SharpenFilter::apply(ImageProcessor& image) {
 
                         // Ограничиваем значение диапазоном [0, 255]
                         // Это предотвращает переполнение и отрицательные значения
-                        const auto clamped_sum = std::max(0LL, std::min(255LL, sum));
+                        const auto clamped_sum = std::max<int64_t>(0, std::min<int64_t>(255, sum));
 
                         const auto result_index = row_offset + static_cast<size_t>(x) * static_cast<size_t>(channels) + static_cast<size_t>(c);
                         output_data[result_index] = static_cast<uint8_t>(clamped_sum);
@@ -143,12 +134,6 @@ FilterResult SharpenFilter::apply(ImageProcessor& image) {
         }
     );
 
-    // Возвращаем буфер в пул для переиспользования
-    if (buffer_pool_ != nullptr)
-    {
-        buffer_pool_->release(std::move(input_copy));
-    }
-
     return FilterResult::success();
 }
 
@@ -167,4 +152,13 @@ std::string SharpenFilter::getCategory() const
     return "Края и детали";
 }
 
+std::string SharpenFilter::getParameters() const
+{
+    return formatParameter("strength", strength_) + "," + formatParameter("border", border_handler_.getStrategyName());
+}
 
+int SharpenFilter::getStreamingRadius() const noexcept
+{
+    // Wrap берет строки у противоположного края изображения, которых нет в окне полосы
+    return border_handler_.getStrategy() == BorderHandler::Strategy::Wrap ? -1 : 1;
+}
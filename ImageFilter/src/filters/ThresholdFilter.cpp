@@ -75,5 +75,12 @@ std::string ThresholdFilter::getCategory() const
     return "Стилистический";
 }
 
+std::string ThresholdFilter::getParameters() const
+{
+    return formatParameter("threshold", threshold_);
+}
 
-
+int ThresholdFilter::getStreamingRadius() const noexcept
+{
+    return 0;
+}
@@ -25,9 +25,6 @@ FilterResult VignetteFilter::apply(ImageProcessor& image)
     const auto channels = image.getChannels();
     auto* data = image.getData();
 
-    // Инициализируем lookup tables
-    LookupTables::initialize();
-
     // Центр изображения
     const auto center_x = width / 2.0;
     const auto center_y = height / 2.0;
@@ -101,5 +98,10 @@ std::string VignetteFilter::getCategory() const
     return "Стилистический";
 }
 
+std::string VignetteFilter::getParameters() const
+{
+    return formatParameter("strength", strength_);
+}
+
 
 
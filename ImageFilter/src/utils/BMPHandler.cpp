@@ -2,6 +2,7 @@
 #include <utils/SafeMath.h>
 #include <fstream>
 #include <algorithm>
+#include <cstdlib>
 #include <cstring>
 #include <limits>
 
@@ -36,313 +37,585 @@ namespace BMPHandler
     };
     #pragma pack(pop)
 
-    uint8_t* loadBMP(const std::string& filename, int& width, int& height, int& channels)
+    namespace
     {
-        std::ifstream file(filename, std::ios::binary);
-        if (!file.is_open())
+        constexpr size_t HEADERS_SIZE = sizeof(BMPHeader) + sizeof(BMPInfoHeader);
+
+        /**
+         * @brief Размер блока, которым BMPWriter пишет строки в файл
+         */
+        constexpr size_t WRITE_BLOCK_BYTES = 1024 * 1024;
+
+        /**
+         * @brief Вычисляет размер строки BMP с выравниванием до 4 байт
+         */
+        bool computeRowSize(int width, size_t& row_size)
         {
-            return nullptr;
+            size_t width_3 = 0;
+            size_t width_3_plus_3 = 0;
+            if (width <= 0 ||
+                !SafeMath::safeMultiply(static_cast<size_t>(width), static_cast<size_t>(3), width_3) ||
+                !SafeMath::safeAdd(width_3, static_cast<size_t>(3), width_3_plus_3))
+            {
+                return false;
+            }
+            row_size = width_3_plus_3 / 4 * 4;
+            return true;
         }
 
-        // Читаем заголовок
-        BMPHeader header;
-        file.read(reinterpret_cast<char*>(&header), sizeof(header));
-        
-        if (!file.good() || header.signature != 0x4D42) // "BM"
+        /**
+         * @brief Читает и проверяет заголовки поддерживаемого BMP (24 бита, без сжатия)
+         * @param headers Начало файла
+         * @param size Доступный размер данных
+         * @return false если заголовки неполные или формат не поддерживается
+         */
+        bool readSupportedHeaders(const uint8_t* headers, size_t size, BMPHeader& header, BMPInfoHeader& info_header)
         {
-            return nullptr;
+            if (size < HEADERS_SIZE)
+            {
+                return false;
+            }
+            std::memcpy(&header, headers, sizeof(header));
+            std::memcpy(&info_header, headers + sizeof(header), sizeof(info_header));
+
+            return header.signature == 0x4D42 && // "BM"
+                   info_header.header_size >= 40 &&
+                   info_header.bits_per_pixel == 24 && info_header.compression == 0 &&
+                   info_header.width > 0 && info_header.height != 0 &&
+                   info_header.height != std::numeric_limits<int32_t>::min() &&
+                   header.data_offset >= HEADERS_SIZE;
         }
 
-        // Читаем информационный заголовок
-        BMPInfoHeader info_header;
-        file.read(reinterpret_cast<char*>(&info_header), sizeof(info_header));
-        
-        if (!file.good() || info_header.header_size < 40)
+        /**
+         * @brief Преобразует строку изображения в BGR для записи в BMP
+         *
+         * При 1 канале значение используется как градация серого, при 2 каналах
+         * строка заполняется серым 128.
+         */
+        void convertRowToBGR(const uint8_t* source, uint8_t* destination, int width, int channels) noexcept
         {
-            return nullptr;
+            const auto pixels = static_cast<size_t>(width);
+            if (channels == 3)
+            {
+                swapRedBlue(source, destination, pixels);
+            }
+            else if (channels == 4)
+            {
+                convertRGBAToBGR(source, destination, pixels);
+            }
+            else
+            {
+                for (size_t x = 0; x < pixels; ++x)
+                {
+                    const uint8_t gray = channels == 1 ? source[x] : 128;
+                    destination[x * 3 + 0] = gray;
+                    destination[x * 3 + 1] = gray;
+                    destination[x * 3 + 2] = gray;
+                }
+            }
         }
 
-        // Проверяем, что это 24-битное RGB изображение без сжатия
-        if (info_header.bits_per_pixel != 24 || info_header.compression != 0)
+        /**
+         * @brief Заполняет заголовки 24-битного BMP, хранящегося снизу вверх
+         */
+        void fillHeaders(int width, int height, size_t file_size, size_t image_data_size,
+                         BMPHeader& header, BMPInfoHeader& info_header) noexcept
         {
-            return nullptr;
+            header.signature = 0x4D42; // "BM"
+            header.file_size = static_cast<uint32_t>(file_size);
+            header.reserved1 = 0;
+            header.reserved2 = 0;
+            header.data_offset = static_cast<uint32_t>(HEADERS_SIZE);
+
+            info_header.header_size = 40;
+            info_header.width = width;
+            info_header.height = height; // Положительное значение = снизу вверх
+            info_header.planes = 1;
+            info_header.bits_per_pixel = 24;
+            info_header.compression = 0; // Без сжатия
+            info_header.image_size = static_cast<uint32_t>(image_data_size);
+            info_header.x_resolution = 0;
+            info_header.y_resolution = 0;
+            info_header.colors_used = 0;
+            info_header.important_colors = 0;
         }
 
-        width = info_header.width;
-        height = std::abs(info_header.height); // Высота может быть отрицательной (верх-вниз)
-        channels = 3; // BMP всегда RGB
+        /**
+         * @brief Вычисляет размер строки, данных и файла BMP
+         * @return false если размеры некорректны или не помещаются в uint32_t
+         */
+        bool computeLayout(int width, int height, size_t& row_size, size_t& image_data_size, size_t& file_size)
+        {
+            return width > 0 && height > 0 &&
+                   computeRowSize(width, row_size) &&
+                   SafeMath::safeMultiply(row_size, static_cast<size_t>(height), image_data_size) &&
+                   SafeMath::safeAdd(HEADERS_SIZE, image_data_size, file_size) &&
+                   file_size <= std::numeric_limits<uint32_t>::max();
+        }
+    }
 
-        if (width <= 0 || height <= 0)
+    // Циклы без зависимостей между итерациями и без проверок внутри:
+    // компилятор разворачивает их в векторные перестановки байтов
+    void swapRedBlue(const uint8_t* source, uint8_t* destination, size_t pixels) noexcept
+    {
+        for (size_t i = 0; i < pixels; ++i)
         {
-            return nullptr;
+            const uint8_t c0 = source[i * 3 + 0];
+            const uint8_t c1 = source[i * 3 + 1];
+            const uint8_t c2 = source[i * 3 + 2];
+            destination[i * 3 + 0] = c2;
+            destination[i * 3 + 1] = c1;
+            destination[i * 3 + 2] = c0;
         }
+    }
 
-        // Вычисляем размер строки с учетом выравнивания (должно быть кратно 4 байтам)
-        size_t width_3 = 0;
-        size_t width_3_plus_3 = 0;
-        if (!SafeMath::safeMultiply(static_cast<size_t>(width), static_cast<size_t>(3), width_3) ||
-            !SafeMath::safeAdd(width_3, static_cast<size_t>(3), width_3_plus_3))
+    void convertBGRToRGBA(const uint8_t* source, uint8_t* destination, size_t pixels) noexcept
+    {
+        for (size_t i = 0; i < pixels; ++i)
         {
-            return nullptr;
+            const uint8_t b = source[i * 3 + 0];
+            const uint8_t g = source[i * 3 + 1];
+            const uint8_t r = source[i * 3 + 2];
+            destination[i * 4 + 0] = r;
+            destination[i * 4 + 1] = g;
+            destination[i * 4 + 2] = b;
+            destination[i * 4 + 3] = 255;
         }
-        
-        size_t row_size_unpadded = 0;
-        if (!SafeMath::safeDivide(width_3_plus_3, static_cast<size_t>(4), row_size_unpadded))
+    }
+
+    void convertRGBAToBGR(const uint8_t* source, uint8_t* destination, size_t pixels) noexcept
+    {
+        for (size_t i = 0; i < pixels; ++i)
         {
-            return nullptr;
+            const uint8_t r = source[i * 4 + 0];
+            const uint8_t g = source[i * 4 + 1];
+            const uint8_t b = source[i * 4 + 2];
+            destination[i * 3 + 0] = b;
+            destination[i * 3 + 1] = g;
+            destination[i * 3 + 2] = r;
         }
-        
-        size_t row_size = 0;
-        if (!SafeMath::safeMultiply(row_size_unpadded, static_cast<size_t>(4), row_size))
+    }
+
+    BMPReader::~BMPReader()
+    {
+        close();
+    }
+
+    void BMPReader::close() noexcept
+    {
+        mapped_file_.close();
+        data_ = nullptr;
+        if (file_.is_open())
         {
-            return nullptr;
+            file_.close();
         }
+        row_buffer_.clear();
+        row_buffer_.shrink_to_fit();
+        width_ = 0;
+        height_ = 0;
+        next_row_ = 0;
+    }
 
-        // Перемещаемся к началу данных изображения
-        file.seekg(header.data_offset, std::ios::beg);
-        if (!file.good())
+    bool BMPReader::open(const std::string& filename)
+    {
+        close();
+
+        // Файл отображается в память целиком: строки копируются прямо из
+        // страничного кэша без промежуточного буфера
+        if (mapped_file_.open(filename, false).isSuccess())
         {
-            return nullptr;
+            if (!parseHeaders(mapped_file_.data(), mapped_file_.size()))
+            {
+                close();
+                return false;
+            }
+            data_ = mapped_file_.data();
+
+            // Строки снизу вверх читаются от конца файла, поэтому последовательную
+            // подсказку даем только для файлов, хранящихся сверху вниз
+            if (top_down_)
+            {
+                mapped_file_.adviseSequential();
+            }
+            else
+            {
+                mapped_file_.prefetch();
+            }
+            return true;
         }
 
-        // Выделяем память для данных
-        size_t width_height_product = 0;
-        size_t buffer_size = 0;
-        if (!SafeMath::safeMultiply(static_cast<size_t>(width), static_cast<size_t>(height), width_height_product) ||
-            !SafeMath::safeMultiply(width_height_product, static_cast<size_t>(3), buffer_size))
+        // Запасной путь: чтение через поток в один переиспользуемый буфер строки
+        file_.open(filename, std::ios::binary | std::ios::ate);
+        if (!file_.is_open())
         {
-            return nullptr;
+            return false;
         }
-        
-        uint8_t* image_data = static_cast<uint8_t*>(std::malloc(buffer_size));
-        if (image_data == nullptr)
+        const auto end_position = file_.tellg();
+        uint8_t headers[HEADERS_SIZE];
+        file_.seekg(0, std::ios::beg);
+        file_.read(reinterpret_cast<char*>(headers), sizeof(headers));
+        if (!file_.good() || end_position < 0 || !parseHeaders(headers, static_cast<size_t>(end_position)))
         {
-            return nullptr;
+            close();
+            return false;
         }
+        row_buffer_.resize(static_cast<size_t>(width_) * 3);
+        return true;
+    }
 
-        // Читаем данные построчно (BMP хранит данные снизу вверх)
-        const bool top_down = info_header.height < 0;
-        
-        if (top_down)
+    bool BMPReader::open(const uint8_t* data, size_t size)
+    {
+        close();
+        if (data == nullptr || !parseHeaders(data, size))
         {
-            // Изображение хранится сверху вниз
-            for (int y = 0; y < height; ++y)
-            {
-                std::vector<uint8_t> row(static_cast<size_t>(row_size));
-                file.read(reinterpret_cast<char*>(row.data()), static_cast<std::streamsize>(row_size));
-                
-                if (!file.good())
-                {
-                    std::free(image_data);
-                    return nullptr;
-                }
+            close();
+            return false;
+        }
+        data_ = data;
+        return true;
+    }
 
-                // Копируем RGB данные (BMP хранит в формате BGR)
-                for (int x = 0; x < width; ++x)
-                {
-                    size_t src_offset = 0;
-                    size_t y_width_sum = 0;
-                    size_t pixel_index = 0;
-                    size_t dst_offset = 0;
-                    if (!SafeMath::safeMultiply(static_cast<size_t>(x), static_cast<size_t>(3), src_offset) ||
-                        !SafeMath::safeMultiply(static_cast<size_t>(y), static_cast<size_t>(width), y_width_sum) ||
-                        !SafeMath::safeAdd(y_width_sum, static_cast<size_t>(x), pixel_index) ||
-                        !SafeMath::safeMultiply(pixel_index, static_cast<size_t>(3), dst_offset))
-                    {
-                        std::free(image_data);
-                        return nullptr;
-                    }
-                    
-                    // Конвертируем BGR в RGB
-                    image_data[dst_offset + 0] = row[src_offset + 2]; // R
-                    image_data[dst_offset + 1] = row[src_offset + 1]; // G
-                    image_data[dst_offset + 2] = row[src_offset + 0]; // B
-                }
-            }
+    bool BMPReader::parseHeaders(const uint8_t* headers, size_t file_size)
+    {
+        // Все проверки выполняются один раз на изображение
+        BMPHeader header{};
+        BMPInfoHeader info_header{};
+        if (!readSupportedHeaders(headers, file_size, header, info_header))
+        {
+            return false;
         }
-        else
+
+        const int width = info_header.width;
+        const int height = std::abs(info_header.height); // Высота может быть отрицательной (верх-вниз)
+
+        // Последняя строка может быть записана без выравнивания
+        size_t row_size = 0;
+        size_t pixel_bytes = 0;
+        size_t rows_bytes = 0;
+        size_t data_end = 0;
+        if (!computeRowSize(width, row_size) ||
+            !SafeMath::safeMultiply(static_cast<size_t>(width), static_cast<size_t>(3), pixel_bytes) ||
+            !SafeMath::safeMultiply(row_size, static_cast<size_t>(height - 1), rows_bytes) ||
+            !SafeMath::safeAdd(static_cast<size_t>(header.data_offset), rows_bytes, data_end) ||
+            !SafeMath::safeAdd(data_end, pixel_bytes, data_end) ||
+            data_end > file_size)
         {
-            // Изображение хранится снизу вверх
-            for (int y = height - 1; y >= 0; --y)
-            {
-                std::vector<uint8_t> row(static_cast<size_t>(row_size));
-                file.read(reinterpret_cast<char*>(row.data()), static_cast<std::streamsize>(row_size));
-                
-                if (!file.good())
-                {
-                    std::free(image_data);
-                    return nullptr;
-                }
+            return false;
+        }
 
-                // Копируем RGB данные (BMP хранит в формате BGR)
-                for (int x = 0; x < width; ++x)
-                {
-                    size_t src_offset = 0;
-                    size_t y_width_sum = 0;
-                    size_t pixel_index = 0;
-                    size_t dst_offset = 0;
-                    if (!SafeMath::safeMultiply(static_cast<size_t>(x), static_cast<size_t>(3), src_offset) ||
-                        !SafeMath::safeMultiply(static_cast<size_t>(y), static_cast<size_t>(width), y_width_sum) ||
-                        !SafeMath::safeAdd(y_width_sum, static_cast<size_t>(x), pixel_index) ||
-                        !SafeMath::safeMultiply(pixel_index, static_cast<size_t>(3), dst_offset))
-                    {
-                        std::free(image_data);
-                        return nullptr;
-                    }
-                    
-                    // Конвертируем BGR в RGB
-                    image_data[dst_offset + 0] = row[src_offset + 2]; // R
-                    image_data[dst_offset + 1] = row[src_offset + 1]; // G
-                    image_data[dst_offset + 2] = row[src_offset + 0]; // B
-                }
-            }
+        width_ = width;
+        height_ = height;
+        top_down_ = info_header.height < 0;
+        data_offset_ = header.data_offset;
+        row_size_ = row_size;
+        next_row_ = 0;
+        return true;
+    }
+
+    const uint8_t* BMPReader::getFileRow(int file_row)
+    {
+        const size_t offset = data_offset_ + static_cast<size_t>(file_row) * row_size_;
+        if (data_ != nullptr)
+        {
+            return data_ + offset;
         }
 
-        return image_data;
+        file_.seekg(static_cast<std::streamoff>(offset), std::ios::beg);
+        file_.read(reinterpret_cast<char*>(row_buffer_.data()), static_cast<std::streamsize>(row_buffer_.size()));
+        return file_.good() ? row_buffer_.data() : nullptr;
     }
 
-    bool saveBMP(const std::string& filename, int width, int height, int channels, const uint8_t* data)
+    bool BMPReader::readRows(uint8_t* destination, int count, int channels)
     {
-        if (width <= 0 || height <= 0 || data == nullptr)
+        if (destination == nullptr || count < 0 || count > height_ - next_row_ ||
+            (channels != 3 && channels != 4))
         {
             return false;
         }
 
-        std::ofstream file(filename, std::ios::binary);
-        if (!file.is_open())
+        const auto pixels = static_cast<size_t>(width_);
+        const size_t destination_row_bytes = pixels * static_cast<size_t>(channels);
+        for (int i = 0; i < count; ++i)
         {
-            return false;
+            const int y = next_row_ + i;
+            const uint8_t* row = getFileRow(top_down_ ? y : height_ - 1 - y);
+            if (row == nullptr)
+            {
+                return false;
+            }
+
+            uint8_t* output = destination + static_cast<size_t>(i) * destination_row_bytes;
+            if (channels == 3)
+            {
+                swapRedBlue(row, output, pixels);
+            }
+            else
+            {
+                convertBGRToRGBA(row, output, pixels);
+            }
         }
+        next_row_ += count;
+        return true;
+    }
 
-        // Вычисляем размер строки с учетом выравнивания (должно быть кратно 4 байтам)
-        size_t width_3 = 0;
-        size_t width_3_plus_3 = 0;
-        if (!SafeMath::safeMultiply(static_cast<size_t>(width), static_cast<size_t>(3), width_3) ||
-            !SafeMath::safeAdd(width_3, static_cast<size_t>(3), width_3_plus_3))
+    bool BMPWriter::open(const std::string& filename, int width, int height)
+    {
+        size_t row_size = 0;
+        size_t image_data_size = 0;
+        size_t file_size = 0;
+        if (!computeLayout(width, height, row_size, image_data_size, file_size))
         {
             return false;
         }
-        
-        size_t row_size_unpadded = 0;
-        if (!SafeMath::safeDivide(width_3_plus_3, static_cast<size_t>(4), row_size_unpadded))
+
+        file_.open(filename, std::ios::binary | std::ios::trunc);
+        if (!file_.is_open())
         {
             return false;
         }
-        
-        size_t row_size = 0;
-        if (!SafeMath::safeMultiply(row_size_unpadded, static_cast<size_t>(4), row_size))
+
+        BMPHeader header{};
+        BMPInfoHeader info_header{};
+        fillHeaders(width, height, file_size, image_data_size, header, info_header);
+
+        file_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file_.write(reinterpret_cast<const char*>(&info_header), sizeof(info_header));
+        if (!file_.good())
         {
+            file_.close();
             return false;
         }
-        
-        size_t image_data_size = 0;
-        if (!SafeMath::safeMultiply(row_size, static_cast<size_t>(height), image_data_size))
+
+        width_ = width;
+        height_ = height;
+        next_row_ = 0;
+        data_offset_ = HEADERS_SIZE;
+        row_size_ = row_size;
+
+        // Байты выравнивания строк остаются нулевыми: преобразование пишет
+        // только первые width * 3 байт каждой строки блока
+        const size_t block_rows = std::clamp<size_t>(WRITE_BLOCK_BYTES / row_size, 1, static_cast<size_t>(height));
+        block_.assign(block_rows * row_size, 0);
+        return true;
+    }
+
+    bool BMPWriter::writeRows(const uint8_t* source, int count, int channels)
+    {
+        if (!file_.is_open() || source == nullptr || count < 0 || count > height_ - next_row_ ||
+            channels < 1 || channels > 4)
         {
             return false;
         }
-        
-        size_t data_offset = 0;
-        if (!SafeMath::safeAdd(static_cast<size_t>(sizeof(BMPHeader)), static_cast<size_t>(sizeof(BMPInfoHeader)), data_offset))
+
+        const size_t source_row_bytes = static_cast<size_t>(width_) * static_cast<size_t>(channels);
+        const int block_rows = static_cast<int>(block_.size() / row_size_);
+
+        // BMP хранит строки снизу вверх: обходим порцию с нижнего блока, чтобы
+        // внутри одного вызова блоки ложились в файл по возрастанию смещений
+        int block_end = next_row_ + count;
+        while (block_end > next_row_)
+        {
+            const int block_begin = std::max(next_row_, block_end - block_rows);
+            int block_row = 0;
+            for (int y = block_end - 1; y >= block_begin; --y, ++block_row)
+            {
+                convertRowToBGR(source + static_cast<size_t>(y - next_row_) * source_row_bytes,
+                                block_.data() + static_cast<size_t>(block_row) * row_size_, width_, channels);
+            }
+
+            const size_t offset = data_offset_ + static_cast<size_t>(height_ - block_end) * row_size_;
+            file_.seekp(static_cast<std::streamoff>(offset), std::ios::beg);
+            file_.write(reinterpret_cast<const char*>(block_.data()),
+                        static_cast<std::streamsize>(static_cast<size_t>(block_row) * row_size_));
+            if (!file_.good())
+            {
+                return false;
+            }
+            block_end = block_begin;
+        }
+
+        next_row_ += count;
+        return true;
+    }
+
+    bool BMPWriter::finish()
+    {
+        if (!file_.is_open())
         {
             return false;
         }
-        
-        size_t file_size = 0;
-        if (!SafeMath::safeAdd(data_offset, image_data_size, file_size))
+        const bool complete = next_row_ == height_;
+        file_.close();
+        block_.clear();
+        block_.shrink_to_fit();
+        return complete && !file_.fail();
+    }
+
+    namespace
+    {
+        /**
+         * @brief Читает все строки открытого BMP в новый буфер
+         */
+        uint8_t* readAllRows(BMPReader& reader, int& width, int& height, int& channels, int desired_channels)
+        {
+            // Выделяем память для данных
+            size_t width_height_product = 0;
+            size_t buffer_size = 0;
+            if (!SafeMath::safeMultiply(static_cast<size_t>(reader.getWidth()), static_cast<size_t>(reader.getHeight()),
+                                        width_height_product) ||
+                !SafeMath::safeMultiply(width_height_product, static_cast<size_t>(desired_channels), buffer_size))
+            {
+                return nullptr;
+            }
+
+            uint8_t* image_data = static_cast<uint8_t*>(std::malloc(buffer_size));
+            if (image_data == nullptr)
+            {
+                return nullptr;
+            }
+
+            if (!reader.readRows(image_data, reader.getHeight(), desired_channels))
+            {
+                std::free(image_data);
+                return nullptr;
+            }
+
+            width = reader.getWidth();
+            height = reader.getHeight();
+            channels = desired_channels;
+            return image_data;
+        }
+    }
+
+    uint8_t* loadBMP(const std::string& filename, int& width, int& height, int& channels, int desired_channels)
+    {
+        if (desired_channels != 3 && desired_channels != 4)
+        {
+            return nullptr;
+        }
+
+        BMPReader reader;
+        if (!reader.open(filename))
+        {
+            return nullptr;
+        }
+        return readAllRows(reader, width, height, channels, desired_channels);
+    }
+
+    bool readBMPInfo(const uint8_t* data, size_t size, int& width, int& height)
+    {
+        BMPHeader header{};
+        BMPInfoHeader info_header{};
+        if (data == nullptr || !readSupportedHeaders(data, size, header, info_header))
         {
             return false;
         }
-        
-        // Проверяем, что размеры помещаются в uint32_t
-        if (file_size > std::numeric_limits<uint32_t>::max() || 
-            image_data_size > std::numeric_limits<uint32_t>::max() ||
-            data_offset > std::numeric_limits<uint32_t>::max())
+        width = info_header.width;
+        height = std::abs(info_header.height);
+        return true;
+    }
+
+    uint8_t* loadBMPFromMemory(const uint8_t* data, size_t size, int& width, int& height, int& channels,
+                               int desired_channels)
+    {
+        if (desired_channels != 3 && desired_channels != 4)
+        {
+            return nullptr;
+        }
+
+        BMPReader reader;
+        if (!reader.open(data, size))
+        {
+            return nullptr;
+        }
+        return readAllRows(reader, width, height, channels, desired_channels);
+    }
+
+    bool saveBMP(const std::string& filename, int width, int height, int channels, const uint8_t* data)
+    {
+        if (data == nullptr)
         {
             return false;
         }
-        
-        const uint32_t data_offset_u32 = static_cast<uint32_t>(data_offset);
-        const uint32_t file_size_u32 = static_cast<uint32_t>(file_size);
-
-        // Записываем заголовок
-        BMPHeader header;
-        header.signature = 0x4D42; // "BM"
-        header.file_size = file_size_u32;
-        header.reserved1 = 0;
-        header.reserved2 = 0;
-        header.data_offset = data_offset_u32;
-        
-        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
-        if (!file.good())
+
+        BMPWriter writer;
+        return writer.open(filename, width, height) &&
+               writer.writeRows(data, height, channels) &&
+               writer.finish();
+    }
+
+    bool encodeBMP(int width, int height, int channels, const uint8_t* data,
+                   const std::function<bool(const uint8_t* bytes, size_t size)>& sink)
+    {
+        size_t row_size = 0;
+        size_t image_data_size = 0;
+        size_t file_size = 0;
+        if (data == nullptr || !sink || channels < 1 || channels > 4 ||
+            !computeLayout(width, height, row_size, image_data_size, file_size))
         {
             return false;
         }
 
-        // Записываем информационный заголовок
-        BMPInfoHeader info_header;
-        info_header.header_size = 40;
-        info_header.width = width;
-        info_header.height = height; // Положительное значение = снизу вверх
-        info_header.planes = 1;
-        info_header.bits_per_pixel = 24;
-        info_header.compression = 0; // Без сжатия
-        info_header.image_size = static_cast<uint32_t>(image_data_size);
-        info_header.x_resolution = 0;
-        info_header.y_resolution = 0;
-        info_header.colors_used = 0;
-        info_header.important_colors = 0;
-        
-        file.write(reinterpret_cast<const char*>(&info_header), sizeof(info_header));
-        if (!file.good())
+        uint8_t headers[HEADERS_SIZE];
+        BMPHeader header{};
+        BMPInfoHeader info_header{};
+        fillHeaders(width, height, file_size, image_data_size, header, info_header);
+        std::memcpy(headers, &header, sizeof(header));
+        std::memcpy(headers + sizeof(header), &info_header, sizeof(info_header));
+        if (!sink(headers, sizeof(headers)))
         {
             return false;
         }
 
-        // Записываем данные изображения построчно (BMP хранит снизу вверх, формат BGR)
-        std::vector<uint8_t> row(static_cast<size_t>(row_size), 0); // Инициализируем нулями для выравнивания
-        
-        for (int y = height - 1; y >= 0; --y)
+        // Строки идут в файл снизу вверх: блок собирается с последней строки
+        // изображения и передается приемнику целиком
+        const size_t source_row_bytes = static_cast<size_t>(width) * static_cast<size_t>(channels);
+        const size_t block_rows = std::clamp<size_t>(WRITE_BLOCK_BYTES / row_size, 1, static_cast<size_t>(height));
+        std::vector<uint8_t> block(block_rows * row_size, 0);
+        int y = height - 1;
+        while (y >= 0)
         {
-            // Копируем и конвертируем RGB в BGR
-            for (int x = 0; x < width; ++x)
+            size_t rows = 0;
+            for (; rows < block_rows && y >= 0; ++rows, --y)
             {
-                size_t y_width_sum = 0;
-                size_t pixel_index = 0;
-                size_t src_offset = 0;
-                size_t dst_offset = 0;
-                if (!SafeMath::safeMultiply(static_cast<size_t>(y), static_cast<size_t>(width), y_width_sum) ||
-                    !SafeMath::safeAdd(y_width_sum, static_cast<size_t>(x), pixel_index) ||
-                    !SafeMath::safeMultiply(pixel_index, static_cast<size_t>(channels), src_offset) ||
-                    !SafeMath::safeMultiply(static_cast<size_t>(x), static_cast<size_t>(3), dst_offset))
-                {
-                    return false;
-                }
-                
-                // Конвертируем RGB в BGR
-                if (channels >= 3)
-                {
-                    row[dst_offset + 0] = data[src_offset + 2]; // B
-                    row[dst_offset + 1] = data[src_offset + 1]; // G
-                    row[dst_offset + 2] = data[src_offset + 0]; // R
-                }
-                else
-                {
-                    // Если меньше 3 каналов, используем градации серого
-                    uint8_t gray = channels == 1 ? data[src_offset] : 128;
-                    row[dst_offset + 0] = gray; // B
-                    row[dst_offset + 1] = gray; // G
-                    row[dst_offset + 2] = gray; // R
-                }
+                convertRowToBGR(data + static_cast<size_t>(y) * source_row_bytes, block.data() + rows * row_size,
+                                width, channels);
             }
-            
-            file.write(reinterpret_cast<const char*>(row.data()), row_size);
-            if (!file.good())
+            if (!sink(block.data(), rows * row_size))
             {
                 return false;
             }
         }
+        return true;
+    }
+
+    bool readBMPRows(const std::string& filename, int channels,
+                     const std::function<bool(int width, int height)>& on_header,
+                     const std::function<bool(const uint8_t* row, int y)>& on_row)
+    {
+        if (channels != 3 && channels != 4)
+        {
+            return false;
+        }
 
+        BMPReader reader;
+        if (!reader.open(filename))
+        {
+            return false;
+        }
+        if (on_header && !on_header(reader.getWidth(), reader.getHeight()))
+        {
+            return false;
+        }
+
+        std::vector<uint8_t> row(static_cast<size_t>(reader.getWidth()) * static_cast<size_t>(channels));
+        for (int y = 0; y < reader.getHeight(); ++y)
+        {
+            if (!reader.readRows(row.data(), 1, channels) || (on_row && !on_row(row.data(), y)))
+            {
+                return false;
+            }
+        }
         return true;
     }
 }
-
@@ -142,3 +142,19 @@ BorderHandler::Strategy BorderHandler::getStrategy() const noexcept
     return strategy_;
 }
 
+const char* BorderHandler::getStrategyName() const noexcept
+{
+    switch (strategy_)
+    {
+        case Strategy::Clamp:
+            return "clamp";
+        case Strategy::Wrap:
+            return "wrap";
+        case Strategy::Extend:
+            return "extend";
+        case Strategy::Mirror:
+            break;
+    }
+    return "mirror";
+}
+
@@ -1,193 +1,257 @@
 #include <utils/BufferPool.h>
 #include <algorithm>
+#include <bit>
 #include <cstddef>
+#include <thread>
 
-BufferPool::BufferPool(size_t max_pool_size)
-    : max_pool_size_(max_pool_size)
+namespace
 {
+    /**
+     * @brief Порядковый номер текущего потока
+     *
+     * Номера выдаются по кругу при первом обращении, поэтому потоки одного
+     * пула потоков распределяются по сегментам равномерно.
+     */
+    size_t threadSlot() noexcept
+    {
+        static std::atomic<size_t> next_slot{0};
+        thread_local const size_t slot = next_slot.fetch_add(1, std::memory_order_relaxed);
+        return slot;
+    }
+
+    /**
+     * @brief Количество сегментов по умолчанию
+     */
+    size_t defaultShardCount() noexcept
+    {
+        const auto hardware_threads = static_cast<size_t>(std::thread::hardware_concurrency());
+        return hardware_threads > 0 ? hardware_threads : 1;
+    }
+
+    /**
+     * @brief Класс буфера по его capacity (округление вниз до степени двойки)
+     */
+    size_t capacityClass(size_t capacity) noexcept
+    {
+        return static_cast<size_t>(std::bit_width(capacity)) - 1;
+    }
 }
 
-std::vector<uint8_t> BufferPool::acquire(size_t size)
+BufferPool::BufferPool(size_t max_pool_size, size_t shard_count, IImageAllocator* allocator)
+    : allocator_(allocator != nullptr ? *allocator : ImageAllocator::getDefault())
+    , max_pool_size_(max_pool_size)
 {
-    std::lock_guard<std::mutex> lock(mutex_);
+    if (shard_count == 0)
+    {
+        shard_count = defaultShardCount();
+    }
+    shard_count = std::bit_ceil(std::min<size_t>(shard_count, 64));
+    shards_ = std::make_unique<Shard[]>(shard_count);
+    shard_mask_ = shard_count - 1;
+}
+
+PooledBuffer BufferPool::acquire(size_t size)
+{
+    if (size == 0)
+    {
+        return {};
+    }
 
-    // Ищем подходящий буфер в пуле
-    const int index = findSuitableBuffer(size);
-    
-    if (index >= 0)
+    const size_t size_class = getSizeClass(size);
+    if (size_class < SIZE_CLASS_COUNT)
     {
-        // Найден подходящий буфер - извлекаем его из пула
-        std::vector<uint8_t> buffer = std::move(buffers_[static_cast<size_t>(index)]);
-        
-        // Удаляем буфер из пула, перемещая последний элемент на его место
-        buffers_[static_cast<size_t>(index)] = std::move(buffers_.back());
-        buffers_.pop_back();
-        
-        // Убеждаемся, что буфер имеет достаточный размер
-        if (buffer.size() < size)
+        // Домашний сегмент проверяется первым, затем остальные по кругу
+        const size_t home = threadSlot() & shard_mask_;
+        for (size_t i = 0; i <= shard_mask_; ++i)
         {
+            auto& shard = shards_[(home + i) & shard_mask_];
+            std::unique_lock<std::mutex> lock(shard.mutex);
+            auto& free_list = shard.free_lists[size_class];
+            if (free_list.empty())
+            {
+                continue;
+            }
+
+            PooledBuffer buffer = std::move(free_list.back());
+            free_list.pop_back();
+            lock.unlock();
+            buffer_count_.fetch_sub(1, std::memory_order_relaxed);
+
+            // capacity >= 2^size_class >= size: перераспределения и заполнения нет
             buffer.resize(size);
+            return buffer;
         }
-        
-        return buffer;
     }
-    
-    // Подходящего буфера нет - создаем новый
-    std::vector<uint8_t> buffer;
-    buffer.reserve(size);
+
+    // Подходящего буфера нет - создаем новый с capacity, равной размеру класса
+    PooledBuffer buffer{PooledBuffer::allocator_type(allocator_)};
+    buffer.reserve(size_class < SIZE_CLASS_COUNT - 1 ? (size_t{1} << size_class) : size);
     buffer.resize(size);
-    
     return buffer;
 }
 
-void BufferPool::release(std::vector<uint8_t>&& buffer)
+void BufferPool::release(PooledBuffer&& buffer)
 {
-    if (buffer.empty())
+    if (buffer.capacity() == 0)
     {
-        // Пустые буферы не добавляем в пул
+        // Буферы без памяти не добавляем в пул
         return;
     }
-    
-    std::lock_guard<std::mutex> lock(mutex_);
-    
-    // Проверяем ограничение размера пула
-    if (max_pool_size_ > 0 && buffers_.size() >= max_pool_size_)
+
+    // Резервируем место в пуле до вставки, чтобы ограничение соблюдалось без общей блокировки
+    const size_t max_pool_size = max_pool_size_.load(std::memory_order_relaxed);
+    const size_t previous_count = buffer_count_.fetch_add(1, std::memory_order_relaxed);
+    if (max_pool_size > 0 && previous_count >= max_pool_size)
     {
         // Пул переполнен - не добавляем буфер
+        buffer_count_.fetch_sub(1, std::memory_order_relaxed);
         return;
     }
-    
+
     // Очищаем буфер, но сохраняем зарезервированную память
     buffer.clear();
-    
-    // Добавляем буфер в пул
-    buffers_.push_back(std::move(buffer));
+    const size_t size_class = capacityClass(buffer.capacity());
+
+    auto& shard = homeShard();
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.free_lists[size_class].push_back(std::move(buffer));
 }
 
 void BufferPool::reserve(size_t size, size_t count)
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-    
-    const size_t current_size = buffers_.size();
-    const size_t target_size = current_size + count;
-    
-    // Учитываем ограничение размера пула
-    const size_t max_allowed = (max_pool_size_ == 0) ? target_size : 
-                               std::min(target_size, max_pool_size_);
-    const size_t to_create = (max_allowed > current_size) ? (max_allowed - current_size) : 0;
-    
-    // Резервируем место для новых буферов
-    buffers_.reserve(max_allowed);
-    
-    // Создаем буферы
-    for (size_t i = 0; i < to_create; ++i)
+    if (size == 0)
     {
-        std::vector<uint8_t> buffer;
-        buffer.reserve(size);
-        buffer.resize(size);
-        buffers_.push_back(std::move(buffer));
+        return;
+    }
+
+    const size_t size_class = getSizeClass(size);
+    const size_t capacity = size_class < SIZE_CLASS_COUNT - 1 ? (size_t{1} << size_class) : size;
+    for (size_t i = 0; i < count; ++i)
+    {
+        const size_t max_pool_size = max_pool_size_.load(std::memory_order_relaxed);
+        if (max_pool_size > 0 && buffer_count_.load(std::memory_order_relaxed) >= max_pool_size)
+        {
+            break;
+        }
+
+        PooledBuffer buffer{PooledBuffer::allocator_type(allocator_)};
+        buffer.reserve(capacity);
+        release(std::move(buffer));
     }
 }
 
 void BufferPool::clear()
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-    buffers_.clear();
+    for (size_t i = 0; i <= shard_mask_; ++i)
+    {
+        auto& shard = shards_[i];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        for (auto& free_list : shard.free_lists)
+        {
+            buffer_count_.fetch_sub(free_list.size(), std::memory_order_relaxed);
+            free_list.clear();
+            free_list.shrink_to_fit();
+        }
+    }
 }
 
 size_t BufferPool::size() const
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return buffers_.size();
+    return buffer_count_.load(std::memory_order_relaxed);
 }
 
 size_t BufferPool::getMaxPoolSize() const noexcept
 {
-    return max_pool_size_;
+    return max_pool_size_.load(std::memory_order_relaxed);
 }
 
 void BufferPool::setMaxPoolSize(size_t max_size) noexcept
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-    max_pool_size_ = max_size;
-    
+    max_pool_size_.store(max_size, std::memory_order_relaxed);
+
     // Если текущий размер пула превышает новый максимум, удаляем лишние буферы
-    if (max_pool_size_ > 0 && buffers_.size() > max_pool_size_)
+    if (max_size > 0)
     {
-        buffers_.resize(max_pool_size_);
-        buffers_.shrink_to_fit();
+        trimTo(max_size);
     }
 }
 
-int BufferPool::findSuitableBuffer(size_t size) const
+size_t BufferPool::getShardCount() const noexcept
+{
+    return shard_mask_ + 1;
+}
+
+size_t BufferPool::getSizeClass(size_t size) noexcept
+{
+    const auto size_class = size > 1 ? static_cast<size_t>(std::bit_width(size - 1)) : size_t{0};
+    return std::max(size_class, MIN_SIZE_CLASS);
+}
+
+BufferPool::Shard& BufferPool::homeShard() const noexcept
+{
+    return shards_[threadSlot() & shard_mask_];
+}
+
+void BufferPool::trimTo(size_t max_count) noexcept
 {
-    // Ищем буфер с capacity >= size
-    // Предпочитаем буферы с минимальным превышением размера для экономии памяти
-    int best_index = -1;
-    size_t best_capacity = 0;
-    
-    for (size_t i = 0; i < buffers_.size(); ++i)
+    // Удаляем в первую очередь самые крупные буферы
+    for (size_t i = 0; i <= shard_mask_; ++i)
     {
-        const size_t capacity = buffers_[i].capacity();
-        if (capacity >= size)
+        auto& shard = shards_[i];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        for (size_t size_class = SIZE_CLASS_COUNT; size_class-- > 0;)
         {
-            // Найден подходящий буфер
-            if (best_index < 0 || capacity < best_capacity)
+            auto& free_list = shard.free_lists[size_class];
+            while (!free_list.empty() && buffer_count_.load(std::memory_order_relaxed) > max_count)
             {
-                // Это лучший вариант (минимальное превышение размера)
-                best_index = static_cast<int>(i);
-                best_capacity = capacity;
+                free_list.pop_back();
+                buffer_count_.fetch_sub(1, std::memory_order_relaxed);
             }
         }
     }
-    
-    return best_index;
 }
 
 size_t BufferPool::getTotalMemory() const
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-    
     size_t total = 0;
-    for (const auto& buffer : buffers_)
+    for (size_t i = 0; i <= shard_mask_; ++i)
     {
-        total += buffer.capacity();
+        const auto& shard = shards_[i];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        for (const auto& free_list : shard.free_lists)
+        {
+            for (const auto& buffer : free_list)
+            {
+                total += buffer.capacity();
+            }
+        }
     }
-    
+
     return total;
 }
 
 void BufferPool::getStats(size_t& total_buffers, size_t& total_memory, 
                          size_t& largest_buffer, size_t& smallest_buffer) const
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-    
-    total_buffers = buffers_.size();
+    total_buffers = 0;
     total_memory = 0;
     largest_buffer = 0;
     smallest_buffer = 0;
-    
-    if (buffers_.empty())
-    {
-        return;
-    }
-    
-    smallest_buffer = buffers_[0].capacity();
-    
-    for (const auto& buffer : buffers_)
+
+    for (size_t i = 0; i <= shard_mask_; ++i)
     {
-        const size_t capacity = buffer.capacity();
-        total_memory += capacity;
-        
-        if (capacity > largest_buffer)
-        {
-            largest_buffer = capacity;
-        }
-        
-        if (capacity < smallest_buffer)
+        const auto& shard = shards_[i];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        for (const auto& free_list : shard.free_lists)
         {
-            smallest_buffer = capacity;
+            for (const auto& buffer : free_list)
+            {
+                const size_t capacity = buffer.capacity();
+                total_memory += capacity;
+                largest_buffer = std::max(largest_buffer, capacity);
+                smallest_buffer = (total_buffers == 0) ? capacity : std::min(smallest_buffer, capacity);
+                ++total_buffers;
+            }
         }
     }
 }
-
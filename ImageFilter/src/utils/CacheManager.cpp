@@ -1,94 +1,126 @@
 #include <utils/CacheManager.h>
+#include <cmath>
 #include <functional>
-#include <mutex>
 
-CacheManager& CacheManager::getInstance() noexcept
-{
-    static CacheManager instance;
-    return instance;
-}
-
-std::vector<int32_t> CacheManager::getOrGenerateKernel(
-    const KernelCacheKey& key,
-    const std::function<std::vector<int32_t>()>& generator)
+namespace
 {
-    // Пытаемся получить ядро из кэша (shared lock для чтения)
+    /**
+     * @brief Округляет значение до ближайшего кратного шагу
+     * @param value Значение
+     * @param step Шаг квантования (<= 0 - без квантования)
+     * @return Квантованное значение
+     */
+    double quantize(double value, double step) noexcept
     {
-        std::shared_lock<std::shared_mutex> lock(kernel_cache_mutex_);
-        const auto it = kernel_cache_.find(key);
-        if (it != kernel_cache_.end())
+        if (step <= 0.0)
         {
-            return it->second;  // Возвращаем копию из кэша
+            return value;
         }
+        return std::round(value / step) * step;
     }
-    
-    // Ядро не найдено в кэше, генерируем новое
-    auto kernel = generator();
-    
-    // Сохраняем в кэш (exclusive lock для записи)
+
+    /**
+     * @brief Квантует значение, если результат остается допустимым параметром генератора
+     * @param value Значение
+     * @param step Шаг квантования (<= 0 - без квантования)
+     * @param is_valid Проверка допустимости значения для генератора
+     * @return Квантованное значение или исходное, если квантование попало в особую точку
+     *
+     * Например, sigma 0.2 при шаге 0.5 округлилась бы до 0, а контраст 0.96 при
+     * шаге 0.1 - до 1.0; генераторы делят на эти значения. Такие ключи
+     * кэшируются с точным значением.
+     */
+    template <typename Predicate>
+    double quantizeWithin(double value, double step, Predicate is_valid) noexcept
     {
-        std::unique_lock<std::shared_mutex> lock(kernel_cache_mutex_);
-        // Проверяем еще раз на случай, если другой поток уже добавил ядро
-        const auto it = kernel_cache_.find(key);
-        if (it == kernel_cache_.end())
-        {
-            kernel_cache_[key] = kernel;
-        }
-        else
+        const double quantized = quantize(value, step);
+        return is_valid(quantized) ? quantized : value;
+    }
+
+    /**
+     * @brief Проверяет, что параметр LUT допустим для генератора таблицы своего типа
+     */
+    bool isValidLUTParameter(LUTCacheKey::Type type, double parameter) noexcept
+    {
+        switch (type)
         {
-            // Используем уже существующее ядро из кэша
-            kernel = it->second;
+            case LUTCacheKey::Type::Gamma:
+                return parameter > 0.0;      // 1 / gamma
+            case LUTCacheKey::Type::Contrast:
+                return parameter < 1.0;      // (1 + c) / (1 - c)
+            case LUTCacheKey::Type::Brightness:
+            default:
+                return true;
         }
     }
-    
-    return kernel;
 }
 
-std::vector<uint8_t> CacheManager::getOrGenerateLUT(
-    const LUTCacheKey& key,
-    const std::function<std::vector<uint8_t>()>& generator)
+CacheManager::CacheManager()
+    : kernel_cache_(CacheLimits{}.kernel_max_bytes),
+      lut_cache_(CacheLimits{}.lut_max_bytes)
+{
+}
+
+CacheManager& CacheManager::getInstance() noexcept
+{
+    static CacheManager instance;
+    return instance;
+}
+
+CacheManager::KernelPtr CacheManager::getOrGenerateKernel(
+    const KernelCacheKey& key,
+    const std::function<std::vector<int32_t>(const KernelCacheKey&)>& generator)
 {
-    // Пытаемся получить LUT из кэша (shared lock для чтения)
+    const auto step = kernel_key_step_.load(std::memory_order_relaxed);
+    KernelCacheKey quantized = key;
+    quantized.radius = quantize(key.radius, step);
+    if (key.type == KernelCacheKey::Type::Gaussian)
     {
-        std::shared_lock<std::shared_mutex> lock(lut_cache_mutex_);
-        const auto it = lut_cache_.find(key);
-        if (it != lut_cache_.end())
-        {
-            return it->second;  // Возвращаем копию из кэша
-        }
+        // Ядро Гаусса делит на sigma
+        quantized.sigma = quantizeWithin(key.sigma, step, [](double sigma) { return sigma > 0.0; });
     }
-    
-    // LUT не найдена в кэше, генерируем новую
-    auto lut = generator();
-    
-    // Сохраняем в кэш (exclusive lock для записи)
+    else
     {
-        std::unique_lock<std::shared_mutex> lock(lut_cache_mutex_);
-        // Проверяем еще раз на случай, если другой поток уже добавил LUT
-        const auto it = lut_cache_.find(key);
-        if (it == lut_cache_.end())
-        {
-            lut_cache_[key] = lut;
-        }
-        else
-        {
-            // Используем уже существующую LUT из кэша
-            lut = it->second;
-        }
+        quantized.sigma = quantize(key.sigma, step);
     }
-    
-    return lut;
+    return kernel_cache_.getOrGenerate(quantized, generator);
+}
+
+CacheManager::LUTPtr CacheManager::getOrGenerateLUT(
+    const LUTCacheKey& key,
+    const std::function<std::vector<uint8_t>(const LUTCacheKey&)>& generator)
+{
+    LUTCacheKey quantized = key;
+    quantized.parameter = quantizeWithin(key.parameter, lut_key_step_.load(std::memory_order_relaxed),
+                                         [&key](double parameter) { return isValidLUTParameter(key.type, parameter); });
+    return lut_cache_.getOrGenerate(quantized, generator);
+}
+
+void CacheManager::setLimits(const CacheLimits& limits)
+{
+    kernel_key_step_.store(limits.kernel_key_step, std::memory_order_relaxed);
+    lut_key_step_.store(limits.lut_key_step, std::memory_order_relaxed);
+    kernel_cache_.setMaxBytes(limits.kernel_max_bytes);
+    lut_cache_.setMaxBytes(limits.lut_max_bytes);
+}
+
+CacheManager::CacheLimits CacheManager::getLimits() const noexcept
+{
+    CacheLimits limits;
+    limits.kernel_max_bytes = kernel_cache_.getStatistics().max_bytes;
+    limits.lut_max_bytes = lut_cache_.getStatistics().max_bytes;
+    limits.kernel_key_step = kernel_key_step_.load(std::memory_order_relaxed);
+    limits.lut_key_step = lut_key_step_.load(std::memory_order_relaxed);
+    return limits;
 }
 
 void CacheManager::clearKernelCache() noexcept
 {
-    std::unique_lock<std::shared_mutex> lock(kernel_cache_mutex_);
     kernel_cache_.clear();
 }
 
 void CacheManager::clearLUTCache() noexcept
 {
-    std::unique_lock<std::shared_mutex> lock(lut_cache_mutex_);
     lut_cache_.clear();
 }
 
@@ -100,18 +132,23 @@ void CacheManager::clearAll() noexcept
 
 CacheManager::CacheStatistics CacheManager::getStatistics() const noexcept
 {
+    const auto fill = [](const auto& source, CacheStatistics::Counters& counters) {
+        counters.hits = source.hits;
+        counters.misses = source.misses;
+        counters.evictions = source.evictions;
+        counters.bytes = source.bytes;
+        counters.max_bytes = source.max_bytes;
+    };
+
     CacheStatistics stats;
-    
-    {
-        std::shared_lock<std::shared_mutex> lock(kernel_cache_mutex_);
-        stats.kernel_cache_size = kernel_cache_.size();
-    }
-    
-    {
-        std::shared_lock<std::shared_mutex> lock(lut_cache_mutex_);
-        stats.lut_cache_size = lut_cache_.size();
-    }
-    
+
+    const auto kernel_stats = kernel_cache_.getStatistics();
+    stats.kernel_cache_size = kernel_stats.entries;
+    fill(kernel_stats, stats.kernel);
+
+    const auto lut_stats = lut_cache_.getStatistics();
+    stats.lut_cache_size = lut_stats.entries;
+    fill(lut_stats, stats.lut);
+
     return stats;
 }
-
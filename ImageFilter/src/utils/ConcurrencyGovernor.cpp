@@ -0,0 +1,239 @@
+#include <utils/ConcurrencyGovernor.h>
+
+#include <algorithm>
+#include <thread>
+#include <utility>
+
+namespace
+{
+    /**
+     * @brief Регистрация текущего потока как рабочего потока уровня файлов
+     */
+    struct WorkerRegistration
+    {
+        const ConcurrencyGovernor* governor = nullptr;
+        int depth = 0;
+    };
+
+    thread_local WorkerRegistration t_worker;
+
+    bool isWorkerOf(const ConcurrencyGovernor* governor) noexcept
+    {
+        return t_worker.governor == governor && t_worker.depth > 0;
+    }
+
+    int resolveBudget(int thread_budget) noexcept
+    {
+        if (thread_budget > 0)
+        {
+            return thread_budget;
+        }
+        return std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+}
+
+ConcurrencyGovernor::Lease::Lease(ConcurrencyGovernor* governor, Kind kind, int threads, int tokens) noexcept
+    : governor_(governor)
+    , kind_(kind)
+    , threads_(threads)
+    , tokens_(tokens)
+{
+}
+
+ConcurrencyGovernor::Lease::~Lease()
+{
+    release();
+}
+
+ConcurrencyGovernor::Lease::Lease(Lease&& other) noexcept
+    : governor_(std::exchange(other.governor_, nullptr))
+    , kind_(std::exchange(other.kind_, Kind::None))
+    , threads_(std::exchange(other.threads_, 1))
+    , tokens_(std::exchange(other.tokens_, 0))
+{
+}
+
+ConcurrencyGovernor::Lease& ConcurrencyGovernor::Lease::operator=(Lease&& other) noexcept
+{
+    if (this != &other)
+    {
+        release();
+        governor_ = std::exchange(other.governor_, nullptr);
+        kind_ = std::exchange(other.kind_, Kind::None);
+        threads_ = std::exchange(other.threads_, 1);
+        tokens_ = std::exchange(other.tokens_, 0);
+    }
+    return *this;
+}
+
+void ConcurrencyGovernor::Lease::release() noexcept
+{
+    if (governor_ != nullptr && kind_ != Kind::None)
+    {
+        governor_->release(kind_, tokens_);
+    }
+    governor_ = nullptr;
+    kind_ = Kind::None;
+    threads_ = 1;
+    tokens_ = 0;
+}
+
+ConcurrencyGovernor& ConcurrencyGovernor::getInstance()
+{
+    static ConcurrencyGovernor instance;
+    return instance;
+}
+
+ConcurrencyGovernor::ConcurrencyGovernor(int thread_budget)
+    : thread_budget_(resolveBudget(thread_budget))
+{
+}
+
+void ConcurrencyGovernor::setThreadBudget(int thread_budget)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    thread_budget_ = resolveBudget(thread_budget);
+    changed_.notify_all();
+}
+
+int ConcurrencyGovernor::getThreadBudget() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return thread_budget_;
+}
+
+void ConcurrencyGovernor::setExclusiveThreshold(int64_t pixels)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    exclusive_threshold_ = std::max<int64_t>(0, pixels);
+}
+
+int64_t ConcurrencyGovernor::getExclusiveThreshold() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return exclusive_threshold_;
+}
+
+ConcurrencyGovernor::Lease ConcurrencyGovernor::acquireWorker()
+{
+    // Вложенная регистрация (например, стадия конвейера внутри пакетного потока)
+    // не занимает бюджет повторно и не ждет монопольной обработки
+    if (isWorkerOf(this))
+    {
+        ++t_worker.depth;
+        return Lease(this, Lease::Kind::Worker, 1, 0);
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        changed_.wait(lock, [this] { return !exclusive_active_ && exclusive_waiting_ == 0; });
+        ++workers_;
+        updatePeak();
+    }
+
+    t_worker.governor = this;
+    t_worker.depth = 1;
+    return Lease(this, Lease::Kind::Worker, 1, 1);
+}
+
+ConcurrencyGovernor::Lease ConcurrencyGovernor::acquireRowThreads(int requested)
+{
+    if (requested <= 1)
+    {
+        return Lease();
+    }
+
+    const bool is_worker = isWorkerOf(this);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Рабочий поток ждет завершения строк, поэтому его единица бюджета свободна
+    const int free_threads = thread_budget_ - workers_ - row_threads_ + (is_worker ? 1 : 0);
+    const int granted = std::clamp(free_threads, 1, requested);
+    if (granted <= 1)
+    {
+        return Lease();
+    }
+
+    const int tokens = is_worker ? granted - 1 : granted;
+    row_threads_ += tokens;
+    updatePeak();
+    return Lease(this, Lease::Kind::Rows, granted, tokens);
+}
+
+ConcurrencyGovernor::Lease ConcurrencyGovernor::acquireExclusive(int width, int height)
+{
+    if (!isWorkerOf(this))
+    {
+        return Lease();
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    const auto pixels = static_cast<int64_t>(width) * static_cast<int64_t>(height);
+    if (exclusive_threshold_ == 0 || pixels < exclusive_threshold_)
+    {
+        return Lease();
+    }
+
+    // На время ожидания уступаем свою единицу, чтобы два монопольных запроса
+    // не ждали друг друга
+    ++exclusive_waiting_;
+    --workers_;
+    changed_.notify_all();
+    changed_.wait(lock, [this] { return !exclusive_active_ && workers_ == 0; });
+    --exclusive_waiting_;
+    ++workers_;
+    exclusive_active_ = true;
+    updatePeak();
+    return Lease(this, Lease::Kind::Exclusive, thread_budget_, 0);
+}
+
+int ConcurrencyGovernor::getThreadsInUse() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return workers_ + row_threads_;
+}
+
+int ConcurrencyGovernor::getPeakThreadsInUse() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return peak_threads_;
+}
+
+void ConcurrencyGovernor::resetPeak()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    peak_threads_ = workers_ + row_threads_;
+}
+
+void ConcurrencyGovernor::release(Lease::Kind kind, int tokens) noexcept
+{
+    if (kind == Lease::Kind::Worker && t_worker.governor == this && t_worker.depth > 0)
+    {
+        if (--t_worker.depth == 0)
+        {
+            t_worker.governor = nullptr;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    switch (kind)
+    {
+        case Lease::Kind::Worker:
+            workers_ -= tokens;
+            break;
+        case Lease::Kind::Rows:
+            row_threads_ -= tokens;
+            break;
+        case Lease::Kind::Exclusive:
+            exclusive_active_ = false;
+            break;
+        case Lease::Kind::None:
+            break;
+    }
+    changed_.notify_all();
+}
+
+void ConcurrencyGovernor::updatePeak()
+{
+    peak_threads_ = std::max(peak_threads_, workers_ + row_threads_);
+}
@@ -0,0 +1,343 @@
+#include <utils/DirectoryScanner.h>
+#include <utils/Logger.h>
+
+#include <algorithm>
+#include <array>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#define IMAGEFILTER_HAS_READDIR 1
+#else
+#define IMAGEFILTER_HAS_READDIR 0
+#endif
+
+namespace
+{
+    // Найденные файлы передаются потребителям пачками, чтобы не блокировать очередь на каждом файле
+    constexpr size_t FILE_BATCH_SIZE = 64;
+
+    // Обход упирается в задержки файловой системы, больше потоков редко помогает
+    constexpr int MAX_AUTO_THREADS = 4;
+
+    char asciiLower(char c) noexcept
+    {
+        return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+    }
+
+    bool equalsIgnoreCase(std::string_view a, std::string_view b) noexcept
+    {
+        return a.size() == b.size() &&
+               std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) { return asciiLower(x) == asciiLower(y); });
+    }
+
+    std::string joinPath(const std::string& directory, const char* name)
+    {
+        std::string path = directory;
+        if (!path.empty() && path.back() != '/')
+        {
+            path += '/';
+        }
+        path += name;
+        return path;
+    }
+}
+
+DirectoryScanner::DirectoryScanner(std::string input_dir)
+    : DirectoryScanner(std::move(input_dir), Options{})
+{
+}
+
+DirectoryScanner::DirectoryScanner(std::string input_dir, const Options& options)
+    : input_dir_(std::move(input_dir))
+    , options_(options)
+{
+}
+
+DirectoryScanner::~DirectoryScanner()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    directories_changed_.notify_all();
+    files_changed_.notify_all();
+
+    for (auto& thread : threads_)
+    {
+        thread.join();
+    }
+}
+
+FilterResult DirectoryScanner::start()
+{
+    // При ошибке next() сразу сообщает о конце обхода
+    complete_ = true;
+
+    std::error_code ec;
+    if (!std::filesystem::exists(input_dir_, ec))
+    {
+        return FilterResult::failure(FilterError::FileNotFound, "Входная директория не существует",
+                                     ErrorContext::withFilename(input_dir_));
+    }
+    if (!std::filesystem::is_directory(input_dir_, ec))
+    {
+        return FilterResult::failure(FilterError::InvalidFilePath, "Указанный путь не является директорией",
+                                     ErrorContext::withFilename(input_dir_));
+    }
+
+    int threads = options_.threads;
+    if (threads <= 0)
+    {
+        threads = options_.recursive
+                      ? std::clamp(static_cast<int>(std::thread::hardware_concurrency()), 1, MAX_AUTO_THREADS)
+                      : 1;  // Одну директорию читает один поток
+    }
+
+    complete_ = false;
+    addDirectory(input_dir_);
+    threads_.reserve(static_cast<size_t>(threads));
+    for (int i = 0; i < threads; ++i)
+    {
+        threads_.emplace_back(&DirectoryScanner::scanWorker, this);
+    }
+    return FilterResult::success();
+}
+
+bool DirectoryScanner::next(std::filesystem::path& path)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    files_changed_.wait(lock, [this] { return !files_.empty() || complete_ || stopping_; });
+    if (files_.empty())
+    {
+        return false;
+    }
+    path = std::move(files_.front());
+    files_.pop_front();
+    return true;
+}
+
+bool DirectoryScanner::tryNext(std::filesystem::path& path)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (files_.empty())
+    {
+        return false;
+    }
+    path = std::move(files_.front());
+    files_.pop_front();
+    return true;
+}
+
+size_t DirectoryScanner::getDiscoveredCount() const noexcept
+{
+    return discovered_.load(std::memory_order_acquire);
+}
+
+bool DirectoryScanner::isComplete() const noexcept
+{
+    return complete_.load(std::memory_order_acquire);
+}
+
+bool DirectoryScanner::isImageFileName(std::string_view filename) noexcept
+{
+    static constexpr std::array<std::string_view, 3> extensions = {"jpg", "jpeg", "png"};
+
+    const size_t dot = filename.rfind('.');
+    if (dot == std::string_view::npos || dot == 0)
+    {
+        return false;
+    }
+    const auto extension = filename.substr(dot + 1);
+    return std::any_of(extensions.begin(), extensions.end(),
+                       [extension](std::string_view valid) { return equalsIgnoreCase(extension, valid); });
+}
+
+bool DirectoryScanner::matchesPattern(std::string_view filename, std::string_view pattern) noexcept
+{
+    if (pattern.empty())
+    {
+        return true;
+    }
+
+    // Шаблон вида "*.ext": имя файла заканчивается на расширение
+    if (pattern.size() >= 2 && pattern[0] == '*' && pattern[1] == '.')
+    {
+        const auto extension = pattern.substr(2);
+        if (filename.size() >= extension.size() &&
+            equalsIgnoreCase(filename.substr(filename.size() - extension.size()), extension))
+        {
+            return true;
+        }
+    }
+
+    // Иначе проверяем точное совпадение
+    return equalsIgnoreCase(filename, pattern);
+}
+
+void DirectoryScanner::scanWorker()
+{
+    while (true)
+    {
+        std::string directory;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            directories_changed_.wait(lock, [this] {
+                return stopping_ || !directories_.empty() || active_directories_ == 0;
+            });
+            if (stopping_ || directories_.empty())
+            {
+                return;
+            }
+            directory = std::move(directories_.front());
+            directories_.pop_front();
+        }
+
+        scanDirectory(directory);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (--active_directories_ == 0)
+        {
+            complete_ = true;
+            directories_changed_.notify_all();
+            files_changed_.notify_all();
+        }
+    }
+}
+
+void DirectoryScanner::scanDirectory(const std::string& directory)
+{
+    std::vector<std::filesystem::path> files;
+    files.reserve(FILE_BATCH_SIZE);
+
+#if IMAGEFILTER_HAS_READDIR
+    DIR* dir = opendir(directory.c_str());
+    if (dir == nullptr)
+    {
+        Logger::warning("Не удалось открыть директорию: " + directory);
+        return;
+    }
+    const int dir_fd = dirfd(dir);
+
+    while (!stopping_)
+    {
+        const dirent* entry = readdir(dir);
+        if (entry == nullptr)
+        {
+            break;
+        }
+
+        const char* name = entry->d_name;
+        if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0')))
+        {
+            continue;
+        }
+
+        // Тип берется из d_type; stat нужен только для ссылок и неизвестного типа
+        unsigned char type = entry->d_type;
+        if (type == DT_UNKNOWN)
+        {
+            struct stat entry_stat{};
+            if (fstatat(dir_fd, name, &entry_stat, AT_SYMLINK_NOFOLLOW) != 0)
+            {
+                continue;
+            }
+            type = S_ISDIR(entry_stat.st_mode) ? DT_DIR
+                 : S_ISREG(entry_stat.st_mode) ? DT_REG
+                 : S_ISLNK(entry_stat.st_mode) ? DT_LNK
+                                               : DT_UNKNOWN;
+        }
+
+        if (type == DT_DIR)
+        {
+            if (options_.recursive)
+            {
+                addDirectory(joinPath(directory, name));
+            }
+            continue;
+        }
+        if ((type != DT_REG && type != DT_LNK) || !accepts(name))
+        {
+            continue;
+        }
+        if (type == DT_LNK)
+        {
+            // Ссылка на файл обрабатывается как файл, ссылки на директории не обходятся
+            struct stat target_stat{};
+            if (fstatat(dir_fd, name, &target_stat, 0) != 0 || !S_ISREG(target_stat.st_mode))
+            {
+                continue;
+            }
+        }
+
+        files.emplace_back(joinPath(directory, name));
+        if (files.size() >= FILE_BATCH_SIZE)
+        {
+            addFiles(files);
+        }
+    }
+    closedir(dir);
+#else
+    std::error_code ec;
+    for (std::filesystem::directory_iterator it(directory, ec), end; !ec && it != end && !stopping_; it.increment(ec))
+    {
+        const auto& entry = *it;
+        std::error_code entry_ec;
+        if (options_.recursive && entry.is_directory(entry_ec) && !entry.is_symlink(entry_ec))
+        {
+            addDirectory(entry.path().string());
+            continue;
+        }
+        if (entry.is_regular_file(entry_ec) && accepts(entry.path().filename().string()))
+        {
+            files.push_back(entry.path());
+            if (files.size() >= FILE_BATCH_SIZE)
+            {
+                addFiles(files);
+            }
+        }
+    }
+    if (ec)
+    {
+        Logger::warning("Ошибка при обходе директории " + directory + ": " + ec.message());
+    }
+#endif
+
+    addFiles(files);
+}
+
+void DirectoryScanner::addFiles(std::vector<std::filesystem::path>& files)
+{
+    if (files.empty())
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& file : files)
+        {
+            files_.push_back(std::move(file));
+        }
+        discovered_.fetch_add(files.size(), std::memory_order_release);
+    }
+    files_changed_.notify_all();
+    files.clear();
+}
+
+void DirectoryScanner::addDirectory(std::string directory)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++active_directories_;
+        directories_.push_back(std::move(directory));
+    }
+    directories_changed_.notify_one();
+}
+
+bool DirectoryScanner::accepts(std::string_view filename) const noexcept
+{
+    return isImageFileName(filename) && matchesPattern(filename, options_.pattern);
+}
@@ -1,157 +1,49 @@
 #include <utils/FileSystemHelper.h>
+#include <utils/DirectoryScanner.h>
 #include <utils/Logger.h>
-#include <algorithm>
-#include <cctype>
 #include <filesystem>
 
-namespace
-{
-    /**
-     * @brief Преобразует строку в нижний регистр
-     */
-    std::string toLower(const std::string& str)
-    {
-        std::string result = str;
-        std::transform(result.begin(), result.end(), result.begin(),
-                      [](unsigned char c) { return std::tolower(c); });
-        return result;
-    }
-
-    /**
-     * @brief Проверяет расширение файла
-     */
-    bool hasExtension(const std::filesystem::path& path, const std::vector<std::string>& extensions)
-    {
-        if (!path.has_extension())
-        {
-            return false;
-        }
-
-        std::string ext = toLower(path.extension().string());
-        // Убираем точку из расширения
-        if (!ext.empty() && ext[0] == '.')
-        {
-            ext = ext.substr(1);
-        }
-
-        for (const auto& valid_ext : extensions)
-        {
-            if (ext == valid_ext)
-            {
-                return true;
-            }
-        }
-        return false;
-    }
-
-    /**
-     * @brief Простой паттерн-матчинг для шаблонов вида "*.jpg"
-     */
-    bool simplePatternMatch(const std::string& filename, const std::string& pattern)
-    {
-        if (pattern.empty())
-        {
-            return true;
-        }
-
-        // Простая поддержка шаблонов вида "*.ext" или "*.EXT"
-        if (pattern.size() >= 2 && pattern[0] == '*' && pattern[1] == '.')
-        {
-            std::string pattern_ext = pattern.substr(2);
-            std::string filename_lower = toLower(filename);
-            std::string pattern_ext_lower = toLower(pattern_ext);
-
-            // Проверяем, заканчивается ли имя файла на расширение из шаблона
-            if (filename_lower.size() >= pattern_ext_lower.size())
-            {
-                std::string file_ext = filename_lower.substr(
-                    filename_lower.size() - pattern_ext_lower.size());
-                return file_ext == pattern_ext_lower;
-            }
-        }
-
-        // Если шаблон не соответствует формату "*.ext", проверяем точное совпадение
-        return toLower(filename) == toLower(pattern);
-    }
-}
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#define IMAGEFILTER_HAS_FSYNC 1
+#else
+#define IMAGEFILTER_HAS_FSYNC 0
+#endif
 
 std::vector<std::filesystem::path> FileSystemHelper::findImages(
     const std::string& input_dir,
     bool recursive,
     const std::string& pattern)
 {
-    std::vector<std::filesystem::path> images;
-    std::filesystem::path input_path(input_dir);
-
-    if (!std::filesystem::exists(input_path))
-    {
-        Logger::error("Входная директория не существует: " + input_dir);
-        return images;
-    }
+    DirectoryScanner::Options options;
+    options.recursive = recursive;
+    options.pattern = pattern;
 
-    if (!std::filesystem::is_directory(input_path))
+    std::vector<std::filesystem::path> images;
+    DirectoryScanner scanner(input_dir, options);
+    const auto result = scanner.start();
+    if (!result.isSuccess())
     {
-        Logger::error("Указанный путь не является директорией: " + input_dir);
+        Logger::error(result.getFullMessage());
         return images;
     }
 
-    if (recursive)
-    {
-        findImagesRecursive(input_path, images, pattern);
-    }
-    else
+    std::filesystem::path image;
+    while (scanner.next(image))
     {
-        // Не рекурсивный поиск - только в текущей директории
-        for (const auto& entry : std::filesystem::directory_iterator(input_path))
-        {
-            if (entry.is_regular_file() && isImageFile(entry.path()))
-            {
-                if (pattern.empty() || matchesPattern(entry.path().filename().string(), pattern))
-                {
-                    images.push_back(entry.path());
-                }
-            }
-        }
+        images.push_back(std::move(image));
     }
-
     return images;
 }
 
-void FileSystemHelper::findImagesRecursive(
-    const std::filesystem::path& dir,
-    std::vector<std::filesystem::path>& images,
-    const std::string& pattern)
-{
-    try
-    {
-        for (const auto& entry : std::filesystem::recursive_directory_iterator(dir))
-        {
-            if (entry.is_regular_file() && isImageFile(entry.path()))
-            {
-                if (pattern.empty() || matchesPattern(entry.path().filename().string(), pattern))
-                {
-                    images.push_back(entry.path());
-                }
-            }
-        }
-    }
-    catch (const std::filesystem::filesystem_error& e)
-    {
-        Logger::error("Ошибка при обходе директории: " + std::string(e.what()));
-    }
-}
-
 bool FileSystemHelper::isImageFile(const std::filesystem::path& path)
 {
-    static const std::vector<std::string> image_extensions = {
-        "jpg", "jpeg", "png"
-    };
-    return hasExtension(path, image_extensions);
+    return DirectoryScanner::isImageFileName(path.filename().string());
 }
 
 bool FileSystemHelper::matchesPattern(const std::string& filename, const std::string& pattern)
 {
-    return simplePatternMatch(filename, pattern);
+    return DirectoryScanner::matchesPattern(filename, pattern);
 }
 
 std::filesystem::path FileSystemHelper::getRelativePath(
@@ -187,3 +79,33 @@ bool FileSystemHelper::ensureOutputDirectory(const std::filesystem::path& output
     }
 }
 
+bool FileSystemHelper::flushToDisk(std::FILE* file)
+{
+    if (std::fflush(file) != 0)
+    {
+        return false;
+    }
+#if IMAGEFILTER_HAS_FSYNC
+    return fsync(fileno(file)) == 0;
+#else
+    return true;
+#endif
+}
+
+bool FileSystemHelper::syncDirectory(const std::filesystem::path& file_path)
+{
+#if IMAGEFILTER_HAS_FSYNC
+    const auto directory = file_path.has_parent_path() ? file_path.parent_path() : std::filesystem::path(".");
+    std::FILE* handle = std::fopen(directory.string().c_str(), "r");
+    if (handle == nullptr)
+    {
+        return false;
+    }
+    const bool synced = fsync(fileno(handle)) == 0;
+    std::fclose(handle);
+    return synced;
+#else
+    (void)file_path;
+    return true;
+#endif
+}
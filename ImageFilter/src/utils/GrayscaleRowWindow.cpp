@@ -0,0 +1,112 @@
+#include <utils/GrayscaleRowWindow.h>
+#include <utils/ParallelImageProcessor.h>
+#include <utils/ColorConversionUtils.h>
+#include <algorithm>
+
+GrayscaleRowWindow::GrayscaleRowWindow(const uint8_t* data, int width, int height, int channels,
+                                       const BorderHandler& border_handler)
+    : data_(data),
+      width_(width),
+      height_(height),
+      channels_(channels),
+      border_handler_(border_handler),
+      strips_(ParallelImageProcessor::splitRows(height, width)),
+      halos_(strips_.size())
+{
+}
+
+size_t GrayscaleRowWindow::getStripCount() const noexcept
+{
+    return strips_.size();
+}
+
+void GrayscaleRowWindow::analyze(const RowVisitor& visitor)
+{
+    process(false, visitor);
+}
+
+void GrayscaleRowWindow::write(const RowVisitor& visitor)
+{
+    process(true, visitor);
+}
+
+void GrayscaleRowWindow::convertRow(const uint8_t* src, int width, int channels, uint8_t* dst) noexcept
+{
+    const auto step = static_cast<size_t>(channels);
+    for (int x = 0; x < width; ++x)
+    {
+        const auto* pixel = src + static_cast<size_t>(x) * step;
+        dst[x] = ColorConversionUtils::rgbToGrayscale(pixel[0], pixel[1], pixel[2]);
+    }
+}
+
+int GrayscaleRowWindow::resolveRow(int y) const noexcept
+{
+    // Дополнительно ограничиваем результат: для изображений высотой в одну строку
+    // отражение может вернуть координату за пределами изображения
+    return std::clamp(border_handler_.getY(y, height_), 0, height_ - 1);
+}
+
+size_t GrayscaleRowWindow::findStrip(int start_row) const noexcept
+{
+    const auto it = std::lower_bound(strips_.begin(), strips_.end(), start_row,
+                                     [](const std::pair<int, int>& strip, int row) { return strip.first < row; });
+    return static_cast<size_t>(it - strips_.begin());
+}
+
+void GrayscaleRowWindow::loadRow(int y, uint8_t* dst) const noexcept
+{
+    const auto row_offset = static_cast<size_t>(resolveRow(y)) * static_cast<size_t>(width_) * static_cast<size_t>(channels_);
+    convertRow(data_ + row_offset, width_, channels_, dst);
+}
+
+void GrayscaleRowWindow::process(bool in_place, const RowVisitor& visitor)
+{
+    const auto width = static_cast<size_t>(width_);
+
+    // Разбиение совпадает с strips_, так как параметры вызова те же, что и в splitRows
+    ParallelImageProcessor::processRowsParallel(
+        height_,
+        width_,
+        [this, in_place, width, &visitor](int start_row, int end_row)
+        {
+            const auto strip = findStrip(start_row);
+            auto& halo = halos_[strip];
+
+            if (!in_place)
+            {
+                // Проход только для чтения: сохраняем строки соседних полос,
+                // которые к моменту прохода записи могут быть уже перезаписаны
+                halo.above.resize(width);
+                halo.below.resize(width);
+                loadRow(start_row - 1, halo.above.data());
+                loadRow(end_row, halo.below.data());
+            }
+
+            // Кольцевой буфер из трех строк градаций серого
+            std::vector<uint8_t> ring(width * 3);
+            uint8_t* rows[3] = {ring.data(), ring.data() + width, ring.data() + width * 2};
+
+            std::copy(halo.above.begin(), halo.above.end(), rows[0]);
+            loadRow(start_row, rows[1]);
+
+            for (int y = start_row; y < end_row; ++y)
+            {
+                // Следующая строка загружается до обработки текущей, поэтому при записи
+                // на месте строка y + 1 изображения еще не изменена
+                if (y + 1 < end_row)
+                {
+                    loadRow(y + 1, rows[2]);
+                }
+                else
+                {
+                    std::copy(halo.below.begin(), halo.below.end(), rows[2]);
+                }
+
+                visitor(strip, y, rows[0], rows[1], rows[2]);
+
+                std::rotate(std::begin(rows), std::begin(rows) + 1, std::end(rows));
+            }
+        }
+    );
+}
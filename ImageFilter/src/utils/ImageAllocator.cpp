@@ -0,0 +1,221 @@
+#include <utils/ImageAllocator.h>
+#include <atomic>
+#include <cstdint>
+#include <new>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <unistd.h>
+#define IMAGEFILTER_HAS_MMAP 1
+#else
+#define IMAGEFILTER_HAS_MMAP 0
+#endif
+
+namespace
+{
+    std::atomic<IImageAllocator*> default_allocator{nullptr};
+
+    size_t roundUp(size_t value, size_t alignment) noexcept
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+#if IMAGEFILTER_HAS_MMAP
+    size_t pageSize() noexcept
+    {
+        static const size_t page_size = []()
+        {
+            const long value = ::sysconf(_SC_PAGESIZE);
+            return value > 0 ? static_cast<size_t>(value) : size_t{4096};
+        }();
+        return page_size;
+    }
+
+    /**
+     * @brief Принудительно заполняет страницы отображения записью
+     */
+    void populatePages(void* ptr, size_t size) noexcept
+    {
+#ifdef MADV_POPULATE_WRITE
+        if (::madvise(ptr, size, MADV_POPULATE_WRITE) == 0)
+        {
+            return;
+        }
+#endif
+        // Ядро без MADV_POPULATE_WRITE (до Linux 5.14): касаемся каждой страницы
+        auto* bytes = static_cast<volatile uint8_t*>(ptr);
+        const size_t step = pageSize();
+        for (size_t offset = 0; offset < size; offset += step)
+        {
+            bytes[offset] = 0;
+        }
+    }
+
+    /**
+     * @brief Отображает size байт с началом, выровненным по alignment
+     *
+     * Отображение берется с запасом alignment, затем лишние начало и конец
+     * возвращаются системе.
+     */
+    void* mapAligned(size_t size, size_t alignment) noexcept
+    {
+        const size_t reserved = size + alignment;
+        void* raw = ::mmap(nullptr, reserved, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw == MAP_FAILED)
+        {
+            return nullptr;
+        }
+
+        const auto raw_address = reinterpret_cast<uintptr_t>(raw);
+        const auto aligned_address = roundUp(raw_address, alignment);
+        const size_t head = aligned_address - raw_address;
+        const size_t tail = reserved - head - size;
+        if (head > 0)
+        {
+            ::munmap(raw, head);
+        }
+        if (tail > 0)
+        {
+            ::munmap(reinterpret_cast<void*>(aligned_address + size), tail);
+        }
+        return reinterpret_cast<void*>(aligned_address);
+    }
+#endif
+}
+
+IImageAllocator& ImageAllocator::getDefault() noexcept
+{
+    auto* allocator = default_allocator.load(std::memory_order_acquire);
+    return allocator != nullptr ? *allocator : HeapImageAllocator::getInstance();
+}
+
+void ImageAllocator::setDefault(IImageAllocator* allocator) noexcept
+{
+    default_allocator.store(allocator, std::memory_order_release);
+}
+
+void* HeapImageAllocator::allocate(size_t size) noexcept
+{
+    return ::operator new(size, std::align_val_t{ALIGNMENT}, std::nothrow);
+}
+
+void HeapImageAllocator::deallocate(void* ptr, size_t /*size*/) noexcept
+{
+    ::operator delete(ptr, std::align_val_t{ALIGNMENT});
+}
+
+const char* HeapImageAllocator::getName() const noexcept
+{
+    return "heap";
+}
+
+HeapImageAllocator& HeapImageAllocator::getInstance() noexcept
+{
+    static HeapImageAllocator instance;
+    return instance;
+}
+
+MmapImageAllocator::MmapImageAllocator() noexcept
+    : MmapImageAllocator(Options{})
+{
+}
+
+MmapImageAllocator::MmapImageAllocator(const Options& options) noexcept
+    : options_(options)
+{
+}
+
+void* MmapImageAllocator::allocate(size_t size) noexcept
+{
+    if (!isSupported() || size < options_.min_mapping_size || size == 0)
+    {
+        return HeapImageAllocator::getInstance().allocate(size);
+    }
+
+#if IMAGEFILTER_HAS_MMAP
+    const size_t mapping_size = mappingSize(size);
+    void* ptr = nullptr;
+    if (options_.huge_pages)
+    {
+        ptr = mapAligned(mapping_size, HUGE_PAGE_SIZE);
+        if (ptr == nullptr)
+        {
+            return nullptr;
+        }
+#ifdef MADV_HUGEPAGE
+        // Подсказка необязательна: при выключенном THP ядро вернет ошибку, и блок останется на 4 КБ страницах
+        ::madvise(ptr, mapping_size, MADV_HUGEPAGE);
+#endif
+        if (options_.populate)
+        {
+            // Заполняем после madvise, чтобы страницы сразу выделялись как huge pages
+            populatePages(ptr, mapping_size);
+        }
+        return ptr;
+    }
+
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#ifdef MAP_POPULATE
+    if (options_.populate)
+    {
+        flags |= MAP_POPULATE;
+    }
+#endif
+    ptr = ::mmap(nullptr, mapping_size, PROT_READ | PROT_WRITE, flags, -1, 0);
+    if (ptr == MAP_FAILED)
+    {
+        return nullptr;
+    }
+#ifndef MAP_POPULATE
+    if (options_.populate)
+    {
+        populatePages(ptr, mapping_size);
+    }
+#endif
+    return ptr;
+#else
+    return nullptr;
+#endif
+}
+
+void MmapImageAllocator::deallocate(void* ptr, size_t size) noexcept
+{
+    if (ptr == nullptr)
+    {
+        return;
+    }
+
+    if (!isSupported() || size < options_.min_mapping_size || size == 0)
+    {
+        HeapImageAllocator::getInstance().deallocate(ptr, size);
+        return;
+    }
+
+#if IMAGEFILTER_HAS_MMAP
+    ::munmap(ptr, mappingSize(size));
+#endif
+}
+
+const char* MmapImageAllocator::getName() const noexcept
+{
+    return options_.huge_pages ? "mmap-hugepage" : "mmap";
+}
+
+const MmapImageAllocator::Options& MmapImageAllocator::getOptions() const noexcept
+{
+    return options_;
+}
+
+bool MmapImageAllocator::isSupported() noexcept
+{
+    return IMAGEFILTER_HAS_MMAP != 0;
+}
+
+size_t MmapImageAllocator::mappingSize(size_t size) const noexcept
+{
+#if IMAGEFILTER_HAS_MMAP
+    return roundUp(size, options_.huge_pages ? HUGE_PAGE_SIZE : pageSize());
+#else
+    return size;
+#endif
+}
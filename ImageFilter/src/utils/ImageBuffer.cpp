@@ -0,0 +1,73 @@
+#include <utils/ImageBuffer.h>
+#include <utils/IImageAllocator.h>
+#include <memory>
+#include <utility>
+
+ImageBuffer::ImageBuffer(uint8_t* data, size_t size, Deleter deleter) noexcept
+    : data_(data)
+    , size_(size)
+    , deleter_(std::move(deleter))
+{
+}
+
+ImageBuffer::~ImageBuffer()
+{
+    reset();
+}
+
+ImageBuffer::ImageBuffer(ImageBuffer&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr))
+    , size_(std::exchange(other.size_, 0))
+    , deleter_(std::move(other.deleter_))
+{
+    other.deleter_ = nullptr;
+}
+
+ImageBuffer& ImageBuffer::operator=(ImageBuffer&& other) noexcept
+{
+    if (this != &other)
+    {
+        reset();
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+        deleter_ = std::move(other.deleter_);
+        other.deleter_ = nullptr;
+    }
+    return *this;
+}
+
+ImageBuffer ImageBuffer::allocate(size_t size, IImageAllocator& allocator)
+{
+    auto* data = static_cast<uint8_t*>(allocator.allocate(size));
+    if (data == nullptr)
+    {
+        return {};
+    }
+
+    return ImageBuffer(data, size, [&allocator, size](uint8_t* ptr) { allocator.deallocate(ptr, size); });
+}
+
+ImageBuffer ImageBuffer::fromPooled(PooledBuffer&& buffer)
+{
+    if (buffer.empty())
+    {
+        return {};
+    }
+
+    // std::function требует копируемого объекта, поэтому вектор хранится в shared_ptr
+    auto holder = std::make_shared<PooledBuffer>(std::move(buffer));
+    auto* data = holder->data();
+    const auto size = holder->size();
+    return ImageBuffer(data, size, [holder](uint8_t*) mutable { holder.reset(); });
+}
+
+void ImageBuffer::reset() noexcept
+{
+    if (data_ != nullptr && deleter_)
+    {
+        deleter_(data_);
+    }
+    data_ = nullptr;
+    size_ = 0;
+    deleter_ = nullptr;
+}
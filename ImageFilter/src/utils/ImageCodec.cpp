@@ -0,0 +1,28 @@
+#include <utils/IImageCodec.h>
+#include <utils/JpegImageCodec.h>
+#include <utils/StbImageCodec.h>
+
+const IImageCodec& ImageCodec::findDecoder(const std::string& extension) noexcept
+{
+    const auto& jpeg_codec = JpegImageCodec::getInstance();
+    if (jpeg_codec.canDecode(extension))
+    {
+        return jpeg_codec;
+    }
+    return getFallback();
+}
+
+const IImageCodec& ImageCodec::findEncoder(const std::string& extension) noexcept
+{
+    const auto& jpeg_codec = JpegImageCodec::getInstance();
+    if (jpeg_codec.canEncode(extension))
+    {
+        return jpeg_codec;
+    }
+    return getFallback();
+}
+
+const IImageCodec& ImageCodec::getFallback() noexcept
+{
+    return StbImageCodec::getInstance();
+}
@@ -1,5 +1,6 @@
 #include <utils/ImageConverter.h>
 #include <utils/FilterResult.h>
+#include <utils/IImageAllocator.h>
 #include <utils/SafeMath.h>
 
 #include <cstdlib>
@@ -65,3 +66,55 @@ FilterResult ImageConverter::convertRGBAToRGB(const uint8_t* rgba_data,
     return FilterResult::success();
 }
 
+
+FilterResult ImageConverter::convertRGBAToRGB(const uint8_t* rgba_data,
+                                             int width,
+                                             int height,
+                                             IImageAllocator& allocator,
+                                             uint8_t*& rgb_data,
+                                             size_t& rgb_size)
+{
+    rgb_data = nullptr;
+    rgb_size = 0;
+
+    if (width <= 0 || height <= 0)
+    {
+        ErrorContext ctx = ErrorContext::withImage(width, height, 4);
+        return FilterResult::failure(FilterError::InvalidSize, 
+                                   "Некорректный размер изображения", ctx);
+    }
+
+    size_t width_height_product = 0;
+    size_t size = 0;
+    if (!SafeMath::safeMultiply(static_cast<size_t>(width), static_cast<size_t>(height), width_height_product) ||
+        !SafeMath::safeMultiply(width_height_product, static_cast<size_t>(3), size))
+    {
+        ErrorContext ctx = ErrorContext::withImage(width, height, 4);
+        return FilterResult::failure(FilterError::ArithmeticOverflow, 
+                                   "Размер изображения слишком большой", ctx);
+    }
+
+    auto* buffer = static_cast<uint8_t*>(allocator.allocate(size));
+    if (buffer == nullptr)
+    {
+        const int errno_code = errno;
+        ErrorContext ctx = ErrorContext::withImage(width, height, 4);
+        if (errno_code != 0)
+        {
+            ctx.system_error_code = errno_code;
+        }
+        return FilterResult::failure(FilterError::OutOfMemory, 
+                                   "Недостаточно памяти для преобразования RGBA в RGB", ctx);
+    }
+
+    const auto result = convertRGBAToRGB(rgba_data, width, height, buffer);
+    if (!result.isSuccess())
+    {
+        allocator.deallocate(buffer, size);
+        return result;
+    }
+
+    rgb_data = buffer;
+    rgb_size = size;
+    return FilterResult::success();
+}
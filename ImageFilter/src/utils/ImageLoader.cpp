@@ -2,32 +2,136 @@
 #include <utils/PathValidator.h>
 #include <utils/BMPHandler.h>
 #include <utils/FilterResult.h>
+#include <utils/IImageCodec.h>
+#include <utils/MappedFile.h>
 #include <utils/SafeMath.h>
-#include <utils/ColorSpaceConverter.h>
-
-// STB Image - заголовочные файлы для работы с изображениями
-#define STB_IMAGE_IMPLEMENTATION
-#include <stb_image.h>
 
 #include <algorithm>
 #include <cctype>
 #include <cerrno>
 #include <cstdlib>
 #include <cstring>
+#include <filesystem>
 #include <stdexcept>
 
-FilterResult ImageLoader::loadFromFile(const std::string& filename, 
-                                       bool preserve_alpha, 
-                                       LoadedImage& result)
+namespace
 {
-    try
+    /**
+     * @brief Уменьшает изображение усреднением блоков scale x scale пикселей
+     *
+     * Используется для кодеков без масштабирования при декодировании. Размеры
+     * результата совпадают с масштабированием libjpeg: ceil(размер / scale).
+     *
+     * @param image Изображение (данные заменяются уменьшенными)
+     * @param scale Знаменатель масштаба
+     * @return FilterResult с результатом операции
+     */
+    FilterResult downscaleBox(ImageLoader::LoadedImage& image, int scale)
     {
-        // Инициализируем результат
-        result.data = nullptr;
-        result.width = 0;
-        result.height = 0;
-        result.channels = 0;
+        const int width = (image.width + scale - 1) / scale;
+        const int height = (image.height + scale - 1) / scale;
+        const auto channels = static_cast<size_t>(image.channels);
+        const size_t source_row = static_cast<size_t>(image.width) * channels;
+
+        size_t output_size = 0;
+        if (!SafeMath::safeMultiply(static_cast<size_t>(width) * static_cast<size_t>(height), channels, output_size))
+        {
+            return FilterResult::failure(FilterError::ArithmeticOverflow, "Размер изображения слишком большой",
+                                         ErrorContext::withImage(width, height, image.channels));
+        }
+
+        auto* output = static_cast<uint8_t*>(std::malloc(output_size));
+        if (output == nullptr)
+        {
+            return FilterResult::failure(FilterError::OutOfMemory, "Недостаточно памяти для уменьшения изображения",
+                                         ErrorContext::withImage(width, height, image.channels));
+        }
 
+        for (int y = 0; y < height; ++y)
+        {
+            const int y_begin = y * scale;
+            const int y_end = std::min(image.height, y_begin + scale);
+            for (int x = 0; x < width; ++x)
+            {
+                const int x_begin = x * scale;
+                const int x_end = std::min(image.width, x_begin + scale);
+                const auto count = static_cast<uint32_t>((y_end - y_begin) * (x_end - x_begin));
+                for (size_t c = 0; c < channels; ++c)
+                {
+                    uint32_t sum = 0;
+                    for (int sy = y_begin; sy < y_end; ++sy)
+                    {
+                        const auto* row = image.data + static_cast<size_t>(sy) * source_row;
+                        for (int sx = x_begin; sx < x_end; ++sx)
+                        {
+                            sum += row[static_cast<size_t>(sx) * channels + c];
+                        }
+                    }
+                    output[(static_cast<size_t>(y) * static_cast<size_t>(width) + static_cast<size_t>(x)) * channels + c] =
+                        static_cast<uint8_t>((sum + count / 2) / count);
+                }
+            }
+        }
+
+        std::free(image.data);
+        image.data = output;
+        image.width = width;
+        image.height = height;
+        return FilterResult::success();
+    }
+
+    /**
+     * @brief Проверяет знаменатель масштаба
+     */
+    bool isValidScale(int scale_denominator)
+    {
+        return scale_denominator == 1 || scale_denominator == 2 || scale_denominator == 4 ||
+               scale_denominator == 8;
+    }
+
+    /**
+     * @brief Освобождает частично загруженное изображение и возвращает ошибку
+     */
+    FilterResult failLoad(ImageLoader::LoadedImage& result, FilterError error, const std::string& message,
+                          const ErrorContext& ctx)
+    {
+        std::free(result.data);
+        result = ImageLoader::LoadedImage{};
+        return FilterResult::failure(error, message, ctx);
+    }
+
+    /**
+     * @brief Определяет формат по сигнатуре данных
+     * @return Расширение формата ("bmp", "jpg", "png") или пустая строка
+     */
+    std::string detectFormat(std::span<const uint8_t> data)
+    {
+        static constexpr uint8_t PNG_SIGNATURE[] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+
+        if (data.size() >= 2 && data[0] == 'B' && data[1] == 'M')
+        {
+            return "bmp";
+        }
+        if (data.size() >= 3 && data[0] == 0xFF && data[1] == 0xD8 && data[2] == 0xFF)
+        {
+            return "jpg";
+        }
+        if (data.size() >= sizeof(PNG_SIGNATURE) &&
+            std::memcmp(data.data(), PNG_SIGNATURE, sizeof(PNG_SIGNATURE)) == 0)
+        {
+            return "png";
+        }
+        return {};
+    }
+
+    /**
+     * @brief Проверяет путь к файлу изображения
+     * @param filename Путь к файлу
+     * @param normalized_path Нормализованный путь (выходной параметр)
+     * @return FilterResult с результатом операции
+     */
+    FilterResult validateImagePath(const std::string& filename, std::string& normalized_path)
+    {
         if (filename.empty())
         {
             ErrorContext ctx = ErrorContext::withFilename(filename);
@@ -44,250 +148,320 @@ FilterResult ImageLoader::loadFromFile(const std::string& filename,
         }
 
         // Нормализация и валидация пути (проверяем до проверки размера файла)
-        const std::string normalized_path = PathValidator::normalizeAndValidate(filename);
+        normalized_path = PathValidator::normalizeAndValidate(filename);
         if (normalized_path.empty())
         {
             ErrorContext ctx = ErrorContext::withFilename(filename);
             return FilterResult::failure(FilterError::InvalidFilePath, 
                                        "Небезопасный путь", ctx);
         }
+        return FilterResult::success();
+    }
+
+    /**
+     * @brief Читает сведения об изображении из заголовка
+     * @param data Закодированные данные
+     * @param info Сведения об изображении
+     * @return FilterResult с результатом операции
+     */
+    FilterResult probeImage(std::span<const uint8_t> data, ImageLoader::ImageInfo& info)
+    {
+        info = ImageLoader::ImageInfo{};
+        info.format = detectFormat(data);
+        info.file_size = data.size();
+
+        if (info.format == "bmp" && BMPHandler::readBMPInfo(data.data(), data.size(), info.width, info.height))
+        {
+            info.channels = 3;
+            return FilterResult::success();
+        }
+
+        // Как и при декодировании: кодек формата, затем запасной кодек stb
+        const IImageCodec* codec = &ImageCodec::findDecoder(info.format);
+        auto probe_result = codec->probe(data, info);
+        if (!probe_result.isSuccess() && probe_result.error == FilterError::UnsupportedFormat &&
+            codec != &ImageCodec::getFallback())
+        {
+            probe_result = ImageCodec::getFallback().probe(data, info);
+        }
+        return probe_result;
+    }
+
+    /**
+     * @brief Декодирует изображение из памяти
+     * @param data Закодированные данные
+     * @param extension Формат в нижнем регистре без точки (пустой - определяет кодек)
+     * @param preserve_alpha Загружать ли с альфа-каналом
+     * @param scale_denominator Проверенный знаменатель масштаба
+     * @param result Загруженное изображение
+     * @return FilterResult с результатом операции
+     */
+    FilterResult decodeImage(std::span<const uint8_t> data, const std::string& extension, bool preserve_alpha,
+                             int scale_denominator, ImageLoader::LoadedImage& result)
+    {
+        const int desired_channels = preserve_alpha ? 4 : 3;
+        bool scaled_by_codec = false;
+
+        // Если это BMP, используем наш обработчик
+        if (extension == "bmp")
+        {
+            // BMP хранит RGB; при preserve_alpha строки сразу разворачиваются в RGBA
+            result.data = BMPHandler::loadBMPFromMemory(data.data(), data.size(), result.width, result.height,
+                                                        result.channels, desired_channels);
+            if (result.data == nullptr)
+            {
+                return failLoad(result, FilterError::FileReadError, "Ошибка загрузки BMP изображения",
+                                ErrorContext{});
+            }
+        }
+        else
+        {
+            // Для других форматов используем кодек, выбранный при конфигурации
+            // (libjpeg-turbo для JPEG), или запасной кодек stb
+            const IImageCodec* codec = &ImageCodec::findDecoder(extension);
+            auto decode_result = codec->decode(data, desired_channels, scale_denominator, result);
+            if (!decode_result.isSuccess() && decode_result.error == FilterError::UnsupportedFormat &&
+                codec != &ImageCodec::getFallback())
+            {
+                // Варианты формата без поддержки в основном кодеке (например, CMYK JPEG)
+                codec = &ImageCodec::getFallback();
+                decode_result = codec->decode(data, desired_channels, scale_denominator, result);
+            }
+            if (!decode_result.isSuccess())
+            {
+                return decode_result;
+            }
+            scaled_by_codec = codec->supportsScaledDecode();
+        }
+
+        if (scale_denominator > 1 && !scaled_by_codec)
+        {
+            const auto scale_result = downscaleBox(result, scale_denominator);
+            if (!scale_result.isSuccess())
+            {
+                std::free(result.data);
+                result = ImageLoader::LoadedImage{};
+                return scale_result;
+            }
+        }
+        return FilterResult::success();
+    }
+
+    /**
+     * @brief Декодирует изображение кодеком, выбранным по содержимому данных
+     *
+     * Расширение файла используется, только если сигнатура не распознана:
+     * файл PNG с расширением .jpg декодируется как PNG, а не отвергается кодеком JPEG.
+     *
+     * @param data Закодированные данные
+     * @param extension Расширение файла в нижнем регистре (пустое для данных из памяти)
+     * @param preserve_alpha Сохранять ли альфа-канал
+     * @param scale_denominator Проверенный знаменатель масштаба
+     * @param result Загруженное изображение
+     * @return FilterResult с результатом операции
+     */
+    FilterResult decodeDetected(std::span<const uint8_t> data, const std::string& extension, bool preserve_alpha,
+                                int scale_denominator, ImageLoader::LoadedImage& result)
+    {
+        std::string format = detectFormat(data);
+        if (format.empty())
+        {
+            format = extension;
+        }
+        auto decode_result = decodeImage(data, format, preserve_alpha, scale_denominator, result);
+        if (!decode_result.isSuccess() && format == "bmp")
+        {
+            // Сигнатура "BM" не гарантирует поддерживаемый вариант BMP: пробуем stb
+            decode_result = decodeImage(data, std::string(), preserve_alpha, scale_denominator, result);
+        }
+        return decode_result;
+    }
+}
 
-        // Проверка размера файла перед загрузкой
-        const uint64_t file_size = PathValidator::getFileSize(normalized_path);
-        if (file_size == 0)
+FilterResult ImageLoader::loadFromFile(const std::string& filename, 
+                                       bool preserve_alpha, 
+                                       LoadedImage& result,
+                                       int scale_denominator)
+{
+    try
+    {
+        // Инициализируем результат
+        result = LoadedImage{};
+
+        if (!isValidScale(scale_denominator))
         {
             ErrorContext ctx = ErrorContext::withFilename(filename);
-            return FilterResult::failure(FilterError::FileReadError, 
-                                       "Не удалось определить размер файла", ctx);
+            ctx.withFilterParam("scale_denominator", scale_denominator);
+            return FilterResult::failure(FilterError::InvalidParameter, 
+                                       "Знаменатель масштаба должен быть 1, 2, 4 или 8", ctx);
         }
 
-        if (file_size > PathValidator::DEFAULT_MAX_IMAGE_SIZE)
+        std::string normalized_path;
+        const auto path_result = validateImagePath(filename, normalized_path);
+        if (!path_result.isSuccess())
+        {
+            return path_result;
+        }
+
+        // Файл открывается один раз: размер берется из того же дескриптора,
+        // а декодер читает отображение без повторного открытия
+        MappedFile file;
+        const auto open_result = file.open(normalized_path);
+        if (!open_result.isSuccess())
+        {
+            return open_result;
+        }
+
+        if (file.size() > PathValidator::DEFAULT_MAX_IMAGE_SIZE)
         {
             ErrorContext ctx = ErrorContext::withFilename(filename);
             return FilterResult::failure(FilterError::FileTooLarge, 
                                        "Файл слишком большой (" + 
-                                       std::to_string(file_size) + " байт, максимум " + 
+                                       std::to_string(file.size()) + " байт, максимум " + 
                                        std::to_string(PathValidator::DEFAULT_MAX_IMAGE_SIZE) + ")",
                                        ctx);
         }
+        file.adviseSequential();
 
-        // Проверяем расширение файла для определения формата
-        const auto dot_pos = filename.find_last_of('.');
-        std::string extension;
-        if (dot_pos != std::string::npos && dot_pos < normalized_path.length() - 1)
+        // Формат определяется по сигнатуре; расширение нормализованного пути
+        // используется для нераспознанных сигнатур
+        std::string extension = std::filesystem::path(normalized_path).extension().string();
+        if (!extension.empty())
         {
-            extension = normalized_path.substr(dot_pos + 1);
+            extension.erase(0, 1);
             std::transform(extension.begin(), extension.end(), extension.begin(),
                            [](unsigned char c) { return std::tolower(c); });
         }
-        
-        // Если это BMP файл, используем наш обработчик
-        if (extension == "bmp")
+
+        auto decode_result = decodeDetected(file.bytes(), extension, preserve_alpha, scale_denominator, result);
+        if (!decode_result.isSuccess())
         {
-            int loaded_channels = 0;
-            result.data = BMPHandler::loadBMP(normalized_path, result.width, result.height, loaded_channels);
-            
-            if (result.data == nullptr)
+            // Кодеки не знают имени файла: дополняем контекст ошибки
+            ErrorContext ctx = decode_result.context.value_or(ErrorContext{});
+            if (!ctx.filename.has_value())
             {
-                result.width = 0;
-                result.height = 0;
-                result.channels = 0;
-                ErrorContext ctx = ErrorContext::withFilename(normalized_path);
-                return FilterResult::failure(FilterError::FileReadError, 
-                                           "Ошибка загрузки BMP изображения", ctx);
+                ctx.filename = normalized_path;
             }
-            
-            // BMP всегда загружается как RGB (3 канала)
-            result.channels = 3;
-            
-            // Если нужен RGBA, преобразуем
-            if (preserve_alpha)
-            {
-                // Проверка на переполнение с использованием SafeMath
-                size_t width_height_product = 0;
-                if (!SafeMath::safeMultiply(static_cast<size_t>(result.width), static_cast<size_t>(result.height), width_height_product))
-                {
-                    std::free(result.data);
-                    result.data = nullptr;
-                    result.width = 0;
-                    result.height = 0;
-                    result.channels = 0;
-                    ErrorContext ctx = ErrorContext::withFilename(normalized_path);
-                    ctx.image_width = result.width;
-                    ctx.image_height = result.height;
-                    ctx.image_channels = result.channels;
-                    return FilterResult::failure(FilterError::ArithmeticOverflow, 
-                                               "Размер изображения слишком большой", ctx);
-                }
-                
-                size_t rgba_size = 0;
-                if (!SafeMath::safeMultiply(width_height_product, static_cast<size_t>(4), rgba_size))
-                {
-                    std::free(result.data);
-                    result.data = nullptr;
-                    result.width = 0;
-                    result.height = 0;
-                    result.channels = 0;
-                    ErrorContext ctx = ErrorContext::withFilename(normalized_path);
-                    ctx.image_width = result.width;
-                    ctx.image_height = result.height;
-                    ctx.image_channels = result.channels;
-                    return FilterResult::failure(FilterError::ArithmeticOverflow, 
-                                               "Размер изображения слишком большой", ctx);
-                }
-                
-                auto* rgba_data = static_cast<uint8_t*>(std::malloc(rgba_size));
-                if (rgba_data == nullptr)
-                {
-                    std::free(result.data);
-                    result.data = nullptr;
-                    result.width = 0;
-                    result.height = 0;
-                    result.channels = 0;
-                    const int errno_code = errno;
-                    ErrorContext ctx = ErrorContext::withFilename(normalized_path);
-                    ctx.image_width = result.width;
-                    ctx.image_height = result.height;
-                    ctx.image_channels = result.channels;
-                    if (errno_code != 0)
-                    {
-                        ctx.system_error_code = errno_code;
-                    }
-                    return FilterResult::failure(FilterError::OutOfMemory, 
-                                               "Недостаточно памяти для преобразования RGB в RGBA",
-                                               ctx);
-                }
-                
-                const auto convert_result = ColorSpaceConverter::convertRGBToRGBA(result.data, result.width, result.height, rgba_data);
-                if (!convert_result.isSuccess())
-                {
-                    std::free(rgba_data);
-                    std::free(result.data);
-                    result.data = nullptr;
-                    result.width = 0;
-                    result.height = 0;
-                    result.channels = 0;
-                    return convert_result;
-                }
-                
-                std::free(result.data);
-                result.data = rgba_data;
-                result.channels = 4;
-            }
-            
-            return FilterResult::success();
+            decode_result.context = ctx;
         }
-        
-        // Для других форматов используем STB
-        // STB автоматически определяет формат изображения по расширению файла
-        // stbi_load возвращает указатель на данные или nullptr при ошибке
-        // Последний параметр - желаемое количество каналов:
-        // 0 = как в файле, 3 = RGB, 4 = RGBA
-        const int desired_channels = preserve_alpha ? 4 : 3;
-        int original_channels = 0;
-        result.data = stbi_load(normalized_path.c_str(), &result.width, &result.height, &original_channels,
-                          desired_channels);
+        return decode_result;
+    }
+    catch (const std::bad_alloc& e)
+    {
+        return failLoad(result, FilterError::OutOfMemory, "Недостаточно памяти: " + std::string(e.what()),
+                        ErrorContext::withFilename(filename));
+    }
+    catch (const std::exception& e)
+    {
+        return failLoad(result, FilterError::SystemError, "Исключение: " + std::string(e.what()),
+                        ErrorContext::withFilename(filename));
+    }
+    catch (...)
+    {
+        return failLoad(result, FilterError::SystemError, "Неизвестное исключение",
+                        ErrorContext::withFilename(filename));
+    }
+}
 
-        if (result.data == nullptr)
+FilterResult ImageLoader::loadFromMemory(std::span<const uint8_t> data,
+                                         bool preserve_alpha,
+                                         LoadedImage& result,
+                                         int scale_denominator)
+{
+    try
+    {
+        result = LoadedImage{};
+
+        if (!isValidScale(scale_denominator))
         {
-            const char* stbi_reason = stbi_failure_reason();
-            std::string error_msg = "Ошибка загрузки изображения";
-            if (stbi_reason != nullptr)
-            {
-                error_msg += ": " + std::string(stbi_reason);
-            }
-            
-            // Проверяем системную ошибку (errno)
-            const int errno_code = errno;
-            ErrorContext ctx = ErrorContext::withFilename(normalized_path);
-            if (errno_code != 0)
-            {
-                ctx.system_error_code = errno_code;
-            }
-            
-            return FilterResult::failure(FilterError::FileReadError, error_msg, ctx);
+            ErrorContext ctx;
+            ctx.withFilterParam("scale_denominator", scale_denominator);
+            return FilterResult::failure(FilterError::InvalidParameter,
+                                       "Знаменатель масштаба должен быть 1, 2, 4 или 8", ctx);
         }
 
-        // Валидация загруженных данных
-        if (result.width <= 0 || result.height <= 0)
+        if (data.empty())
         {
-            stbi_image_free(result.data);
-            result.data = nullptr;
-            result.width = 0;
-            result.height = 0;
-            result.channels = 0;
-            ErrorContext ctx = ErrorContext::withFilename(normalized_path);
-            ctx.image_width = result.width;
-            ctx.image_height = result.height;
-            ctx.image_channels = original_channels;
-            return FilterResult::failure(FilterError::InvalidSize, 
-                                       "Некорректный размер изображения", ctx);
+            return FilterResult::failure(FilterError::InvalidSize, "Пустые данные изображения");
         }
 
-        if (original_channels <= 0 || original_channels > 4)
+        if (data.size() > PathValidator::DEFAULT_MAX_IMAGE_SIZE)
         {
-            stbi_image_free(result.data);
-            result.data = nullptr;
-            result.width = 0;
-            result.height = 0;
-            result.channels = 0;
-            ErrorContext ctx = ErrorContext::withFilename(normalized_path);
-            ctx.image_width = result.width;
-            ctx.image_height = result.height;
-            ctx.image_channels = original_channels;
-            return FilterResult::failure(FilterError::InvalidChannels, 
-                                       "Некорректное количество каналов: " + 
-                                       std::to_string(original_channels), ctx);
+            return FilterResult::failure(FilterError::FileTooLarge,
+                                       "Данные слишком большие (" +
+                                       std::to_string(data.size()) + " байт, максимум " +
+                                       std::to_string(PathValidator::DEFAULT_MAX_IMAGE_SIZE) + ")");
         }
 
-        // Устанавливаем количество каналов в зависимости от запроса
-        // Если preserve_alpha = true и файл имеет альфа-канал, будет 4 канала
-        // Если preserve_alpha = false или файл не имеет альфа-канала, будет 3 канала
-        result.channels = desired_channels;
-
-        return FilterResult::success();
+        return decodeDetected(data, std::string(), preserve_alpha, scale_denominator, result);
     }
     catch (const std::bad_alloc& e)
     {
-        if (result.data != nullptr)
-        {
-            stbi_image_free(result.data);
-            result.data = nullptr;
-        }
-        result.width = 0;
-        result.height = 0;
-        result.channels = 0;
-        ErrorContext ctx = ErrorContext::withFilename(filename);
-        return FilterResult::failure(FilterError::OutOfMemory, 
-                                   "Недостаточно памяти: " + std::string(e.what()), ctx);
+        return failLoad(result, FilterError::OutOfMemory, "Недостаточно памяти: " + std::string(e.what()),
+                        ErrorContext{});
     }
     catch (const std::exception& e)
     {
-        if (result.data != nullptr)
-        {
-            stbi_image_free(result.data);
-            result.data = nullptr;
-        }
-        result.width = 0;
-        result.height = 0;
-        result.channels = 0;
-        ErrorContext ctx = ErrorContext::withFilename(filename);
-        return FilterResult::failure(FilterError::SystemError, 
-                                   "Исключение: " + std::string(e.what()), ctx);
+        return failLoad(result, FilterError::SystemError, "Исключение: " + std::string(e.what()), ErrorContext{});
     }
     catch (...)
     {
-        if (result.data != nullptr)
+        return failLoad(result, FilterError::SystemError, "Неизвестное исключение", ErrorContext{});
+    }
+}
+
+FilterResult ImageLoader::probe(const std::string& filename, ImageInfo& info)
+{
+    try
+    {
+        info = ImageInfo{};
+
+        std::string normalized_path;
+        const auto path_result = validateImagePath(filename, normalized_path);
+        if (!path_result.isSuccess())
+        {
+            return path_result;
+        }
+
+        // Без подсказки последовательного чтения: с диска читаются только
+        // страницы, которых касается разбор заголовка
+        MappedFile file;
+        const auto open_result = file.open(normalized_path);
+        if (!open_result.isSuccess())
+        {
+            return open_result;
+        }
+        if (file.empty())
+        {
+            return FilterResult::failure(FilterError::InvalidSize, "Пустой файл изображения",
+                                         ErrorContext::withFilename(normalized_path));
+        }
+
+        auto probe_result = probeImage(file.bytes(), info);
+        if (!probe_result.isSuccess())
         {
-            stbi_image_free(result.data);
-            result.data = nullptr;
+            ErrorContext ctx = probe_result.context.value_or(ErrorContext{});
+            if (!ctx.filename.has_value())
+            {
+                ctx.filename = normalized_path;
+            }
+            probe_result.context = ctx;
         }
-        result.width = 0;
-        result.height = 0;
-        result.channels = 0;
-        ErrorContext ctx = ErrorContext::withFilename(filename);
-        return FilterResult::failure(FilterError::SystemError, 
-                                   "Неизвестное исключение", ctx);
+        return probe_result;
+    }
+    catch (const std::exception& e)
+    {
+        return FilterResult::failure(FilterError::SystemError, "Исключение: " + std::string(e.what()),
+                                     ErrorContext::withFilename(filename));
     }
 }
 
+FilterResult ImageLoader::probeFromMemory(std::span<const uint8_t> data, ImageInfo& info)
+{
+    info = ImageInfo{};
+    if (data.empty())
+    {
+        return FilterResult::failure(FilterError::InvalidSize, "Пустые данные изображения");
+    }
+    return probeImage(data, info);
+}
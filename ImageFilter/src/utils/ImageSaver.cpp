@@ -2,105 +2,74 @@
 #include <utils/PathValidator.h>
 #include <utils/BMPHandler.h>
 #include <utils/FilterResult.h>
+#include <utils/IImageCodec.h>
 #include <utils/SafeMath.h>
 
-#define STB_IMAGE_WRITE_IMPLEMENTATION
-#include <stb_image_write.h>
-
 #include <algorithm>
 #include <cctype>
 #include <cerrno>
-#include <cstdlib>
-#include <cstring>
-#include <memory>
+#include <cstdio>
+#include <new>
 #include <stdexcept>
 
 namespace
 {
     /**
-     * @brief Преобразует RGBA данные в RGB данные для сохранения
-     * @param rgba_data Исходные RGBA данные
-     * @param width Ширина изображения
-     * @param height Высота изображения
-     * @param rgb_data Выходной буфер для RGB данных (должен быть выделен)
-     * @return FilterResult с результатом операции
+     * @brief Проверяет данные, размеры и количество каналов изображения
+     * @param ctx Базовый контекст ошибки (имя файла или пустой)
      */
-    FilterResult convertRGBAToRGBForSave(const uint8_t* rgba_data, 
-                                          int width, 
-                                          int height, 
-                                          uint8_t* rgb_data)
+    FilterResult validateImage(const uint8_t* data, int width, int height, int channels, ErrorContext ctx)
     {
-        size_t width_height_product = 0;
-        if (!SafeMath::safeMultiply(static_cast<size_t>(width), static_cast<size_t>(height), width_height_product))
+        // Валидация данных изображения
+        if (data == nullptr)
         {
-            ErrorContext ctx = ErrorContext::withImage(width, height, 4);
-            return FilterResult::failure(FilterError::ArithmeticOverflow, 
-                                       "Размер изображения слишком большой", ctx);
+            return FilterResult::failure(FilterError::InvalidImage, 
+                                       "Данные изображения не заданы", ctx);
         }
-        
-        for (size_t i = 0; i < width_height_product; ++i)
+
+        ctx.image_width = width;
+        ctx.image_height = height;
+        ctx.image_channels = channels;
+
+        // Валидация размеров изображения
+        if (width <= 0 || height <= 0)
         {
-            size_t rgb_offset = 0;
-            size_t rgba_offset = 0;
-            if (!SafeMath::safeMultiply(i, static_cast<size_t>(3), rgb_offset) ||
-                !SafeMath::safeMultiply(i, static_cast<size_t>(4), rgba_offset))
-            {
-                ErrorContext ctx = ErrorContext::withImage(width, height, 4);
-                return FilterResult::failure(FilterError::ArithmeticOverflow, 
-                                           "Размер изображения слишком большой", ctx);
-            }
-            
-            rgb_data[rgb_offset + 0] = rgba_data[rgba_offset + 0]; // R
-            rgb_data[rgb_offset + 1] = rgba_data[rgba_offset + 1]; // G
-            rgb_data[rgb_offset + 2] = rgba_data[rgba_offset + 2]; // B
+            return FilterResult::failure(FilterError::InvalidSize, 
+                                       "Некорректный размер изображения", ctx);
+        }
+
+        // Валидация каналов изображения
+        if (channels != 3 && channels != 4)
+        {
+            return FilterResult::failure(FilterError::InvalidChannels, 
+                                       "Ожидается 3 канала (RGB) или 4 канала (RGBA), получено: " + std::to_string(channels), ctx);
         }
-        
         return FilterResult::success();
     }
 
     /**
-     * @brief Преобразует RGBA данные в RGB данные построчно (для JPEG)
-     * @param rgba_data Исходные RGBA данные
-     * @param width Ширина изображения
-     * @param height Высота изображения
-     * @param rgb_data Выходной буфер для RGB данных (должен быть выделен)
-     * @return FilterResult с результатом операции
+     * @brief Приводит расширение к нижнему регистру
      */
-    FilterResult convertRGBAToRGBRowByRow(const uint8_t* rgba_data, 
-                                           int width, 
-                                           int height, 
-                                           uint8_t* rgb_data)
+    std::string toLower(std::string extension)
     {
-        for (int y = 0; y < height; ++y)
+        std::transform(extension.begin(), extension.end(), extension.begin(),
+                       [](unsigned char c) { return std::tolower(c); });
+        return extension;
+    }
+
+    /**
+     * @brief Выбирает кодек для формата (кроме BMP)
+     */
+    FilterResult findEncoder(const std::string& extension, const IImageCodec*& codec)
+    {
+        // Форматы кодирует кодек, выбранный при конфигурации
+        // (libjpeg-turbo для JPEG), или запасной кодек stb
+        codec = &ImageCodec::findEncoder(extension);
+        if (!codec->canEncode(extension))
         {
-            for (int x = 0; x < width; ++x)
-            {
-                size_t y_width_sum = 0;
-                size_t pixel_index = 0;
-                if (!SafeMath::safeMultiply(static_cast<size_t>(y), static_cast<size_t>(width), y_width_sum) ||
-                    !SafeMath::safeAdd(y_width_sum, static_cast<size_t>(x), pixel_index))
-                {
-                    ErrorContext ctx = ErrorContext::withImage(width, height, 4);
-                    return FilterResult::failure(FilterError::ArithmeticOverflow, 
-                                               "Размер изображения слишком большой", ctx);
-                }
-                
-                size_t rgba_offset = 0;
-                size_t rgb_offset = 0;
-                if (!SafeMath::safeMultiply(pixel_index, static_cast<size_t>(4), rgba_offset) ||
-                    !SafeMath::safeMultiply(pixel_index, static_cast<size_t>(3), rgb_offset))
-                {
-                    ErrorContext ctx = ErrorContext::withImage(width, height, 4);
-                    return FilterResult::failure(FilterError::ArithmeticOverflow, 
-                                               "Размер изображения слишком большой", ctx);
-                }
-                
-                rgb_data[rgb_offset + 0] = rgba_data[rgba_offset + 0]; // R
-                rgb_data[rgb_offset + 1] = rgba_data[rgba_offset + 1]; // G
-                rgb_data[rgb_offset + 2] = rgba_data[rgba_offset + 2]; // B
-            }
+            return FilterResult::failure(FilterError::UnsupportedFormat, 
+                                       "Неподдерживаемый формат файла: " + extension);
         }
-        
         return FilterResult::success();
     }
 }
@@ -139,34 +108,10 @@ FilterResult ImageSaver::saveToFile(const std::string& filename,
                                        "Небезопасный путь", ctx);
         }
 
-        // Валидация данных изображения
-        if (data == nullptr)
-        {
-            ErrorContext ctx = ErrorContext::withFilename(filename);
-            return FilterResult::failure(FilterError::InvalidImage, 
-                                       "Данные изображения не заданы", ctx);
-        }
-
-        // Валидация размеров изображения
-        if (width <= 0 || height <= 0)
-        {
-            ErrorContext ctx = ErrorContext::withFilename(filename);
-            ctx.image_width = width;
-            ctx.image_height = height;
-            ctx.image_channels = channels;
-            return FilterResult::failure(FilterError::InvalidSize, 
-                                       "Некорректный размер изображения", ctx);
-        }
-
-        // Валидация каналов изображения
-        if (channels != 3 && channels != 4)
+        const auto validation = validateImage(data, width, height, channels, ErrorContext::withFilename(filename));
+        if (!validation.isSuccess())
         {
-            ErrorContext ctx = ErrorContext::withFilename(filename);
-            ctx.image_width = width;
-            ctx.image_height = height;
-            ctx.image_channels = channels;
-            return FilterResult::failure(FilterError::InvalidChannels, 
-                                       "Ожидается 3 канала (RGB) или 4 канала (RGBA), получено: " + std::to_string(channels), ctx);
+            return validation;
         }
 
         // Определяем формат по расширению файла
@@ -178,181 +123,75 @@ FilterResult ImageSaver::saveToFile(const std::string& filename,
                                        "Некорректный путь к файлу (отсутствует расширение)", ctx);
         }
 
-        auto extension = normalized_path.substr(dot_pos + 1);
-
         // Преобразуем расширение в нижний регистр для сравнения
-        std::transform(extension.begin(), extension.end(), extension.begin(),
-                       [](unsigned char c) { return std::tolower(c); });
-        
+        const auto extension = toLower(normalized_path.substr(dot_pos + 1));
+
         // Проверяем поддержку BMP формата
         if (extension == "bmp")
         {
-            // Преобразуем RGBA в RGB, если нужно (BMP не поддерживает альфа-канал)
-            const uint8_t* save_data = data;
-            std::unique_ptr<uint8_t[]> rgb_data_ptr;
-            int save_channels = channels;
-            
-            if (channels == 4)
-            {
-                // Преобразуем RGBA в RGB
-                size_t width_height_product = 0;
-                if (!SafeMath::safeMultiply(static_cast<size_t>(width), static_cast<size_t>(height), width_height_product))
-                {
-                    ErrorContext ctx = ErrorContext::withFilename(normalized_path);
-                    ctx.image_width = width;
-                    ctx.image_height = height;
-                    ctx.image_channels = channels;
-                    return FilterResult::failure(FilterError::ArithmeticOverflow, 
-                                               "Размер изображения слишком большой", ctx);
-                }
-                
-                size_t rgb_size = 0;
-                if (!SafeMath::safeMultiply(width_height_product, static_cast<size_t>(3), rgb_size))
-                {
-                    ErrorContext ctx = ErrorContext::withFilename(normalized_path);
-                    ctx.image_width = width;
-                    ctx.image_height = height;
-                    ctx.image_channels = channels;
-                    return FilterResult::failure(FilterError::ArithmeticOverflow, 
-                                               "Размер изображения слишком большой", ctx);
-                }
-                
-                rgb_data_ptr = std::make_unique<uint8_t[]>(rgb_size);
-                uint8_t* rgb_data = rgb_data_ptr.get();
-                
-                const auto convert_result = convertRGBAToRGBForSave(data, width, height, rgb_data);
-                if (!convert_result.isSuccess())
-                {
-                    return convert_result;
-                }
-                
-                save_data = rgb_data;
-                save_channels = 3;
-            }
-            
-            const bool bmp_result = BMPHandler::saveBMP(normalized_path, width, height, save_channels, save_data);
+            // BMP не поддерживает альфа-канал: RGBA преобразуется в BGR построчно
+            // при записи, без промежуточной полнокадровой копии
+            const bool bmp_result = BMPHandler::saveBMP(normalized_path, width, height, channels, data);
             if (!bmp_result)
             {
                 ErrorContext ctx = ErrorContext::withFilename(normalized_path);
                 ctx.image_width = width;
                 ctx.image_height = height;
-                ctx.image_channels = save_channels;
+                ctx.image_channels = channels;
                 return FilterResult::failure(FilterError::FileWriteError, 
                                            "Ошибка сохранения BMP изображения", ctx);
             }
             return FilterResult::success();
         }
 
-        int result = 0;
-        int save_channels = channels;
-
-        // Если нужно сохранить как RGB, но изображение RGBA, нужно преобразовать
-        if (!preserve_alpha && channels == 4)
+        const IImageCodec* codec = nullptr;
+        auto codec_result = findEncoder(extension, codec);
+        if (!codec_result.isSuccess())
         {
-            // JPEG не поддерживает альфа-канал, всегда используем 3 канала
-            if (extension == "jpg" || extension == "jpeg")
-            {
-                save_channels = 3;
-            }
-        }
-        // Если нужно сохранить альфа-канал, но изображение RGB, используем текущее количество каналов
-        else if (preserve_alpha && channels == 3)
-        {
-            // Изображение RGB, альфа-канал недоступен
-            save_channels = 3;
+            codec_result.context = ErrorContext::withFilename(normalized_path);
+            return codec_result;
         }
 
-        if (extension == "jpg" || extension == "jpeg")
+        std::FILE* file = std::fopen(normalized_path.c_str(), "wb");
+        if (file == nullptr)
         {
-            // JPEG не поддерживает альфа-канал, всегда сохраняем как RGB
-            // Если изображение RGBA, нужно преобразовать
-            if (channels == 4)
-            {
-                // Создаем временный буфер для RGB данных
-                size_t width_height_product = 0;
-                if (!SafeMath::safeMultiply(static_cast<size_t>(width), static_cast<size_t>(height), width_height_product))
-                {
-                    ErrorContext ctx = ErrorContext::withFilename(filename);
-                    ctx.image_width = width;
-                    ctx.image_height = height;
-                    ctx.image_channels = channels;
-                    return FilterResult::failure(FilterError::ArithmeticOverflow, 
-                                               "Размер изображения слишком большой", ctx);
-                }
-                
-                size_t rgb_size = 0;
-                if (!SafeMath::safeMultiply(width_height_product, static_cast<size_t>(3), rgb_size))
-                {
-                    ErrorContext ctx = ErrorContext::withFilename(filename);
-                    ctx.image_width = width;
-                    ctx.image_height = height;
-                    ctx.image_channels = channels;
-                    return FilterResult::failure(FilterError::ArithmeticOverflow, 
-                                               "Размер изображения слишком большой", ctx);
-                }
-                
-                auto* rgb_data = static_cast<uint8_t*>(std::malloc(rgb_size));
-                if (rgb_data == nullptr)
-                {
-                    const int errno_code = errno;
-                    ErrorContext ctx = ErrorContext::withFilename(filename);
-                    ctx.image_width = width;
-                    ctx.image_height = height;
-                    ctx.image_channels = channels;
-                    if (errno_code != 0)
-                    {
-                        ctx.system_error_code = errno_code;
-                    }
-                    return FilterResult::failure(FilterError::OutOfMemory, 
-                                               "Недостаточно памяти для преобразования RGBA в RGB",
-                                               ctx);
-                }
-
-                // Преобразуем RGBA в RGB, игнорируя альфа-канал
-                const auto convert_result = convertRGBAToRGBRowByRow(data, width, height, rgb_data);
-                if (!convert_result.isSuccess())
-                {
-                    std::free(rgb_data);
-                    return convert_result;
-                }
+            ErrorContext ctx = ErrorContext::withFilename(normalized_path);
+            ctx.system_error_code = errno;
+            return FilterResult::failure(FilterError::FileWriteError, "Не удалось создать файл", ctx);
+        }
 
-                result = stbi_write_jpg(normalized_path.c_str(), width, height, 3, rgb_data, jpeg_quality);
-                std::free(rgb_data);
-            }
-            else
+        // Кодек передает байты порциями прямо в файл; errno сохраняется только
+        // при ошибке записи, а не остается от посторонних вызовов кодека
+        int errno_code = 0;
+        const IImageCodec::ByteSink sink = [file, &errno_code](const uint8_t* bytes, size_t size) {
+            if (std::fwrite(bytes, 1, size, file) == size)
             {
-                // Сохраняем как JPEG с настраиваемым качеством (0-100, где 100 - наилучшее качество)
-                result = stbi_write_jpg(normalized_path.c_str(), width, height, 3, data, jpeg_quality);
+                return true;
             }
-        }
-        else if (extension == "png")
+            errno_code = errno;
+            return false;
+        };
+        auto result = codec->encode(sink, extension, data, width, height, channels, preserve_alpha, jpeg_quality);
+        const bool close_failed = std::fclose(file) != 0;
+        if (close_failed && errno_code == 0)
         {
-            // PNG поддерживает альфа-канал
-            // Сохраняем с текущим количеством каналов (3 или 4)
-            // stride_in_bytes = 0 означает автоматический расчет шага (width * channels)
-            result = stbi_write_png(normalized_path.c_str(), width, height, save_channels,
-                                    data, 0);
+            errno_code = errno;
         }
-        else
+        if (result.isSuccess() && close_failed)
         {
-            ErrorContext ctx = ErrorContext::withFilename(normalized_path);
-            return FilterResult::failure(FilterError::UnsupportedFormat, 
-                                       "Неподдерживаемый формат файла: " + extension, ctx);
+            result = FilterResult::failure(FilterError::FileWriteError, "Ошибка записи файла");
         }
-
-        if (result == 0)
+        if (!result.isSuccess())
         {
-            const int errno_code = errno;
-            ErrorContext ctx = ErrorContext::withFilename(normalized_path);
-            if (errno_code != 0)
+            ErrorContext ctx = result.context.value_or(ErrorContext{});
+            ctx.filename = normalized_path;
+            if (errno_code != 0 && !ctx.system_error_code.has_value())
             {
                 ctx.system_error_code = errno_code;
             }
-            return FilterResult::failure(FilterError::FileWriteError, 
-                                       "Ошибка записи файла", ctx);
+            result.context = ctx;
         }
-
-        return FilterResult::success();
+        return result;
     }
     catch (const std::bad_alloc& e)
     {
@@ -374,3 +213,103 @@ FilterResult ImageSaver::saveToFile(const std::string& filename,
     }
 }
 
+FilterResult ImageSaver::saveToMemory(const std::string& format,
+                                      const uint8_t* data,
+                                      int width,
+                                      int height,
+                                      int channels,
+                                      bool preserve_alpha,
+                                      int jpeg_quality,
+                                      std::vector<uint8_t>& output)
+{
+    try
+    {
+        output.clear();
+
+        const auto validation = validateImage(data, width, height, channels, ErrorContext{});
+        if (!validation.isSuccess())
+        {
+            return validation;
+        }
+
+        const auto extension = toLower(!format.empty() && format.front() == '.' ? format.substr(1) : format);
+        // Исключение не должно пройти через кадры C-кодеков: нехватка памяти
+        // превращается в ошибку записи и сообщается после возврата из кодека
+        bool out_of_memory = false;
+        const IImageCodec::ByteSink sink = [&output, &out_of_memory](const uint8_t* bytes, size_t size) {
+            try
+            {
+                output.insert(output.end(), bytes, bytes + size);
+                return true;
+            }
+            catch (const std::bad_alloc&)
+            {
+                out_of_memory = true;
+                return false;
+            }
+        };
+        const auto out_of_memory_failure = [&output]() {
+            output.clear();
+            return FilterResult::failure(FilterError::OutOfMemory,
+                                         "Недостаточно памяти для закодированного изображения");
+        };
+
+        if (extension == "bmp")
+        {
+            // Размер BMP известен заранее: буфер выделяется один раз
+            size_t row_size = 0;
+            size_t file_size = 0;
+            if (SafeMath::safeMultiply(static_cast<size_t>(width), static_cast<size_t>(3), row_size) &&
+                SafeMath::safeMultiply((row_size + 3) / 4 * 4, static_cast<size_t>(height), file_size) &&
+                SafeMath::safeAdd(file_size, static_cast<size_t>(54), file_size))
+            {
+                output.reserve(file_size);
+            }
+            if (!BMPHandler::encodeBMP(width, height, channels, data, sink))
+            {
+                if (out_of_memory)
+                {
+                    return out_of_memory_failure();
+                }
+                output.clear();
+                return FilterResult::failure(FilterError::FileWriteError, "Ошибка кодирования BMP изображения",
+                                           ErrorContext::withImage(width, height, channels));
+            }
+            return FilterResult::success();
+        }
+
+        const IImageCodec* codec = nullptr;
+        auto result = findEncoder(extension, codec);
+        if (result.isSuccess())
+        {
+            result = codec->encode(sink, extension, data, width, height, channels, preserve_alpha, jpeg_quality);
+        }
+        if (out_of_memory)
+        {
+            return out_of_memory_failure();
+        }
+        if (!result.isSuccess())
+        {
+            output.clear();
+        }
+        return result;
+    }
+    catch (const std::bad_alloc& e)
+    {
+        output.clear();
+        return FilterResult::failure(FilterError::OutOfMemory, 
+                                   "Недостаточно памяти: " + std::string(e.what()));
+    }
+    catch (const std::exception& e)
+    {
+        output.clear();
+        return FilterResult::failure(FilterError::SystemError, 
+                                   "Исключение: " + std::string(e.what()));
+    }
+    catch (...)
+    {
+        output.clear();
+        return FilterResult::failure(FilterError::SystemError, 
+                                   "Неизвестное исключение");
+    }
+}
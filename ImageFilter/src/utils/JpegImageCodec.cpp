@@ -0,0 +1,765 @@
+#include <utils/JpegImageCodec.h>
+#include <utils/RowStream.h>
+#include <utils/SafeMath.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <span>
+#include <vector>
+
+#ifdef IMAGEFILTER_HAS_LIBJPEG
+#include <csetjmp>
+extern "C"
+{
+#include <jpeglib.h>
+#include <jerror.h>
+}
+#endif
+
+namespace
+{
+    bool isJpegExtension(const std::string& extension)
+    {
+        return extension == "jpg" || extension == "jpeg";
+    }
+
+    bool isValidScale(int scale_denominator)
+    {
+        return scale_denominator == 1 || scale_denominator == 2 || scale_denominator == 4 ||
+               scale_denominator == 8;
+    }
+
+#ifdef IMAGEFILTER_HAS_LIBJPEG
+    /**
+     * @brief Максимум строк, передаваемых libjpeg за один вызов
+     */
+    constexpr int MAX_SCANLINES_PER_CALL = 16;
+
+    /**
+     * @brief Размер строки в байтах с проверкой переполнения
+     */
+    bool rowBytes(int width, int channels, size_t& result)
+    {
+        return width > 0 && channels > 0 &&
+               SafeMath::safeMultiply(static_cast<size_t>(width), static_cast<size_t>(channels), result);
+    }
+
+    /**
+     * @brief Обработчик ошибок libjpeg: сохраняет сообщение и возвращает управление через longjmp
+     */
+    struct JpegErrorManager
+    {
+        jpeg_error_mgr base;
+        std::jmp_buf jump;
+        char message[JMSG_LENGTH_MAX];
+    };
+
+    void jpegErrorExit(j_common_ptr info)
+    {
+        auto* manager = reinterpret_cast<JpegErrorManager*>(info->err);
+        (*info->err->format_message)(info, manager->message);
+        std::longjmp(manager->jump, 1);
+    }
+
+    void jpegOutputMessage(j_common_ptr)
+    {
+        // Предупреждения libjpeg не выводятся в stderr
+    }
+
+    void initErrorManager(JpegErrorManager& manager)
+    {
+        jpeg_std_error(&manager.base);
+        manager.base.error_exit = jpegErrorExit;
+        manager.base.output_message = jpegOutputMessage;
+        manager.message[0] = '\0';
+    }
+
+    /**
+     * @brief Построчный декодер JPEG
+     *
+     * Между вызовами readRows() в памяти находится только состояние декодера.
+     * С расширениями libjpeg-turbo декодер сам выдает RGB или RGBA для любого
+     * источника; без них градации серого и альфа добавляются через одну строку.
+     *
+     * @note Код после setjmp не создает объектов с нетривиальным деструктором
+     * до возможного вызова libjpeg, поэтому longjmp не пропускает деструкторы.
+     */
+    class JpegRowReader final : public IRowReader
+    {
+    public:
+        JpegRowReader()
+        {
+            initErrorManager(error_);
+            decoder_.err = &error_.base;
+        }
+
+        ~JpegRowReader() override
+        {
+            if (created_)
+            {
+                jpeg_destroy_decompress(&decoder_);
+            }
+            if (file_ != nullptr)
+            {
+                std::fclose(file_);
+            }
+        }
+
+        JpegRowReader(const JpegRowReader&) = delete;
+        JpegRowReader& operator=(const JpegRowReader&) = delete;
+
+        /**
+         * @brief Открывает JPEG файл
+         */
+        FilterResult open(const std::string& path, bool preserve_alpha, int scale_denominator)
+        {
+            path_ = path;
+            file_ = std::fopen(path.c_str(), "rb");
+            if (file_ == nullptr)
+            {
+                return FilterResult::failure(FilterError::FileReadError, "Не удалось открыть файл",
+                                             ErrorContext::withFilename(path));
+            }
+            return start(preserve_alpha, scale_denominator);
+        }
+
+        /**
+         * @brief Открывает JPEG в памяти (данные не копируются и должны жить до конца чтения)
+         */
+        FilterResult open(std::span<const uint8_t> data, bool preserve_alpha, int scale_denominator)
+        {
+#if defined(MEM_SRCDST_SUPPORTED) || JPEG_LIB_VERSION >= 80
+            if (data.empty())
+            {
+                return FilterResult::failure(FilterError::InvalidSize, "Пустые данные изображения");
+            }
+            memory_ = data;
+            return start(preserve_alpha, scale_denominator);
+#else
+            (void)data;
+            (void)preserve_alpha;
+            (void)scale_denominator;
+            return FilterResult::failure(FilterError::UnsupportedFormat, "libjpeg собрана без jpeg_mem_src");
+#endif
+        }
+
+        int getWidth() const noexcept override { return width_; }
+        int getHeight() const noexcept override { return height_; }
+        int getChannels() const noexcept override { return channels_; }
+
+        FilterResult readRows(uint8_t* destination, int count) override
+        {
+            if (count < 0 || count > height_ - static_cast<int>(decoder_.output_scanline))
+            {
+                return FilterResult::failure(FilterError::InvalidParameter, "Запрошено больше строк, чем осталось",
+                                             errorContext());
+            }
+
+            if (setjmp(error_.jump) != 0)
+            {
+                return FilterResult::failure(FilterError::CorruptedImage,
+                                             std::string("Ошибка декодирования JPEG: ") + error_.message,
+                                             errorContext());
+            }
+
+            int done = 0;
+            while (done < count)
+            {
+                if (row_.empty())
+                {
+                    // Строки декодируются прямо в буфер назначения порциями
+                    JSAMPROW rows[MAX_SCANLINES_PER_CALL];
+                    const int batch = std::min(count - done, MAX_SCANLINES_PER_CALL);
+                    for (int i = 0; i < batch; ++i)
+                    {
+                        rows[i] = destination + static_cast<size_t>(done + i) * row_bytes_;
+                    }
+                    done += static_cast<int>(jpeg_read_scanlines(&decoder_, rows, static_cast<JDIMENSION>(batch)));
+                    continue;
+                }
+
+                JSAMPROW row = row_.data();
+                jpeg_read_scanlines(&decoder_, &row, 1);
+                expandRow(destination + static_cast<size_t>(done) * row_bytes_);
+                ++done;
+            }
+
+            if (static_cast<int>(decoder_.output_scanline) == height_)
+            {
+                jpeg_finish_decompress(&decoder_);
+            }
+            return FilterResult::success();
+        }
+
+    private:
+        /**
+         * @brief Контекст ошибки: имя файла, если чтение идет из файла
+         */
+        ErrorContext errorContext() const
+        {
+            return path_.empty() ? ErrorContext{} : ErrorContext::withFilename(path_);
+        }
+
+        /**
+         * @brief Читает заголовок из открытого источника и запускает декодер
+         */
+        FilterResult start(bool preserve_alpha, int scale_denominator)
+        {
+            if (setjmp(error_.jump) != 0)
+            {
+                return FilterResult::failure(FilterError::CorruptedImage,
+                                             std::string("Ошибка декодирования JPEG: ") + error_.message,
+                                             errorContext());
+            }
+
+            jpeg_create_decompress(&decoder_);
+            created_ = true;
+            if (file_ != nullptr)
+            {
+                jpeg_stdio_src(&decoder_, file_);
+            }
+            else
+            {
+#if defined(MEM_SRCDST_SUPPORTED) || JPEG_LIB_VERSION >= 80
+                // Декодер читает прямо из отображения файла или буфера вызывающего кода
+                jpeg_mem_src(&decoder_, const_cast<unsigned char*>(memory_.data()),
+                             static_cast<unsigned long>(memory_.size()));
+#endif
+            }
+            jpeg_read_header(&decoder_, TRUE);
+
+            if (decoder_.jpeg_color_space == JCS_CMYK || decoder_.jpeg_color_space == JCS_YCCK)
+            {
+                return FilterResult::failure(FilterError::UnsupportedFormat, "CMYK JPEG не поддерживается",
+                                             errorContext());
+            }
+
+            // Уменьшение в области DCT: декодер вычисляет обратное DCT размера 8 / scale
+            decoder_.scale_num = 1;
+            decoder_.scale_denom = static_cast<unsigned int>(scale_denominator);
+
+            channels_ = preserve_alpha ? 4 : 3;
+#ifdef JCS_ALPHA_EXTENSIONS
+            source_channels_ = channels_;
+            decoder_.out_color_space = channels_ == 4 ? JCS_EXT_RGBA : JCS_RGB;
+#else
+            source_channels_ = decoder_.num_components == 1 ? 1 : 3;
+            decoder_.out_color_space = source_channels_ == 1 ? JCS_GRAYSCALE : JCS_RGB;
+#endif
+            jpeg_start_decompress(&decoder_);
+
+            width_ = static_cast<int>(decoder_.output_width);
+            height_ = static_cast<int>(decoder_.output_height);
+            if (!rowBytes(width_, channels_, row_bytes_) || height_ <= 0)
+            {
+                return FilterResult::failure(FilterError::InvalidSize, "Некорректный размер изображения",
+                                             ErrorContext::withImage(width_, height_, channels_));
+            }
+            if (source_channels_ != channels_)
+            {
+                row_.resize(static_cast<size_t>(width_) * static_cast<size_t>(source_channels_));
+            }
+            return FilterResult::success();
+        }
+
+        /**
+         * @brief Расширяет строку декодера до channels_ каналов
+         */
+        void expandRow(uint8_t* output) const noexcept
+        {
+            for (int x = 0; x < width_; ++x)
+            {
+                auto* pixel = output + static_cast<size_t>(x) * static_cast<size_t>(channels_);
+                if (source_channels_ == 1)
+                {
+                    const auto gray = row_[static_cast<size_t>(x)];
+                    pixel[0] = gray;
+                    pixel[1] = gray;
+                    pixel[2] = gray;
+                }
+                else
+                {
+                    const auto* source = row_.data() + static_cast<size_t>(x) * 3;
+                    pixel[0] = source[0];
+                    pixel[1] = source[1];
+                    pixel[2] = source[2];
+                }
+                if (channels_ == 4)
+                {
+                    pixel[3] = 255;
+                }
+            }
+        }
+
+        jpeg_decompress_struct decoder_{};
+        JpegErrorManager error_{};
+        std::FILE* file_ = nullptr;
+        std::span<const uint8_t> memory_;
+        std::string path_;
+        std::vector<uint8_t> row_;   // Строка декодера, если ее формат отличается от выходного
+        size_t row_bytes_ = 0;
+        int width_ = 0;
+        int height_ = 0;
+        int channels_ = 0;
+        int source_channels_ = 0;
+        bool created_ = false;
+    };
+
+    /**
+     * @brief Размер буфера, которым кодер отдает байты приемнику
+     */
+    constexpr size_t OUTPUT_BUFFER_BYTES = 64 * 1024;
+
+    /**
+     * @brief Приемник libjpeg, передающий закодированные байты в IImageCodec::ByteSink
+     */
+    struct JpegSinkDestination
+    {
+        jpeg_destination_mgr base;
+        const IImageCodec::ByteSink* sink;
+        uint8_t* buffer;
+    };
+
+    void jpegInitDestination(j_compress_ptr encoder)
+    {
+        auto* destination = reinterpret_cast<JpegSinkDestination*>(encoder->dest);
+        destination->base.next_output_byte = destination->buffer;
+        destination->base.free_in_buffer = OUTPUT_BUFFER_BYTES;
+    }
+
+    boolean jpegEmptyOutputBuffer(j_compress_ptr encoder)
+    {
+        auto* destination = reinterpret_cast<JpegSinkDestination*>(encoder->dest);
+        if (!(*destination->sink)(destination->buffer, OUTPUT_BUFFER_BYTES))
+        {
+            ERREXIT(encoder, JERR_FILE_WRITE);
+        }
+        jpegInitDestination(encoder);
+        return TRUE;
+    }
+
+    void jpegTermDestination(j_compress_ptr encoder)
+    {
+        auto* destination = reinterpret_cast<JpegSinkDestination*>(encoder->dest);
+        const size_t remaining = OUTPUT_BUFFER_BYTES - destination->base.free_in_buffer;
+        if (remaining > 0 && !(*destination->sink)(destination->buffer, remaining))
+        {
+            ERREXIT(encoder, JERR_FILE_WRITE);
+        }
+    }
+
+    /**
+     * @brief Построчный кодер JPEG
+     *
+     * Закодированные байты передаются приемнику порциями по OUTPUT_BUFFER_BYTES:
+     * в файл (построчная запись RowStream) или в память (ImageSaver::saveToMemory).
+     * С расширениями libjpeg-turbo строки RGBA передаются кодеру напрямую
+     * (альфа пропускается как JCS_EXT_RGBA), иначе - через буфер одной строки.
+     */
+    class JpegRowWriter final : public IRowWriter
+    {
+    public:
+        /**
+         * @brief Кодер в файл (создается в begin())
+         */
+        JpegRowWriter(std::string path, int quality)
+            : path_(std::move(path)), quality_(std::clamp(quality, 0, 100))
+        {
+            initErrorManager(error_);
+            encoder_.err = &error_.base;
+            file_sink_ = [this](const uint8_t* bytes, size_t size) {
+                return std::fwrite(bytes, 1, size, file_) == size;
+            };
+            sink_ = &file_sink_;
+        }
+
+        /**
+         * @brief Кодер в приемник байтов (приемник должен жить до finish())
+         */
+        JpegRowWriter(const IImageCodec::ByteSink& sink, int quality)
+            : sink_(&sink), quality_(std::clamp(quality, 0, 100))
+        {
+            initErrorManager(error_);
+            encoder_.err = &error_.base;
+        }
+
+        ~JpegRowWriter() override
+        {
+            if (created_)
+            {
+                jpeg_destroy_compress(&encoder_);
+            }
+            if (file_ != nullptr)
+            {
+                std::fclose(file_);
+            }
+        }
+
+        JpegRowWriter(const JpegRowWriter&) = delete;
+        JpegRowWriter& operator=(const JpegRowWriter&) = delete;
+
+        FilterResult begin(int width, int height, int channels) override
+        {
+            if (!rowBytes(width, channels, row_bytes_) || height <= 0 || (channels != 3 && channels != 4))
+            {
+                return FilterResult::failure(FilterError::InvalidSize, "Некорректный размер изображения",
+                                             ErrorContext::withImage(width, height, channels));
+            }
+            width_ = width;
+            channels_ = channels;
+#ifndef JCS_ALPHA_EXTENSIONS
+            if (channels_ == 4)
+            {
+                row_.resize(static_cast<size_t>(width) * 3);
+            }
+#endif
+            output_.resize(OUTPUT_BUFFER_BYTES);
+
+            if (!path_.empty())
+            {
+                file_ = std::fopen(path_.c_str(), "wb");
+                if (file_ == nullptr)
+                {
+                    return FilterResult::failure(FilterError::FileWriteError, "Не удалось создать файл",
+                                                 ErrorContext::withFilename(path_));
+                }
+            }
+
+            if (setjmp(error_.jump) != 0)
+            {
+                return failure();
+            }
+
+            jpeg_create_compress(&encoder_);
+            created_ = true;
+            destination_.base.init_destination = jpegInitDestination;
+            destination_.base.empty_output_buffer = jpegEmptyOutputBuffer;
+            destination_.base.term_destination = jpegTermDestination;
+            destination_.sink = sink_;
+            destination_.buffer = output_.data();
+            encoder_.dest = &destination_.base;
+            encoder_.image_width = static_cast<JDIMENSION>(width);
+            encoder_.image_height = static_cast<JDIMENSION>(height);
+#ifdef JCS_ALPHA_EXTENSIONS
+            encoder_.input_components = channels_;
+            encoder_.in_color_space = channels_ == 4 ? JCS_EXT_RGBA : JCS_RGB;
+#else
+            encoder_.input_components = 3;
+            encoder_.in_color_space = JCS_RGB;
+#endif
+            jpeg_set_defaults(&encoder_);
+            jpeg_set_quality(&encoder_, quality_, TRUE);
+            jpeg_start_compress(&encoder_, TRUE);
+            return FilterResult::success();
+        }
+
+        FilterResult writeRows(const uint8_t* source, int count) override
+        {
+            if (setjmp(error_.jump) != 0)
+            {
+                return failure();
+            }
+
+            int done = 0;
+            while (done < count)
+            {
+                if (row_.empty())
+                {
+                    JSAMPROW rows[MAX_SCANLINES_PER_CALL];
+                    const int batch = std::min(count - done, MAX_SCANLINES_PER_CALL);
+                    for (int i = 0; i < batch; ++i)
+                    {
+                        rows[i] = const_cast<JSAMPROW>(source + static_cast<size_t>(done + i) * row_bytes_);
+                    }
+                    done += static_cast<int>(jpeg_write_scanlines(&encoder_, rows, static_cast<JDIMENSION>(batch)));
+                    continue;
+                }
+
+                const auto* input = source + static_cast<size_t>(done) * row_bytes_;
+                for (int x = 0; x < width_; ++x)
+                {
+                    std::memcpy(row_.data() + static_cast<size_t>(x) * 3, input + static_cast<size_t>(x) * 4, 3);
+                }
+                JSAMPROW row = row_.data();
+                jpeg_write_scanlines(&encoder_, &row, 1);
+                ++done;
+            }
+            return FilterResult::success();
+        }
+
+        FilterResult finish() override
+        {
+            if (setjmp(error_.jump) != 0)
+            {
+                return failure();
+            }
+
+            jpeg_finish_compress(&encoder_);
+            if (file_ != nullptr)
+            {
+                const bool write_failed = std::fclose(file_) != 0;
+                file_ = nullptr;
+                if (write_failed)
+                {
+                    return FilterResult::failure(FilterError::FileWriteError, "Ошибка записи файла",
+                                                 ErrorContext::withFilename(path_));
+                }
+            }
+            return FilterResult::success();
+        }
+
+    private:
+        FilterResult failure() const
+        {
+            return FilterResult::failure(FilterError::FileWriteError,
+                                         std::string("Ошибка кодирования JPEG: ") + error_.message,
+                                         path_.empty() ? ErrorContext{} : ErrorContext::withFilename(path_));
+        }
+
+        jpeg_compress_struct encoder_{};
+        JpegErrorManager error_{};
+        JpegSinkDestination destination_{};
+        std::FILE* file_ = nullptr;
+        std::string path_;
+        IImageCodec::ByteSink file_sink_;
+        const IImageCodec::ByteSink* sink_ = nullptr;
+        std::vector<uint8_t> output_; // Буфер закодированных байтов перед передачей приемнику
+        std::vector<uint8_t> row_;    // Строка без альфа-канала для RGBA входа (без расширений turbo)
+        size_t row_bytes_ = 0;
+        int width_ = 0;
+        int channels_ = 0;
+        int quality_;
+        bool created_ = false;
+    };
+
+#if defined(MEM_SRCDST_SUPPORTED) || JPEG_LIB_VERSION >= 80
+    /**
+     * @brief Читает только заголовок JPEG (маркеры до SOF) без запуска декодера
+     *
+     * @note Между setjmp и вызовами libjpeg не создаются объекты с
+     * нетривиальным деструктором.
+     */
+    FilterResult readJpegHeader(std::span<const uint8_t> data, ImageLoader::ImageInfo& info)
+    {
+        JpegErrorManager error;
+        initErrorManager(error);
+        jpeg_decompress_struct decoder{};
+        decoder.err = &error.base;
+        jpeg_create_decompress(&decoder);
+
+        if (setjmp(error.jump) != 0)
+        {
+            jpeg_destroy_decompress(&decoder);
+            return FilterResult::failure(FilterError::CorruptedImage,
+                                         std::string("Ошибка чтения заголовка JPEG: ") + error.message);
+        }
+
+        jpeg_mem_src(&decoder, const_cast<unsigned char*>(data.data()), static_cast<unsigned long>(data.size()));
+        jpeg_read_header(&decoder, TRUE);
+        info.width = static_cast<int>(decoder.image_width);
+        info.height = static_cast<int>(decoder.image_height);
+        info.channels = decoder.num_components;
+        jpeg_destroy_decompress(&decoder);
+
+        if (info.width <= 0 || info.height <= 0 || info.channels <= 0 || info.channels > 4)
+        {
+            return FilterResult::failure(FilterError::InvalidSize, "Некорректный заголовок изображения",
+                                         ErrorContext::withImage(info.width, info.height, info.channels));
+        }
+        return FilterResult::success();
+    }
+#endif
+#endif
+
+#ifndef IMAGEFILTER_HAS_LIBJPEG
+    FilterResult unavailable(const std::string& path)
+    {
+        return FilterResult::failure(FilterError::UnsupportedFormat, "Библиотека собрана без кодека libjpeg",
+                                     path.empty() ? ErrorContext{} : ErrorContext::withFilename(path));
+    }
+#endif
+}
+
+const char* JpegImageCodec::getName() const noexcept
+{
+#ifdef IMAGEFILTER_JPEG_IS_TURBO
+    return "libjpeg-turbo";
+#else
+    return "libjpeg";
+#endif
+}
+
+bool JpegImageCodec::canDecode(const std::string& extension) const noexcept
+{
+    return isAvailable() && isJpegExtension(extension);
+}
+
+bool JpegImageCodec::canEncode(const std::string& extension) const noexcept
+{
+    return isAvailable() && isJpegExtension(extension);
+}
+
+bool JpegImageCodec::supportsScaledDecode() const noexcept
+{
+    return isAvailable();
+}
+
+bool JpegImageCodec::isAvailable() noexcept
+{
+#ifdef IMAGEFILTER_HAS_LIBJPEG
+    return true;
+#else
+    return false;
+#endif
+}
+
+JpegImageCodec& JpegImageCodec::getInstance() noexcept
+{
+    static JpegImageCodec instance;
+    return instance;
+}
+
+FilterResult JpegImageCodec::openRowReader(const std::string& path, bool preserve_alpha, int scale_denominator,
+                                           std::unique_ptr<IRowReader>& reader)
+{
+    reader.reset();
+    if (!isValidScale(scale_denominator))
+    {
+        ErrorContext ctx = ErrorContext::withFilename(path);
+        ctx.withFilterParam("scale_denominator", scale_denominator);
+        return FilterResult::failure(FilterError::InvalidParameter,
+                                     "Знаменатель масштаба должен быть 1, 2, 4 или 8", ctx);
+    }
+
+#ifdef IMAGEFILTER_HAS_LIBJPEG
+    auto jpeg_reader = std::make_unique<JpegRowReader>();
+    auto result = jpeg_reader->open(path, preserve_alpha, scale_denominator);
+    if (result.isSuccess())
+    {
+        reader = std::move(jpeg_reader);
+    }
+    return result;
+#else
+    (void)preserve_alpha;
+    return unavailable(path);
+#endif
+}
+
+FilterResult JpegImageCodec::createRowWriter(const std::string& path, int jpeg_quality,
+                                             std::unique_ptr<IRowWriter>& writer)
+{
+    writer.reset();
+#ifdef IMAGEFILTER_HAS_LIBJPEG
+    writer = std::make_unique<JpegRowWriter>(path, jpeg_quality);
+    return FilterResult::success();
+#else
+    (void)jpeg_quality;
+    return unavailable(path);
+#endif
+}
+
+FilterResult JpegImageCodec::decode(std::span<const uint8_t> data, int desired_channels, int scale_denominator,
+                                    ImageLoader::LoadedImage& result) const
+{
+    if (!isValidScale(scale_denominator))
+    {
+        ErrorContext ctx;
+        ctx.withFilterParam("scale_denominator", scale_denominator);
+        return FilterResult::failure(FilterError::InvalidParameter,
+                                     "Знаменатель масштаба должен быть 1, 2, 4 или 8", ctx);
+    }
+
+#ifdef IMAGEFILTER_HAS_LIBJPEG
+    JpegRowReader reader;
+    auto open_result = reader.open(data, desired_channels == 4, scale_denominator);
+    if (!open_result.isSuccess())
+    {
+        return open_result;
+    }
+
+    size_t frame_size = 0;
+    if (!SafeMath::safeMultiply(static_cast<size_t>(reader.getWidth()), static_cast<size_t>(reader.getHeight()),
+                                frame_size) ||
+        !SafeMath::safeMultiply(frame_size, static_cast<size_t>(reader.getChannels()), frame_size))
+    {
+        return FilterResult::failure(FilterError::ArithmeticOverflow, "Размер изображения слишком большой",
+                                     ErrorContext::withImage(reader.getWidth(), reader.getHeight(),
+                                                             reader.getChannels()));
+    }
+
+    auto* pixels = static_cast<uint8_t*>(std::malloc(frame_size));
+    if (pixels == nullptr)
+    {
+        return FilterResult::failure(FilterError::OutOfMemory, "Недостаточно памяти для изображения",
+                                     ErrorContext::withImage(reader.getWidth(), reader.getHeight(),
+                                                             reader.getChannels()));
+    }
+
+    auto read_result = reader.readRows(pixels, reader.getHeight());
+    if (!read_result.isSuccess())
+    {
+        std::free(pixels);
+        return read_result;
+    }
+
+    result.data = pixels;
+    result.width = reader.getWidth();
+    result.height = reader.getHeight();
+    result.channels = reader.getChannels();
+    return FilterResult::success();
+#else
+    (void)data;
+    (void)desired_channels;
+    (void)result;
+    return unavailable(std::string());
+#endif
+}
+
+FilterResult JpegImageCodec::probe(std::span<const uint8_t> data, ImageLoader::ImageInfo& info) const
+{
+#if defined(IMAGEFILTER_HAS_LIBJPEG) && (defined(MEM_SRCDST_SUPPORTED) || JPEG_LIB_VERSION >= 80)
+    if (data.empty())
+    {
+        return FilterResult::failure(FilterError::InvalidSize, "Пустые данные изображения");
+    }
+    return readJpegHeader(data, info);
+#else
+    // Заголовок прочитает запасной кодек stb
+    (void)data;
+    (void)info;
+    return unavailable(std::string());
+#endif
+}
+
+FilterResult JpegImageCodec::encode(const ByteSink& sink, const std::string& extension, const uint8_t* data,
+                                    int width, int height, int channels, bool preserve_alpha,
+                                    int jpeg_quality) const
+{
+    // JPEG не поддерживает альфа-канал: RGBA кодируется как RGB
+    (void)extension;
+    (void)preserve_alpha;
+
+#ifdef IMAGEFILTER_HAS_LIBJPEG
+    JpegRowWriter writer(sink, jpeg_quality);
+    auto result = writer.begin(width, height, channels);
+    if (result.isSuccess())
+    {
+        result = writer.writeRows(data, height);
+    }
+    if (result.isSuccess())
+    {
+        result = writer.finish();
+    }
+    return result;
+#else
+    (void)sink;
+    (void)data;
+    (void)width;
+    (void)height;
+    (void)channels;
+    (void)jpeg_quality;
+    return unavailable(std::string());
+#endif
+}
@@ -46,6 +46,16 @@ namespace {
         static bool quiet = false;
         return quiet;
     }
+
+    /**
+     * @brief Получает ссылку на флаг вывода всех сообщений в stderr
+     * @return Ссылка на флаг
+     */
+    bool& getStderrOnly() noexcept
+    {
+        static bool stderr_only = false;
+        return stderr_only;
+    }
 }
 
 void Logger::setLevel(LogLevel level) noexcept
@@ -58,6 +68,11 @@ void Logger::setQuiet(bool quiet) noexcept
     getQuiet() = quiet;
 }
 
+void Logger::setStderrOnly(bool stderr_only) noexcept
+{
+    getStderrOnly() = stderr_only;
+}
+
 LogLevel Logger::getLevel() noexcept
 {
     return getMinLevel();
@@ -79,7 +94,7 @@ void Logger::log(LogLevel level, const std::string& message)
     const auto time = std::chrono::system_clock::to_time_t(now);
     const auto tm = *std::localtime(&time);
 
-    std::ostream& stream = (level >= LogLevel::ERROR) ? std::cerr : std::cout;
+    std::ostream& stream = (level >= LogLevel::ERROR || getStderrOnly()) ? std::cerr : std::cout;
 
     stream << "[" << std::put_time(&tm, "%Y-%m-%d %H:%M:%S") << "] "
            << "[" << levelToString(level) << "] "
@@ -1,5 +1,6 @@
+#include <array>
+#include <bit>
 #include <cmath>
-#include <mutex>
 #include <numbers>
 #include <utils/LookupTables.h>
 #include <utils/CacheManager.h>
@@ -14,172 +15,236 @@ constexpr double EXP_TABLE_STEP = 0.01;
 constexpr double EXP_TABLE_MAX = 20.0;
 
 /**
- * @brief Нормализует угол в диапазон [0, 360)
- * @param angle_degrees Угол в градусах
- * @return Нормализованный угол
+ * @brief Вычисляет sin(x) для |x| <= pi/4 рядом Тейлора (constexpr)
+ * @param x Аргумент в радианах
+ * @return Значение sin(x)
  */
-int normalizeAngle(int angle_degrees) noexcept {
-    // Нормализуем угол в диапазон [0, 360)
-    angle_degrees %= 360;
-    if (angle_degrees < 0) {
-        angle_degrees += 360;
+constexpr long double taylorSin(long double x) noexcept {
+    const auto x2 = x * x;
+    long double term = x;
+    long double sum = x;
+    for (int n = 1; n <= 12; ++n) {
+        term *= -x2 / static_cast<long double>((2 * n) * (2 * n + 1));
+        sum += term;
     }
-    return angle_degrees;
+    return sum;
 }
 
 /**
- * @brief Получает ссылку на таблицу sin (масштабированная)
- * Использует локальную статическую переменную для избежания exit-time destructors
- * @return Ссылка на таблицу sin (масштабированная)
+ * @brief Вычисляет cos(x) для |x| <= pi/4 рядом Тейлора (constexpr)
+ * @param x Аргумент в радианах
+ * @return Значение cos(x)
  */
-std::array<int32_t, SIN_COS_TABLE_SIZE>& getSinTableScaled() noexcept {
-    static std::array<int32_t, SIN_COS_TABLE_SIZE> table{};
-    return table;
+constexpr long double taylorCos(long double x) noexcept {
+    const auto x2 = x * x;
+    long double term = 1.0L;
+    long double sum = 1.0L;
+    for (int n = 1; n <= 12; ++n) {
+        term *= -x2 / static_cast<long double>((2 * n - 1) * (2 * n));
+        sum += term;
+    }
+    return sum;
 }
 
 /**
- * @brief Получает ссылку на таблицу cos (масштабированная)
- * Использует локальную статическую переменную для избежания exit-time destructors
- * @return Ссылка на таблицу cos (масштабированная)
+ * @brief Вычисляет sin угла в целых градусах (constexpr)
+ *
+ * Угол приводится к октанту [0, 45] градусов по формулам приведения,
+ * в котором ряд Тейлора быстро сходится. Вычисление ведется в long double,
+ * поэтому значения для "точных" углов (30, 60, 90, ...) симметричны
+ * и совпадают с точными (например, sin(30) == 0.5).
+ *
+ * @param degrees Угол в градусах [0, 360)
+ * @return Значение sin
  */
-std::array<int32_t, SIN_COS_TABLE_SIZE>& getCosTableScaled() noexcept {
-    static std::array<int32_t, SIN_COS_TABLE_SIZE> table{};
-    return table;
+constexpr double sinDegrees(int degrees) noexcept {
+    const int quadrant = degrees / 90;
+    const int within = degrees % 90;
+
+    // sin или cos угла within (0..89) через октант [0, 45]
+    const auto reduced = [](int angle, bool want_sin) {
+        if (angle <= 45) {
+            const auto rad = static_cast<long double>(angle) * std::numbers::pi_v<long double> / 180.0L;
+            return want_sin ? taylorSin(rad) : taylorCos(rad);
+        }
+        const auto rad = static_cast<long double>(90 - angle) * std::numbers::pi_v<long double> / 180.0L;
+        return want_sin ? taylorCos(rad) : taylorSin(rad);
+    };
+
+    switch (quadrant) {
+        case 0: return static_cast<double>(reduced(within, true));
+        case 1: return static_cast<double>(reduced(within, false));
+        case 2: return static_cast<double>(-reduced(within, true));
+        default: return static_cast<double>(-reduced(within, false));
+    }
 }
 
 /**
- * @brief Получает ссылку на таблицу sin (double)
- * Использует локальную статическую переменную для избежания exit-time destructors
- * @return Ссылка на таблицу sin (double)
+ * @brief Вычисляет exp(-x) для x >= 0 (constexpr)
+ *
+ * exp(-x) = exp(-1)^n * exp(-f), где n - целая часть x, f из [0, 1).
+ *
+ * @param x Аргумент
+ * @return Значение exp(-x)
  */
-std::array<double, SIN_COS_TABLE_SIZE>& getSinTable() noexcept {
-    static std::array<double, SIN_COS_TABLE_SIZE> table{};
-    return table;
+constexpr double expNegativeConstexpr(double x) noexcept {
+    const auto whole = static_cast<int>(x);
+    const auto fraction = static_cast<long double>(x) - static_cast<long double>(whole);
+
+    long double term = 1.0L;
+    long double sum = 1.0L;
+    for (int n = 1; n <= 25; ++n) {
+        term *= -fraction / static_cast<long double>(n);
+        sum += term;
+    }
+
+    constexpr long double inv_e = 1.0L / std::numbers::e_v<long double>;
+    for (int i = 0; i < whole; ++i) {
+        sum *= inv_e;
+    }
+    return static_cast<double>(sum);
 }
 
 /**
- * @brief Получает ссылку на таблицу cos (double)
- * Использует локальную статическую переменную для избежания exit-time destructors
- * @return Ссылка на таблицу cos (double)
+ * @brief Точная невязка c * c - x (constexpr)
+ *
+ * Разбиение Вельткампа представляет c * c суммой точных произведений,
+ * что позволяет сравнивать соседние кандидаты в корни.
+ *
+ * @param c Кандидат в корень
+ * @param x Аргумент
+ * @return Значение c * c - x
  */
-std::array<double, SIN_COS_TABLE_SIZE>& getCosTable() noexcept {
-    static std::array<double, SIN_COS_TABLE_SIZE> table{};
-    return table;
+constexpr double sqrtResidual(double c, double x) noexcept {
+    constexpr double VELTKAMP_SPLIT = 134217729.0;  // 2^27 + 1
+    const auto t = VELTKAMP_SPLIT * c;
+    const auto hi = t - (t - c);
+    const auto lo = c - hi;
+    return ((hi * hi - x) + 2.0 * hi * lo) + lo * lo;
 }
 
 /**
- * @brief Получает ссылку на таблицу exp(-x)
- * Использует локальную статическую переменную для избежания exit-time destructors
- * @return Ссылка на таблицу exp(-x)
+ * @brief Вычисляет sqrt(x) методом Ньютона (constexpr)
+ *
+ * Результат итераций уточняется выбором ближайшего к корню среди
+ * соседних значений double, поэтому совпадает с корректно округленным std::sqrt.
+ *
+ * @param x Аргумент (>= 0)
+ * @return Значение sqrt(x)
  */
-std::array<double, EXP_TABLE_SIZE>& getExpNegativeTable() noexcept {
-    static std::array<double, EXP_TABLE_SIZE> table{};
-    return table;
+constexpr double sqrtConstexpr(double x) noexcept {
+    if (x <= 0.0) {
+        return 0.0;
+    }
+
+    double y = x >= 1.0 ? x : 1.0;
+    for (int i = 0; i < 64; ++i) {
+        const auto next = 0.5 * (y + x / y);
+        if (next == y) {
+            break;
+        }
+        y = next;
+    }
+
+    const auto bits = std::bit_cast<uint64_t>(y);
+    double best = y;
+    double best_residual = sqrtResidual(y, x);
+    for (const auto candidate : {std::bit_cast<double>(bits - 1), std::bit_cast<double>(bits + 1)}) {
+        const auto residual = sqrtResidual(candidate, x);
+        if ((residual < 0.0 ? -residual : residual) < (best_residual < 0.0 ? -best_residual : best_residual)) {
+            best = candidate;
+            best_residual = residual;
+        }
+    }
+    return best;
 }
 
 /**
- * @brief Получает ссылку на таблицу sqrt (double)
- * Использует локальную статическую переменную для избежания exit-time destructors
- * @return Ссылка на таблицу sqrt (double)
+ * @brief Нормализует угол в диапазон [0, 360)
+ * @param angle_degrees Угол в градусах
+ * @return Нормализованный угол
  */
-std::array<double, SQRT_TABLE_SIZE>& getSqrtTable() noexcept {
-    static std::array<double, SQRT_TABLE_SIZE> table{};
-    return table;
+int normalizeAngle(int angle_degrees) noexcept {
+    // Нормализуем угол в диапазон [0, 360)
+    angle_degrees %= 360;
+    if (angle_degrees < 0) {
+        angle_degrees += 360;
+    }
+    return angle_degrees;
 }
 
 /**
- * @brief Получает ссылку на таблицу sqrt (масштабированная)
- * Использует локальную статическую переменную для избежания exit-time destructors
- * @return Ссылка на таблицу sqrt (масштабированная)
+ * @brief Таблицы sin/cos (double и масштабированные на 65536)
  */
-std::array<int32_t, SQRT_TABLE_SIZE>& getSqrtTableScaled() noexcept {
-    static std::array<int32_t, SQRT_TABLE_SIZE> table{};
-    return table;
-}
+struct SinCosTables {
+    std::array<double, SIN_COS_TABLE_SIZE> sin{};
+    std::array<double, SIN_COS_TABLE_SIZE> cos{};
+    std::array<int32_t, SIN_COS_TABLE_SIZE> sin_scaled{};
+    std::array<int32_t, SIN_COS_TABLE_SIZE> cos_scaled{};
+};
 
 /**
- * @brief Получает ссылку на флаг инициализации
- * Использует локальную статическую переменную для избежания exit-time destructors
- * @return Ссылка на флаг инициализации
+ * @brief Таблицы sqrt (double и масштабированная на 65536)
  */
-bool& getInitialized() noexcept {
-    static bool initialized = false;
-    return initialized;
+struct SqrtTables {
+    std::array<double, SQRT_TABLE_SIZE> value{};
+    std::array<int32_t, SQRT_TABLE_SIZE> scaled{};
+};
+
+constexpr SinCosTables makeSinCosTables() noexcept {
+    SinCosTables tables;
+    for (int i = 0; i < SIN_COS_TABLE_SIZE; ++i) {
+        const auto index = static_cast<size_t>(i);
+        tables.sin[index] = sinDegrees(i);
+        tables.cos[index] = sinDegrees((i + 90) % 360);
+        tables.sin_scaled[index] = static_cast<int32_t>(tables.sin[index] * 65536.0);
+        tables.cos_scaled[index] = static_cast<int32_t>(tables.cos[index] * 65536.0);
+    }
+    return tables;
 }
-} // namespace
-
-void LookupTables::initialize() {
-    static std::once_flag flag;
-    std::call_once(flag, []() {
-        auto& sin_table = getSinTable();
-        auto& cos_table = getCosTable();
-        auto& sin_table_scaled = getSinTableScaled();
-        auto& cos_table_scaled = getCosTableScaled();
-        auto& exp_negative_table = getExpNegativeTable();
-        auto& sqrt_table = getSqrtTable();
-        auto& sqrt_table_scaled = getSqrtTableScaled();
-
-        // Инициализация таблиц sin/cos
-        for (int i = 0; i < SIN_COS_TABLE_SIZE; ++i) {
-            const auto angle_rad = static_cast<double>(i) * std::numbers::pi / 180.0;
-            sin_table[static_cast<size_t>(i)] = std::sin(angle_rad);
-            cos_table[static_cast<size_t>(i)] = std::cos(angle_rad);
-            sin_table_scaled[static_cast<size_t>(i)] =
-                static_cast<int32_t>(sin_table[static_cast<size_t>(i)] * 65536.0);
-            cos_table_scaled[static_cast<size_t>(i)] =
-                static_cast<int32_t>(cos_table[static_cast<size_t>(i)] * 65536.0);
-        }
-
-        // Инициализация таблицы exp(-x)
-        for (int i = 0; i < EXP_TABLE_SIZE; ++i) {
-            const auto x = static_cast<double>(i) * EXP_TABLE_STEP;
-            exp_negative_table[static_cast<size_t>(i)] = std::exp(-x);
-        }
 
-        // Инициализация таблицы sqrt
-        for (int i = 0; i < SQRT_TABLE_SIZE; ++i) {
-            sqrt_table[static_cast<size_t>(i)] = std::sqrt(static_cast<double>(i));
-            sqrt_table_scaled[static_cast<size_t>(i)] =
-                static_cast<int32_t>(sqrt_table[static_cast<size_t>(i)] * 65536.0);
-        }
+constexpr std::array<double, EXP_TABLE_SIZE> makeExpNegativeTable() noexcept {
+    std::array<double, EXP_TABLE_SIZE> table{};
+    for (int i = 0; i < EXP_TABLE_SIZE; ++i) {
+        table[static_cast<size_t>(i)] = expNegativeConstexpr(static_cast<double>(i) * EXP_TABLE_STEP);
+    }
+    return table;
+}
 
-        getInitialized() = true;
-    });
+constexpr SqrtTables makeSqrtTables() noexcept {
+    SqrtTables tables;
+    for (int i = 0; i < SQRT_TABLE_SIZE; ++i) {
+        const auto index = static_cast<size_t>(i);
+        tables.value[index] = sqrtConstexpr(static_cast<double>(i));
+        tables.scaled[index] = static_cast<int32_t>(tables.value[index] * 65536.0);
+    }
+    return tables;
 }
 
+// Таблицы вычисляются при компиляции и размещаются в секции только для чтения:
+// нет инициализации во время выполнения и проверок флага на горячем пути
+constexpr SinCosTables SIN_COS_TABLES = makeSinCosTables();
+constexpr std::array<double, EXP_TABLE_SIZE> EXP_NEGATIVE_TABLE = makeExpNegativeTable();
+constexpr SqrtTables SQRT_TABLES = makeSqrtTables();
+} // namespace
+
 int32_t LookupTables::sinScaled(int angle_degrees) noexcept {
-    if (!getInitialized()) {
-        initialize();
-    }
-    return getSinTableScaled()[static_cast<size_t>(normalizeAngle(angle_degrees))];
+    return SIN_COS_TABLES.sin_scaled[static_cast<size_t>(normalizeAngle(angle_degrees))];
 }
 
 int32_t LookupTables::cosScaled(int angle_degrees) noexcept {
-    if (!getInitialized()) {
-        initialize();
-    }
-    return getCosTableScaled()[static_cast<size_t>(normalizeAngle(angle_degrees))];
+    return SIN_COS_TABLES.cos_scaled[static_cast<size_t>(normalizeAngle(angle_degrees))];
 }
 
 double LookupTables::sin(int angle_degrees) noexcept {
-    if (!getInitialized()) {
-        initialize();
-    }
-    return getSinTable()[static_cast<size_t>(normalizeAngle(angle_degrees))];
+    return SIN_COS_TABLES.sin[static_cast<size_t>(normalizeAngle(angle_degrees))];
 }
 
 double LookupTables::cos(int angle_degrees) noexcept {
-    if (!getInitialized()) {
-        initialize();
-    }
-    return getCosTable()[static_cast<size_t>(normalizeAngle(angle_degrees))];
+    return SIN_COS_TABLES.cos[static_cast<size_t>(normalizeAngle(angle_degrees))];
 }
 
 double LookupTables::expNegative(double x) noexcept {
-    if (!getInitialized()) {
-        initialize();
-    }
-
     if (x < 0.0) {
         // Для отрицательных значений возвращаем exp(x) = 1/exp(-x)
         return 1.0 / expNegative(-x);
@@ -190,33 +255,27 @@ double LookupTables::expNegative(double x) noexcept {
         return 0.0;
     }
 
-    auto& exp_negative_table = getExpNegativeTable();
-
     // Линейная интерполяция между ближайшими значениями в таблице
     const auto index = x / EXP_TABLE_STEP;
     const auto index_low = static_cast<int>(index);
     const auto index_high = index_low + 1;
 
     if (index_high >= EXP_TABLE_SIZE) {
-        return exp_negative_table[EXP_TABLE_SIZE - 1];
+        return EXP_NEGATIVE_TABLE[EXP_TABLE_SIZE - 1];
     }
 
     const auto t = index - static_cast<double>(index_low);
-    return exp_negative_table[static_cast<size_t>(index_low)] * (1.0 - t) +
-           exp_negative_table[static_cast<size_t>(index_high)] * t;
+    return EXP_NEGATIVE_TABLE[static_cast<size_t>(index_low)] * (1.0 - t) +
+           EXP_NEGATIVE_TABLE[static_cast<size_t>(index_high)] * t;
 }
 
 double LookupTables::sqrtInt(int x) noexcept {
-    if (!getInitialized()) {
-        initialize();
-    }
-
     if (x < 0) {
         return 0.0;
     }
 
     if (x < SQRT_TABLE_SIZE) {
-        return getSqrtTable()[static_cast<size_t>(x)];
+        return SQRT_TABLES.value[static_cast<size_t>(x)];
     }
 
     // Для значений вне таблицы используем std::sqrt
@@ -224,23 +283,19 @@ double LookupTables::sqrtInt(int x) noexcept {
 }
 
 int32_t LookupTables::sqrtIntScaled(int x) noexcept {
-    if (!getInitialized()) {
-        initialize();
-    }
-
     if (x < 0) {
         return 0;
     }
 
     if (x < SQRT_TABLE_SIZE) {
-        return getSqrtTableScaled()[static_cast<size_t>(x)];
+        return SQRT_TABLES.scaled[static_cast<size_t>(x)];
     }
 
     // Для значений вне таблицы вычисляем и масштабируем
     return static_cast<int32_t>(std::sqrt(static_cast<double>(x)) * 65536.0);
 }
 
-std::vector<uint8_t> LookupTables::getGammaLUT(double gamma) noexcept
+std::shared_ptr<const std::vector<uint8_t>> LookupTables::getGammaLUT(double gamma) noexcept
 {
     if (gamma <= 0.0)
     {
@@ -252,9 +307,10 @@ std::vector<uint8_t> LookupTables::getGammaLUT(double gamma) noexcept
     key.parameter = gamma;
     
     auto& cache_manager = CacheManager::getInstance();
-    return cache_manager.getOrGenerateLUT(key, [gamma]() {
+    return cache_manager.getOrGenerateLUT(key, [](const LUTCacheKey& cache_key) {
         std::vector<uint8_t> lut(256);
-        const double inv_gamma = 1.0 / gamma;
+        // Квантование ключа не должно приводить к нулевой гамме
+        const double inv_gamma = cache_key.parameter > 0.0 ? 1.0 / cache_key.parameter : 1.0;
         for (int i = 0; i < 256; ++i)
         {
             const double normalized = static_cast<double>(i) / 255.0;
@@ -266,7 +322,7 @@ std::vector<uint8_t> LookupTables::getGammaLUT(double gamma) noexcept
     });
 }
 
-std::vector<uint8_t> LookupTables::getBrightnessLUT(double brightness) noexcept
+std::shared_ptr<const std::vector<uint8_t>> LookupTables::getBrightnessLUT(double brightness) noexcept
 {
     // Ограничиваем диапазон [-1.0, 1.0]
     brightness = std::max(-1.0, std::min(1.0, brightness));
@@ -276,9 +332,9 @@ std::vector<uint8_t> LookupTables::getBrightnessLUT(double brightness) noexcept
     key.parameter = brightness;
     
     auto& cache_manager = CacheManager::getInstance();
-    return cache_manager.getOrGenerateLUT(key, [brightness]() {
+    return cache_manager.getOrGenerateLUT(key, [](const LUTCacheKey& cache_key) {
         std::vector<uint8_t> lut(256);
-        const double factor = 1.0 + brightness;
+        const double factor = 1.0 + cache_key.parameter;
         for (int i = 0; i < 256; ++i)
         {
             const double value = static_cast<double>(i) * factor;
@@ -289,7 +345,7 @@ std::vector<uint8_t> LookupTables::getBrightnessLUT(double brightness) noexcept
     });
 }
 
-std::vector<uint8_t> LookupTables::getContrastLUT(double contrast) noexcept
+std::shared_ptr<const std::vector<uint8_t>> LookupTables::getContrastLUT(double contrast) noexcept
 {
     // Ограничиваем диапазон [-1.0, 1.0]
     contrast = std::max(-1.0, std::min(1.0, contrast));
@@ -299,10 +355,11 @@ std::vector<uint8_t> LookupTables::getContrastLUT(double contrast) noexcept
     key.parameter = contrast;
     
     auto& cache_manager = CacheManager::getInstance();
-    return cache_manager.getOrGenerateLUT(key, [contrast]() {
+    return cache_manager.getOrGenerateLUT(key, [](const LUTCacheKey& cache_key) {
         std::vector<uint8_t> lut(256);
         // Преобразуем контраст из [-1, 1] в множитель
-        const double factor = (1.0 + contrast) / (1.0 - contrast);
+        const double contrast_value = cache_key.parameter;
+        const double factor = (1.0 + contrast_value) / (1.0 - contrast_value);
         const double offset = 128.0 * (1.0 - factor);
         
         for (int i = 0; i < 256; ++i)
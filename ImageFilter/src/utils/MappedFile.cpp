@@ -0,0 +1,142 @@
+#include <utils/MappedFile.h>
+
+#include <cerrno>
+#include <fstream>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define IMAGEFILTER_HAS_MMAP 1
+#else
+#define IMAGEFILTER_HAS_MMAP 0
+#endif
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr))
+    , size_(std::exchange(other.size_, 0))
+    , buffer_(std::move(other.buffer_))
+    , mapped_(std::exchange(other.mapped_, false))
+{
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other)
+    {
+        close();
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+        buffer_ = std::move(other.buffer_);
+        mapped_ = std::exchange(other.mapped_, false);
+    }
+    return *this;
+}
+
+void MappedFile::close() noexcept
+{
+#if IMAGEFILTER_HAS_MMAP
+    if (mapped_ && data_ != nullptr)
+    {
+        munmap(const_cast<uint8_t*>(data_), size_);
+    }
+#endif
+    data_ = nullptr;
+    size_ = 0;
+    buffer_.clear();
+    buffer_.shrink_to_fit();
+    mapped_ = false;
+}
+
+FilterResult MappedFile::open(const std::string& path, bool read_fallback)
+{
+    close();
+
+#if IMAGEFILTER_HAS_MMAP
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        ErrorContext ctx = ErrorContext::withFilename(path);
+        ctx.system_error_code = errno;
+        return FilterResult::failure(FilterError::FileReadError, "Не удалось открыть файл", ctx);
+    }
+
+    struct stat file_stat{};
+    if (fstat(fd, &file_stat) != 0 || !S_ISREG(file_stat.st_mode) || file_stat.st_size <= 0)
+    {
+        ::close(fd);
+        return FilterResult::failure(FilterError::FileReadError, "Не удалось определить размер файла",
+                                     ErrorContext::withFilename(path));
+    }
+
+    const auto file_size = static_cast<size_t>(file_stat.st_size);
+    void* mapping = mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping != MAP_FAILED)
+    {
+        data_ = static_cast<const uint8_t*>(mapping);
+        size_ = file_size;
+        mapped_ = true;
+        return FilterResult::success();
+    }
+#endif
+
+    if (!read_fallback)
+    {
+        return FilterResult::failure(FilterError::FileReadError, "Не удалось отобразить файл в память",
+                                     ErrorContext::withFilename(path));
+    }
+
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open())
+    {
+        return FilterResult::failure(FilterError::FileReadError, "Не удалось открыть файл",
+                                     ErrorContext::withFilename(path));
+    }
+    const auto end_position = file.tellg();
+    if (end_position <= 0)
+    {
+        return FilterResult::failure(FilterError::FileReadError, "Не удалось определить размер файла",
+                                     ErrorContext::withFilename(path));
+    }
+
+    buffer_.resize(static_cast<size_t>(end_position));
+    file.seekg(0, std::ios::beg);
+    file.read(reinterpret_cast<char*>(buffer_.data()), static_cast<std::streamsize>(buffer_.size()));
+    if (!file.good())
+    {
+        buffer_.clear();
+        return FilterResult::failure(FilterError::FileReadError, "Ошибка чтения файла",
+                                     ErrorContext::withFilename(path));
+    }
+    data_ = buffer_.data();
+    size_ = buffer_.size();
+    return FilterResult::success();
+}
+
+void MappedFile::prefetch() const noexcept
+{
+#if IMAGEFILTER_HAS_MMAP
+    if (mapped_)
+    {
+        madvise(const_cast<uint8_t*>(data_), size_, MADV_WILLNEED);
+    }
+#endif
+}
+
+void MappedFile::adviseSequential() const noexcept
+{
+#if IMAGEFILTER_HAS_MMAP
+    if (mapped_)
+    {
+        madvise(const_cast<uint8_t*>(data_), size_, MADV_SEQUENTIAL);
+    }
+#endif
+}
@@ -1,6 +1,8 @@
 #include <utils/ParallelImageProcessor.h>
+#include <utils/ConcurrencyGovernor.h>
 #include <utils/ThreadPool.h>
 #include <utils/IThreadPool.h>
+#include <atomic>
 #include <thread>
 #include <memory>
 #include <algorithm>
@@ -9,6 +11,11 @@
 
 namespace
 {
+    /**
+     * @brief Количество потоков, заданное setThreadCountOverride() (0 = не задано)
+     */
+    std::atomic<int> thread_count_override{0};
+
     /**
      * @brief Обертка для вызова processRowRange с захваченными значениями
      * 
@@ -32,81 +39,105 @@ void ParallelImageProcessor::processRowsParallel(
     int num_threads
 )
 {
-    if (height <= 0 || width <= 0)
-    {
-        return;
-    }
-
-    // Адаптивный выбор: определяем, нужна ли параллельная обработка
-    if (!shouldUseParallelProcessing(width, height))
+    const auto ranges = splitRows(height, width, num_threads);
+    if (ranges.empty())
     {
-        // Маленькие изображения обрабатываем последовательно
-        processRowRange(0, height);
         return;
     }
 
-    // Получаем адаптивное количество потоков
-    const auto adaptive_threads = getAdaptiveThreadCount(width, height, num_threads);
-
-    // Если только один поток, обрабатываем последовательно
-    if (adaptive_threads == 1 || height < adaptive_threads)
+    // Одна полоса: маленькое изображение или один поток, обрабатываем последовательно
+    if (ranges.size() == 1)
     {
-        processRowRange(0, height);
+        processRowRange(ranges.front().first, ranges.front().second);
         return;
     }
 
     // Используем переданный thread_pool или создаем локальный
     std::unique_ptr<ThreadPool> local_pool;
+    ConcurrencyGovernor::Lease row_lease;
     IThreadPool* pool = thread_pool;
     if (pool == nullptr)
     {
-        // Создаем локальный пул потоков для этого вызова
-        const int pool_threads = (adaptive_threads > 0) ? adaptive_threads : getOptimalThreadCount();
-        local_pool = std::make_unique<ThreadPool>(pool_threads);
+        // Размер локального пула ограничен свободной частью общего бюджета потоков:
+        // если бюджет занят потоками уровня файлов, полосы обрабатываются последовательно.
+        // Разбиение на полосы при этом не меняется (см. splitRows())
+        const auto adaptive_threads = getAdaptiveThreadCount(width, height, num_threads);
+        const int requested_threads = std::min(static_cast<int>(ranges.size()),
+                                               (adaptive_threads > 0) ? adaptive_threads : getOptimalThreadCount());
+        row_lease = ConcurrencyGovernor::getInstance().acquireRowThreads(requested_threads);
+        if (row_lease.getThreads() <= 1)
+        {
+            for (const auto& [start_row, end_row] : ranges)
+            {
+                processRowRange(start_row, end_row);
+            }
+            return;
+        }
+
+        local_pool = std::make_unique<ThreadPool>(row_lease.getThreads());
         pool = local_pool.get();
     }
 
+    for (const auto& [start_row, end_row] : ranges)
+    {
+        // Добавляем задачу в ThreadPool для переиспользования потоков
+        // Захватываем все переменные явно по значению, включая processRowRange
+        // для безопасности при асинхронном выполнении
+        pool->enqueue([start_row = start_row, end_row = end_row, processRowRange]() {
+            callProcessRowRange(start_row, end_row, processRowRange);
+        });
+    }
+
+    // Ждем завершения всех задач
+    pool->waitAll();
+}
+
+std::vector<std::pair<int, int>> ParallelImageProcessor::splitRows(int height, int width, int num_threads)
+{
+    std::vector<std::pair<int, int>> ranges;
+    if (height <= 0 || width <= 0)
+    {
+        return ranges;
+    }
+
+    // Адаптивный выбор: маленькие изображения обрабатываются одной полосой
+    if (!shouldUseParallelProcessing(width, height))
+    {
+        ranges.emplace_back(0, height);
+        return ranges;
+    }
+
+    // Получаем адаптивное количество потоков
+    const auto adaptive_threads = getAdaptiveThreadCount(width, height, num_threads);
+
+    // Если только один поток, вся высота - одна полоса
+    if (adaptive_threads == 1 || height < adaptive_threads)
+    {
+        ranges.emplace_back(0, height);
+        return ranges;
+    }
+
     // Вычисляем базовое количество строк на поток и остаток
     // Остаток распределяем по первым потокам, чтобы все строки были обработаны
     const int base_rows_per_thread = height / adaptive_threads;
     const int remainder = height % adaptive_threads;
 
-    // Создаем задачи для каждого потока
-    // Первые remainder потоков получают на одну строку больше
+    ranges.reserve(static_cast<size_t>(adaptive_threads));
     for (int i = 0; i < adaptive_threads; ++i)
     {
-        // Вычисляем начало диапазона для текущего потока
-        int start_row = i * base_rows_per_thread + std::min(i, remainder);
-        // Вычисляем конец диапазона
-        int end_row = start_row + base_rows_per_thread;
-        // Первые remainder потоков получают дополнительную строку
-        if (i < remainder)
-        {
-            end_row += 1;
-        }
-        
-        // Проверяем, что диапазон не выходит за границы
+        // Первые remainder полос получают на одну строку больше
+        const int start_row = i * base_rows_per_thread + std::min(i, remainder);
+        const int end_row = std::min(height, start_row + base_rows_per_thread + (i < remainder ? 1 : 0));
+
         if (start_row >= height)
         {
             break;  // Больше нет строк для обработки
         }
-        
-        // Ограничиваем end_row высотой изображения
-        if (end_row > height)
-        {
-            end_row = height;
-        }
-        
-        // Добавляем задачу в ThreadPool для переиспользования потоков
-        // Захватываем все переменные явно по значению, включая processRowRange
-        // для безопасности при асинхронном выполнении
-        pool->enqueue([start_row, end_row, processRowRange]() {
-            callProcessRowRange(start_row, end_row, processRowRange);
-        });
+
+        ranges.emplace_back(start_row, end_row);
     }
 
-    // Ждем завершения всех задач
-    pool->waitAll();
+    return ranges;
 }
 
 void ParallelImageProcessor::processRowsParallel(
@@ -124,6 +155,12 @@ void ParallelImageProcessor::processRowsParallel(
 
 int ParallelImageProcessor::getOptimalThreadCount() noexcept
 {
+    const auto override_threads = thread_count_override.load(std::memory_order_relaxed);
+    if (override_threads > 0)
+    {
+        return override_threads;
+    }
+
     const auto hardware_threads = static_cast<int>(std::thread::hardware_concurrency());
     
     // Если не удалось определить, используем 1 поток
@@ -135,6 +172,11 @@ int ParallelImageProcessor::getOptimalThreadCount() noexcept
     return hardware_threads;
 }
 
+void ParallelImageProcessor::setThreadCountOverride(int num_threads) noexcept
+{
+    thread_count_override.store(std::max(0, num_threads), std::memory_order_relaxed);
+}
+
 bool ParallelImageProcessor::shouldUseParallelProcessing(int width, int height) noexcept
 {
     const auto image_size = static_cast<int64_t>(width) * height;
@@ -0,0 +1,339 @@
+#include <utils/RowStream.h>
+#include <ImageProcessor.h>
+#include <utils/BMPHandler.h>
+#include <utils/ImageBuffer.h>
+#include <utils/JpegImageCodec.h>
+#include <utils/PathValidator.h>
+#include <utils/SafeMath.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+namespace
+{
+    /**
+     * @brief Возвращает расширение файла в нижнем регистре
+     */
+    std::string getExtension(const std::string& filename)
+    {
+        const auto dot_pos = filename.find_last_of('.');
+        if (dot_pos == std::string::npos || dot_pos == filename.length() - 1)
+        {
+            return {};
+        }
+        std::string extension = filename.substr(dot_pos + 1);
+        std::transform(extension.begin(), extension.end(), extension.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return extension;
+    }
+
+    /**
+     * @brief Проверяет путь так же, как ImageLoader и ImageSaver
+     * @param filename Путь к файлу
+     * @param normalized_path Нормализованный путь (выходной параметр)
+     */
+    FilterResult validatePath(const std::string& filename, std::string& normalized_path)
+    {
+        if (filename.empty())
+        {
+            return FilterResult::failure(FilterError::InvalidFilePath, "Путь к файлу пуст",
+                                         ErrorContext::withFilename(filename));
+        }
+        if (PathValidator::containsDangerousCharacters(filename))
+        {
+            return FilterResult::failure(FilterError::InvalidFilePath, "Путь содержит опасные символы",
+                                         ErrorContext::withFilename(filename));
+        }
+        normalized_path = PathValidator::normalizeAndValidate(filename);
+        if (normalized_path.empty())
+        {
+            return FilterResult::failure(FilterError::InvalidFilePath, "Небезопасный путь",
+                                         ErrorContext::withFilename(filename));
+        }
+        return FilterResult::success();
+    }
+
+    /**
+     * @brief Размер строки в байтах с проверкой переполнения
+     */
+    bool rowBytes(int width, int channels, size_t& result)
+    {
+        return width > 0 && channels > 0 &&
+               SafeMath::safeMultiply(static_cast<size_t>(width), static_cast<size_t>(channels), result);
+    }
+
+    /**
+     * @brief Полнокадровый источник строк поверх ImageProcessor::loadFromFile
+     */
+    class ImageRowReader final : public IRowReader
+    {
+    public:
+        FilterResult open(const std::string& filename, bool preserve_alpha)
+        {
+            auto result = image_.loadFromFile(filename, preserve_alpha);
+            if (result.isSuccess() && !rowBytes(image_.getWidth(), image_.getChannels(), row_bytes_))
+            {
+                return FilterResult::failure(FilterError::ArithmeticOverflow, "Размер изображения слишком большой",
+                                             ErrorContext::withImage(image_.getWidth(), image_.getHeight(),
+                                                                     image_.getChannels()));
+            }
+            return result;
+        }
+
+        int getWidth() const noexcept override { return image_.getWidth(); }
+        int getHeight() const noexcept override { return image_.getHeight(); }
+        int getChannels() const noexcept override { return image_.getChannels(); }
+
+        FilterResult readRows(uint8_t* destination, int count) override
+        {
+            if (count < 0 || count > image_.getHeight() - next_row_)
+            {
+                return FilterResult::failure(FilterError::InvalidParameter, "Запрошено больше строк, чем осталось",
+                                             ErrorContext::withImage(getWidth(), getHeight(), getChannels()));
+            }
+            std::memcpy(destination, image_.getData() + static_cast<size_t>(next_row_) * row_bytes_,
+                        static_cast<size_t>(count) * row_bytes_);
+            next_row_ += count;
+            return FilterResult::success();
+        }
+
+    private:
+        ImageProcessor image_;
+        size_t row_bytes_ = 0;
+        int next_row_ = 0;
+    };
+
+    /**
+     * @brief Полнокадровый приемник строк поверх ImageProcessor::saveToFile
+     */
+    class ImageRowWriter final : public IRowWriter
+    {
+    public:
+        ImageRowWriter(std::string filename, bool preserve_alpha, int jpeg_quality)
+            : filename_(std::move(filename)), preserve_alpha_(preserve_alpha), jpeg_quality_(jpeg_quality)
+        {
+        }
+
+        FilterResult begin(int width, int height, int channels) override
+        {
+            size_t frame_size = 0;
+            if (!rowBytes(width, channels, row_bytes_) || height <= 0 ||
+                !SafeMath::safeMultiply(row_bytes_, static_cast<size_t>(height), frame_size))
+            {
+                return FilterResult::failure(FilterError::InvalidSize, "Некорректный размер изображения",
+                                             ErrorContext::withImage(width, height, channels));
+            }
+            image_.setJpegQuality(jpeg_quality_);
+            return image_.adopt(width, height, channels, ImageBuffer::allocate(frame_size, image_.getAllocator()));
+        }
+
+        FilterResult writeRows(const uint8_t* source, int count) override
+        {
+            if (count < 0 || count > image_.getHeight() - next_row_)
+            {
+                return FilterResult::failure(FilterError::InvalidParameter, "Записано больше строк, чем высота изображения",
+                                             ErrorContext::withFilename(filename_));
+            }
+            std::memcpy(image_.getData() + static_cast<size_t>(next_row_) * row_bytes_, source,
+                        static_cast<size_t>(count) * row_bytes_);
+            next_row_ += count;
+            return FilterResult::success();
+        }
+
+        FilterResult finish() override
+        {
+            return image_.saveToFile(filename_, preserve_alpha_ && image_.hasAlpha());
+        }
+
+    private:
+        ImageProcessor image_;
+        std::string filename_;
+        size_t row_bytes_ = 0;
+        int next_row_ = 0;
+        bool preserve_alpha_;
+        int jpeg_quality_;
+    };
+
+    /**
+     * @brief Построчный источник строк BMP поверх BMPHandler::BMPReader
+     */
+    class BmpRowReader final : public IRowReader
+    {
+    public:
+        FilterResult open(const std::string& filename, bool preserve_alpha)
+        {
+            if (!reader_.open(filename))
+            {
+                return FilterResult::failure(FilterError::FileReadError, "Ошибка загрузки BMP изображения",
+                                             ErrorContext::withFilename(filename));
+            }
+            channels_ = preserve_alpha ? 4 : 3;
+            return FilterResult::success();
+        }
+
+        int getWidth() const noexcept override { return reader_.getWidth(); }
+        int getHeight() const noexcept override { return reader_.getHeight(); }
+        int getChannels() const noexcept override { return channels_; }
+
+        FilterResult readRows(uint8_t* destination, int count) override
+        {
+            if (!reader_.readRows(destination, count, channels_))
+            {
+                return FilterResult::failure(FilterError::FileReadError, "Ошибка чтения строк BMP изображения",
+                                             ErrorContext::withImage(getWidth(), getHeight(), channels_));
+            }
+            return FilterResult::success();
+        }
+
+    private:
+        BMPHandler::BMPReader reader_;
+        int channels_ = 3;
+    };
+
+    /**
+     * @brief Построчный приемник строк BMP поверх BMPHandler::BMPWriter
+     */
+    class BmpRowWriter final : public IRowWriter
+    {
+    public:
+        explicit BmpRowWriter(std::string filename) : filename_(std::move(filename))
+        {
+        }
+
+        FilterResult begin(int width, int height, int channels) override
+        {
+            if (!writer_.open(filename_, width, height))
+            {
+                ErrorContext ctx = ErrorContext::withFilename(filename_);
+                ctx.image_width = width;
+                ctx.image_height = height;
+                ctx.image_channels = channels;
+                return FilterResult::failure(FilterError::FileWriteError, "Ошибка сохранения BMP изображения", ctx);
+            }
+            channels_ = channels;
+            return FilterResult::success();
+        }
+
+        FilterResult writeRows(const uint8_t* source, int count) override
+        {
+            if (!writer_.writeRows(source, count, channels_))
+            {
+                return FilterResult::failure(FilterError::FileWriteError, "Ошибка записи строк BMP изображения",
+                                             ErrorContext::withFilename(filename_));
+            }
+            return FilterResult::success();
+        }
+
+        FilterResult finish() override
+        {
+            if (!writer_.finish())
+            {
+                return FilterResult::failure(FilterError::FileWriteError, "Ошибка сохранения BMP изображения",
+                                             ErrorContext::withFilename(filename_));
+            }
+            return FilterResult::success();
+        }
+
+    private:
+        BMPHandler::BMPWriter writer_;
+        std::string filename_;
+        int channels_ = 3;
+    };
+
+    bool isJpegExtension(const std::string& extension)
+    {
+        return extension == "jpg" || extension == "jpeg";
+    }
+}
+
+bool RowStream::isStreamingFormat(const std::string& filename)
+{
+    const auto extension = getExtension(filename);
+    if (extension == "bmp")
+    {
+        return true;
+    }
+    return JpegImageCodec::isAvailable() && isJpegExtension(extension);
+}
+
+FilterResult RowStream::openReader(const std::string& filename, bool preserve_alpha,
+                                   std::unique_ptr<IRowReader>& reader)
+{
+    reader.reset();
+
+    if (getExtension(filename) == "bmp")
+    {
+        std::string normalized_path;
+        auto path_result = validatePath(filename, normalized_path);
+        if (!path_result.isSuccess())
+        {
+            return path_result;
+        }
+
+        auto bmp_reader = std::make_unique<BmpRowReader>();
+        auto result = bmp_reader->open(normalized_path, preserve_alpha);
+        if (result.isSuccess())
+        {
+            reader = std::move(bmp_reader);
+        }
+        return result;
+    }
+
+    if (JpegImageCodec::isAvailable() && isJpegExtension(getExtension(filename)))
+    {
+        std::string normalized_path;
+        auto path_result = validatePath(filename, normalized_path);
+        if (!path_result.isSuccess())
+        {
+            return path_result;
+        }
+
+        auto result = JpegImageCodec::openRowReader(normalized_path, preserve_alpha, 1, reader);
+        if (result.isSuccess() || result.error != FilterError::UnsupportedFormat)
+        {
+            return result;
+        }
+        // Варианты JPEG без построчной поддержки декодирует полнокадровый загрузчик
+    }
+
+    auto image_reader = std::make_unique<ImageRowReader>();
+    auto result = image_reader->open(filename, preserve_alpha);
+    if (result.isSuccess())
+    {
+        reader = std::move(image_reader);
+    }
+    return result;
+}
+
+FilterResult RowStream::createWriter(const std::string& filename, bool preserve_alpha, int jpeg_quality,
+                                     std::unique_ptr<IRowWriter>& writer)
+{
+    writer.reset();
+
+    if (getExtension(filename) == "bmp")
+    {
+        std::string normalized_path;
+        auto path_result = validatePath(filename, normalized_path);
+        if (!path_result.isSuccess())
+        {
+            return path_result;
+        }
+        writer = std::make_unique<BmpRowWriter>(normalized_path);
+        return FilterResult::success();
+    }
+
+    if (JpegImageCodec::isAvailable() && isJpegExtension(getExtension(filename)))
+    {
+        std::string normalized_path;
+        auto path_result = validatePath(filename, normalized_path);
+        if (!path_result.isSuccess())
+        {
+            return path_result;
+        }
+        return JpegImageCodec::createRowWriter(normalized_path, jpeg_quality, writer);
+    }
+
+    writer = std::make_unique<ImageRowWriter>(filename, preserve_alpha, jpeg_quality);
+    return FilterResult::success();
+}
@@ -0,0 +1,124 @@
+#include <utils/ScratchArena.h>
+#include <utils/IImageAllocator.h>
+#include <algorithm>
+
+namespace
+{
+    size_t alignUp(size_t value) noexcept
+    {
+        return (value + ScratchArena::ALIGNMENT - 1) & ~(ScratchArena::ALIGNMENT - 1);
+    }
+}
+
+ScratchArena::ScratchArena(IImageAllocator* allocator, size_t chunk_size)
+    : allocator_(allocator != nullptr ? *allocator : ImageAllocator::getDefault())
+    , chunk_size_(alignUp(std::max<size_t>(chunk_size, ALIGNMENT)))
+{
+}
+
+ScratchArena::~ScratchArena()
+{
+    clear();
+}
+
+uint8_t* ScratchArena::allocate(size_t size) noexcept
+{
+    const size_t aligned_size = alignUp(std::max<size_t>(size, 1));
+
+    // Ищем место в текущем и следующих (уже выделенных) блоках
+    while (current_ < chunks_.size())
+    {
+        const auto& chunk = chunks_[current_];
+        if (chunk.size - offset_ >= aligned_size)
+        {
+            break;
+        }
+        ++current_;
+        offset_ = 0;
+    }
+
+    if (current_ == chunks_.size() && !addChunk(aligned_size))
+    {
+        return nullptr;
+    }
+
+    auto* ptr = chunks_[current_].data + offset_;
+    offset_ += aligned_size;
+    used_ += aligned_size;
+    peak_ = std::max(peak_, used_);
+    return ptr;
+}
+
+void ScratchArena::rewind() noexcept
+{
+    current_ = 0;
+    offset_ = 0;
+    used_ = 0;
+}
+
+void ScratchArena::reset() noexcept
+{
+    if (chunks_.size() > 1)
+    {
+        // Объединяем блоки: следующее изображение уместится в один блок
+        const size_t total = getReservedBytes();
+        clear();
+        addChunk(total);
+    }
+    rewind();
+    peak_ = 0;
+}
+
+void ScratchArena::clear() noexcept
+{
+    for (const auto& chunk : chunks_)
+    {
+        allocator_.deallocate(chunk.data, chunk.size);
+    }
+    chunks_.clear();
+    rewind();
+}
+
+size_t ScratchArena::getUsedBytes() const noexcept
+{
+    return used_;
+}
+
+size_t ScratchArena::getPeakBytes() const noexcept
+{
+    return peak_;
+}
+
+size_t ScratchArena::getReservedBytes() const noexcept
+{
+    size_t total = 0;
+    for (const auto& chunk : chunks_)
+    {
+        total += chunk.size;
+    }
+    return total;
+}
+
+bool ScratchArena::addChunk(size_t size) noexcept
+{
+    const size_t chunk_size = std::max(alignUp(size), chunk_size_);
+    auto* data = static_cast<uint8_t*>(allocator_.allocate(chunk_size));
+    if (data == nullptr)
+    {
+        return false;
+    }
+
+    try
+    {
+        chunks_.push_back(Chunk{data, chunk_size});
+    }
+    catch (...)
+    {
+        allocator_.deallocate(data, chunk_size);
+        return false;
+    }
+
+    current_ = chunks_.size() - 1;
+    offset_ = 0;
+    return true;
+}
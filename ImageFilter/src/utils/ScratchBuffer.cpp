@@ -0,0 +1,72 @@
+#include <utils/ScratchBuffer.h>
+#include <utils/ScratchArena.h>
+#include <utility>
+
+ScratchBuffer::ScratchBuffer(ScratchArena* arena, IBufferPool* pool, size_t size)
+    : size_(size)
+{
+    if (arena != nullptr)
+    {
+        data_ = arena->allocate(size);
+        if (data_ != nullptr)
+        {
+            return;
+        }
+    }
+
+    if (pool != nullptr)
+    {
+        owned_ = pool->acquire(size);
+        pool_ = pool;
+    }
+    else
+    {
+        owned_.resize(size);
+    }
+    data_ = owned_.data();
+}
+
+ScratchBuffer::~ScratchBuffer()
+{
+    release();
+}
+
+ScratchBuffer::ScratchBuffer(ScratchBuffer&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr))
+    , size_(std::exchange(other.size_, 0))
+    , owned_(std::move(other.owned_))
+    , pool_(std::exchange(other.pool_, nullptr))
+{
+}
+
+ScratchBuffer& ScratchBuffer::operator=(ScratchBuffer&& other) noexcept
+{
+    if (this != &other)
+    {
+        release();
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+        owned_ = std::move(other.owned_);
+        pool_ = std::exchange(other.pool_, nullptr);
+    }
+    return *this;
+}
+
+void ScratchBuffer::release() noexcept
+{
+    if (pool_ != nullptr && owned_.capacity() > 0)
+    {
+        try
+        {
+            pool_->release(std::move(owned_));
+        }
+        catch (...)
+        {
+            // Пул не смог принять буфер - он будет освобожден ниже
+        }
+    }
+    owned_ = PooledBuffer();
+    pool_ = nullptr;
+    data_ = nullptr;
+    size_ = 0;
+}
@@ -0,0 +1,193 @@
+#include <utils/StbImageCodec.h>
+
+// STB Image - заголовочные файлы для работы с изображениями
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include <stb_image_write.h>
+
+#include <cstdlib>
+#include <limits>
+
+namespace
+{
+    /**
+     * @brief Состояние записи stb_image_write в приемник байтов
+     */
+    struct StbSinkState
+    {
+        const IImageCodec::ByteSink* sink;
+        bool failed;
+    };
+
+    void writeToSink(void* context, void* data, int size)
+    {
+        auto* state = static_cast<StbSinkState*>(context);
+        if (!state->failed && size > 0 &&
+            !(*state->sink)(static_cast<const uint8_t*>(data), static_cast<size_t>(size)))
+        {
+            state->failed = true;
+        }
+    }
+}
+
+const char* StbImageCodec::getName() const noexcept
+{
+    return "stb";
+}
+
+bool StbImageCodec::canDecode(const std::string& extension) const noexcept
+{
+    // stb_image определяет формат по содержимому файла
+    (void)extension;
+    return true;
+}
+
+bool StbImageCodec::canEncode(const std::string& extension) const noexcept
+{
+    return extension == "jpg" || extension == "jpeg" || extension == "png";
+}
+
+FilterResult StbImageCodec::decode(std::span<const uint8_t> data, int desired_channels, int scale_denominator,
+                                   ImageLoader::LoadedImage& result) const
+{
+    // Масштабирование выполняет ImageLoader после полного декодирования
+    (void)scale_denominator;
+
+    if (data.empty() || data.size() > static_cast<size_t>(std::numeric_limits<int>::max()))
+    {
+        return FilterResult::failure(FilterError::InvalidSize, "Некорректный размер данных изображения");
+    }
+
+    // STB автоматически определяет формат изображения по содержимому
+    // stbi_load_from_memory возвращает указатель на данные или nullptr при ошибке
+    // Последний параметр - желаемое количество каналов:
+    // 0 = как в файле, 3 = RGB, 4 = RGBA
+    int original_channels = 0;
+    result.data = stbi_load_from_memory(data.data(), static_cast<int>(data.size()), &result.width,
+                                        &result.height, &original_channels, desired_channels);
+
+    if (result.data == nullptr)
+    {
+        const char* stbi_reason = stbi_failure_reason();
+        std::string error_msg = "Ошибка загрузки изображения";
+        if (stbi_reason != nullptr)
+        {
+            error_msg += ": " + std::string(stbi_reason);
+        }
+
+        return FilterResult::failure(FilterError::FileReadError, error_msg);
+    }
+
+    // Валидация загруженных данных
+    if (result.width <= 0 || result.height <= 0)
+    {
+        stbi_image_free(result.data);
+        result.data = nullptr;
+        result.width = 0;
+        result.height = 0;
+        result.channels = 0;
+        ErrorContext ctx;
+        ctx.image_width = result.width;
+        ctx.image_height = result.height;
+        ctx.image_channels = original_channels;
+        return FilterResult::failure(FilterError::InvalidSize,
+                                   "Некорректный размер изображения", ctx);
+    }
+
+    if (original_channels <= 0 || original_channels > 4)
+    {
+        stbi_image_free(result.data);
+        result.data = nullptr;
+        result.width = 0;
+        result.height = 0;
+        result.channels = 0;
+        ErrorContext ctx;
+        ctx.image_width = result.width;
+        ctx.image_height = result.height;
+        ctx.image_channels = original_channels;
+        return FilterResult::failure(FilterError::InvalidChannels,
+                                   "Некорректное количество каналов: " +
+                                   std::to_string(original_channels), ctx);
+    }
+
+    // Количество каналов соответствует запросу независимо от файла
+    result.channels = desired_channels;
+    return FilterResult::success();
+}
+
+FilterResult StbImageCodec::probe(std::span<const uint8_t> data, ImageLoader::ImageInfo& info) const
+{
+    if (data.empty() || data.size() > static_cast<size_t>(std::numeric_limits<int>::max()))
+    {
+        return FilterResult::failure(FilterError::InvalidSize, "Некорректный размер данных изображения");
+    }
+
+    // stbi_info разбирает только заголовки и не выделяет память под пиксели
+    int width = 0;
+    int height = 0;
+    int channels = 0;
+    if (stbi_info_from_memory(data.data(), static_cast<int>(data.size()), &width, &height, &channels) == 0)
+    {
+        const char* stbi_reason = stbi_failure_reason();
+        std::string error_msg = "Не удалось прочитать заголовок изображения";
+        if (stbi_reason != nullptr)
+        {
+            error_msg += ": " + std::string(stbi_reason);
+        }
+        return FilterResult::failure(FilterError::FileReadError, error_msg);
+    }
+
+    if (width <= 0 || height <= 0 || channels <= 0 || channels > 4)
+    {
+        return FilterResult::failure(FilterError::InvalidSize, "Некорректный заголовок изображения",
+                                     ErrorContext::withImage(width, height, channels));
+    }
+
+    info.width = width;
+    info.height = height;
+    info.channels = channels;
+    return FilterResult::success();
+}
+
+FilterResult StbImageCodec::encode(const ByteSink& sink, const std::string& extension, const uint8_t* data,
+                                   int width, int height, int channels, bool preserve_alpha,
+                                   int jpeg_quality) const
+{
+    // PNG сохраняет данные с текущим количеством каналов (3 или 4)
+    (void)preserve_alpha;
+
+    StbSinkState state{&sink, false};
+    int result = 0;
+    if (extension == "jpg" || extension == "jpeg")
+    {
+        // Кодер JPEG читает пиксели с шагом channels и берет только R, G, B:
+        // RGBA кодируется как RGB без промежуточной копии кадра
+        result = stbi_write_jpg_to_func(writeToSink, &state, width, height, channels, data, jpeg_quality);
+    }
+    else if (extension == "png")
+    {
+        // stride_in_bytes = 0 означает автоматический расчет шага (width * channels)
+        result = stbi_write_png_to_func(writeToSink, &state, width, height, channels, data, 0);
+    }
+    else
+    {
+        return FilterResult::failure(FilterError::UnsupportedFormat,
+                                   "Неподдерживаемый формат файла: " + extension);
+    }
+
+    if (result == 0 || state.failed)
+    {
+        return FilterResult::failure(FilterError::FileWriteError, "Ошибка записи изображения",
+                                   ErrorContext::withImage(width, height, channels));
+    }
+
+    return FilterResult::success();
+}
+
+StbImageCodec& StbImageCodec::getInstance() noexcept
+{
+    static StbImageCodec instance;
+    return instance;
+}
@@ -0,0 +1,189 @@
+#include <utils/StripPipeline.h>
+#include <ImageProcessor.h>
+#include <filters/IFilter.h>
+#include <utils/IBufferPool.h>
+#include <utils/RowStream.h>
+#include <utils/SafeMath.h>
+#include <utils/ScratchArena.h>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+int StripPipeline::getChainRadius(const std::vector<IFilter*>& filters) noexcept
+{
+    int total = 0;
+    for (const auto* filter : filters)
+    {
+        const int radius = filter != nullptr ? filter->getStreamingRadius() : -1;
+        if (radius < 0 || radius > std::numeric_limits<int>::max() / 2 - total)
+        {
+            return -1;
+        }
+        total += radius;
+    }
+    return total;
+}
+
+FilterResult StripPipeline::run(IRowReader& reader,
+                                IRowWriter& writer,
+                                const std::vector<IFilter*>& filters,
+                                int strip_rows,
+                                Statistics* statistics)
+{
+    const int width = reader.getWidth();
+    const int height = reader.getHeight();
+    const int channels = reader.getChannels();
+
+    const int radius = getChainRadius(filters);
+    if (radius < 0)
+    {
+        for (const auto* filter : filters)
+        {
+            if (filter == nullptr || filter->getStreamingRadius() < 0)
+            {
+                ErrorContext ctx;
+                ctx.filter_params = filter != nullptr ? filter->getName() : std::string("null");
+                return FilterResult::failure(FilterError::InvalidParameter,
+                                             "Фильтр не поддерживает потоковую обработку полосами", ctx);
+            }
+        }
+        return FilterResult::failure(FilterError::ArithmeticOverflow, "Суммарный радиус цепочки слишком большой");
+    }
+
+    const int strip = std::max(1, strip_rows);
+    const int window_rows = static_cast<int>(std::min<int64_t>(height, static_cast<int64_t>(strip) + 2 * static_cast<int64_t>(radius)));
+
+    // Окно не короче ядра цепочки (2R + 1 строк): фильтры проверяют радиус по
+    // размерам переданного изображения, и у краев кадра окно [a - R, b + R)
+    // короче, чем допускает обработка всего изображения
+    const int min_window_rows = static_cast<int>(std::min<int64_t>(height, 2 * static_cast<int64_t>(radius) + 1));
+
+    size_t row_bytes = 0;
+    size_t window_bytes = 0;
+    if (width <= 0 || height <= 0 ||
+        !SafeMath::safeMultiply(static_cast<size_t>(width), static_cast<size_t>(channels), row_bytes) ||
+        !SafeMath::safeMultiply(row_bytes, static_cast<size_t>(window_rows), window_bytes))
+    {
+        return FilterResult::failure(FilterError::InvalidSize, "Некорректный размер изображения",
+                                     ErrorContext::withImage(width, height, channels));
+    }
+
+    // Декодированные строки окна [window_begin, window_end)
+    PooledBuffer decoded;
+    // Копия окна, которую изменяют фильтры: нужна только при R > 0, так как
+    // исходные строки перекрытия понадобятся следующей полосе
+    PooledBuffer working;
+    decoded.resize(window_bytes);
+    if (radius > 0 && !filters.empty())
+    {
+        working.resize(window_bytes);
+    }
+
+    ScratchArena scratch_arena;
+    ImageProcessor window;
+    window.setScratchArena(&scratch_arena);
+
+    auto result = writer.begin(width, height, channels);
+    if (!result.isSuccess())
+    {
+        return result;
+    }
+
+    int window_begin = 0;
+    int window_end = 0;
+    size_t strips = 0;
+    size_t peak_scratch = 0;
+
+    for (int strip_begin = 0; strip_begin < height; strip_begin += strip)
+    {
+        const int strip_end = std::min(height, strip_begin + strip);
+        const int need_begin = std::max(0, std::min(strip_begin - radius, height - min_window_rows));
+        const int need_end = static_cast<int>(std::min<int64_t>(
+            height, std::max<int64_t>(static_cast<int64_t>(strip_end) + radius, min_window_rows)));
+
+        // Сдвигаем перекрытие с предыдущей полосой в начало буфера
+        if (need_begin > window_begin)
+        {
+            const int keep = std::max(0, window_end - need_begin);
+            if (keep > 0)
+            {
+                std::memmove(decoded.data(),
+                             decoded.data() + static_cast<size_t>(need_begin - window_begin) * row_bytes,
+                             static_cast<size_t>(keep) * row_bytes);
+            }
+            window_begin = need_begin;
+            window_end = need_begin + keep;
+        }
+
+        // Декодируем недостающие строки
+        if (need_end > window_end)
+        {
+            result = reader.readRows(decoded.data() + static_cast<size_t>(window_end - window_begin) * row_bytes,
+                                     need_end - window_end);
+            if (!result.isSuccess())
+            {
+                return result;
+            }
+            window_end = need_end;
+        }
+
+        const int rows = window_end - window_begin;
+        const uint8_t* output = decoded.data() + static_cast<size_t>(strip_begin - window_begin) * row_bytes;
+
+        if (!filters.empty())
+        {
+            uint8_t* target = decoded.data();
+            if (!working.empty())
+            {
+                std::memcpy(working.data(), decoded.data(), static_cast<size_t>(rows) * row_bytes);
+                target = working.data();
+            }
+
+            // Окно не владеет буфером: память принадлежит decoded/working
+            result = window.adopt(width, rows, channels, target, [](uint8_t*) {});
+            if (!result.isSuccess())
+            {
+                return result;
+            }
+
+            scratch_arena.reset();
+            for (auto* filter : filters)
+            {
+                result = filter->apply(window);
+                if (!result.isSuccess())
+                {
+                    return result;
+                }
+                scratch_arena.rewind();
+            }
+            peak_scratch = std::max(peak_scratch, scratch_arena.getPeakBytes());
+
+            if (window.getWidth() != width || window.getHeight() != rows || window.getChannels() != channels)
+            {
+                return FilterResult::failure(FilterError::InvalidSize,
+                                             "Фильтр изменил размер полосы при потоковой обработке",
+                                             ErrorContext::withImage(window.getWidth(), window.getHeight(),
+                                                                     window.getChannels()));
+            }
+            output = window.getData() + static_cast<size_t>(strip_begin - window_begin) * row_bytes;
+        }
+
+        result = writer.writeRows(output, strip_end - strip_begin);
+        if (!result.isSuccess())
+        {
+            return result;
+        }
+        ++strips;
+    }
+
+    result = writer.finish();
+
+    if (statistics != nullptr)
+    {
+        statistics->strips = strips;
+        statistics->halo_rows = radius;
+        statistics->peak_memory_bytes = decoded.capacity() + working.capacity() + peak_scratch;
+    }
+    return result;
+}
@@ -0,0 +1,158 @@
+/**
+ * @file BMPHandlerTests.cpp
+ * @brief Юнит-тесты чтения и записи BMP.
+ *
+ * Проверяется полнокадровый и построчный ввод-вывод (ширина с выравниванием
+ * строк), загрузка сразу в RGBA и отклонение усеченного файла.
+ */
+
+#include <gtest/gtest.h>
+
+#include <utils/BMPHandler.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    std::vector<uint8_t> makeImage(int width, int height, int channels)
+    {
+        std::vector<uint8_t> pixels(static_cast<size_t>(width) * height * channels);
+        std::mt19937 generator(7);
+        std::uniform_int_distribution<int> distribution(0, 255);
+        for (auto& value : pixels)
+        {
+            value = static_cast<uint8_t>(distribution(generator));
+        }
+        return pixels;
+    }
+
+    std::string tempPath(const char* name)
+    {
+        return (std::filesystem::temp_directory_path() / name).string();
+    }
+}
+
+TEST(BMPHandlerTest, SaveLoadRoundTripWithRowPadding)
+{
+    // 3 * 13 = 39 байт в строке: в файле строки дополняются до 40
+    const int width = 13;
+    const int height = 7;
+    const auto pixels = makeImage(width, height, 3);
+    const auto path = tempPath("imagefilter_bmp_roundtrip.bmp");
+
+    ASSERT_TRUE(BMPHandler::saveBMP(path, width, height, 3, pixels.data()));
+    EXPECT_EQ(std::filesystem::file_size(path), 54u + 40u * height);
+
+    int loaded_width = 0;
+    int loaded_height = 0;
+    int loaded_channels = 0;
+    auto* loaded = BMPHandler::loadBMP(path, loaded_width, loaded_height, loaded_channels);
+    ASSERT_NE(loaded, nullptr);
+    EXPECT_EQ(loaded_width, width);
+    EXPECT_EQ(loaded_height, height);
+    EXPECT_EQ(loaded_channels, 3);
+    EXPECT_EQ(std::vector<uint8_t>(loaded, loaded + pixels.size()), pixels);
+    std::free(loaded);
+
+    std::filesystem::remove(path);
+}
+
+TEST(BMPHandlerTest, LoadsDirectlyAsRgbaAndDropsAlphaOnSave)
+{
+    const int width = 5;
+    const int height = 4;
+    auto rgba = makeImage(width, height, 4);
+    const auto path = tempPath("imagefilter_bmp_rgba.bmp");
+
+    ASSERT_TRUE(BMPHandler::saveBMP(path, width, height, 4, rgba.data()));
+
+    int loaded_width = 0;
+    int loaded_height = 0;
+    int loaded_channels = 0;
+    auto* loaded = BMPHandler::loadBMP(path, loaded_width, loaded_height, loaded_channels, 4);
+    ASSERT_NE(loaded, nullptr);
+    EXPECT_EQ(loaded_channels, 4);
+    for (size_t i = 0; i < rgba.size(); i += 4)
+    {
+        EXPECT_EQ(loaded[i + 0], rgba[i + 0]);
+        EXPECT_EQ(loaded[i + 1], rgba[i + 1]);
+        EXPECT_EQ(loaded[i + 2], rgba[i + 2]);
+        EXPECT_EQ(loaded[i + 3], 255);
+    }
+    std::free(loaded);
+
+    std::filesystem::remove(path);
+}
+
+TEST(BMPHandlerTest, RowWriterAndRowCallbackMatchFullFrame)
+{
+    const int width = 31;
+    const int height = 23;
+    const auto pixels = makeImage(width, height, 3);
+    const size_t row_bytes = static_cast<size_t>(width) * 3;
+    const auto full_path = tempPath("imagefilter_bmp_full.bmp");
+    const auto rows_path = tempPath("imagefilter_bmp_rows.bmp");
+
+    ASSERT_TRUE(BMPHandler::saveBMP(full_path, width, height, 3, pixels.data()));
+
+    // Порции разной высоты, как у полос потокового конвейера
+    BMPHandler::BMPWriter writer;
+    ASSERT_TRUE(writer.open(rows_path, width, height));
+    int written = 0;
+    for (int count : {1, 5, 10, 7})
+    {
+        ASSERT_TRUE(writer.writeRows(pixels.data() + written * row_bytes, count, 3));
+        written += count;
+    }
+    ASSERT_TRUE(writer.finish());
+
+    std::ifstream full(full_path, std::ios::binary);
+    std::ifstream rows(rows_path, std::ios::binary);
+    const std::vector<char> full_bytes((std::istreambuf_iterator<char>(full)), std::istreambuf_iterator<char>());
+    const std::vector<char> rows_bytes((std::istreambuf_iterator<char>(rows)), std::istreambuf_iterator<char>());
+    EXPECT_EQ(full_bytes, rows_bytes);
+
+    std::vector<uint8_t> streamed;
+    int next_y = 0;
+    const bool ok = BMPHandler::readBMPRows(
+        rows_path, 3,
+        [&](int w, int h) { return w == width && h == height; },
+        [&](const uint8_t* row, int y)
+        {
+            EXPECT_EQ(y, next_y++);
+            streamed.insert(streamed.end(), row, row + row_bytes);
+            return true;
+        });
+    EXPECT_TRUE(ok);
+    EXPECT_EQ(streamed, pixels);
+
+    std::filesystem::remove(full_path);
+    std::filesystem::remove(rows_path);
+}
+
+TEST(BMPHandlerTest, RejectsTruncatedFile)
+{
+    const int width = 16;
+    const int height = 16;
+    const auto pixels = makeImage(width, height, 3);
+    const auto path = tempPath("imagefilter_bmp_truncated.bmp");
+
+    ASSERT_TRUE(BMPHandler::saveBMP(path, width, height, 3, pixels.data()));
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 10);
+
+    BMPHandler::BMPReader reader;
+    EXPECT_FALSE(reader.open(path));
+
+    int loaded_width = 0;
+    int loaded_height = 0;
+    int loaded_channels = 0;
+    EXPECT_EQ(BMPHandler::loadBMP(path, loaded_width, loaded_height, loaded_channels), nullptr);
+
+    std::filesystem::remove(path);
+}
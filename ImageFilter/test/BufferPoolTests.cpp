@@ -0,0 +1,135 @@
+/**
+ * @file BufferPoolTests.cpp
+ * @brief Юнит-тесты для BufferPool.
+ *
+ * Проверяются классы размеров, повторное использование памяти без
+ * перераспределения, ограничение размера пула, обмен буферами между
+ * потоками и сохранение альфа-канала фильтром с неинициализированным буфером.
+ */
+
+#include <gtest/gtest.h>
+
+#include <ImageProcessor.h>
+#include <filters/MedianFilter.h>
+#include <utils/BufferPool.h>
+
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Размер класса — ближайшая степень двойки, не меньше 64 байт.
+ */
+TEST(BufferPoolTests, SizeClassesArePowersOfTwo)
+{
+    EXPECT_EQ(BufferPool::getSizeClass(1), 6u);
+    EXPECT_EQ(BufferPool::getSizeClass(64), 6u);
+    EXPECT_EQ(BufferPool::getSizeClass(65), 7u);
+    EXPECT_EQ(BufferPool::getSizeClass(4096), 12u);
+    EXPECT_EQ(BufferPool::getSizeClass(4097), 13u);
+
+    BufferPool pool(0, 3);
+    EXPECT_EQ(pool.getShardCount(), 4u);
+
+    const auto buffer = pool.acquire(1000);
+    EXPECT_EQ(buffer.size(), 1000u);
+    EXPECT_EQ(buffer.capacity(), 1024u);
+}
+
+/**
+ * @brief Буфер того же класса возвращается повторно без перераспределения.
+ */
+TEST(BufferPoolTests, ReusesBufferOfSameClass)
+{
+    BufferPool pool(0, 1);
+    auto buffer = pool.acquire(3000);
+    const auto* data = buffer.data();
+    pool.release(std::move(buffer));
+    EXPECT_EQ(pool.size(), 1u);
+    EXPECT_EQ(pool.getTotalMemory(), 4096u);
+
+    // Другой класс размера не забирает буфер
+    const auto small = pool.acquire(100);
+    EXPECT_EQ(pool.size(), 1u);
+
+    const auto reused = pool.acquire(2100);
+    EXPECT_EQ(reused.data(), data);
+    EXPECT_EQ(reused.size(), 2100u);
+    EXPECT_EQ(pool.size(), 0u);
+}
+
+/**
+ * @brief Ограничение размера пула соблюдается при release, reserve и setMaxPoolSize.
+ */
+TEST(BufferPoolTests, RespectsMaxPoolSize)
+{
+    BufferPool pool(2, 2);
+    pool.reserve(100, 5);
+    EXPECT_EQ(pool.size(), 2u);
+
+    pool.release(PooledBuffer(10));
+    EXPECT_EQ(pool.size(), 2u);
+
+    size_t total_buffers = 0;
+    size_t total_memory = 0;
+    size_t largest = 0;
+    size_t smallest = 0;
+    pool.getStats(total_buffers, total_memory, largest, smallest);
+    EXPECT_EQ(total_buffers, 2u);
+    EXPECT_EQ(total_memory, 256u);
+    EXPECT_EQ(largest, 128u);
+    EXPECT_EQ(smallest, 128u);
+
+    pool.setMaxPoolSize(1);
+    EXPECT_EQ(pool.size(), 1u);
+
+    pool.clear();
+    EXPECT_EQ(pool.size(), 0u);
+    EXPECT_EQ(pool.getTotalMemory(), 0u);
+}
+
+/**
+ * @brief Буфер, возвращенный другим потоком, доступен из любого сегмента.
+ */
+TEST(BufferPoolTests, BufferReleasedByOtherThreadIsReused)
+{
+    BufferPool pool(0, 8);
+    const uint8_t* data = nullptr;
+    std::thread worker([&pool, &data]()
+    {
+        auto buffer = pool.acquire(1 << 16);
+        data = buffer.data();
+        pool.release(std::move(buffer));
+    });
+    worker.join();
+
+    const auto buffer = pool.acquire(1 << 16);
+    EXPECT_EQ(buffer.data(), data);
+}
+
+/**
+ * @brief Медианный фильтр сохраняет альфа-канал при работе с буфером из пула.
+ */
+TEST(BufferPoolTests, MedianFilterKeepsAlphaWithPooledBuffer)
+{
+    const int width = 9;
+    const int height = 7;
+    std::vector<uint8_t> rgba(static_cast<size_t>(width) * height * 4);
+    for (size_t i = 0; i < rgba.size(); ++i)
+    {
+        rgba[i] = static_cast<uint8_t>(i * 37 + 11);
+    }
+
+    BufferPool pool;
+    // Заполняем пул «грязным» буфером класса 256 байт (размер кадра 252 байта)
+    pool.release(PooledBuffer(256, 0xAB));
+
+    ImageProcessor image;
+    ASSERT_TRUE(image.resize(width, height, 4, rgba.data()).isSuccess());
+    MedianFilter filter(1, BorderHandler::Strategy::Mirror, &pool);
+    ASSERT_TRUE(filter.apply(image).isSuccess());
+
+    for (size_t i = 3; i < rgba.size(); i += 4)
+    {
+        ASSERT_EQ(image.getData()[i], rgba[i]) << "pixel " << i / 4;
+    }
+}
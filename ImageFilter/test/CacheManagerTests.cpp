@@ -0,0 +1,203 @@
+/**
+ * @file CacheManagerTests.cpp
+ * @brief Юнит-тесты для CacheManager.
+ *
+ * Проверяются разделяемая выдача значений без копирования,
+ * однократная генерация при одновременных промахах, ограничение объема
+ * с вытеснением, счетчики статистики и квантование ключей (в том числе
+ * обход особых точек генераторов).
+ */
+
+#include <gtest/gtest.h>
+
+#include <utils/CacheManager.h>
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Повторный запрос возвращает тот же объект без вызова генератора.
+ */
+TEST(CacheManagerTests, HitReturnsSharedValue)
+{
+    auto& cache = CacheManager::getInstance();
+    cache.clearAll();
+    cache.setLimits(CacheManager::CacheLimits{});
+    const auto base = cache.getStatistics().kernel;
+
+    int calls = 0;
+    const KernelCacheKey key{KernelCacheKey::Type::BoxBlur, 3.0, 0.0};
+    const auto generator = [&calls](const KernelCacheKey&) {
+        ++calls;
+        return std::vector<int32_t>{1, 2, 3};
+    };
+
+    const auto first = cache.getOrGenerateKernel(key, generator);
+    const auto second = cache.getOrGenerateKernel(key, generator);
+
+    EXPECT_EQ(calls, 1);
+    EXPECT_EQ(first.get(), second.get());
+    EXPECT_EQ(*first, (std::vector<int32_t>{1, 2, 3}));
+    const auto stats = cache.getStatistics();
+    EXPECT_EQ(stats.kernel_cache_size, 1u);
+    EXPECT_EQ(stats.kernel.hits - base.hits, 1u);
+    EXPECT_EQ(stats.kernel.misses - base.misses, 1u);
+    EXPECT_EQ(stats.kernel.bytes, 3 * sizeof(int32_t));
+}
+
+/**
+ * @brief Одновременные промахи по одному ключу вызывают генератор один раз.
+ */
+TEST(CacheManagerTests, ConcurrentMissesGenerateOnce)
+{
+    auto& cache = CacheManager::getInstance();
+    cache.clearAll();
+
+    std::atomic<int> calls{0};
+    const LUTCacheKey key{LUTCacheKey::Type::Gamma, 2.2};
+    const auto generator = [&calls](const LUTCacheKey&) {
+        ++calls;
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        return std::vector<uint8_t>(256, 7);
+    };
+
+    constexpr int thread_count = 8;
+    std::vector<CacheManager::LUTPtr> results(thread_count);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < thread_count; ++i)
+    {
+        threads.emplace_back([&, i]() { results[static_cast<size_t>(i)] = cache.getOrGenerateLUT(key, generator); });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(calls.load(), 1);
+    for (const auto& result : results)
+    {
+        ASSERT_NE(result, nullptr);
+        EXPECT_EQ(result.get(), results.front().get());
+    }
+}
+
+/**
+ * @brief Исключение генератора пробрасывается и не кэшируется.
+ */
+TEST(CacheManagerTests, FailedGenerationIsRetried)
+{
+    auto& cache = CacheManager::getInstance();
+    cache.clearAll();
+
+    const LUTCacheKey key{LUTCacheKey::Type::Contrast, 0.5};
+    EXPECT_THROW(cache.getOrGenerateLUT(key, [](const LUTCacheKey&) -> std::vector<uint8_t> { throw std::runtime_error("fail"); }),
+                 std::runtime_error);
+    EXPECT_EQ(cache.getStatistics().lut_cache_size, 0u);
+
+    const auto lut = cache.getOrGenerateLUT(key, [](const LUTCacheKey&) { return std::vector<uint8_t>(256, 1); });
+    ASSERT_NE(lut, nullptr);
+    EXPECT_EQ(lut->size(), 256u);
+}
+
+/**
+ * @brief Превышение объема вытесняет записи, к которым не было обращений.
+ */
+TEST(CacheManagerTests, EvictsWhenOverBudget)
+{
+    auto& cache = CacheManager::getInstance();
+    cache.clearAll();
+    CacheManager::CacheLimits limits;
+    limits.lut_max_bytes = 3 * 256;
+    cache.setLimits(limits);
+    const auto base = cache.getStatistics().lut;
+
+    const auto generator = [](const LUTCacheKey& key) {
+        return std::vector<uint8_t>(256, static_cast<uint8_t>(key.parameter * 100));
+    };
+
+    const auto kept = cache.getOrGenerateLUT({LUTCacheKey::Type::Brightness, 0.1}, generator);
+    for (int i = 2; i <= 6; ++i)
+    {
+        cache.getOrGenerateLUT({LUTCacheKey::Type::Brightness, i / 10.0}, generator);
+    }
+
+    const auto stats = cache.getStatistics();
+    EXPECT_LE(stats.lut.bytes, limits.lut_max_bytes);
+    EXPECT_EQ(stats.lut.max_bytes, limits.lut_max_bytes);
+    EXPECT_EQ(stats.lut_cache_size, 3u);
+    EXPECT_EQ(stats.lut.evictions - base.evictions, 3u);
+
+    // Выданное значение остается действительным после вытеснения
+    EXPECT_EQ((*kept)[0], 10);
+
+    cache.setLimits(CacheManager::CacheLimits{});
+}
+
+/**
+ * @brief Квантованные ключи разделяют одну запись, генератор получает квантованный ключ.
+ */
+TEST(CacheManagerTests, QuantizedKeysShareEntry)
+{
+    auto& cache = CacheManager::getInstance();
+    cache.clearAll();
+    CacheManager::CacheLimits limits;
+    limits.kernel_key_step = 0.5;
+    cache.setLimits(limits);
+
+    std::vector<double> generated_radii;
+    const auto generator = [&generated_radii](const KernelCacheKey& key) {
+        generated_radii.push_back(key.radius);
+        return std::vector<int32_t>{1};
+    };
+
+    const auto first = cache.getOrGenerateKernel({KernelCacheKey::Type::Gaussian, 4.9, 2.45}, generator);
+    const auto second = cache.getOrGenerateKernel({KernelCacheKey::Type::Gaussian, 5.1, 2.55}, generator);
+
+    EXPECT_EQ(first.get(), second.get());
+    ASSERT_EQ(generated_radii.size(), 1u);
+    EXPECT_DOUBLE_EQ(generated_radii.front(), 5.0);
+
+    cache.setLimits(CacheManager::CacheLimits{});
+}
+
+/**
+ * @brief Квантование не превращает sigma в 0, а контраст и гамму - в особые точки генераторов.
+ */
+TEST(CacheManagerTests, QuantizationAvoidsSingularParameters)
+{
+    auto& cache = CacheManager::getInstance();
+    cache.clearAll();
+    CacheManager::CacheLimits limits;
+    limits.kernel_key_step = 0.5;
+    limits.lut_key_step = 0.1;
+    cache.setLimits(limits);
+
+    double generated_sigma = 0.0;
+    cache.getOrGenerateKernel({KernelCacheKey::Type::Gaussian, 0.6, 0.2}, [&generated_sigma](const KernelCacheKey& key) {
+        generated_sigma = key.sigma;
+        return std::vector<int32_t>{1};
+    });
+    EXPECT_DOUBLE_EQ(generated_sigma, 0.2);
+
+    std::vector<double> generated_parameters;
+    const auto lut_generator = [&generated_parameters](const LUTCacheKey& key) {
+        generated_parameters.push_back(key.parameter);
+        return std::vector<uint8_t>(256);
+    };
+    cache.getOrGenerateLUT({LUTCacheKey::Type::Contrast, 0.96}, lut_generator);
+    cache.getOrGenerateLUT({LUTCacheKey::Type::Gamma, 0.04}, lut_generator);
+    // Допустимые значения по-прежнему квантуются
+    cache.getOrGenerateLUT({LUTCacheKey::Type::Contrast, 0.52}, lut_generator);
+    cache.getOrGenerateLUT({LUTCacheKey::Type::Brightness, 0.96}, lut_generator);
+
+    ASSERT_EQ(generated_parameters.size(), 4u);
+    EXPECT_DOUBLE_EQ(generated_parameters[0], 0.96);
+    EXPECT_DOUBLE_EQ(generated_parameters[1], 0.04);
+    EXPECT_NEAR(generated_parameters[2], 0.5, 1e-12);
+    EXPECT_NEAR(generated_parameters[3], 1.0, 1e-12);
+
+    cache.setLimits(CacheManager::CacheLimits{});
+}
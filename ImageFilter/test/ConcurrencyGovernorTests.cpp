@@ -0,0 +1,139 @@
+/**
+ * @file ConcurrencyGovernorTests.cpp
+ * @brief Юнит-тесты общего бюджета потоков ConcurrencyGovernor.
+ *
+ * Проверяется выдача потоков строк из свободной части бюджета, учет рабочих
+ * потоков уровня файлов, монопольная обработка больших изображений и
+ * ограничение processRowsParallel глобальным бюджетом.
+ */
+
+#include <gtest/gtest.h>
+
+#include <utils/ConcurrencyGovernor.h>
+#include <utils/ParallelImageProcessor.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+TEST(ConcurrencyGovernorTest, RowThreadsComeFromFreeBudget)
+{
+    ConcurrencyGovernor governor(4);
+
+    auto first = governor.acquireRowThreads(8);
+    EXPECT_EQ(first.getThreads(), 4);
+    EXPECT_EQ(governor.getThreadsInUse(), 4);
+
+    // Бюджет исчерпан: обработка последовательная
+    const auto second = governor.acquireRowThreads(8);
+    EXPECT_EQ(second.getThreads(), 1);
+
+    first.release();
+    EXPECT_EQ(governor.getThreadsInUse(), 0);
+    EXPECT_EQ(governor.acquireRowThreads(3).getThreads(), 3);
+    EXPECT_EQ(governor.getPeakThreadsInUse(), 4);
+}
+
+TEST(ConcurrencyGovernorTest, BusyWorkersLeaveFewerRowThreads)
+{
+    ConcurrencyGovernor governor(4);
+    std::promise<void> release_workers;
+    const auto released = release_workers.get_future().share();
+    std::atomic<int> started{0};
+
+    std::vector<std::thread> workers;
+    for (int i = 0; i < 2; ++i)
+    {
+        workers.emplace_back([&governor, &started, released]() {
+            const auto lease = governor.acquireWorker();
+            ++started;
+            released.wait();
+        });
+    }
+    while (started.load() < 2)
+    {
+        std::this_thread::yield();
+    }
+
+    {
+        const auto worker = governor.acquireWorker();
+        EXPECT_EQ(governor.getThreadsInUse(), 3);
+
+        // Свободна одна единица плюс единица самого ожидающего рабочего потока
+        const auto rows = governor.acquireRowThreads(8);
+        EXPECT_EQ(rows.getThreads(), 2);
+        EXPECT_EQ(governor.getThreadsInUse(), 4);
+    }
+
+    release_workers.set_value();
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+    EXPECT_EQ(governor.getThreadsInUse(), 0);
+}
+
+TEST(ConcurrencyGovernorTest, ExclusiveImageWaitsForOtherFiles)
+{
+    ConcurrencyGovernor governor(4);
+    governor.setExclusiveThreshold(1000);
+
+    std::promise<void> finish_small_file;
+    std::promise<void> small_started;
+    std::thread small_worker([&]() {
+        const auto lease = governor.acquireWorker();
+        small_started.set_value();
+        finish_small_file.get_future().wait();
+    });
+    small_started.get_future().wait();
+
+    std::atomic<bool> exclusive_granted{false};
+    std::atomic<int> exclusive_threads{0};
+    std::thread large_worker([&]() {
+        const auto worker = governor.acquireWorker();
+        EXPECT_EQ(governor.acquireExclusive(10, 10).getThreads(), 1);  // Ниже порога
+
+        const auto exclusive = governor.acquireExclusive(100, 100);
+        exclusive_granted = true;
+        exclusive_threads = governor.acquireRowThreads(8).getThreads();
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_FALSE(exclusive_granted.load());
+
+    finish_small_file.set_value();
+    small_worker.join();
+    large_worker.join();
+    EXPECT_TRUE(exclusive_granted.load());
+    EXPECT_EQ(exclusive_threads.load(), 4);
+
+    // Вне рабочего потока монопольный режим не запрашивается
+    EXPECT_EQ(governor.acquireExclusive(100, 100).getThreads(), 1);
+}
+
+TEST(ConcurrencyGovernorTest, ProcessRowsParallelStaysWithinGlobalBudget)
+{
+    auto& governor = ConcurrencyGovernor::getInstance();
+    const int previous_budget = governor.getThreadBudget();
+    governor.setThreadBudget(2);
+    governor.resetPeak();
+
+    std::mutex mutex;
+    std::set<std::thread::id> thread_ids;
+    std::atomic<int> rows{0};
+    ParallelImageProcessor::processRowsParallel(2000, 2000, [&](int start_row, int end_row) {
+        rows += end_row - start_row;
+        std::lock_guard<std::mutex> lock(mutex);
+        thread_ids.insert(std::this_thread::get_id());
+    }, nullptr, 8);
+
+    EXPECT_EQ(rows.load(), 2000);
+    EXPECT_LE(thread_ids.size(), 2u);
+    EXPECT_LE(governor.getPeakThreadsInUse(), 2);
+    EXPECT_EQ(governor.getThreadsInUse(), 0);
+    governor.setThreadBudget(previous_budget);
+}
@@ -0,0 +1,136 @@
+/**
+ * @file DirectoryScannerTests.cpp
+ * @brief Юнит-тесты параллельного обхода директорий DirectoryScanner.
+ *
+ * Проверяется полный рекурсивный обход вложенных директорий несколькими
+ * потоками, фильтрация по расширению и шаблону, обход без рекурсии,
+ * ошибка для отсутствующей директории и обработка символических ссылок.
+ */
+
+#include <gtest/gtest.h>
+
+#include <TestSupport.h>
+
+#include <utils/DirectoryScanner.h>
+
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <string>
+
+namespace
+{
+    using TestSupport::makeTempDirectory;
+
+    void touch(const std::filesystem::path& path)
+    {
+        std::filesystem::create_directories(path.parent_path());
+        std::ofstream file(path, std::ios::binary);
+        file << "x";
+    }
+
+    std::set<std::string> scanAll(const std::filesystem::path& directory, const DirectoryScanner::Options& options)
+    {
+        DirectoryScanner scanner(directory.string(), options);
+        EXPECT_TRUE(scanner.start().isSuccess());
+
+        std::set<std::string> files;
+        std::filesystem::path path;
+        while (scanner.next(path))
+        {
+            files.insert(path.lexically_relative(directory).generic_string());
+        }
+        EXPECT_TRUE(scanner.isComplete());
+        EXPECT_EQ(scanner.getDiscoveredCount(), files.size());
+        return files;
+    }
+}
+
+TEST(DirectoryScannerTest, RecursiveScanFindsEveryNestedImage)
+{
+    const auto directory = makeTempDirectory("imagefilter_scanner_recursive");
+    std::set<std::string> expected;
+    for (int d = 0; d < 6; ++d)
+    {
+        for (int f = 0; f < 30; ++f)
+        {
+            const std::string relative = "d" + std::to_string(d) + "/sub/img" + std::to_string(f) + ".png";
+            touch(directory / relative);
+            expected.insert(relative);
+        }
+    }
+    touch(directory / "top.jpg");
+    expected.insert("top.jpg");
+
+    DirectoryScanner::Options options;
+    options.recursive = true;
+    options.threads = 3;
+    EXPECT_EQ(scanAll(directory, options), expected);
+    std::filesystem::remove_all(directory);
+}
+
+TEST(DirectoryScannerTest, FiltersByExtensionAndPatternIgnoringCase)
+{
+    const auto directory = makeTempDirectory("imagefilter_scanner_pattern");
+    touch(directory / "a.PNG");
+    touch(directory / "b.jpeg");
+    touch(directory / "c.JPG");
+    touch(directory / "notes.txt");
+    touch(directory / "noext");
+
+    EXPECT_EQ(scanAll(directory, {}), (std::set<std::string>{"a.PNG", "b.jpeg", "c.JPG"}));
+
+    DirectoryScanner::Options options;
+    options.pattern = "*.jpg";
+    EXPECT_EQ(scanAll(directory, options), (std::set<std::string>{"c.JPG"}));
+
+    EXPECT_TRUE(DirectoryScanner::isImageFileName("photo.JpEg"));
+    EXPECT_FALSE(DirectoryScanner::isImageFileName(".png"));
+    EXPECT_TRUE(DirectoryScanner::matchesPattern("Photo.png", "photo.PNG"));
+    std::filesystem::remove_all(directory);
+}
+
+TEST(DirectoryScannerTest, NonRecursiveScanSkipsSubdirectories)
+{
+    const auto directory = makeTempDirectory("imagefilter_scanner_flat");
+    touch(directory / "top.png");
+    touch(directory / "nested" / "inner.png");
+
+    EXPECT_EQ(scanAll(directory, {}), (std::set<std::string>{"top.png"}));
+    std::filesystem::remove_all(directory);
+}
+
+TEST(DirectoryScannerTest, MissingDirectoryFailsToStart)
+{
+    DirectoryScanner scanner((std::filesystem::temp_directory_path() / "imagefilter_scanner_missing").string());
+    const auto result = scanner.start();
+    EXPECT_FALSE(result.isSuccess());
+    EXPECT_EQ(result.error, FilterError::FileNotFound);
+
+    std::filesystem::path path;
+    EXPECT_FALSE(scanner.next(path));
+    EXPECT_EQ(scanner.getDiscoveredCount(), 0u);
+}
+
+TEST(DirectoryScannerTest, FollowsFileLinksButNotDirectoryLinks)
+{
+    const auto directory = makeTempDirectory("imagefilter_scanner_links");
+    const auto outside = makeTempDirectory("imagefilter_scanner_links_target");
+    touch(outside / "linked.png");
+    touch(outside / "dir" / "hidden.png");
+
+    std::error_code ec;
+    std::filesystem::create_symlink(outside / "linked.png", directory / "linked.png", ec);
+    std::filesystem::create_directory_symlink(outside / "dir", directory / "dir", ec);
+    if (ec)
+    {
+        GTEST_SKIP() << "Символические ссылки не поддерживаются";
+    }
+    touch(directory / "real.png");
+
+    DirectoryScanner::Options options;
+    options.recursive = true;
+    EXPECT_EQ(scanAll(directory, options), (std::set<std::string>{"linked.png", "real.png"}));
+    std::filesystem::remove_all(directory);
+    std::filesystem::remove_all(outside);
+}
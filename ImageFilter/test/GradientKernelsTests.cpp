@@ -0,0 +1,200 @@
+/**
+ * @file GradientKernelsTests.cpp
+ * @brief Юнит-тесты построчных ядер градиента и фильтра детекции краёв.
+ *
+ * Результаты ядер сравниваются со скалярной эталонной реализацией
+ * (свертка 3x3 с проверкой границ на каждом элементе ядра) для операторов
+ * Собеля, Преввитта и Шарра.
+ */
+
+#include <gtest/gtest.h>
+
+#include <ImageProcessor.h>
+#include <filters/EdgeDetectionFilter.h>
+#include <utils/BorderHandler.h>
+#include <utils/ColorConversionUtils.h>
+#include <utils/GradientKernels.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace
+{
+    using Kernel = std::array<std::array<int, 3>, 3>;
+
+    /**
+     * @brief Эталонные ядра Gx оператора (Gy = Gx^T)
+     */
+    Kernel referenceKernelX(GradientKernels::Operator op)
+    {
+        switch (op)
+        {
+            case GradientKernels::Operator::Prewitt:
+                return {{{-1, 0, 1}, {-1, 0, 1}, {-1, 0, 1}}};
+            case GradientKernels::Operator::Scharr:
+                return {{{-3, 0, 3}, {-10, 0, 10}, {-3, 0, 3}}};
+            case GradientKernels::Operator::Sobel:
+            default:
+                return {{{-1, 0, 1}, {-2, 0, 2}, {-1, 0, 1}}};
+        }
+    }
+
+    /**
+     * @brief Скалярная эталонная свертка 3x3 для изображения в градациях серого
+     */
+    void referenceGradient(GradientKernels::Operator op, const std::vector<uint8_t>& gray,
+                           int width, int height, const BorderHandler& border,
+                           std::vector<int>& gx, std::vector<int>& gy)
+    {
+        const auto kx = referenceKernelX(op);
+        gx.assign(gray.size(), 0);
+        gy.assign(gray.size(), 0);
+        for (int y = 0; y < height; ++y)
+        {
+            for (int x = 0; x < width; ++x)
+            {
+                int sx = 0;
+                int sy = 0;
+                for (int dy = -1; dy <= 1; ++dy)
+                {
+                    for (int dx = -1; dx <= 1; ++dx)
+                    {
+                        const auto px = border.getX(x + dx, width);
+                        const auto py = border.getY(y + dy, height);
+                        const int value = gray[static_cast<size_t>(py) * width + px];
+                        sx += value * kx[dy + 1][dx + 1];
+                        sy += value * kx[dx + 1][dy + 1];
+                    }
+                }
+                gx[static_cast<size_t>(y) * width + x] = sx;
+                gy[static_cast<size_t>(y) * width + x] = sy;
+            }
+        }
+    }
+
+    std::vector<uint8_t> randomBytes(size_t size, unsigned seed)
+    {
+        std::mt19937 rng(seed);
+        std::vector<uint8_t> data(size);
+        for (auto& value : data)
+        {
+            value = static_cast<uint8_t>(rng() & 0xFF);
+        }
+        return data;
+    }
+
+    constexpr std::array<GradientKernels::Operator, 3> ALL_OPERATORS = {
+        GradientKernels::Operator::Sobel,
+        GradientKernels::Operator::Prewitt,
+        GradientKernels::Operator::Scharr
+    };
+}
+
+/**
+ * @brief Градиенты строки совпадают с эталонной сверткой для всех операторов и стратегий границ.
+ */
+TEST(GradientKernelsTests, GradientRowMatchesScalarReference)
+{
+    const int width = 37;
+    const int height = 5;
+    const auto gray = randomBytes(static_cast<size_t>(width) * height, 1);
+
+    for (const auto strategy : {BorderHandler::Strategy::Mirror, BorderHandler::Strategy::Clamp,
+                                BorderHandler::Strategy::Wrap})
+    {
+        const BorderHandler border(strategy);
+        for (const auto op : ALL_OPERATORS)
+        {
+            std::vector<int> expected_gx;
+            std::vector<int> expected_gy;
+            referenceGradient(op, gray, width, height, border, expected_gx, expected_gy);
+
+            std::vector<int16_t> gx(width);
+            std::vector<int16_t> gy(width);
+            for (int y = 0; y < height; ++y)
+            {
+                const auto* above = gray.data() + static_cast<size_t>(border.getY(y - 1, height)) * width;
+                const auto* center = gray.data() + static_cast<size_t>(y) * width;
+                const auto* below = gray.data() + static_cast<size_t>(border.getY(y + 1, height)) * width;
+                GradientKernels::computeGradientRow(op, above, center, below, width,
+                                                    border.getX(-1, width), border.getX(width, width),
+                                                    gx.data(), gy.data());
+
+                for (int x = 0; x < width; ++x)
+                {
+                    ASSERT_EQ(gx[x], expected_gx[static_cast<size_t>(y) * width + x]) << "x=" << x << " y=" << y;
+                    ASSERT_EQ(gy[x], expected_gy[static_cast<size_t>(y) * width + x]) << "x=" << x << " y=" << y;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Точная магнитуда совпадает с sqrt, приближенная отличается не более чем на 4%.
+ */
+TEST(GradientKernelsTests, MagnitudeExactAndApproximate)
+{
+    // Крайние значения оператора Шарра и случайные значения
+    std::vector<int16_t> gx = {0, 4080, -4080, 4080, 3, -7, 1000, 0};
+    std::vector<int16_t> gy = {0, 4080, 4080, 0, -4, 24, -2000, -4080};
+    const auto width = static_cast<int>(gx.size());
+
+    std::vector<int32_t> exact(gx.size());
+    std::vector<int32_t> approximate(gx.size());
+    GradientKernels::computeMagnitudeRow(GradientKernels::Magnitude::Exact, gx.data(), gy.data(), width, exact.data());
+    GradientKernels::computeMagnitudeRow(GradientKernels::Magnitude::Approximate, gx.data(), gy.data(), width, approximate.data());
+
+    for (size_t i = 0; i < gx.size(); ++i)
+    {
+        const double reference = std::hypot(static_cast<double>(gx[i]), static_cast<double>(gy[i]));
+        EXPECT_EQ(exact[i], static_cast<int32_t>(std::floor(reference))) << "i=" << i;
+        EXPECT_NEAR(approximate[i], reference, reference * 0.04 + 1.0) << "i=" << i;
+    }
+}
+
+/**
+ * @brief Фильтр с максимальной чувствительностью дает нормализованную эталонную магнитуду.
+ */
+TEST(GradientKernelsTests, EdgeDetectionFilterMatchesScalarReference)
+{
+    const int width = 23;
+    const int height = 11;
+    const auto rgb = randomBytes(static_cast<size_t>(width) * height * 3, 2);
+
+    std::vector<uint8_t> gray(static_cast<size_t>(width) * height);
+    for (size_t i = 0; i < gray.size(); ++i)
+    {
+        gray[i] = ColorConversionUtils::rgbToGrayscale(rgb[i * 3], rgb[i * 3 + 1], rgb[i * 3 + 2]);
+    }
+
+    const BorderHandler border(BorderHandler::Strategy::Mirror);
+    for (const auto op : ALL_OPERATORS)
+    {
+        std::vector<int> gx;
+        std::vector<int> gy;
+        referenceGradient(op, gray, width, height, border, gx, gy);
+
+        std::vector<int> magnitude(gray.size());
+        for (size_t i = 0; i < gray.size(); ++i)
+        {
+            magnitude[i] = static_cast<int>(std::sqrt(static_cast<double>(gx[i] * gx[i] + gy[i] * gy[i])));
+        }
+        const int max_magnitude = *std::max_element(magnitude.begin(), magnitude.end());
+        ASSERT_GT(max_magnitude, 0);
+
+        ImageProcessor image;
+        ASSERT_TRUE(image.resize(width, height, 3, rgb.data()).isSuccess());
+        EdgeDetectionFilter filter(1.0, op);
+        ASSERT_TRUE(filter.apply(image).isSuccess());
+
+        for (size_t i = 0; i < gray.size(); ++i)
+        {
+            const auto expected = static_cast<uint8_t>(magnitude[i] * 255 / max_magnitude);
+            ASSERT_EQ(image.getData()[i * 3], expected) << "pixel " << i;
+        }
+    }
+}
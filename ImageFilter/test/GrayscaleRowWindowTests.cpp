@@ -0,0 +1,240 @@
+/**
+ * @file GrayscaleRowWindowTests.cpp
+ * @brief Юнит-тесты потоковой обработки окном из трех строк (GrayscaleRowWindow).
+ *
+ * Фильтры EdgeDetectionFilter и OutlineFilter сравниваются с прежней
+ * полнокадровой реализацией (буфер градаций серого на все изображение и
+ * свертка 3x3 с BorderHandler на каждом элементе ядра) при разном количестве
+ * потоков, то есть при разном разбиении на полосы, включая полосы в одну строку.
+ */
+
+#include <gtest/gtest.h>
+
+#include <TestSupport.h>
+
+#include <ImageProcessor.h>
+#include <filters/EdgeDetectionFilter.h>
+#include <filters/OutlineFilter.h>
+#include <utils/BorderHandler.h>
+#include <utils/ColorConversionUtils.h>
+#include <utils/ParallelImageProcessor.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace
+{
+    using TestSupport::ScopedThreadCount;
+
+    // 211x61 - "среднее" изображение: полос в два раза меньше, чем потоков
+    constexpr int WIDTH = 211;
+    constexpr int HEIGHT = 61;
+
+    // Разбиение на 1, 2, 3, 8 и 50 полос (последнее - полосы по одной-две строки)
+    constexpr std::array<int, 5> THREAD_COUNTS = {1, 4, 6, 16, 100};
+
+    constexpr std::array<BorderHandler::Strategy, 3> ALL_STRATEGIES = {
+        BorderHandler::Strategy::Mirror,
+        BorderHandler::Strategy::Clamp,
+        BorderHandler::Strategy::Wrap
+    };
+
+    std::vector<uint8_t> randomBytes(size_t size, unsigned seed)
+    {
+        std::mt19937 rng(seed);
+        std::vector<uint8_t> data(size);
+        for (auto& value : data)
+        {
+            value = static_cast<uint8_t>(rng() & 0xFF);
+        }
+        return data;
+    }
+
+    /**
+     * @brief Полнокадровый буфер градаций серого
+     */
+    std::vector<uint8_t> toGrayscale(const std::vector<uint8_t>& pixels, int channels)
+    {
+        std::vector<uint8_t> gray(static_cast<size_t>(WIDTH) * HEIGHT);
+        for (size_t i = 0; i < gray.size(); ++i)
+        {
+            const auto* pixel = pixels.data() + i * static_cast<size_t>(channels);
+            gray[i] = ColorConversionUtils::rgbToGrayscale(pixel[0], pixel[1], pixel[2]);
+        }
+        return gray;
+    }
+
+    /**
+     * @brief Свертка 3x3 полнокадрового буфера с проверкой границ на каждом элементе ядра
+     */
+    template <typename Kernel>
+    int convolve(const std::vector<uint8_t>& gray, const BorderHandler& border, int x, int y, const Kernel& kernel)
+    {
+        int sum = 0;
+        for (int ky = -1; ky <= 1; ++ky)
+        {
+            for (int kx = -1; kx <= 1; ++kx)
+            {
+                const auto px = border.getX(x + kx, WIDTH);
+                const auto py = border.getY(y + ky, HEIGHT);
+                sum += gray[static_cast<size_t>(py) * WIDTH + px] * kernel[ky + 1][kx + 1];
+            }
+        }
+        return sum;
+    }
+
+    /**
+     * @brief Записывает значение в RGB-каналы пикселя, альфа-канал не меняется
+     */
+    void writeGray(std::vector<uint8_t>& pixels, int channels, size_t index, uint8_t value)
+    {
+        auto* pixel = pixels.data() + index * static_cast<size_t>(channels);
+        pixel[0] = value;
+        pixel[1] = value;
+        pixel[2] = value;
+    }
+
+    /**
+     * @brief Прежняя полнокадровая реализация EdgeDetectionFilter (оператор Собеля)
+     */
+    std::vector<uint8_t> referenceEdges(std::vector<uint8_t> pixels, int channels, double sensitivity,
+                                        const BorderHandler& border)
+    {
+        constexpr int gx_kernel[3][3] = {{-1, 0, 1}, {-2, 0, 2}, {-1, 0, 1}};
+        constexpr int gy_kernel[3][3] = {{-1, -2, -1}, {0, 0, 0}, {1, 2, 1}};
+
+        const auto gray = toGrayscale(pixels, channels);
+        std::vector<int> magnitude(gray.size());
+        for (int y = 0; y < HEIGHT; ++y)
+        {
+            for (int x = 0; x < WIDTH; ++x)
+            {
+                const int gx = convolve(gray, border, x, y, gx_kernel);
+                const int gy = convolve(gray, border, x, y, gy_kernel);
+                magnitude[static_cast<size_t>(y) * WIDTH + x] = static_cast<int>(std::sqrt(static_cast<double>(gx * gx + gy * gy)));
+            }
+        }
+
+        const int max_gradient = *std::max_element(magnitude.begin(), magnitude.end());
+        const auto threshold = static_cast<int>(max_gradient * (1.0 - sensitivity));
+        const auto effective_max = max_gradient - threshold;
+        for (size_t i = 0; i < magnitude.size(); ++i)
+        {
+            const auto gradient = std::max(0, magnitude[i] - threshold);
+            writeGray(pixels, channels, i, effective_max > 0 ? static_cast<uint8_t>((gradient * 255) / effective_max) : 0);
+        }
+        return pixels;
+    }
+
+    /**
+     * @brief Прежняя полнокадровая реализация OutlineFilter
+     */
+    std::vector<uint8_t> referenceOutline(std::vector<uint8_t> pixels, int channels, const BorderHandler& border)
+    {
+        constexpr int laplacian_kernel[3][3] = {{0, -1, 0}, {-1, 4, -1}, {0, -1, 0}};
+
+        const auto gray = toGrayscale(pixels, channels);
+        std::vector<int> laplacian(gray.size());
+        for (int y = 0; y < HEIGHT; ++y)
+        {
+            for (int x = 0; x < WIDTH; ++x)
+            {
+                laplacian[static_cast<size_t>(y) * WIDTH + x] = convolve(gray, border, x, y, laplacian_kernel);
+            }
+        }
+
+        const auto [min_it, max_it] = std::minmax_element(laplacian.begin(), laplacian.end());
+        const int min_val = *min_it;
+        const int range = *max_it - min_val;
+        if (range > 0)
+        {
+            for (size_t i = 0; i < laplacian.size(); ++i)
+            {
+                writeGray(pixels, channels, i, static_cast<uint8_t>(static_cast<int64_t>(laplacian[i] - min_val) * 255 / range));
+            }
+        }
+        return pixels;
+    }
+
+    /**
+     * @brief Применяет фильтр к копии пикселей и сравнивает с эталоном построчно
+     */
+    void expectMatchesReference(IFilter& filter, const std::vector<uint8_t>& pixels, int channels,
+                                const std::vector<uint8_t>& expected, int num_threads)
+    {
+        ImageProcessor image;
+        ASSERT_TRUE(image.resize(WIDTH, HEIGHT, channels, pixels.data()).isSuccess());
+        ASSERT_TRUE(filter.apply(image).isSuccess());
+
+        const auto row_size = static_cast<size_t>(WIDTH) * channels;
+        for (int y = 0; y < HEIGHT; ++y)
+        {
+            const auto* actual_row = image.getData() + static_cast<size_t>(y) * row_size;
+            const auto* expected_row = expected.data() + static_cast<size_t>(y) * row_size;
+            ASSERT_TRUE(std::equal(actual_row, actual_row + row_size, expected_row))
+                << filter.getName() << ": строка " << y << " из " << HEIGHT
+                << ", каналов " << channels << ", потоков " << num_threads;
+        }
+    }
+}
+
+/**
+ * @brief Разбиение соответствует ожидаемому: от одной полосы до полос в одну-две строки.
+ */
+TEST(GrayscaleRowWindowTests, ThreadCountsCoverStripBoundaries)
+{
+    std::vector<size_t> strip_counts;
+    for (const auto num_threads : THREAD_COUNTS)
+    {
+        ScopedThreadCount threads(num_threads);
+        strip_counts.push_back(ParallelImageProcessor::splitRows(HEIGHT, WIDTH).size());
+    }
+    EXPECT_EQ(strip_counts, (std::vector<size_t>{1, 2, 3, 8, 50}));
+}
+
+/**
+ * @brief EdgeDetectionFilter совпадает с полнокадровой реализацией при любом разбиении.
+ */
+TEST(GrayscaleRowWindowTests, EdgeDetectionMatchesFullFrameReference)
+{
+    for (const int channels : {3, 4})
+    {
+        const auto pixels = randomBytes(static_cast<size_t>(WIDTH) * HEIGHT * channels, 3);
+        for (const auto strategy : ALL_STRATEGIES)
+        {
+            const BorderHandler border(strategy);
+            const auto expected = referenceEdges(pixels, channels, 0.7, border);
+            for (const auto num_threads : THREAD_COUNTS)
+            {
+                ScopedThreadCount threads(num_threads);
+                EdgeDetectionFilter filter(0.7, EdgeDetectionFilter::Operator::Sobel, strategy);
+                expectMatchesReference(filter, pixels, channels, expected, num_threads);
+            }
+        }
+    }
+}
+
+/**
+ * @brief OutlineFilter совпадает с полнокадровой реализацией при любом разбиении.
+ */
+TEST(GrayscaleRowWindowTests, OutlineMatchesFullFrameReference)
+{
+    for (const int channels : {3, 4})
+    {
+        const auto pixels = randomBytes(static_cast<size_t>(WIDTH) * HEIGHT * channels, 4);
+        for (const auto strategy : ALL_STRATEGIES)
+        {
+            const BorderHandler border(strategy);
+            const auto expected = referenceOutline(pixels, channels, border);
+            for (const auto num_threads : THREAD_COUNTS)
+            {
+                ScopedThreadCount threads(num_threads);
+                OutlineFilter filter(strategy);
+                expectMatchesReference(filter, pixels, channels, expected, num_threads);
+            }
+        }
+    }
+}
@@ -0,0 +1,142 @@
+/**
+ * @file ImageAllocatorTests.cpp
+ * @brief Юнит-тесты распределителей памяти изображений.
+ *
+ * Проверяются выравнивание блоков, отображения mmap с выравниванием
+ * по huge page и использование распределителя в ImageProcessor и BufferPool.
+ */
+
+#include <gtest/gtest.h>
+
+#include <ImageProcessor.h>
+#include <utils/BufferPool.h>
+#include <utils/ImageAllocator.h>
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+    /**
+     * @brief Распределитель, считающий выделения и освобождения
+     */
+    class CountingAllocator final : public IImageAllocator
+    {
+    public:
+        void* allocate(size_t size) noexcept override
+        {
+            ++allocations;
+            allocated_bytes += size;
+            return HeapImageAllocator::getInstance().allocate(size);
+        }
+
+        void deallocate(void* ptr, size_t size) noexcept override
+        {
+            ++deallocations;
+            deallocated_bytes += size;
+            HeapImageAllocator::getInstance().deallocate(ptr, size);
+        }
+
+        const char* getName() const noexcept override
+        {
+            return "counting";
+        }
+
+        int allocations = 0;
+        int deallocations = 0;
+        size_t allocated_bytes = 0;
+        size_t deallocated_bytes = 0;
+    };
+
+    bool isAligned(const void* ptr, size_t alignment)
+    {
+        return reinterpret_cast<uintptr_t>(ptr) % alignment == 0;
+    }
+}
+
+/**
+ * @brief Куча и mmap выдают блоки, выровненные минимум по 64 байтам.
+ */
+TEST(ImageAllocatorTests, BlocksAreAligned)
+{
+    MmapImageAllocator::Options options;
+    options.min_mapping_size = 4096;
+    options.populate = true;
+    MmapImageAllocator mmap_allocator(options);
+
+    for (IImageAllocator* allocator : {static_cast<IImageAllocator*>(&HeapImageAllocator::getInstance()),
+                                       static_cast<IImageAllocator*>(&mmap_allocator)})
+    {
+        for (const size_t size : {size_t{1}, size_t{100}, size_t{5000}, size_t{3} * 1024 * 1024 + 7})
+        {
+            auto* ptr = static_cast<uint8_t*>(allocator->allocate(size));
+            ASSERT_NE(ptr, nullptr) << allocator->getName() << " size=" << size;
+            EXPECT_TRUE(isAligned(ptr, IImageAllocator::ALIGNMENT)) << allocator->getName() << " size=" << size;
+            std::memset(ptr, 0x5A, size);
+            EXPECT_EQ(ptr[size - 1], 0x5A);
+            allocator->deallocate(ptr, size);
+        }
+    }
+
+    if (MmapImageAllocator::isSupported())
+    {
+        const size_t size = 5 * 1024 * 1024;
+        void* ptr = mmap_allocator.allocate(size);
+        ASSERT_NE(ptr, nullptr);
+        EXPECT_TRUE(isAligned(ptr, MmapImageAllocator::HUGE_PAGE_SIZE));
+        mmap_allocator.deallocate(ptr, size);
+    }
+}
+
+/**
+ * @brief ImageProcessor выделяет и освобождает свои буферы через заданный распределитель.
+ */
+TEST(ImageAllocatorTests, ImageProcessorUsesAllocator)
+{
+    CountingAllocator allocator;
+    {
+        const int width = 5;
+        const int height = 3;
+        std::vector<uint8_t> rgba(static_cast<size_t>(width) * height * 4, 255);
+
+        ImageProcessor image;
+        image.setAllocator(&allocator);
+        ASSERT_TRUE(image.resize(width, height, 4, rgba.data()).isSuccess());
+        EXPECT_EQ(allocator.allocations, 1);
+        EXPECT_EQ(allocator.allocated_bytes, rgba.size());
+
+        // Преобразование выполняется на месте, без нового выделения
+        ASSERT_TRUE(image.convertToRGB().isSuccess());
+        EXPECT_EQ(allocator.allocations, 1);
+        EXPECT_EQ(allocator.deallocations, 0);
+        EXPECT_EQ(image.getChannels(), 3);
+        EXPECT_EQ(image.getData()[0], 255);
+
+        // Перемещенный объект освобождает буфер своим распределителем
+        ImageProcessor moved = std::move(image);
+        EXPECT_EQ(allocator.deallocations, 0);
+    }
+    EXPECT_EQ(allocator.deallocations, allocator.allocations);
+    EXPECT_EQ(allocator.deallocated_bytes, allocator.allocated_bytes);
+}
+
+/**
+ * @brief BufferPool создает буферы через свой распределитель.
+ */
+TEST(ImageAllocatorTests, BufferPoolUsesAllocator)
+{
+    CountingAllocator allocator;
+    {
+        BufferPool pool(0, 1, &allocator);
+        auto buffer = pool.acquire(1000);
+        EXPECT_EQ(allocator.allocations, 1);
+        EXPECT_EQ(allocator.allocated_bytes, 1024u);
+        EXPECT_TRUE(isAligned(buffer.data(), IImageAllocator::ALIGNMENT));
+        pool.release(std::move(buffer));
+
+        const auto reused = pool.acquire(600);
+        EXPECT_EQ(allocator.allocations, 1);
+    }
+    EXPECT_EQ(allocator.deallocations, 1);
+}
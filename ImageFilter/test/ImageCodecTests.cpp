@@ -0,0 +1,199 @@
+/**
+ * @file ImageCodecTests.cpp
+ * @brief Юнит-тесты выбора кодека и масштабированного декодирования.
+ *
+ * Проверяется выбор кодека по расширению, сохранение и загрузка JPEG через
+ * libjpeg-turbo (если доступен), выбор кодека по содержимому файла с неверным
+ * расширением, размеры при уменьшении в 2, 4 и 8 раз и уменьшение усреднением
+ * для форматов без масштабирования в кодеке.
+ */
+
+#include <gtest/gtest.h>
+
+#include <utils/IImageCodec.h>
+#include <utils/ImageLoader.h>
+#include <utils/ImageSaver.h>
+#include <utils/JpegImageCodec.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace
+{
+    std::vector<uint8_t> makeGradient(int width, int height)
+    {
+        std::vector<uint8_t> pixels(static_cast<size_t>(width) * height * 3);
+        for (int y = 0; y < height; ++y)
+        {
+            for (int x = 0; x < width; ++x)
+            {
+                auto* pixel = pixels.data() + (static_cast<size_t>(y) * width + x) * 3;
+                pixel[0] = static_cast<uint8_t>(x * 255 / width);
+                pixel[1] = static_cast<uint8_t>(y * 255 / height);
+                pixel[2] = 128;
+            }
+        }
+        return pixels;
+    }
+
+    std::string tempPath(const char* name)
+    {
+        return (std::filesystem::temp_directory_path() / name).string();
+    }
+}
+
+TEST(ImageCodecTest, SelectsConfiguredJpegCodecAndStbFallback)
+{
+    EXPECT_STREQ(ImageCodec::findDecoder("png").getName(), "stb");
+    EXPECT_STREQ(ImageCodec::findEncoder("png").getName(), "stb");
+    EXPECT_STREQ(ImageCodec::getFallback().getName(), "stb");
+
+    // Имя кодека отражает найденную библиотеку: libjpeg-turbo или обычный libjpeg
+    const std::string jpeg_name = JpegImageCodec().getName();
+    EXPECT_TRUE(jpeg_name == "libjpeg-turbo" || jpeg_name == "libjpeg") << jpeg_name;
+
+    const std::string expected_jpeg = JpegImageCodec::isAvailable() ? jpeg_name : "stb";
+    EXPECT_EQ(ImageCodec::findDecoder("jpg").getName(), expected_jpeg);
+    EXPECT_EQ(ImageCodec::findEncoder("jpeg").getName(), expected_jpeg);
+}
+
+TEST(ImageCodecTest, JpegScaledDecodeUsesCeilDimensions)
+{
+    if (!JpegImageCodec::isAvailable())
+    {
+        GTEST_SKIP() << "Библиотека собрана без libjpeg";
+    }
+
+    const int width = 203;
+    const int height = 101;
+    const auto pixels = makeGradient(width, height);
+    const auto path = tempPath("imagefilter_codec_scaled.jpg");
+    ASSERT_TRUE(ImageSaver::saveToFile(path, pixels.data(), width, height, 3, false, 95).isSuccess());
+
+    for (const int scale : {1, 2, 4, 8})
+    {
+        ImageLoader::LoadedImage image;
+        ASSERT_TRUE(ImageLoader::loadFromFile(path, true, image, scale).isSuccess()) << scale;
+        EXPECT_EQ(image.width, (width + scale - 1) / scale);
+        EXPECT_EQ(image.height, (height + scale - 1) / scale);
+        EXPECT_EQ(image.channels, 4);
+
+        // Центр градиента сохраняется при любом масштабе
+        const auto* center = image.data + (static_cast<size_t>(image.height / 2) * image.width + image.width / 2) * 4;
+        EXPECT_NEAR(center[0], 127, 8) << scale;
+        EXPECT_NEAR(center[1], 127, 8) << scale;
+        EXPECT_NEAR(center[2], 128, 8) << scale;
+        EXPECT_EQ(center[3], 255);
+        std::free(image.data);
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST(ImageCodecTest, RelativeJpegPathUsesJpegCodec)
+{
+    if (!JpegImageCodec::isAvailable())
+    {
+        GTEST_SKIP() << "Библиотека собрана без libjpeg";
+    }
+
+    const int width = 64;
+    const int height = 32;
+    const auto pixels = makeGradient(width, height);
+    const auto directory = std::filesystem::temp_directory_path() / "imagefilter_codec_relative";
+    std::filesystem::create_directories(directory);
+    ASSERT_TRUE(ImageSaver::saveToFile((directory / "a.jpg").string(), pixels.data(), width, height, 3, false, 90)
+                    .isSuccess());
+
+    // Расширение берется из нормализованного пути, а не по позиции в относительном
+    const auto previous_directory = std::filesystem::current_path();
+    std::filesystem::current_path(directory);
+    ImageLoader::LoadedImage image;
+    const auto result = ImageLoader::loadFromFile("a.jpg", false, image, 8);
+    std::filesystem::current_path(previous_directory);
+
+    ASSERT_TRUE(result.isSuccess()) << result.getFullMessage();
+    EXPECT_EQ(image.width, width / 8);
+    EXPECT_EQ(image.height, height / 8);
+    std::free(image.data);
+
+    std::filesystem::remove_all(directory);
+}
+
+TEST(ImageCodecTest, MisnamedFilesUseCodecForTheirContent)
+{
+    const int width = 64;
+    const int height = 32;
+    const auto pixels = makeGradient(width, height);
+
+    // BMP под расширением .jpg читается обработчиком BMP, а не кодеком JPEG
+    const auto bmp_path = tempPath("imagefilter_codec_misnamed_bmp.bmp");
+    const auto bmp_as_jpg = tempPath("imagefilter_codec_misnamed_bmp.jpg");
+    ASSERT_TRUE(ImageSaver::saveToFile(bmp_path, pixels.data(), width, height, 3, false, 90).isSuccess());
+    std::filesystem::rename(bmp_path, bmp_as_jpg);
+
+    ImageLoader::LoadedImage image;
+    const auto bmp_result = ImageLoader::loadFromFile(bmp_as_jpg, false, image);
+    ASSERT_TRUE(bmp_result.isSuccess()) << bmp_result.getFullMessage();
+    EXPECT_EQ(image.width, width);
+    EXPECT_EQ(image.height, height);
+    EXPECT_EQ(image.data[0], pixels[0]);
+    std::free(image.data);
+    std::filesystem::remove(bmp_as_jpg);
+
+    if (!JpegImageCodec::isAvailable())
+    {
+        GTEST_SKIP() << "Библиотека собрана без libjpeg";
+    }
+
+    // JPEG под расширением .png декодируется кодеком JPEG (с масштабированием)
+    const auto jpg_path = tempPath("imagefilter_codec_misnamed_jpg.jpg");
+    const auto jpg_as_png = tempPath("imagefilter_codec_misnamed_jpg.png");
+    ASSERT_TRUE(ImageSaver::saveToFile(jpg_path, pixels.data(), width, height, 3, false, 90).isSuccess());
+    std::filesystem::rename(jpg_path, jpg_as_png);
+
+    const auto jpg_result = ImageLoader::loadFromFile(jpg_as_png, false, image, 8);
+    ASSERT_TRUE(jpg_result.isSuccess()) << jpg_result.getFullMessage();
+    EXPECT_EQ(image.width, width / 8);
+    EXPECT_EQ(image.height, height / 8);
+    std::free(image.data);
+    std::filesystem::remove(jpg_as_png);
+}
+
+TEST(ImageCodecTest, BoxDownscaleForFormatsWithoutScaledDecode)
+{
+    // 5 x 3 пикселя: при масштабе 2 крайние блоки неполные
+    const int width = 5;
+    const int height = 3;
+    std::vector<uint8_t> pixels(static_cast<size_t>(width) * height * 3);
+    for (size_t i = 0; i < pixels.size(); ++i)
+    {
+        pixels[i] = static_cast<uint8_t>((i / 3) * 10);
+    }
+    const auto path = tempPath("imagefilter_codec_scaled.bmp");
+    ASSERT_TRUE(ImageSaver::saveToFile(path, pixels.data(), width, height, 3, false, 90).isSuccess());
+
+    ImageLoader::LoadedImage image;
+    ASSERT_TRUE(ImageLoader::loadFromFile(path, false, image, 2).isSuccess());
+    EXPECT_EQ(image.width, 3);
+    EXPECT_EQ(image.height, 2);
+    EXPECT_EQ(image.channels, 3);
+    // Блок (0,0): пиксели 0, 1, 5, 6 -> (0 + 10 + 50 + 60) / 4 = 30
+    EXPECT_EQ(image.data[0], 30);
+    // Блок (2,1): единственный пиксель 14 -> 140
+    EXPECT_EQ(image.data[(1 * 3 + 2) * 3], 140);
+    std::free(image.data);
+
+    std::filesystem::remove(path);
+}
+
+TEST(ImageCodecTest, RejectsUnsupportedScale)
+{
+    ImageLoader::LoadedImage image;
+    const auto result = ImageLoader::loadFromFile(tempPath("imagefilter_codec_missing.jpg"), false, image, 3);
+    EXPECT_EQ(result.error, FilterError::InvalidParameter);
+    EXPECT_EQ(image.data, nullptr);
+}
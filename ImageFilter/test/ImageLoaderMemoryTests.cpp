@@ -0,0 +1,145 @@
+/**
+ * @file ImageLoaderMemoryTests.cpp
+ * @brief Юнит-тесты загрузки изображений из памяти и отображенных файлов.
+ *
+ * Проверяется чтение файла через MappedFile, декодирование BMP и JPEG из
+ * буфера с определением формата по сигнатуре и ошибки для пустых данных
+ * и отсутствующих файлов.
+ */
+
+#include <gtest/gtest.h>
+
+#include <ImageProcessor.h>
+#include <utils/ImageLoader.h>
+#include <utils/ImageSaver.h>
+#include <utils/JpegImageCodec.h>
+#include <utils/MappedFile.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace
+{
+    std::vector<uint8_t> makePixels(int width, int height)
+    {
+        std::vector<uint8_t> pixels(static_cast<size_t>(width) * height * 3);
+        for (size_t i = 0; i < pixels.size(); ++i)
+        {
+            pixels[i] = static_cast<uint8_t>(i * 7);
+        }
+        return pixels;
+    }
+
+    std::string tempPath(const char* name)
+    {
+        return (std::filesystem::temp_directory_path() / name).string();
+    }
+
+    std::vector<uint8_t> readAll(const std::string& path)
+    {
+        MappedFile file;
+        if (!file.open(path).isSuccess())
+        {
+            return {};
+        }
+        return {file.data(), file.data() + file.size()};
+    }
+}
+
+TEST(ImageLoaderMemoryTest, MappedFileExposesFileContents)
+{
+    const int width = 7;
+    const int height = 3;
+    const auto pixels = makePixels(width, height);
+    const auto path = tempPath("imagefilter_mapped_file.bmp");
+    ASSERT_TRUE(ImageSaver::saveToFile(path, pixels.data(), width, height, 3, false, 90).isSuccess());
+
+    MappedFile file;
+    ASSERT_TRUE(file.open(path).isSuccess());
+    EXPECT_EQ(file.size(), std::filesystem::file_size(path));
+    EXPECT_EQ(file.data()[0], 'B');
+    EXPECT_EQ(file.data()[1], 'M');
+    file.prefetch();
+
+    MappedFile moved = std::move(file);
+    EXPECT_TRUE(file.empty());
+    EXPECT_EQ(moved.bytes().size(), std::filesystem::file_size(path));
+
+    moved.close();
+    EXPECT_EQ(moved.data(), nullptr);
+    std::filesystem::remove(path);
+}
+
+TEST(ImageLoaderMemoryTest, DecodesBmpFromMemory)
+{
+    const int width = 5;
+    const int height = 4;
+    const auto pixels = makePixels(width, height);
+    const auto path = tempPath("imagefilter_memory.bmp");
+    ASSERT_TRUE(ImageSaver::saveToFile(path, pixels.data(), width, height, 3, false, 90).isSuccess());
+    const auto bytes = readAll(path);
+    std::filesystem::remove(path);
+    ASSERT_FALSE(bytes.empty());
+
+    ImageLoader::LoadedImage image;
+    ASSERT_TRUE(ImageLoader::loadFromMemory(bytes, true, image).isSuccess());
+    EXPECT_EQ(image.width, width);
+    EXPECT_EQ(image.height, height);
+    ASSERT_EQ(image.channels, 4);
+    for (size_t i = 0; i < static_cast<size_t>(width) * height; ++i)
+    {
+        EXPECT_EQ(image.data[i * 4 + 0], pixels[i * 3 + 0]);
+        EXPECT_EQ(image.data[i * 4 + 2], pixels[i * 3 + 2]);
+        EXPECT_EQ(image.data[i * 4 + 3], 255);
+    }
+    std::free(image.data);
+
+    ImageProcessor processor;
+    ASSERT_TRUE(processor.loadFromMemory(bytes).isSuccess());
+    EXPECT_EQ(processor.getWidth(), width);
+    EXPECT_EQ(processor.getChannels(), 3);
+}
+
+TEST(ImageLoaderMemoryTest, DecodesJpegFromMemoryWithScale)
+{
+    if (!JpegImageCodec::isAvailable())
+    {
+        GTEST_SKIP() << "Библиотека собрана без libjpeg";
+    }
+
+    const int width = 64;
+    const int height = 40;
+    const auto pixels = makePixels(width, height);
+    const auto path = tempPath("imagefilter_memory.jpg");
+    ASSERT_TRUE(ImageSaver::saveToFile(path, pixels.data(), width, height, 3, false, 90).isSuccess());
+    const auto bytes = readAll(path);
+    std::filesystem::remove(path);
+    ASSERT_FALSE(bytes.empty());
+
+    ImageLoader::LoadedImage image;
+    ASSERT_TRUE(ImageLoader::loadFromMemory(bytes, false, image, 4).isSuccess());
+    EXPECT_EQ(image.width, 16);
+    EXPECT_EQ(image.height, 10);
+    EXPECT_EQ(image.channels, 3);
+    std::free(image.data);
+}
+
+TEST(ImageLoaderMemoryTest, ReportsEmptyDataAndMissingFile)
+{
+    ImageLoader::LoadedImage image;
+    EXPECT_EQ(ImageLoader::loadFromMemory({}, false, image).error, FilterError::InvalidSize);
+    EXPECT_EQ(image.data, nullptr);
+
+    const std::vector<uint8_t> garbage = {'B', 'M', 1, 2, 3};
+    EXPECT_FALSE(ImageLoader::loadFromMemory(garbage, false, image).isSuccess());
+    EXPECT_EQ(image.data, nullptr);
+
+    const auto missing = tempPath("imagefilter_memory_missing.png");
+    const auto result = ImageLoader::loadFromFile(missing, false, image);
+    EXPECT_EQ(result.error, FilterError::FileReadError);
+    ASSERT_TRUE(result.context.has_value());
+    EXPECT_TRUE(result.context->filename.has_value());
+}
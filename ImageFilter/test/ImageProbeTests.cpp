@@ -0,0 +1,98 @@
+/**
+ * @file ImageProbeTests.cpp
+ * @brief Юнит-тесты чтения сведений об изображении из заголовка ImageLoader::probe.
+ *
+ * Проверяется определение формата, размеров и количества каналов BMP и JPEG
+ * без декодирования пикселей, разбор BMP только по заголовкам и ошибки для
+ * неизвестных данных и отсутствующих файлов.
+ */
+
+#include <gtest/gtest.h>
+
+#include <utils/ImageLoader.h>
+#include <utils/ImageSaver.h>
+#include <utils/JpegImageCodec.h>
+#include <utils/MappedFile.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace
+{
+    std::string saveImage(const char* name, int width, int height)
+    {
+        const auto path = (std::filesystem::temp_directory_path() / name).string();
+        const std::vector<uint8_t> pixels(static_cast<size_t>(width) * height * 3, 100);
+        EXPECT_TRUE(ImageSaver::saveToFile(path, pixels.data(), width, height, 3, false, 90).isSuccess());
+        return path;
+    }
+}
+
+TEST(ImageProbeTest, ProbesBmpFile)
+{
+    const auto path = saveImage("imagefilter_probe.bmp", 37, 21);
+
+    ImageLoader::ImageInfo info;
+    ASSERT_TRUE(ImageLoader::probe(path, info).isSuccess());
+    EXPECT_EQ(info.format, "bmp");
+    EXPECT_EQ(info.width, 37);
+    EXPECT_EQ(info.height, 21);
+    EXPECT_EQ(info.channels, 3);
+    EXPECT_EQ(info.file_size, std::filesystem::file_size(path));
+    std::filesystem::remove(path);
+}
+
+TEST(ImageProbeTest, BmpHeadersAreEnoughWithoutPixels)
+{
+    const auto path = saveImage("imagefilter_probe_headers.bmp", 640, 480);
+    MappedFile file;
+    ASSERT_TRUE(file.open(path).isSuccess());
+    const std::vector<uint8_t> headers(file.data(), file.data() + 54);
+    file.close();
+    std::filesystem::remove(path);
+
+    // Пикселей нет: декодирование невозможно, но размеры читаются
+    ImageLoader::LoadedImage image;
+    EXPECT_FALSE(ImageLoader::loadFromMemory(headers, false, image).isSuccess());
+
+    ImageLoader::ImageInfo info;
+    ASSERT_TRUE(ImageLoader::probeFromMemory(headers, info).isSuccess());
+    EXPECT_EQ(info.width, 640);
+    EXPECT_EQ(info.height, 480);
+    EXPECT_EQ(info.file_size, 54u);
+}
+
+TEST(ImageProbeTest, ProbesJpegHeader)
+{
+    if (!JpegImageCodec::isAvailable())
+    {
+        GTEST_SKIP() << "Библиотека собрана без libjpeg";
+    }
+
+    const auto path = saveImage("imagefilter_probe.jpg", 64, 40);
+    ImageLoader::ImageInfo info;
+    ASSERT_TRUE(ImageLoader::probe(path, info).isSuccess());
+    EXPECT_EQ(info.format, "jpg");
+    EXPECT_EQ(info.width, 64);
+    EXPECT_EQ(info.height, 40);
+    EXPECT_EQ(info.channels, 3);
+    std::filesystem::remove(path);
+}
+
+TEST(ImageProbeTest, ReportsUnknownDataAndMissingFile)
+{
+    ImageLoader::ImageInfo info;
+    EXPECT_EQ(ImageLoader::probeFromMemory({}, info).error, FilterError::InvalidSize);
+
+    const std::vector<uint8_t> garbage = {'n', 'o', 't', ' ', 'a', 'n', ' ', 'i', 'm', 'a', 'g', 'e'};
+    EXPECT_FALSE(ImageLoader::probeFromMemory(garbage, info).isSuccess());
+    EXPECT_TRUE(info.format.empty());
+
+    const auto missing = (std::filesystem::temp_directory_path() / "imagefilter_probe_missing.png").string();
+    const auto result = ImageLoader::probe(missing, info);
+    EXPECT_FALSE(result.isSuccess());
+    ASSERT_TRUE(result.context.has_value());
+    EXPECT_TRUE(result.context->filename.has_value());
+}
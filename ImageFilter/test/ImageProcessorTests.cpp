@@ -0,0 +1,128 @@
+/**
+ * @file ImageProcessorTests.cpp
+ * @brief Юнит-тесты владения буфером ImageProcessor.
+ *
+ * Проверяются передача буфера без копирования через adopt(), освобождение
+ * через пользовательский deleter, преобразование RGBA в RGB на месте и поворот
+ * без промежуточной копии.
+ */
+
+#include <gtest/gtest.h>
+
+#include <ImageProcessor.h>
+#include <filters/Rotate90Filter.h>
+#include <utils/BufferPool.h>
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief adopt() использует переданный буфер без копирования и освобождает его deleter'ом.
+ */
+TEST(ImageProcessorTests, AdoptTakesOwnershipWithoutCopy)
+{
+    int deleted = 0;
+    auto* pixels = new uint8_t[2 * 2 * 3]{};
+    {
+        ImageProcessor image;
+        ASSERT_TRUE(image.adopt(2, 2, 3, pixels, [&deleted](uint8_t* ptr)
+        {
+            ++deleted;
+            delete[] ptr;
+        }).isSuccess());
+        EXPECT_EQ(image.getData(), pixels);
+        EXPECT_EQ(image.getWidth(), 2);
+        EXPECT_EQ(deleted, 0);
+
+        // Замена данных освобождает предыдущий буфер
+        std::vector<uint8_t> other(4 * 4 * 3, 1);
+        ASSERT_TRUE(image.resize(4, 4, 3, other.data()).isSuccess());
+        EXPECT_EQ(deleted, 1);
+    }
+    EXPECT_EQ(deleted, 1);
+}
+
+/**
+ * @brief При ошибке adopt() буфер освобождается, а изображение не меняется.
+ */
+TEST(ImageProcessorTests, AdoptReleasesBufferOnError)
+{
+    int deleted = 0;
+    const auto deleter = [&deleted](uint8_t* ptr)
+    {
+        ++deleted;
+        delete[] ptr;
+    };
+
+    ImageProcessor image;
+    EXPECT_FALSE(image.adopt(0, 2, 3, new uint8_t[6], deleter).isSuccess());
+    EXPECT_EQ(deleted, 1);
+
+    // Буфер меньше изображения
+    EXPECT_FALSE(image.adopt(4, 4, 3, ImageBuffer(new uint8_t[10], 10, deleter)).isSuccess());
+    EXPECT_EQ(deleted, 2);
+    EXPECT_FALSE(image.isValid());
+}
+
+/**
+ * @brief convertToRGB() преобразует данные на месте с композицией на белом фоне.
+ */
+TEST(ImageProcessorTests, ConvertToRGBInPlace)
+{
+    const std::vector<uint8_t> rgba = {
+        10, 20, 30, 255,   200, 100, 50, 0,
+        0, 0, 0, 128,      40, 80, 120, 255,
+    };
+
+    ImageProcessor image;
+    ASSERT_TRUE(image.resize(2, 2, 4, rgba.data()).isSuccess());
+    const auto* data_before = image.getData();
+    ASSERT_TRUE(image.convertToRGB().isSuccess());
+    EXPECT_EQ(image.getData(), data_before);
+    EXPECT_EQ(image.getChannels(), 3);
+
+    const std::vector<uint8_t> expected = {10, 20, 30, 255, 255, 255, 126, 126, 126, 40, 80, 120};
+    for (size_t i = 0; i < expected.size(); ++i)
+    {
+        EXPECT_EQ(image.getData()[i], expected[i]) << "i=" << i;
+    }
+}
+
+/**
+ * @brief Поворот передает буфер из пула изображению без копирования.
+ */
+TEST(ImageProcessorTests, RotateAdoptsPooledBuffer)
+{
+    const int width = 3;
+    const int height = 2;
+    std::vector<uint8_t> rgb(static_cast<size_t>(width) * height * 3);
+    for (size_t i = 0; i < rgb.size(); ++i)
+    {
+        rgb[i] = static_cast<uint8_t>(i);
+    }
+
+    BufferPool pool(0, 1);
+    auto pooled = pool.acquire(rgb.size());
+    const auto* pooled_data = pooled.data();
+    pool.release(std::move(pooled));
+
+    ImageProcessor image;
+    ASSERT_TRUE(image.resize(width, height, 3, rgb.data()).isSuccess());
+    Rotate90Filter filter(true, &pool);
+    ASSERT_TRUE(filter.apply(image).isSuccess());
+
+    EXPECT_EQ(image.getData(), pooled_data);
+    EXPECT_EQ(image.getWidth(), height);
+    EXPECT_EQ(image.getHeight(), width);
+
+    // По часовой стрелке: пиксель (x, y) переходит в (height - 1 - y, x)
+    for (int y = 0; y < height; ++y)
+    {
+        for (int x = 0; x < width; ++x)
+        {
+            const auto src = (static_cast<size_t>(y) * width + x) * 3;
+            const auto dst = (static_cast<size_t>(x) * height + (height - 1 - y)) * 3;
+            EXPECT_EQ(image.getData()[dst], rgb[src]) << "x=" << x << " y=" << y;
+        }
+    }
+}
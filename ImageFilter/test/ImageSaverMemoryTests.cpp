@@ -0,0 +1,123 @@
+/**
+ * @file ImageSaverMemoryTests.cpp
+ * @brief Юнит-тесты кодирования изображений в память.
+ *
+ * Проверяется совпадение BMP в памяти с файлом, кодирование RGBA в JPEG
+ * без альфа-канала (если доступен libjpeg), обертка ImageProcessor
+ * и ошибки для неподдерживаемого формата и некорректных данных.
+ */
+
+#include <gtest/gtest.h>
+
+#include <ImageProcessor.h>
+#include <utils/ImageLoader.h>
+#include <utils/ImageSaver.h>
+#include <utils/JpegImageCodec.h>
+#include <utils/MappedFile.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace
+{
+    std::vector<uint8_t> makePixels(int width, int height, int channels)
+    {
+        std::vector<uint8_t> pixels(static_cast<size_t>(width) * height * channels);
+        for (size_t i = 0; i < pixels.size(); ++i)
+        {
+            pixels[i] = static_cast<uint8_t>(i * 13);
+        }
+        return pixels;
+    }
+}
+
+TEST(ImageSaverMemoryTest, BmpInMemoryMatchesFile)
+{
+    const int width = 7;
+    const int height = 5;
+    const auto pixels = makePixels(width, height, 4);
+    const auto path = (std::filesystem::temp_directory_path() / "imagefilter_saver_memory.bmp").string();
+    ASSERT_TRUE(ImageSaver::saveToFile(path, pixels.data(), width, height, 4, false, 90).isSuccess());
+
+    std::vector<uint8_t> encoded;
+    ASSERT_TRUE(ImageSaver::saveToMemory(".BMP", pixels.data(), width, height, 4, false, 90, encoded).isSuccess());
+
+    MappedFile file;
+    ASSERT_TRUE(file.open(path).isSuccess());
+    ASSERT_EQ(encoded.size(), file.size());
+    EXPECT_TRUE(std::equal(encoded.begin(), encoded.end(), file.data()));
+    file.close();
+    std::filesystem::remove(path);
+}
+
+TEST(ImageSaverMemoryTest, JpegDropsAlphaWhileEncoding)
+{
+    if (!JpegImageCodec::isAvailable())
+    {
+        GTEST_SKIP() << "Библиотека собрана без libjpeg";
+    }
+
+    const int width = 48;
+    const int height = 32;
+    std::vector<uint8_t> pixels(static_cast<size_t>(width) * height * 4);
+    for (size_t i = 0; i < pixels.size(); i += 4)
+    {
+        pixels[i + 0] = 200;
+        pixels[i + 1] = 100;
+        pixels[i + 2] = 50;
+        pixels[i + 3] = 0; // Прозрачность не должна влиять на цвет
+    }
+
+    std::vector<uint8_t> encoded;
+    ASSERT_TRUE(ImageSaver::saveToMemory("jpg", pixels.data(), width, height, 4, false, 95, encoded).isSuccess());
+    ASSERT_GT(encoded.size(), 2u);
+    EXPECT_EQ(encoded[0], 0xFF);
+    EXPECT_EQ(encoded[1], 0xD8);
+
+    ImageLoader::LoadedImage image;
+    ASSERT_TRUE(ImageLoader::loadFromMemory(encoded, false, image).isSuccess());
+    EXPECT_EQ(image.width, width);
+    EXPECT_EQ(image.height, height);
+    EXPECT_NEAR(image.data[0], 200, 4);
+    EXPECT_NEAR(image.data[1], 100, 4);
+    EXPECT_NEAR(image.data[2], 50, 4);
+    std::free(image.data);
+}
+
+TEST(ImageSaverMemoryTest, ProcessorRoundTripThroughMemory)
+{
+    const int width = 6;
+    const int height = 4;
+    const auto pixels = makePixels(width, height, 3);
+
+    ImageProcessor processor;
+    std::vector<uint8_t> encoded;
+    EXPECT_EQ(processor.saveToMemory("bmp", encoded).error, FilterError::InvalidImage);
+
+    ASSERT_TRUE(processor.resize(width, height, 3, pixels.data()).isSuccess());
+    ASSERT_TRUE(processor.saveToMemory("bmp", encoded).isSuccess());
+
+    ImageProcessor decoded;
+    ASSERT_TRUE(decoded.loadFromMemory(encoded).isSuccess());
+    ASSERT_EQ(decoded.getWidth(), width);
+    ASSERT_EQ(decoded.getHeight(), height);
+    EXPECT_TRUE(std::equal(pixels.begin(), pixels.end(), decoded.getData()));
+}
+
+TEST(ImageSaverMemoryTest, RejectsUnsupportedFormatAndBadImage)
+{
+    const auto pixels = makePixels(4, 4, 3);
+    std::vector<uint8_t> encoded = {1, 2, 3};
+
+    EXPECT_EQ(ImageSaver::saveToMemory("tiff", pixels.data(), 4, 4, 3, false, 90, encoded).error,
+              FilterError::UnsupportedFormat);
+    EXPECT_TRUE(encoded.empty());
+    EXPECT_EQ(ImageSaver::saveToMemory("png", nullptr, 4, 4, 3, false, 90, encoded).error,
+              FilterError::InvalidImage);
+    EXPECT_EQ(ImageSaver::saveToMemory("png", pixels.data(), 4, 4, 2, false, 90, encoded).error,
+              FilterError::InvalidChannels);
+}
@@ -0,0 +1,63 @@
+/**
+ * @file LookupTablesTests.cpp
+ * @brief Юнит-тесты таблиц LookupTables, вычисляемых при компиляции.
+ *
+ * Значения таблиц сравниваются с функциями стандартной библиотеки.
+ */
+
+#include <gtest/gtest.h>
+
+#include <utils/LookupTables.h>
+
+#include <cmath>
+#include <numbers>
+
+/**
+ * @brief Таблица sqrt совпадает с std::sqrt побитово.
+ */
+TEST(LookupTablesTests, SqrtMatchesStd)
+{
+    for (int x = 0; x <= 10000; ++x)
+    {
+        ASSERT_EQ(LookupTables::sqrtInt(x), std::sqrt(static_cast<double>(x))) << "x=" << x;
+        ASSERT_EQ(LookupTables::sqrtIntScaled(x),
+                  static_cast<int32_t>(std::sqrt(static_cast<double>(x)) * 65536.0)) << "x=" << x;
+    }
+    EXPECT_EQ(LookupTables::sqrtInt(123456), std::sqrt(123456.0));
+}
+
+/**
+ * @brief Таблицы sin/cos точны и симметричны для "точных" углов.
+ */
+TEST(LookupTablesTests, SinCosAccuracy)
+{
+    for (int angle = -360; angle < 720; ++angle)
+    {
+        const auto rad = static_cast<double>(angle) * std::numbers::pi / 180.0;
+        ASSERT_NEAR(LookupTables::sin(angle), std::sin(rad), 1e-14) << "angle=" << angle;
+        ASSERT_NEAR(LookupTables::cos(angle), std::cos(rad), 1e-14) << "angle=" << angle;
+    }
+
+    EXPECT_EQ(LookupTables::sin(30), 0.5);
+    EXPECT_EQ(LookupTables::cos(60), 0.5);
+    EXPECT_EQ(LookupTables::sin(90), 1.0);
+    EXPECT_EQ(LookupTables::cos(180), -1.0);
+    EXPECT_EQ(LookupTables::sinScaled(30), 32768);
+    EXPECT_EQ(LookupTables::cosScaled(270), 0);
+}
+
+/**
+ * @brief exp(-x) совпадает с std::exp в узлах таблицы и между ними.
+ */
+TEST(LookupTablesTests, ExpNegativeAccuracy)
+{
+    for (int i = 0; i <= 2000; ++i)
+    {
+        const auto x = static_cast<double>(i) * 0.01;
+        ASSERT_NEAR(LookupTables::expNegative(x), std::exp(-x), std::exp(-x) * 1e-14) << "x=" << x;
+    }
+
+    // Линейная интерполяция между узлами
+    EXPECT_NEAR(LookupTables::expNegative(0.505), std::exp(-0.505), 1e-5);
+    EXPECT_EQ(LookupTables::expNegative(25.0), 0.0);
+}
@@ -0,0 +1,124 @@
+/**
+ * @file ScratchArenaTests.cpp
+ * @brief Юнит-тесты арены временных буферов фильтров.
+ *
+ * Проверяются выравнивание и переиспользование памяти арены, объединение блоков
+ * между изображениями, выбор источника памяти ScratchBuffer и совпадение
+ * результата цепочки фильтров с ареной и без нее.
+ */
+
+#include <gtest/gtest.h>
+
+#include <ImageProcessor.h>
+#include <filters/GaussianBlurFilter.h>
+#include <filters/MedianFilter.h>
+#include <utils/BufferPool.h>
+#include <utils/ScratchArena.h>
+#include <utils/ScratchBuffer.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+/**
+ * @brief Выделения выровнены, rewind() переиспользует память, reset() объединяет блоки.
+ */
+TEST(ScratchArenaTests, BumpRewindAndCoalesce)
+{
+    ScratchArena arena(nullptr, 4096);
+
+    auto* first = arena.allocate(100);
+    auto* second = arena.allocate(100);
+    ASSERT_NE(first, nullptr);
+    ASSERT_NE(second, nullptr);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(first) % ScratchArena::ALIGNMENT, 0u);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(second) % ScratchArena::ALIGNMENT, 0u);
+    EXPECT_EQ(arena.getUsedBytes(), 256u);
+
+    // Освобождение между фильтрами возвращает ту же память
+    arena.rewind();
+    EXPECT_EQ(arena.allocate(100), first);
+    EXPECT_EQ(arena.getPeakBytes(), 256u);
+
+    // Выделение больше блока добавляет новый блок
+    ASSERT_NE(arena.allocate(10000), nullptr);
+    EXPECT_GT(arena.getReservedBytes(), 4096u);
+
+    // Между изображениями блоки объединяются в один
+    const auto reserved = arena.getReservedBytes();
+    arena.reset();
+    EXPECT_EQ(arena.getPeakBytes(), 0u);
+    EXPECT_EQ(arena.getReservedBytes(), reserved);
+    auto* whole = arena.allocate(reserved);
+    ASSERT_NE(whole, nullptr);
+    EXPECT_EQ(arena.getReservedBytes(), reserved);
+}
+
+/**
+ * @brief ScratchBuffer берет память из арены, затем из пула, и возвращает буфер в пул.
+ */
+TEST(ScratchArenaTests, ScratchBufferSourcePriority)
+{
+    ScratchArena arena;
+    BufferPool pool;
+
+    {
+        ScratchBuffer buffer(&arena, &pool, 1000);
+        EXPECT_EQ(buffer.size(), 1000u);
+        EXPECT_EQ(arena.getUsedBytes(), 1024u);
+    }
+    EXPECT_EQ(pool.size(), 0u);
+
+    {
+        ScratchBuffer buffer(nullptr, &pool, 1000);
+        EXPECT_EQ(buffer.size(), 1000u);
+        ScratchBuffer moved(std::move(buffer));
+        EXPECT_EQ(moved.size(), 1000u);
+    }
+    EXPECT_EQ(pool.size(), 1u);
+
+    ScratchBuffer heap(nullptr, nullptr, 10);
+    EXPECT_EQ(heap.size(), 10u);
+    EXPECT_NE(heap.data(), nullptr);
+}
+
+/**
+ * @brief Цепочка с ареной дает тот же результат, пик ограничен самым требовательным фильтром.
+ */
+TEST(ScratchArenaTests, ChainWithArenaMatchesAndBoundsPeak)
+{
+    const int width = 31;
+    const int height = 17;
+    const size_t frame = static_cast<size_t>(width) * height * 3;
+
+    std::mt19937 rng(7);
+    std::vector<uint8_t> pixels(frame);
+    for (auto& value : pixels)
+    {
+        value = static_cast<uint8_t>(rng() & 0xFF);
+    }
+
+    ImageProcessor reference;
+    ASSERT_TRUE(reference.resize(width, height, 3, pixels.data()).isSuccess());
+    ImageProcessor image;
+    ASSERT_TRUE(image.resize(width, height, 3, pixels.data()).isSuccess());
+
+    ScratchArena arena;
+    image.setScratchArena(&arena);
+
+    GaussianBlurFilter blur(2.0);
+    MedianFilter median(1);
+    for (IFilter* filter : {static_cast<IFilter*>(&blur), static_cast<IFilter*>(&median)})
+    {
+        ASSERT_TRUE(filter->apply(reference).isSuccess());
+        ASSERT_TRUE(filter->apply(image).isSuccess());
+        arena.rewind();
+    }
+
+    EXPECT_EQ(std::vector<uint8_t>(image.getData(), image.getData() + frame),
+              std::vector<uint8_t>(reference.getData(), reference.getData() + frame));
+
+    // Каждому фильтру нужен один кадр временной памяти
+    const size_t aligned_frame = (frame + ScratchArena::ALIGNMENT - 1) & ~(ScratchArena::ALIGNMENT - 1);
+    EXPECT_EQ(arena.getPeakBytes(), aligned_frame);
+}
@@ -0,0 +1,273 @@
+/**
+ * @file StripPipelineTests.cpp
+ * @brief Юнит-тесты потоковой обработки изображения полосами.
+ *
+ * Проверяется, что обработка полосами любой высоты совпадает с обработкой
+ * всего изображения, что цепочки с полнокадровыми фильтрами и фильтрами
+ * с обработкой границ Wrap отклоняются, и построчный кодек JPEG (если
+ * libjpeg доступен).
+ */
+
+#include <gtest/gtest.h>
+
+#include <ImageProcessor.h>
+#include <filters/BoxBlurFilter.h>
+#include <filters/BrightnessFilter.h>
+#include <filters/EdgeDetectionFilter.h>
+#include <filters/GaussianBlurFilter.h>
+#include <filters/MedianFilter.h>
+#include <filters/SharpenFilter.h>
+#include <utils/RowStream.h>
+#include <utils/StripPipeline.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <random>
+#include <vector>
+
+namespace
+{
+    /**
+     * @brief Источник строк из вектора в памяти
+     */
+    class MemoryRowReader : public IRowReader
+    {
+    public:
+        MemoryRowReader(const std::vector<uint8_t>& pixels, int width, int height, int channels)
+            : pixels_(pixels), width_(width), height_(height), channels_(channels)
+        {
+        }
+
+        int getWidth() const noexcept override { return width_; }
+        int getHeight() const noexcept override { return height_; }
+        int getChannels() const noexcept override { return channels_; }
+
+        FilterResult readRows(uint8_t* destination, int count) override
+        {
+            const size_t row_bytes = static_cast<size_t>(width_) * channels_;
+            std::memcpy(destination, pixels_.data() + static_cast<size_t>(next_row_) * row_bytes,
+                        static_cast<size_t>(count) * row_bytes);
+            next_row_ += count;
+            return FilterResult::success();
+        }
+
+    private:
+        const std::vector<uint8_t>& pixels_;
+        int width_;
+        int height_;
+        int channels_;
+        int next_row_ = 0;
+    };
+
+    /**
+     * @brief Приемник строк в вектор в памяти
+     */
+    class MemoryRowWriter : public IRowWriter
+    {
+    public:
+        FilterResult begin(int width, int height, int channels) override
+        {
+            row_bytes_ = static_cast<size_t>(width) * channels;
+            pixels.clear();
+            pixels.reserve(row_bytes_ * height);
+            return FilterResult::success();
+        }
+
+        FilterResult writeRows(const uint8_t* source, int count) override
+        {
+            pixels.insert(pixels.end(), source, source + static_cast<size_t>(count) * row_bytes_);
+            return FilterResult::success();
+        }
+
+        FilterResult finish() override
+        {
+            finished = true;
+            return FilterResult::success();
+        }
+
+        std::vector<uint8_t> pixels;
+        bool finished = false;
+
+    private:
+        size_t row_bytes_ = 0;
+    };
+
+    std::vector<uint8_t> randomPixels(size_t size, unsigned seed)
+    {
+        std::mt19937 rng(seed);
+        std::vector<uint8_t> pixels(size);
+        for (auto& value : pixels)
+        {
+            value = static_cast<uint8_t>(rng() & 0xFF);
+        }
+        return pixels;
+    }
+}
+
+/**
+ * @brief Результат полосами любой высоты совпадает с обработкой всего изображения.
+ */
+TEST(StripPipelineTests, MatchesWholeImageForAnyStripHeight)
+{
+    const int width = 29;
+    const int height = 47;
+    const int channels = 3;
+    const auto pixels = randomPixels(static_cast<size_t>(width) * height * channels, 3);
+
+    GaussianBlurFilter blur(1.5);
+    MedianFilter median(1);
+    SharpenFilter sharpen(0.8);
+    BoxBlurFilter box(2);
+    BrightnessFilter brightness(1.1);
+    const std::vector<IFilter*> chain = {&blur, &median, &sharpen, &box, &brightness};
+    ASSERT_EQ(StripPipeline::getChainRadius(chain), 1 + 1 + 1 + 2 + 0);
+
+    ImageProcessor reference;
+    ASSERT_TRUE(reference.resize(width, height, channels, pixels.data()).isSuccess());
+    for (auto* filter : chain)
+    {
+        ASSERT_TRUE(filter->apply(reference).isSuccess());
+    }
+    const std::vector<uint8_t> expected(reference.getData(),
+                                        reference.getData() + pixels.size());
+
+    for (const int strip_rows : {1, 4, 16, 47, 256})
+    {
+        MemoryRowReader reader(pixels, width, height, channels);
+        MemoryRowWriter writer;
+        StripPipeline::Statistics statistics;
+        ASSERT_TRUE(StripPipeline::run(reader, writer, chain, strip_rows, &statistics).isSuccess());
+        EXPECT_TRUE(writer.finished);
+        EXPECT_EQ(writer.pixels, expected) << "strip_rows=" << strip_rows;
+        EXPECT_EQ(statistics.strips, static_cast<size_t>((height + strip_rows - 1) / strip_rows));
+    }
+}
+
+/**
+ * @brief Радиус, допустимый для всего изображения, допустим и для полос.
+ *
+ * Окно первой и последней полосы короче ядра: без дополнения фильтр отклонил
+ * бы радиус 12 для окна 16x20, хотя для изображения 16x64 он допустим.
+ */
+TEST(StripPipelineTests, AcceptsRadiusValidForWholeImage)
+{
+    const int width = 16;
+    const int height = 64;
+    const int channels = 3;
+    const auto pixels = randomPixels(static_cast<size_t>(width) * height * channels, 6);
+
+    BoxBlurFilter box(12);
+    const std::vector<IFilter*> chain = {&box};
+
+    ImageProcessor reference;
+    ASSERT_TRUE(reference.resize(width, height, channels, pixels.data()).isSuccess());
+    ASSERT_TRUE(box.apply(reference).isSuccess());
+    const std::vector<uint8_t> expected(reference.getData(), reference.getData() + pixels.size());
+
+    for (const int strip_rows : {1, 8, 30, 64})
+    {
+        MemoryRowReader reader(pixels, width, height, channels);
+        MemoryRowWriter writer;
+        const auto result = StripPipeline::run(reader, writer, chain, strip_rows);
+        ASSERT_TRUE(result.isSuccess()) << "strip_rows=" << strip_rows << ": " << result.getFullMessage();
+        EXPECT_EQ(writer.pixels, expected) << "strip_rows=" << strip_rows;
+    }
+}
+
+/**
+ * @brief Фильтры с обработкой границ Wrap не обрабатываются полосами.
+ *
+ * Строки за верхним краем берутся у нижнего края изображения, которого нет в окне полосы.
+ */
+TEST(StripPipelineTests, RejectsWrapBorderFilters)
+{
+    BoxBlurFilter box_wrap(2, BorderHandler::Strategy::Wrap);
+    GaussianBlurFilter blur_wrap(1.5, BorderHandler::Strategy::Wrap);
+    MedianFilter median_wrap(1, BorderHandler::Strategy::Wrap);
+    SharpenFilter sharpen_wrap(0.8, BorderHandler::Strategy::Wrap);
+    for (IFilter* filter : std::vector<IFilter*>{&box_wrap, &blur_wrap, &median_wrap, &sharpen_wrap})
+    {
+        EXPECT_EQ(filter->getStreamingRadius(), -1) << filter->getName();
+    }
+    EXPECT_EQ(BoxBlurFilter(2, BorderHandler::Strategy::Clamp).getStreamingRadius(), 2);
+
+    const auto pixels = randomPixels(16 * 16 * 3, 5);
+    MemoryRowReader reader(pixels, 16, 16, 3);
+    MemoryRowWriter writer;
+    EXPECT_FALSE(StripPipeline::run(reader, writer, {&box_wrap}, 4).isSuccess());
+    EXPECT_FALSE(writer.finished);
+}
+
+/**
+ * @brief Цепочка с фильтром, которому нужен весь кадр, не обрабатывается полосами.
+ */
+TEST(StripPipelineTests, RejectsWholeImageFilters)
+{
+    const auto pixels = randomPixels(8 * 8 * 3, 4);
+    EdgeDetectionFilter edges;
+    BrightnessFilter brightness(1.1);
+    const std::vector<IFilter*> chain = {&brightness, &edges};
+    EXPECT_EQ(StripPipeline::getChainRadius(chain), -1);
+
+    MemoryRowReader reader(pixels, 8, 8, 3);
+    MemoryRowWriter writer;
+    EXPECT_FALSE(StripPipeline::run(reader, writer, chain).isSuccess());
+    EXPECT_FALSE(writer.finished);
+}
+
+/**
+ * @brief Построчный кодек JPEG: запись и чтение по строкам дают исходное изображение с потерями сжатия.
+ */
+TEST(StripPipelineTests, JpegRowStreamRoundTrip)
+{
+    const std::string path = (std::filesystem::temp_directory_path() / "imagefilter_strip_test.jpg").string();
+    if (!RowStream::isStreamingFormat(path))
+    {
+        GTEST_SKIP() << "libjpeg недоступен";
+    }
+
+    const int width = 64;
+    const int height = 40;
+    std::vector<uint8_t> pixels(static_cast<size_t>(width) * height * 3);
+    for (int y = 0; y < height; ++y)
+    {
+        for (int x = 0; x < width; ++x)
+        {
+            auto* pixel = pixels.data() + (static_cast<size_t>(y) * width + x) * 3;
+            pixel[0] = static_cast<uint8_t>(x * 4);
+            pixel[1] = static_cast<uint8_t>(y * 6);
+            pixel[2] = 128;
+        }
+    }
+
+    {
+        std::unique_ptr<IRowWriter> writer;
+        ASSERT_TRUE(RowStream::createWriter(path, false, 95, writer).isSuccess());
+        MemoryRowReader reader(pixels, width, height, 3);
+        ASSERT_TRUE(StripPipeline::run(reader, *writer, {}, 7).isSuccess());
+    }
+
+    std::unique_ptr<IRowReader> reader;
+    ASSERT_TRUE(RowStream::openReader(path, true, reader).isSuccess());
+    ASSERT_EQ(reader->getWidth(), width);
+    ASSERT_EQ(reader->getHeight(), height);
+    ASSERT_EQ(reader->getChannels(), 4);
+
+    std::vector<uint8_t> decoded(static_cast<size_t>(width) * height * 4);
+    ASSERT_TRUE(reader->readRows(decoded.data(), 15).isSuccess());
+    ASSERT_TRUE(reader->readRows(decoded.data() + static_cast<size_t>(width) * 15 * 4, height - 15).isSuccess());
+    reader.reset();
+    std::filesystem::remove(path);
+
+    for (size_t i = 0; i < static_cast<size_t>(width) * height; ++i)
+    {
+        for (int c = 0; c < 3; ++c)
+        {
+            ASSERT_NEAR(decoded[i * 4 + c], pixels[i * 3 + c], 12) << "pixel " << i;
+        }
+        ASSERT_EQ(decoded[i * 4 + 3], 255);
+    }
+}
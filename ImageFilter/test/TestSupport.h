@@ -0,0 +1,126 @@
+#pragma once
+
+/**
+ * @file TestSupport.h
+ * @brief Общие вспомогательные функции юнит-тестов библиотеки и CLI.
+ *
+ * Временные директории, чтение и запись файлов, заголовки изображений для
+ * проверок без декодирования пикселей, фильтр-заглушка с настраиваемыми
+ * свойствами потоковой обработки и выбор количества потоков обработки строк.
+ */
+
+#include <filters/IFilter.h>
+#include <utils/ConcurrencyGovernor.h>
+#include <utils/FilterResult.h>
+#include <utils/ParallelImageProcessor.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+class ImageProcessor;
+
+namespace TestSupport
+{
+    /**
+     * @brief Создает пустую временную директорию (удаляя остатки прошлого запуска)
+     * @param name Имя директории внутри системной временной директории
+     */
+    inline std::filesystem::path makeTempDirectory(const char* name)
+    {
+        const auto directory = std::filesystem::temp_directory_path() / name;
+        std::filesystem::remove_all(directory);
+        std::filesystem::create_directories(directory);
+        return directory;
+    }
+
+    inline void writeFile(const std::filesystem::path& path, const std::string& contents)
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << contents;
+    }
+
+    inline void writeBytes(const std::filesystem::path& path, const std::vector<uint8_t>& bytes)
+    {
+        std::ofstream file(path, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    }
+
+    inline std::string readFile(const std::filesystem::path& path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+    }
+
+    /**
+     * @brief Заголовки 24-битного BMP с заданными размерами (без пикселей)
+     *
+     * Обход директории принимает только расширения JPEG и PNG, а формат при
+     * чтении заголовка определяется по сигнатуре, поэтому файлам тестов можно
+     * давать расширение .png.
+     */
+    inline void writeImageHeader(const std::filesystem::path& path, int32_t width, int32_t height)
+    {
+        std::vector<uint8_t> bytes(54, 0);
+        bytes[0] = 'B';
+        bytes[1] = 'M';
+        bytes[10] = 54;  // Смещение данных
+        bytes[14] = 40;  // Размер информационного заголовка
+        for (int i = 0; i < 4; ++i)
+        {
+            bytes[18 + i] = static_cast<uint8_t>(static_cast<uint32_t>(width) >> (8 * i));
+            bytes[22 + i] = static_cast<uint8_t>(static_cast<uint32_t>(height) >> (8 * i));
+        }
+        bytes[26] = 1;   // Плоскости
+        bytes[28] = 24;  // Бит на пиксель
+        writeBytes(path, bytes);
+    }
+
+    /**
+     * @brief Фильтр-заглушка: не меняет изображение, сообщает заданные
+     * радиус потоковой обработки и поддержку обработки на месте
+     */
+    class StubFilter : public IFilter
+    {
+    public:
+        explicit StubFilter(int radius, bool in_place = false) : radius_(radius), in_place_(in_place) {}
+        FilterResult apply(ImageProcessor&) override { return FilterResult::success(); }
+        [[nodiscard]] std::string getName() const override { return "stub"; }
+        [[nodiscard]] std::string getDescription() const override { return ""; }
+        [[nodiscard]] std::string getCategory() const override { return ""; }
+        [[nodiscard]] bool supportsInPlace() const noexcept override { return in_place_; }
+        [[nodiscard]] int getStreamingRadius() const noexcept override { return radius_; }
+
+    private:
+        int radius_;
+        bool in_place_;
+    };
+
+    /**
+     * @brief Задает количество потоков обработки строк на время теста
+     *
+     * Меняет и разбиение на полосы, и бюджет потоков, поэтому тесты
+     * воспроизводят разбиение многоядерной машины на любом количестве ядер.
+     */
+    class ScopedThreadCount
+    {
+    public:
+        explicit ScopedThreadCount(int num_threads)
+        {
+            ParallelImageProcessor::setThreadCountOverride(num_threads);
+            ConcurrencyGovernor::getInstance().setThreadBudget(num_threads);
+        }
+
+        ~ScopedThreadCount()
+        {
+            ParallelImageProcessor::setThreadCountOverride(0);
+            ConcurrencyGovernor::getInstance().setThreadBudget(0);
+        }
+
+        ScopedThreadCount(const ScopedThreadCount&) = delete;
+        ScopedThreadCount& operator=(const ScopedThreadCount&) = delete;
+    };
+}